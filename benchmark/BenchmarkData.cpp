@@ -0,0 +1,304 @@
+// BenchmarkData.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "BenchmarkData.h"
+#include <math.h>
+#include <stdio.h>
+#include <thread>
+
+#ifdef WIN32
+    #include <direct.h>
+#else
+    #include <sys/stat.h>
+    #include <sys/types.h>
+#endif
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const float FIELD_OF_VIEW = 60.0f; // Vertical, degrees
+static const float ASPECT = 16.0f / 9.0f;
+static const float NEAR_PLANE = 0.1f;
+static const float FAR_PLANE = 500.0f;
+static const int MAP_SIZE = 256;          // Side of the diffuse maps of generated objects
+
+std::string BenchmarkData::directory;
+std::set<std::string> BenchmarkData::written;
+std::map<std::string, Model *> BenchmarkData::models;
+RecordingBackend BenchmarkData::backend;
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// initialize
+// Description:
+//      Creates the data directory and routes all drawing to the recording backend.
+// Parameters:
+//      in_directory <const std::string&>: Directory for the generated files, created if missing.
+// Returns:
+//      <bool>: False if the directory could not be created.
+//
+bool BenchmarkData::initialize(const std::string &in_directory) {
+    directory = in_directory;
+
+    if (!directory.empty() && directory[directory.length() - 1] != '/' && directory[directory.length() - 1] != '\\')
+        directory += "/";
+
+#ifdef WIN32
+    _mkdir(directory.data());
+#else
+    mkdir(directory.data(), 0755);
+#endif
+
+    RenderBackend::set(&backend);
+
+    // Check the directory can be written to before any benchmark relies on it
+    std::string probeName = directory + "probe";
+    bool writable = std::ofstream(probeName.data()).is_open();
+    remove(probeName.data());
+
+    return writable;
+}
+
+//
+// clear
+// Description:
+//      Deletes the loaded models and gives the drawing back to OpenGL. The generated files stay in the
+//      data directory.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void BenchmarkData::clear(void) {
+    for (std::map<std::string, Model *>::iterator it = models.begin(); it != models.end(); it++)
+        delete it->second;
+
+    models.clear();
+    written.clear();
+
+    RenderBackend::set(NULL);
+}
+
+//
+// getObject
+// Description:
+//      Getter function for a generated height field object, written with its material library and diffuse
+//      map the first time it is asked for. The files are named after the options, so asking twice with the
+//      same options gives the same file.
+// Parameters:
+//      object    <const ObjectOptions&>: Layout of the object, the material library is named after the object.
+//      materials <const MaterialOptions&>: Kind of the materials, their number is taken from the object.
+// Returns:
+//      <std::string>: Full path of the obj file, empty if it could not be written.
+//
+std::string BenchmarkData::getObject(const ObjectOptions &object, const MaterialOptions &materials) {
+    char name[160];
+    snprintf(name, sizeof(name), "object_%d_%d_%d_%d_%d_%d%d_%u_%d_%d%d_%u", object.numVertices, object.faceArity,
+             object.numGroups, object.numMaterials, object.materialSwitches, object.uvs, object.normals, object.seed,
+             (int)(materials.alpha * 100.0f + 0.5f), !materials.diffuseMap.empty(), !materials.bumpMap.empty(),
+             materials.seed);
+
+    std::string filename = directory + name + ".obj";
+
+    if (written.count(filename) > 0)
+        return filename;
+
+    ObjectOptions objectOptions = object;
+    MaterialOptions materialOptions = materials;
+
+    if (object.numMaterials > 0) {
+        objectOptions.materialLibrary = std::string(name) + ".mtl";
+        materialOptions.numMaterials = object.numMaterials;
+
+        if (!SceneGenerator::writeMaterials(directory + objectOptions.materialLibrary, materialOptions))
+            return "";
+
+        if (!materials.diffuseMap.empty() && getTexture(materials.diffuseMap, MAP_SIZE, MAP_SIZE, 24).empty())
+            return "";
+
+        if (!materials.bumpMap.empty() && getTexture(materials.bumpMap, MAP_SIZE, MAP_SIZE, 24).empty())
+            return "";
+    }
+
+    if (!SceneGenerator::writeObject(filename, objectOptions))
+        return "";
+
+    written.insert(filename);
+    return filename;
+}
+
+//
+// getLevel
+// Description:
+//      Getter function for a generated level of rooms, written the first time it is asked for.
+// Parameters:
+//      roomsX <int>: Rooms along x.
+//      roomsZ <int>: Rooms along z.
+// Returns:
+//      <std::string>: Full path of the obj file, empty if it could not be written.
+//
+std::string BenchmarkData::getLevel(int roomsX, int roomsZ) {
+    char name[64];
+    snprintf(name, sizeof(name), "level_%d_%d.obj", roomsX, roomsZ);
+
+    std::string filename = directory + name;
+
+    if (written.count(filename) > 0)
+        return filename;
+
+    if (!SceneGenerator::writeLevel(filename, roomsX, roomsZ))
+        return "";
+
+    written.insert(filename);
+    return filename;
+}
+
+//
+// getTexture
+// Description:
+//      Getter function for a generated tga image, written the first time it is asked for.
+// Parameters:
+//      name   <const std::string&>: File name of the image inside the data directory.
+//      width  <int>: Width in pixels.
+//      height <int>: Height in pixels.
+//      bpp    <int>: Bits per pixel, 24 or 32.
+// Returns:
+//      <std::string>: Full path of the tga file, empty if it could not be written.
+//
+std::string BenchmarkData::getTexture(const std::string &name, int width, int height, int bpp) {
+    std::string filename = directory + name;
+
+    if (written.count(filename) > 0)
+        return filename;
+
+    if (!SceneGenerator::writeTGA(filename, width, height, bpp))
+        return "";
+
+    written.insert(filename);
+    return filename;
+}
+
+//
+// getModel
+// Description:
+//      Getter function for a model loaded from a generated file, loaded the first time it is asked for.
+// Parameters:
+//      filename <const std::string&>: Full path from 'getObject' or 'getLevel'.
+// Returns:
+//      <Model&>: The model, kept until 'clear'.
+//
+Model &BenchmarkData::getModel(const std::string &filename) {
+    std::map<std::string, Model *>::iterator it = models.find(filename);
+
+    if (it != models.end())
+        return *it->second;
+
+    Model *model = new Model(filename);
+    models[filename] = model;
+
+    return *model;
+}
+
+//
+// getBackend
+// Description:
+//      Getter function for the backend all drawing goes to.
+// Parameters:
+//      None (void).
+// Returns:
+//      <RecordingBackend&>: The backend.
+//
+RecordingBackend &BenchmarkData::getBackend(void) {
+    return backend;
+}
+
+//
+// getDirectory
+// Description:
+//      Getter function for the directory of the generated files.
+// Parameters:
+//      None (void).
+// Returns:
+//      directory <std::string>: The directory, ending in a separator.
+//
+std::string BenchmarkData::getDirectory(void) {
+    return directory;
+}
+
+//
+// makeViewProjection
+// Description:
+//      Builds the projection times view matrix of a camera with a 60 degree field of view and a 16:9
+//      screen, in the column major layout the frustum and the occlusion buffer take.
+// Parameters:
+//      eye    <const Vector3&>: Position of the camera.
+//      target <const Vector3&>: Point the camera looks at, not straight above or below the eye.
+//      matrix <float*>: Receives the 16 values.
+// Returns:
+//      None (void).
+//
+void BenchmarkData::makeViewProjection(const Vector3 &eye, const Vector3 &target, float *matrix) {
+    Vector3 position = eye;
+    Vector3 forward = Vector3(target) - position;
+    forward.Normalize();
+
+    Vector3 up(0.0f, 1.0f, 0.0f);
+    Vector3 side = forward * up;
+    side.Normalize();
+    up = side * forward;
+
+    float view[16] = {
+        side.x, up.x, -forward.x, 0.0f,
+        side.y, up.y, -forward.y, 0.0f,
+        side.z, up.z, -forward.z, 0.0f,
+        -side.Dot(position), -up.Dot(position), forward.Dot(position), 1.0f
+    };
+
+    float f = 1.0f / tanf(FIELD_OF_VIEW * 0.5f * 3.14159265f / 180.0f);
+    float projection[16] = {
+        f / ASPECT, 0.0f, 0.0f, 0.0f,
+        0.0f, f, 0.0f, 0.0f,
+        0.0f, 0.0f, (FAR_PLANE + NEAR_PLANE) / (NEAR_PLANE - FAR_PLANE), -1.0f,
+        0.0f, 0.0f, 2.0f * FAR_PLANE * NEAR_PLANE / (NEAR_PLANE - FAR_PLANE), 0.0f
+    };
+
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            float sum = 0.0f;
+
+            for (int k = 0; k < 4; k++)
+                sum += projection[k * 4 + row] * view[column * 4 + k];
+
+            matrix[column * 4 + row] = sum;
+        }
+    }
+}
+
+//
+// addThreadCounts
+// Description:
+//      Adds the thread counts 1, 2, 4, ... up to the number of hardware threads, and that number, as
+//      arguments of a benchmark which scales over threads.
+// Parameters:
+//      benchmark <benchmark::internal::Benchmark*>: The benchmark to add the arguments to.
+// Returns:
+//      None (void).
+//
+void BenchmarkData::addThreadCounts(benchmark::internal::Benchmark *benchmark) {
+    int hardware = (int)std::thread::hardware_concurrency();
+
+    if (hardware < 1)
+        hardware = 1;
+
+    for (int threads = 1; threads < hardware; threads *= 2)
+        benchmark->Arg(threads);
+
+    benchmark->Arg(hardware);
+}
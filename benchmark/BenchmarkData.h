@@ -0,0 +1,58 @@
+// BenchmarkData.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// BenchmarkData
+// Description:
+// Shared inputs of the benchmarks. Generated files are written to the data directory the first time a benchmark
+// asks for them in a run, and loaded models are kept until 'clear', so setting up an input is not part of the
+// timings and benchmarks sharing an input load it once.
+// All drawing goes to a RecordingBackend installed by 'initialize', so the benchmarks run without a window or
+// an OpenGL context and can report the calls the engine would have made.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __BENCHMARKDATA_H
+#define __BENCHMARKDATA_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <benchmark/benchmark.h>
+#include <map>
+#include <set>
+#include <string>
+#include "SceneGenerator.h"
+#include "../include/Model.h"
+#include "../include/RecordingBackend.h"
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class BenchmarkData {
+    public:
+        // Public class functions
+        static bool initialize(const std::string &in_directory);
+        static void clear(void);
+
+        static std::string getObject(const ObjectOptions &object, const MaterialOptions &materials = MaterialOptions());
+        static std::string getLevel(int roomsX, int roomsZ);
+        static std::string getTexture(const std::string &name, int width, int height, int bpp);
+        static Model &getModel(const std::string &filename);
+
+        static RecordingBackend &getBackend(void);
+        static std::string getDirectory(void);
+
+        static void makeViewProjection(const Vector3 &eye, const Vector3 &target, float *matrix);
+        static void addThreadCounts(benchmark::internal::Benchmark *benchmark);
+
+    private:
+        // Private class members
+        static std::string directory;
+        static std::set<std::string> written;       // Files generated in this run
+        static std::map<std::string, Model *> models;
+        static RecordingBackend backend;
+};
+
+#endif
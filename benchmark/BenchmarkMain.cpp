@@ -0,0 +1,60 @@
+// BenchmarkMain.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Entry point of the benchmark suite. Takes the usual Google Benchmark flags, plus --data_dir=<directory> for
+// the generated inputs (benchmark_data in the working directory by default). Results are only written to a file
+// when --benchmark_out is given, the benchmark_json target does that inside the build directory.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "BenchmarkData.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const char *DATA_DIR_FLAG = "--data_dir=";
+static const char *DEFAULT_DATA_DIR = "benchmark_data";
+
+//*********************************************************************************
+// Main
+//*********************************************************************************
+int main(int argc, char **argv) {
+    std::string directory = DEFAULT_DATA_DIR;
+    std::vector<char *> arguments;
+
+    for (int a = 0; a < argc; a++) {
+        if (strncmp(argv[a], DATA_DIR_FLAG, strlen(DATA_DIR_FLAG)) == 0) {
+            directory = argv[a] + strlen(DATA_DIR_FLAG);
+            continue;
+        }
+
+        arguments.push_back(argv[a]);
+    }
+
+    int numArguments = (int)arguments.size();
+    arguments.push_back(NULL);
+
+    benchmark::Initialize(&numArguments, &arguments[0]);
+
+    if (benchmark::ReportUnrecognizedArguments(numArguments, &arguments[0]))
+        return 1;
+
+    if (!BenchmarkData::initialize(directory)) {
+        fprintf(stderr, "Cannot write generated inputs to '%s'\n", directory.data());
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    BenchmarkData::clear();
+
+    return 0;
+}
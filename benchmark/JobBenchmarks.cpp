@@ -0,0 +1,217 @@
+// JobBenchmarks.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Benchmarks of the job system: the cost of a job submitted from outside the workers and from inside a job,
+// dependency chains, the overhead of parallelFor, how stealing evens out uneven ranges, and the scaling of the
+// mesh processing of a model over threads.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <vector>
+#include "BenchmarkData.h"
+#include "../include/JobSystem.h"
+#include "../include/Parallel.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int NUM_JOBS = 16384;           // Empty jobs per iteration of the throughput benchmarks
+static const int NUM_CHAINED_JOBS = 1024;
+static const int NUM_UNEVEN_ITEMS = 4096;
+
+static float spin(int steps);
+
+//*********************************************************************************
+// Benchmarks
+//*********************************************************************************
+
+//
+// BM_JobThroughput
+// Description:
+//      Submits empty jobs and waits for them, from the benchmark thread through the shared queue
+//      (range 0) or from a job on a worker through its own deque (range 1).
+// Parameters:
+//      state <benchmark::State&>: Range (from a worker).
+// Returns:
+//      None (void).
+//
+static void BM_JobThroughput(benchmark::State &state) {
+    bool fromWorker = state.range(0) != 0;
+    std::atomic<int> numRun(0);
+
+    JobSystem::resetStats();
+
+    for (auto _ : state) {
+        std::function<void(void)> spawn = [&numRun]() {
+            JobCounter counter;
+
+            for (int j = 0; j < NUM_JOBS; j++)
+                JobSystem::run([&numRun]() { numRun.fetch_add(1, std::memory_order_relaxed); }, &counter);
+
+            JobSystem::wait(counter);
+        };
+
+        if (fromWorker) {
+            JobCounter root;
+            JobSystem::run(spawn, &root);
+            JobSystem::wait(root);
+        }
+        else {
+            spawn();
+        }
+    }
+
+    JobSystemStats stats = JobSystem::getStats();
+
+    state.SetItemsProcessed(state.iterations() * NUM_JOBS);
+    state.counters["workers"] = stats.numWorkers;
+    state.counters["stolen_fraction"] = stats.executed > 0 ? (double)stats.stolen / stats.executed : 0.0;
+    benchmark::DoNotOptimize(numRun.load());
+}
+BENCHMARK(BM_JobThroughput)->ArgName("worker")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//
+// BM_JobDependencyChain
+// Description:
+//      Runs a chain of jobs where every job waits for the counter of the one before it, so the jobs
+//      are started by their predecessors and never run at the same time.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_JobDependencyChain(benchmark::State &state) {
+    std::vector<JobCounter> counters(NUM_CHAINED_JOBS);
+    std::vector<int> order;
+    order.reserve(NUM_CHAINED_JOBS);
+
+    for (auto _ : state) {
+        order.clear();
+
+        for (int j = 0; j < NUM_CHAINED_JOBS; j++)
+            JobSystem::run([&order, j]() { order.push_back(j); }, &counters[j], j > 0 ? &counters[j - 1] : NULL);
+
+        JobSystem::wait(counters[NUM_CHAINED_JOBS - 1]);
+    }
+
+    bool ordered = (int)order.size() == NUM_CHAINED_JOBS;
+
+    for (int j = 0; ordered && j < NUM_CHAINED_JOBS; j++)
+        ordered = order[j] == j;
+
+    state.SetItemsProcessed(state.iterations() * NUM_CHAINED_JOBS);
+    state.counters["ordered"] = ordered ? 1.0 : 0.0;
+}
+BENCHMARK(BM_JobDependencyChain)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+//
+// BM_ParallelForOverhead
+// Description:
+//      Runs a parallelFor of nearly empty sub ranges, the fixed cost of splitting a loop, by number
+//      of jobs.
+// Parameters:
+//      state <benchmark::State&>: Range (jobs).
+// Returns:
+//      None (void).
+//
+static void BM_ParallelForOverhead(benchmark::State &state) {
+    int numJobs = (int)state.range(0);
+    std::vector<int> values(numJobs);
+
+    for (auto _ : state) {
+        JobSystem::parallelFor(0, numJobs, [&values](int first, int last) {
+            for (int i = first; i < last; i++)
+                values[i]++;
+        }, 1, numJobs);
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * numJobs);
+}
+BENCHMARK(BM_ParallelForOverhead)->ArgName("jobs")->Arg(2)->Arg(16)->Arg(256)->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+//
+// BM_ParallelForUneven
+// Description:
+//      Runs a loop where the cost of an item grows with its index, split into one range per thread
+//      (range 0) or into the default number of ranges, a few per thread, which idle workers steal (range 1).
+// Parameters:
+//      state <benchmark::State&>: Range (stealing).
+// Returns:
+//      None (void).
+//
+static void BM_ParallelForUneven(benchmark::State &state) {
+    int maxJobs = state.range(0) != 0 ? 0 : JobSystem::getNumWorkers() + 1;
+    std::vector<float> results(NUM_UNEVEN_ITEMS);
+
+    for (auto _ : state) {
+        JobSystem::parallelFor(0, NUM_UNEVEN_ITEMS, [&results](int first, int last) {
+            for (int i = first; i < last; i++)
+                results[i] = spin(i / 8);
+        }, 16, maxJobs);
+
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_UNEVEN_ITEMS);
+}
+BENCHMARK(BM_ParallelForUneven)->ArgName("stealing")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//
+// BM_MeshProcessingScaling
+// Description:
+//      Generates the normals of a height field of 250k vertices loaded without them, as 'loadObject'
+//      does after parsing, by number of threads.
+// Parameters:
+//      state <benchmark::State&>: Range (threads).
+// Returns:
+//      None (void).
+//
+static void BM_MeshProcessingScaling(benchmark::State &state) {
+    ObjectOptions options;
+    options.numVertices = 250000;
+    options.normals = false;
+
+    Model &model = BenchmarkData::getModel(BenchmarkData::getObject(options));
+
+    Parallel::setNumThreads((int)state.range(0));
+
+    for (auto _ : state)
+        model.generateNormals();
+
+    Parallel::setNumThreads(0);
+
+    int numFaces = SceneGenerator::getNumFaces(SceneGenerator::getGridSize(options.numVertices), options.faceArity);
+    state.SetItemsProcessed(state.iterations() * numFaces);
+}
+BENCHMARK(BM_MeshProcessingScaling)->ArgName("threads")->Apply(BenchmarkData::addThreadCounts)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// spin
+// Description:
+//      Does a number of dependent floating point steps, as work of a known cost.
+// Parameters:
+//      steps <int>: Number of steps.
+// Returns:
+//      <float>: A value depending on every step.
+//
+static float spin(int steps) {
+    float value = 0.0f;
+
+    for (int s = 0; s < steps; s++)
+        value = value * 0.999f + 0.5f;
+
+    return value;
+}
@@ -0,0 +1,483 @@
+// LoaderBenchmarks.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Benchmarks of loading assets: obj parsing and face records, material libraries, tga images, the arena the
+// faces live in, normal and tangent generation, mesh compilation and the mesh cache codecs.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+#include <vector>
+#include "BenchmarkData.h"
+#include "../include/Arena.h"
+#include "../include/CompiledMesh.h"
+#include "../include/FaceParser.h"
+#include "../include/MeshCodec.h"
+#include "../include/MemoryTracker.h"
+#include "../include/TangentGenerator.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int NUM_PARSED_FACES = 4096; // Face records parsed per iteration
+
+static long long getFileSize(const std::string &filename);
+
+//*********************************************************************************
+// Benchmarks
+//*********************************************************************************
+
+//
+// BM_LoadObject
+// Description:
+//      Loads a height field with textured materials, by vertex count and corners per face.
+// Parameters:
+//      state <benchmark::State&>: Ranges (vertices, face arity).
+// Returns:
+//      None (void).
+//
+static void BM_LoadObject(benchmark::State &state) {
+    ObjectOptions options;
+    options.numVertices = (int)state.range(0);
+    options.faceArity = (int)state.range(1);
+    options.numGroups = 16;
+    options.numMaterials = 8;
+    options.materialSwitches = 256;
+
+    MaterialOptions materials;
+    materials.diffuseMap = "diffuse.tga";
+
+    std::string filename = BenchmarkData::getObject(options, materials);
+
+    if (filename.empty()) {
+        state.SkipWithError("Could not write the object");
+        return;
+    }
+
+    Model model;
+
+    for (auto _ : state) {
+        if (!model.loadObject(filename)) {
+            state.SkipWithError("Could not load the object");
+            break;
+        }
+    }
+
+    int numFaces = SceneGenerator::getNumFaces(SceneGenerator::getGridSize(options.numVertices), options.faceArity);
+
+    state.SetBytesProcessed(state.iterations() * getFileSize(filename));
+    state.counters["faces"] = numFaces;
+    state.counters["faces_per_second"] = benchmark::Counter(numFaces, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["mesh_bytes"] = (double)MemoryTracker::getStats(MEMORY_MESH).liveBytes;
+}
+BENCHMARK(BM_LoadObject)
+    ->Args({10000, 3})->Args({100000, 3})->Args({500000, 3})
+    ->Args({100000, 4})->Args({100000, 6})->Args({100000, 9})
+    ->Unit(benchmark::kMillisecond);
+
+//
+// BM_LoadObjectLayout
+// Description:
+//      Loads a height field of 100k vertices split into more and more groups and material runs.
+// Parameters:
+//      state <benchmark::State&>: Ranges (groups, material switches).
+// Returns:
+//      None (void).
+//
+static void BM_LoadObjectLayout(benchmark::State &state) {
+    ObjectOptions options;
+    options.numVertices = 100000;
+    options.numGroups = (int)state.range(0);
+    options.numMaterials = state.range(1) > 0 ? 32 : 0;
+    options.materialSwitches = (int)state.range(1);
+
+    std::string filename = BenchmarkData::getObject(options);
+
+    if (filename.empty()) {
+        state.SkipWithError("Could not write the object");
+        return;
+    }
+
+    Model model;
+
+    for (auto _ : state)
+        model.loadObject(filename);
+
+    int numBatches = 0;
+
+    for (int i = 0; i < (int)model.getObjects().size(); i++)
+        numBatches += (int)model.getObjects()[i]->batches.size();
+
+    state.SetBytesProcessed(state.iterations() * getFileSize(filename));
+    state.counters["batches"] = numBatches;
+}
+BENCHMARK(BM_LoadObjectLayout)
+    ->Args({1, 0})->Args({64, 64})->Args({1024, 4096})
+    ->Unit(benchmark::kMillisecond);
+
+//
+// BM_LoadMaterials
+// Description:
+//      Loads a material library without maps, by number of materials.
+// Parameters:
+//      state <benchmark::State&>: Range (materials).
+// Returns:
+//      None (void).
+//
+static void BM_LoadMaterials(benchmark::State &state) {
+    MaterialOptions options;
+    options.numMaterials = (int)state.range(0);
+
+    char name[64];
+    snprintf(name, sizeof(name), "materials_%d.mtl", options.numMaterials);
+
+    std::string filename = BenchmarkData::getDirectory() + name;
+
+    if (!SceneGenerator::writeMaterials(filename, options)) {
+        state.SkipWithError("Could not write the material library");
+        return;
+    }
+
+    Model model;
+
+    for (auto _ : state) {
+        model.loadMaterials(filename);
+
+        state.PauseTiming();
+        model.deleteObjects();
+        state.ResumeTiming();
+    }
+
+    state.SetBytesProcessed(state.iterations() * getFileSize(filename));
+    state.SetItemsProcessed(state.iterations() * options.numMaterials);
+}
+BENCHMARK(BM_LoadMaterials)->Arg(16)->Arg(256)->Arg(4096)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_LoadTGA
+// Description:
+//      Loads an uncompressed tga image into a texture, by side and bits per pixel. The upload goes to the
+//      recording backend.
+// Parameters:
+//      state <benchmark::State&>: Ranges (side, bits per pixel).
+// Returns:
+//      None (void).
+//
+static void BM_LoadTGA(benchmark::State &state) {
+    int size = (int)state.range(0);
+    int bpp = (int)state.range(1);
+
+    char name[64];
+    snprintf(name, sizeof(name), "image_%d_%d.tga", size, bpp);
+
+    std::string filename = BenchmarkData::getTexture(name, size, size, bpp);
+
+    if (filename.empty()) {
+        state.SkipWithError("Could not write the image");
+        return;
+    }
+
+    for (auto _ : state) {
+        Texture *texture = new Texture(filename);
+
+        if (texture->imageData == NULL) {
+            delete texture;
+            state.SkipWithError("Could not load the image");
+            break;
+        }
+
+        delete texture;
+    }
+
+    state.SetBytesProcessed(state.iterations() * getFileSize(filename));
+}
+BENCHMARK(BM_LoadTGA)
+    ->Args({256, 24})->Args({1024, 24})->Args({1024, 32})->Args({2048, 32})
+    ->Unit(benchmark::kMicrosecond);
+
+//
+// BM_ParseFaces
+// Description:
+//      Parses face records in the v/vt/vn form, by corners per face.
+// Parameters:
+//      state <benchmark::State&>: Range (face arity).
+// Returns:
+//      None (void).
+//
+static void BM_ParseFaces(benchmark::State &state) {
+    int arity = (int)state.range(0);
+    int numVertices = 1 << 20;
+
+    std::vector<std::string> records(NUM_PARSED_FACES);
+    char corner[64];
+
+    for (int f = 0; f < NUM_PARSED_FACES; f++) {
+        for (int c = 0; c < arity; c++) {
+            int index = (f * 7919 + c * 104729) % numVertices + 1;
+            snprintf(corner, sizeof(corner), " %d/%d/%d", index, index, index);
+            records[f] += corner;
+        }
+    }
+
+    std::vector<FaceCorner> corners;
+
+    for (auto _ : state) {
+        for (int f = 0; f < NUM_PARSED_FACES; f++) {
+            bool valid = FaceParser::parseFace(records[f].c_str(), numVertices, numVertices, numVertices, corners);
+            benchmark::DoNotOptimize(valid);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_PARSED_FACES);
+}
+BENCHMARK(BM_ParseFaces)->Arg(3)->Arg(4)->Arg(8);
+
+//
+// BM_FaceAllocation
+// Description:
+//      Allocates and frees the records of triangles the way the loader does, one by one through the memory
+//      tracker (range 0) or from an arena freed at once (range 1).
+// Parameters:
+//      state <benchmark::State&>: Ranges (arena, faces).
+// Returns:
+//      None (void).
+//
+static void BM_FaceAllocation(benchmark::State &state) {
+    bool useArena = state.range(0) != 0;
+    int numFaces = (int)state.range(1);
+
+    Arena arena;
+    std::vector<Face *> faces(numFaces);
+
+    for (auto _ : state) {
+        for (int f = 0; f < numFaces; f++) {
+            Face *face;
+
+            if (useArena) {
+                face = arena.create<Face>();
+                face->vertices = arena.allocateArray<Vector3 *>(3);
+                face->normals = arena.allocateArray<Vector3 *>(3);
+                face->UVWs = arena.allocateArray<Vector3 *>(3);
+            }
+            else {
+                face = new Face;
+                face->vertices = MemoryTracker::allocateArray<Vector3 *>(3, MEMORY_MESH);
+                face->normals = MemoryTracker::allocateArray<Vector3 *>(3, MEMORY_MESH);
+                face->UVWs = MemoryTracker::allocateArray<Vector3 *>(3, MEMORY_MESH);
+            }
+
+            faces[f] = face;
+        }
+
+        benchmark::ClobberMemory();
+
+        if (useArena) {
+            arena.clear();
+        }
+        else {
+            for (int f = 0; f < numFaces; f++) {
+                MemoryTracker::deallocate(faces[f]->vertices);
+                MemoryTracker::deallocate(faces[f]->normals);
+                MemoryTracker::deallocate(faces[f]->UVWs);
+                delete faces[f];
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * numFaces);
+}
+BENCHMARK(BM_FaceAllocation)->ArgNames({"arena", "faces"})
+    ->Args({0, 100000})->Args({1, 100000})
+    ->Unit(benchmark::kMillisecond);
+
+//
+// BM_GenerateNormals
+// Description:
+//      Generates smooth normals for a height field loaded without them, up to 2M vertices and 4M
+//      triangles, where the per vertex smoothing and the corner lookup dominate.
+// Parameters:
+//      state <benchmark::State&>: Range (vertices).
+// Returns:
+//      None (void).
+//
+static void BM_GenerateNormals(benchmark::State &state) {
+    ObjectOptions options;
+    options.numVertices = (int)state.range(0);
+    options.normals = false;
+
+    std::string filename = BenchmarkData::getObject(options);
+    Model &model = BenchmarkData::getModel(filename);
+
+    for (auto _ : state)
+        model.generateNormals();
+
+    int numFaces = SceneGenerator::getNumFaces(SceneGenerator::getGridSize(options.numVertices), options.faceArity);
+    state.SetItemsProcessed(state.iterations() * numFaces);
+}
+BENCHMARK(BM_GenerateNormals)->Arg(10000)->Arg(100000)->Arg(2000000)->Unit(benchmark::kMillisecond);
+
+//
+// BM_CompileMesh
+// Description:
+//      Compiles a loaded model into a vertex and index buffer, with float (range 0) or quantized (range 1)
+//      vertices.
+// Parameters:
+//      state <benchmark::State&>: Range (vertex format).
+// Returns:
+//      None (void).
+//
+static void BM_CompileMesh(benchmark::State &state) {
+    ObjectOptions options;
+    options.numVertices = 100000;
+
+    Model &model = BenchmarkData::getModel(BenchmarkData::getObject(options));
+    VERTEX_FORMAT format = state.range(0) == 0 ? VERTEX_FORMAT_FLOAT : VERTEX_FORMAT_QUANTIZED;
+    CompiledMesh mesh;
+
+    for (auto _ : state)
+        mesh.compile(model, format);
+
+    state.counters["vertex_bytes"] = (double)mesh.getVertexBytes();
+}
+BENCHMARK(BM_CompileMesh)->ArgName("quantized")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+//
+// BM_GenerateTangents
+// Description:
+//      Generates the tangents of a compiled height field whose materials all have a bump map, so every
+//      compiled range gets tangents.
+// Parameters:
+//      state <benchmark::State&>: Range (vertices).
+// Returns:
+//      None (void).
+//
+static void BM_GenerateTangents(benchmark::State &state) {
+    ObjectOptions options;
+    options.numVertices = (int)state.range(0);
+    options.numGroups = 16;
+    options.numMaterials = 8;
+    options.materialSwitches = 256;
+
+    MaterialOptions materials;
+    materials.diffuseMap = "diffuse.tga";
+    materials.bumpMap = "bump.tga";
+
+    Model &model = BenchmarkData::getModel(BenchmarkData::getObject(options, materials));
+    CompiledMesh mesh;
+
+    if (!mesh.compile(model)) {
+        state.SkipWithError("Could not compile the object");
+        return;
+    }
+
+    for (auto _ : state)
+        TangentGenerator::generate(mesh, model.getMaterials());
+
+    state.SetItemsProcessed(state.iterations() * mesh.getNumVertices());
+    state.counters["tangents"] = (double)mesh.tangents.size();
+}
+BENCHMARK(BM_GenerateTangents)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+//
+// BM_IndexCodec
+// Description:
+//      Encodes (range 0) or decodes (range 1) the index buffer of a compiled height field.
+// Parameters:
+//      state <benchmark::State&>: Range (decode).
+// Returns:
+//      None (void).
+//
+static void BM_IndexCodec(benchmark::State &state) {
+    ObjectOptions options;
+    options.numVertices = 100000;
+
+    Model &model = BenchmarkData::getModel(BenchmarkData::getObject(options));
+    CompiledMesh mesh;
+    mesh.compile(model);
+
+    std::vector<unsigned char> encoded;
+    MeshCodec::encodeIndexBuffer(&mesh.indices[0], mesh.indices.size(), encoded);
+
+    std::vector<unsigned int> decoded(mesh.indices.size());
+
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            MeshCodec::encodeIndexBuffer(&mesh.indices[0], mesh.indices.size(), encoded);
+        }
+        else {
+            bool valid = MeshCodec::decodeIndexBuffer(&encoded[0], encoded.size(), &decoded[0], decoded.size());
+            benchmark::DoNotOptimize(valid);
+        }
+    }
+
+    size_t rawBytes = mesh.indices.size() * sizeof(unsigned int);
+
+    state.SetBytesProcessed(state.iterations() * rawBytes);
+    state.counters["ratio"] = (double)encoded.size() / rawBytes;
+}
+BENCHMARK(BM_IndexCodec)->ArgName("decode")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_VertexCodec
+// Description:
+//      Encodes (range 0) or decodes (range 1) the float vertex buffer of a compiled height field.
+// Parameters:
+//      state <benchmark::State&>: Range (decode).
+// Returns:
+//      None (void).
+//
+static void BM_VertexCodec(benchmark::State &state) {
+    ObjectOptions options;
+    options.numVertices = 100000;
+
+    Model &model = BenchmarkData::getModel(BenchmarkData::getObject(options));
+    CompiledMesh mesh;
+    mesh.compile(model);
+
+    std::vector<unsigned char> encoded;
+    MeshCodec::encodeVertexBuffer(&mesh.vertices[0], mesh.vertices.size(), sizeof(CompiledVertex), encoded);
+
+    std::vector<CompiledVertex> decoded(mesh.vertices.size());
+
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            MeshCodec::encodeVertexBuffer(&mesh.vertices[0], mesh.vertices.size(), sizeof(CompiledVertex), encoded);
+        }
+        else {
+            bool valid = MeshCodec::decodeVertexBuffer(&encoded[0], encoded.size(), &decoded[0], decoded.size(),
+                                                       sizeof(CompiledVertex));
+            benchmark::DoNotOptimize(valid);
+        }
+    }
+
+    size_t rawBytes = mesh.vertices.size() * sizeof(CompiledVertex);
+
+    state.SetBytesProcessed(state.iterations() * rawBytes);
+    state.counters["ratio"] = (double)encoded.size() / rawBytes;
+}
+BENCHMARK(BM_VertexCodec)->ArgName("decode")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// getFileSize
+// Description:
+//      Getter function for the size of a file.
+// Parameters:
+//      filename <const std::string&>: Full path of the file.
+// Returns:
+//      <long long>: The size in bytes, 0 if the file could not be opened.
+//
+static long long getFileSize(const std::string &filename) {
+    std::ifstream file(filename.data(), std::ios_base::binary | std::ios_base::ate);
+
+    if (!file.is_open())
+        return 0;
+
+    return (long long)file.tellg();
+}
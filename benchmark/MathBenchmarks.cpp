@@ -0,0 +1,185 @@
+// MathBenchmarks.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Benchmarks of the Vector3 operations the loaders, the normal generation and the collision code spend their
+// time in, over arrays large enough to leave the first level cache.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "../include/Vector3.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int NUM_VECTORS = 16384;
+
+static void fillVectors(std::vector<Vector3> &vectors, unsigned int seed);
+
+//*********************************************************************************
+// Benchmarks
+//*********************************************************************************
+
+//
+// BM_Vector3MultiplyAdd
+// Description:
+//      Computes a + b * s, the core of integration and interpolation.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_Vector3MultiplyAdd(benchmark::State &state) {
+    std::vector<Vector3> a, b, result(NUM_VECTORS);
+    fillVectors(a, 1);
+    fillVectors(b, 2);
+
+    for (auto _ : state) {
+        for (int i = 0; i < NUM_VECTORS; i++)
+            result[i] = a[i] + b[i] * 0.5f;
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_Vector3MultiplyAdd);
+
+//
+// BM_Vector3Dot
+// Description:
+//      Sums the dot products of pairs of vectors.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_Vector3Dot(benchmark::State &state) {
+    std::vector<Vector3> a, b;
+    fillVectors(a, 3);
+    fillVectors(b, 4);
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+
+        for (int i = 0; i < NUM_VECTORS; i++)
+            sum += a[i].Dot(b[i]);
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_Vector3Dot);
+
+//
+// BM_Vector3Cross
+// Description:
+//      Computes the cross products of pairs of vectors, as face normals are.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_Vector3Cross(benchmark::State &state) {
+    std::vector<Vector3> a, b, result(NUM_VECTORS);
+    fillVectors(a, 5);
+    fillVectors(b, 6);
+
+    for (auto _ : state) {
+        for (int i = 0; i < NUM_VECTORS; i++)
+            result[i] = a[i] * b[i];
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_Vector3Cross);
+
+//
+// BM_Vector3Normalize
+// Description:
+//      Normalizes copies of vectors, which costs a square root and three divisions each.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_Vector3Normalize(benchmark::State &state) {
+    std::vector<Vector3> a, result(NUM_VECTORS);
+    fillVectors(a, 7);
+
+    for (auto _ : state) {
+        for (int i = 0; i < NUM_VECTORS; i++) {
+            result[i] = a[i];
+            result[i].Normalize();
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_Vector3Normalize);
+
+//
+// BM_Vector3Distance
+// Description:
+//      Sums the distances between pairs of points.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_Vector3Distance(benchmark::State &state) {
+    std::vector<Vector3> a, b;
+    fillVectors(a, 8);
+    fillVectors(b, 9);
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+
+        for (int i = 0; i < NUM_VECTORS; i++)
+            sum += a[i].Distance(b[i]);
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_Vector3Distance);
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// fillVectors
+// Description:
+//      Fills an array with vectors from -1 to 1 on every axis, none of them zero.
+// Parameters:
+//      vectors <std::vector<Vector3>&>: Receives NUM_VECTORS vectors.
+//      seed    <unsigned int>: Seed of the values.
+// Returns:
+//      None (void).
+//
+static void fillVectors(std::vector<Vector3> &vectors, unsigned int seed) {
+    vectors.resize(NUM_VECTORS);
+
+    unsigned int state = seed * 2654435761u;
+
+    for (int i = 0; i < NUM_VECTORS; i++) {
+        float values[3];
+
+        for (int axis = 0; axis < 3; axis++) {
+            state = state * 1664525u + 1013904223u;
+            values[axis] = (state >> 8) / 8388608.0f - 1.0f;
+        }
+
+        vectors[i] = Vector3(values[0], values[1], values[2] == 0.0f ? 0.5f : values[2]);
+    }
+}
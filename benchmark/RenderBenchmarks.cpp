@@ -0,0 +1,622 @@
+// RenderBenchmarks.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Benchmarks of the frame: frustum, occlusion and PVS culling, drawing many instances, sorting the render queue
+// and transparent faces, streaming through the ring buffer, the cost of going through the render backend, and
+// the overhead of the profiler. Drawing goes to the recording backend, so the timings are the CPU side only.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "BenchmarkData.h"
+#include "../include/BVH.h"
+#include "../include/Light.h"
+#include "../include/MemoryTracker.h"
+#include "../include/ModelAsset.h"
+#include "../include/OcclusionBuffer.h"
+#include "../include/PVS.h"
+#include "../include/Profiler.h"
+#include "../include/RenderQueue.h"
+#include "../include/RingBuffer.h"
+#include "../include/TransparencySorter.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int NUM_CULLED_BOXES = 100000;
+static const int NUM_INSTANCES = 10000;
+static const int NUM_QUEUE_ITEMS = 100000;
+static const int NUM_STREAM_WRITES = 256;     // Writes per frame to the ring buffer
+static const int STREAM_WRITE_SIZE = 4096;
+static const int NUM_BACKEND_CALLS = 65536;
+static const int NUM_PROFILED_SCOPES = 4096;
+static const float LEVEL_ROOM_SIZE = 8.0f;    // Matches the rooms of SceneGenerator::writeLevel
+
+static Model &getCullingScene(void);
+static float random(unsigned int &state);
+
+//*********************************************************************************
+// Benchmarks
+//*********************************************************************************
+
+//
+// BM_FrustumCullBoxes
+// Description:
+//      Tests 100k boxes against the view frustum eight at a time (range 1) or one by one (range 0).
+// Parameters:
+//      state <benchmark::State&>: Range (batched).
+// Returns:
+//      None (void).
+//
+static void BM_FrustumCullBoxes(benchmark::State &state) {
+    BoundingBoxArray boxes;
+    std::vector<BoundingBox> boxList(NUM_CULLED_BOXES);
+    unsigned int seed = 5;
+
+    for (int i = 0; i < NUM_CULLED_BOXES; i++) {
+        Vector3 center(400.0f * random(seed) - 200.0f, 20.0f * random(seed), 400.0f * random(seed) - 200.0f);
+        boxList[i].min = center - Vector3(1.0f, 1.0f, 1.0f);
+        boxList[i].max = center + Vector3(1.0f, 1.0f, 1.0f);
+        boxes.add(boxList[i]);
+    }
+
+    float matrix[16];
+    BenchmarkData::makeViewProjection(Vector3(0.0f, 10.0f, -200.0f), Vector3(0.0f, 0.0f, 0.0f), matrix);
+
+    Frustum frustum;
+    frustum.setFromMatrix(matrix);
+
+    std::vector<unsigned char> visible(boxes.minX.size());
+    int numVisible = 0;
+
+    for (auto _ : state) {
+        if (state.range(0) != 0) {
+            numVisible = frustum.cullBoxes(boxes, &visible[0]);
+        }
+        else {
+            numVisible = 0;
+
+            for (int i = 0; i < NUM_CULLED_BOXES; i++) {
+                visible[i] = frustum.testBox(boxList[i]);
+                numVisible += visible[i];
+            }
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_CULLED_BOXES);
+    state.counters["visible"] = numVisible;
+}
+BENCHMARK(BM_FrustumCullBoxes)->ArgName("batched")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_CullObjects
+// Description:
+//      Culls the group objects and face batches of a model split into 1024 groups against the view frustum.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_CullObjects(benchmark::State &state) {
+    Model &model = getCullingScene();
+
+    float matrix[16];
+    BenchmarkData::makeViewProjection(Vector3(0.0f, 20.0f, -150.0f), Vector3(0.0f, 0.0f, 0.0f), matrix);
+
+    Frustum frustum;
+    frustum.setFromMatrix(matrix);
+
+    int numVisible = 0;
+
+    for (auto _ : state)
+        numVisible = model.cullObjects(frustum);
+
+    state.counters["visible_batches"] = numVisible;
+}
+BENCHMARK(BM_CullObjects)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_OcclusionRender
+// Description:
+//      Rasterizes the walls of an 8 x 8 room level into the occlusion buffer from inside a room.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_OcclusionRender(benchmark::State &state) {
+    Model &level = BenchmarkData::getModel(BenchmarkData::getLevel(8, 8));
+
+    float matrix[16];
+    BenchmarkData::makeViewProjection(Vector3(3.0f * LEVEL_ROOM_SIZE + 4.0f, 1.7f, 0.5f),
+                                      Vector3(4.0f * LEVEL_ROOM_SIZE, 1.5f, 8.0f * LEVEL_ROOM_SIZE), matrix);
+
+    OcclusionBuffer buffer;
+    buffer.addOccluder(level);
+    buffer.setViewProjection(matrix);
+
+    for (auto _ : state)
+        buffer.render();
+
+    state.counters["triangles"] = buffer.getStats().numRasterizedTriangles;
+}
+BENCHMARK(BM_OcclusionRender)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_OcclusionCull
+// Description:
+//      Culls the rooms of an 8 x 8 room level against the occlusion buffer rendered from inside a room.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_OcclusionCull(benchmark::State &state) {
+    Model &level = BenchmarkData::getModel(BenchmarkData::getLevel(8, 8));
+
+    float matrix[16];
+    BenchmarkData::makeViewProjection(Vector3(3.0f * LEVEL_ROOM_SIZE + 4.0f, 1.7f, 0.5f),
+                                      Vector3(4.0f * LEVEL_ROOM_SIZE, 1.5f, 8.0f * LEVEL_ROOM_SIZE), matrix);
+
+    OcclusionBuffer buffer;
+    buffer.addOccluder(level);
+    buffer.setViewProjection(matrix);
+    buffer.render();
+
+    Frustum frustum;
+    frustum.setFromMatrix(matrix);
+
+    int numVisible = 0;
+
+    for (auto _ : state) {
+        level.cullObjects(frustum);
+        numVisible = level.cullOccludedObjects(buffer);
+    }
+
+    state.counters["visible_batches"] = numVisible;
+    state.counters["batches"] = (double)level.getObjects().size();
+}
+BENCHMARK(BM_OcclusionCull)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_PVSBake
+// Description:
+//      Bakes the potentially visible sets of a level, by rooms per side.
+// Parameters:
+//      state <benchmark::State&>: Range (rooms per side).
+// Returns:
+//      None (void).
+//
+static void BM_PVSBake(benchmark::State &state) {
+    int rooms = (int)state.range(0);
+    Model &level = BenchmarkData::getModel(BenchmarkData::getLevel(rooms, rooms));
+    BVH bvh;
+    bvh.build(level);
+
+    PVS pvs;
+
+    for (auto _ : state)
+        pvs.bake(level, bvh, 2.0f, 16);
+
+    state.counters["cells"] = pvs.getStats().numCells;
+    state.counters["rays"] = (double)pvs.getStats().numRays;
+    state.counters["average_visible"] = pvs.getStats().averageVisible;
+}
+BENCHMARK(BM_PVSBake)->ArgName("rooms")->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond);
+
+//
+// BM_PVSQuery
+// Description:
+//      Culls the rooms of an 8 x 8 room level with its potentially visible sets from points spread over it.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_PVSQuery(benchmark::State &state) {
+    int rooms = 8;
+    Model &level = BenchmarkData::getModel(BenchmarkData::getLevel(rooms, rooms));
+    BVH bvh;
+    bvh.build(level);
+
+    PVS pvs;
+    pvs.bake(level, bvh, 2.0f, 16);
+
+    int numObjects = (int)level.getObjects().size();
+    std::vector<unsigned char> visible(numObjects);
+    std::vector<Vector3> points(1024);
+    unsigned int seed = 6;
+
+    for (int i = 0; i < (int)points.size(); i++)
+        points[i] = Vector3(rooms * LEVEL_ROOM_SIZE * random(seed), 1.7f, rooms * LEVEL_ROOM_SIZE * random(seed));
+
+    long long numVisible = 0;
+
+    for (auto _ : state) {
+        for (int i = 0; i < (int)points.size(); i++) {
+            memset(&visible[0], 1, visible.size());
+            numVisible += pvs.cullObjects(points[i], &visible[0], numObjects);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+    state.counters["visible"] = state.iterations() > 0 ? (double)numVisible / (state.iterations() * points.size()) : 0.0;
+}
+BENCHMARK(BM_PVSQuery)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_DrawInstances
+// Description:
+//      Draws 10k instances of one shared asset with 'ModelAsset::drawInstances'. Instancing needs a
+//      context, so the instances are drawn one by one from the client side arrays of the asset, which
+//      the recording backend counts. Reports the memory of the shared asset next to what 10k separately
+//      loaded models would take.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_DrawInstances(benchmark::State &state) {
+    ObjectOptions options;
+    options.numVertices = 256;
+    options.numMaterials = 2;
+    options.materialSwitches = 2;
+
+    long long liveBefore = MemoryTracker::getTotalStats().liveBytes;
+    ModelAsset *asset = ModelAsset::load(BenchmarkData::getObject(options));
+
+    if (asset == NULL) {
+        state.SkipWithError("Could not load the asset");
+        return;
+    }
+
+    // The compiled mesh lives in plain vectors the tracker does not see
+    CompiledMesh &mesh = asset->getMesh();
+    long long assetBytes = MemoryTracker::getTotalStats().liveBytes - liveBefore +
+                           (long long)(mesh.getVertexBytes() + mesh.indices.size() * sizeof(unsigned int));
+
+    std::vector<ModelInstance> instances(NUM_INSTANCES);
+    unsigned int seed = 7;
+
+    for (int i = 0; i < NUM_INSTANCES; i++) {
+        instances[i].asset = asset;
+        instances[i].transform[12] = 1000.0f * random(seed) - 500.0f;
+        instances[i].transform[14] = 1000.0f * random(seed) - 500.0f;
+    }
+
+    RecordingBackend &backend = BenchmarkData::getBackend();
+    ModelAsset::setInstancingEnabled(false);
+
+    for (auto _ : state) {
+        backend.resetStats();
+        ModelAsset::drawInstances(&instances[0], NUM_INSTANCES);
+    }
+
+    ModelAsset::setInstancingEnabled(true);
+
+    state.SetItemsProcessed(state.iterations() * NUM_INSTANCES);
+    state.counters["draw_calls"] = backend.getStats().drawCalls;
+    state.counters["state_changes"] = backend.getStats().stateChanges;
+    state.counters["asset_bytes"] = (double)assetBytes;
+    state.counters["instance_bytes"] = (double)(assetBytes + (long long)sizeof(ModelInstance) * NUM_INSTANCES);
+    state.counters["separate_model_bytes"] = (double)assetBytes * NUM_INSTANCES;
+
+    ModelAsset::release(asset);
+}
+BENCHMARK(BM_DrawInstances)->Unit(benchmark::kMillisecond);
+
+//
+// BM_RenderQueueSort
+// Description:
+//      Sorts 100k render items by pass, material, texture and depth.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_RenderQueueSort(benchmark::State &state) {
+    ObjectOptions options;
+    options.numVertices = 4096;
+    options.numMaterials = 64;
+    options.materialSwitches = 64;
+
+    MaterialOptions materials;
+    materials.diffuseMap = "diffuse.tga";
+
+    Model &model = BenchmarkData::getModel(BenchmarkData::getObject(options, materials));
+    std::vector<Material *> &modelMaterials = model.getMaterials();
+
+    std::vector<RenderItem> items(NUM_QUEUE_ITEMS);
+    std::vector<Vector3> centers(NUM_QUEUE_ITEMS);
+    unsigned int seed = 8;
+
+    for (int i = 0; i < NUM_QUEUE_ITEMS; i++) {
+        items[i].model = &model;
+        items[i].material = modelMaterials.empty() ? NULL : modelMaterials[i % modelMaterials.size()];
+        items[i].transform = NULL;
+        items[i].object = 0;
+        items[i].batch = 0;
+        centers[i] = Vector3(500.0f * random(seed), 0.0f, 500.0f * random(seed));
+    }
+
+    RenderQueue queue;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        queue.begin(Vector3(0.0f, 0.0f, 0.0f));
+
+        for (int i = 0; i < NUM_QUEUE_ITEMS; i++)
+            queue.add(items[i], centers[i]);
+
+        state.ResumeTiming();
+
+        queue.sort();
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_QUEUE_ITEMS);
+}
+BENCHMARK(BM_RenderQueueSort)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_TransparencySort
+// Description:
+//      Sorts the 100k transparent faces of a height field back to front for a moving view point, with a
+//      full radix sort every frame (range 0) or insertion sorts of the last order (range 1).
+// Parameters:
+//      state <benchmark::State&>: Range (incremental).
+// Returns:
+//      None (void).
+//
+static void BM_TransparencySort(benchmark::State &state) {
+    ObjectOptions options;
+    options.numVertices = 225 * 225; // 100352 triangles
+    options.numMaterials = 1;
+    options.materialSwitches = 1;
+
+    MaterialOptions materials;
+    materials.alpha = 0.5f;
+
+    Model &model = BenchmarkData::getModel(BenchmarkData::getObject(options, materials));
+
+    TransparencySorter sorter;
+    sorter.build(model);
+    sorter.setIncrementalDistance(state.range(0) != 0 ? 1.0f : 0.0f);
+
+    Vector3 viewPoint(0.0f, 20.0f, -150.0f);
+
+    for (auto _ : state) {
+        viewPoint.x += 0.01f;
+        sorter.sort(viewPoint);
+    }
+
+    state.SetItemsProcessed(state.iterations() * sorter.getStats().numFaces);
+    state.counters["faces"] = sorter.getStats().numFaces;
+    state.counters["full_sorts"] = sorter.getStats().fullSorts;
+}
+BENCHMARK(BM_TransparencySort)->ArgName("incremental")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_RingBufferFrame
+// Description:
+//      Streams a frame of 256 writes of 4 KB through the ring buffer in system memory.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_RingBufferFrame(benchmark::State &state) {
+    RingBuffer ring(4 * NUM_STREAM_WRITES * STREAM_WRITE_SIZE, 3, true);
+    std::vector<unsigned char> data(STREAM_WRITE_SIZE, 0x5a);
+
+    for (auto _ : state) {
+        for (int w = 0; w < NUM_STREAM_WRITES; w++) {
+            void *memory = ring.begin(STREAM_WRITE_SIZE);
+
+            if (memory != NULL)
+                memcpy(memory, &data[0], STREAM_WRITE_SIZE);
+
+            ring.commit();
+        }
+
+        ring.endFrame();
+    }
+
+    state.SetBytesProcessed(state.iterations() * NUM_STREAM_WRITES * STREAM_WRITE_SIZE);
+    state.counters["failed_writes"] = ring.getStats().failedWrites;
+}
+BENCHMARK(BM_RingBufferFrame)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_BackendCalls
+// Description:
+//      Sends immediate mode triangles through the render backend, the cost of the virtual call per
+//      attribute on top of what the recording backend does with it.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_BackendCalls(benchmark::State &state) {
+    RenderBackend *backend = RenderBackend::get();
+
+    for (auto _ : state) {
+        backend->begin(GL_TRIANGLES);
+
+        for (int i = 0; i < NUM_BACKEND_CALLS / 3; i++) {
+            backend->normal(0.0, 1.0, 0.0);
+            backend->texCoord(0.5f, 0.5f);
+            backend->vertex(i, 0.0, 1.0);
+        }
+
+        backend->end();
+    }
+
+    state.SetItemsProcessed(state.iterations() * (NUM_BACKEND_CALLS / 3) * 3);
+}
+BENCHMARK(BM_BackendCalls)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_LightUpdate
+// Description:
+//      Updates a spot light through the recording backend. One update is logged first and has to send
+//      the position and then the spot direction of the light, the calls 'updateLight' is made of.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_LightUpdate(benchmark::State &state) {
+    if (Light::num_lights == 0)
+        Light::Initialize();
+
+    Light light(LIGHT_SPOT);
+
+    if (light.getLightNum() == 0) {
+        state.SkipWithError("No free light");
+        return;
+    }
+
+    light.setPosition(1.0f, 4.0f, 2.0f);
+    light.setSpotDirection(0.0f, -1.0f, 0.0f);
+
+    RecordingBackend &backend = BenchmarkData::getBackend();
+    backend.clearLog();
+    backend.setLogging(true);
+    light.updateLight();
+    backend.setLogging(false);
+
+    char expected[2][128];
+    snprintf(expected[0], sizeof(expected[0]), "glLightfv(0x%04X, 0x%04X, {1, 4, 2, 1})", light.getLightNum(), GL_POSITION);
+    snprintf(expected[1], sizeof(expected[1]), "glLightfv(0x%04X, 0x%04X, {0, -1, 0})", light.getLightNum(), GL_SPOT_DIRECTION);
+
+    const std::vector<std::string> &log = backend.getLog();
+    bool recorded = log.size() == 2 && log[0] == expected[0] && log[1] == expected[1];
+    backend.clearLog();
+
+    if (!recorded) {
+        state.SkipWithError("Light::updateLight made unexpected backend calls");
+        return;
+    }
+
+    backend.resetStats();
+
+    for (auto _ : state)
+        light.updateLight();
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["backend_calls"] = state.iterations() > 0 ? (double)backend.getStats().calls / state.iterations() : 0.0;
+    state.counters["redundant_state_changes"] = state.iterations() > 0 ?
+        (double)backend.getStats().redundantStateChanges / state.iterations() : 0.0;
+}
+BENCHMARK(BM_LightUpdate);
+
+//
+// BM_DrawModel
+// Description:
+//      Draws a model split into 1024 groups and 32 materials through the backend, its display lists
+//      compiled in the first frame.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_DrawModel(benchmark::State &state) {
+    Model &model = getCullingScene();
+    RecordingBackend &backend = BenchmarkData::getBackend();
+
+    model.setCulling(false);
+    model.drawModel();
+
+    for (auto _ : state) {
+        backend.resetStats();
+        model.drawModel();
+    }
+
+    model.setCulling(true);
+
+    state.counters["backend_calls"] = (double)backend.getStats().calls;
+    state.counters["list_calls"] = backend.getStats().listCalls;
+    state.counters["state_changes"] = backend.getStats().stateChanges;
+    state.counters["redundant_state_changes"] = backend.getStats().redundantStateChanges;
+}
+BENCHMARK(BM_DrawModel)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_ProfileScope
+// Description:
+//      Opens and closes nested profiler scopes with the profiler disabled (range 0) or enabled (range 1).
+//      The events are collected outside the timing.
+// Parameters:
+//      state <benchmark::State&>: Range (enabled).
+// Returns:
+//      None (void).
+//
+static void BM_ProfileScope(benchmark::State &state) {
+    bool wasEnabled = Profiler::isEnabled();
+    Profiler::setEnabled(state.range(0) != 0);
+
+    for (auto _ : state) {
+        for (int i = 0; i < NUM_PROFILED_SCOPES / 2; i++) {
+            PROFILE_SCOPE("BM_ProfileScope outer");
+            {
+                PROFILE_SCOPE("BM_ProfileScope inner");
+                benchmark::ClobberMemory();
+            }
+        }
+
+        state.PauseTiming();
+        Profiler::collect();
+        state.ResumeTiming();
+    }
+
+    Profiler::setEnabled(wasEnabled);
+
+    state.SetItemsProcessed(state.iterations() * NUM_PROFILED_SCOPES);
+    state.counters["dropped"] = (double)Profiler::getDroppedEvents();
+}
+BENCHMARK(BM_ProfileScope)->ArgName("enabled")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// getCullingScene
+// Description:
+//      Getter function for the height field of 250k vertices in 1024 groups and 32 materials the culling
+//      and drawing benchmarks share.
+// Parameters:
+//      None (void).
+// Returns:
+//      <Model&>: The model.
+//
+static Model &getCullingScene(void) {
+    ObjectOptions options;
+    options.numVertices = 250000;
+    options.numGroups = 1024;
+    options.numMaterials = 32;
+    options.materialSwitches = 4096;
+
+    return BenchmarkData::getModel(BenchmarkData::getObject(options));
+}
+
+//
+// random
+// Description:
+//      Steps a linear congruential generator.
+// Parameters:
+//      state <unsigned int&>: State of the generator.
+// Returns:
+//      <float>: A number from 0 up to but not including 1.
+//
+static float random(unsigned int &state) {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) / 16777216.0f;
+}
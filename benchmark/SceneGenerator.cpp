@@ -0,0 +1,475 @@
+// SceneGenerator.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "SceneGenerator.h"
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const float ROOM_SIZE = 8.0f;
+static const float WALL_HEIGHT = 3.0f;
+static const float WALL_THICKNESS = 0.25f;
+static const float DOOR_WIDTH = 1.6f;
+static const float DOOR_HEIGHT = 2.2f;
+
+// Corners of the six quads of a box, counted from the first of its eight vertices
+static const int BOX_FACES[6][4] = {
+    {0, 3, 2, 1}, // -z
+    {4, 5, 6, 7}, // +z
+    {0, 4, 7, 3}, // -x
+    {1, 2, 6, 5}, // +x
+    {0, 1, 5, 4}, // -y
+    {3, 7, 6, 2}  // +y
+};
+
+static void writeCorner(char *&text, char *textEnd, int index, bool uvs, bool normals);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// writeObject
+// Description:
+//      Writes a height field of about 'numVertices' vertices as an obj file. Faces with more than four
+//      corners are strips along a row of the grid, triangles split every cell in two.
+// Parameters:
+//      filename <const std::string&>: Full path of the obj file.
+//      options  <const ObjectOptions&>: Size and layout of the object.
+// Returns:
+//      <bool>: False if the file could not be written.
+//
+bool SceneGenerator::writeObject(const std::string &filename, const ObjectOptions &options) {
+    std::ofstream file(filename.data());
+
+    if (!file.is_open() || options.faceArity < 3)
+        return false;
+
+    unsigned int state = options.seed;
+    int size = getGridSize(options.numVertices);
+    float half = (size - 1) * 0.5f;
+    char line[4096];
+
+    file << "# Generated height field, " << size * size << " vertices, " << options.faceArity << " corners per face\n";
+
+    if (options.numMaterials > 0 && !options.materialLibrary.empty())
+        file << "mtllib " << options.materialLibrary << "\n";
+
+    for (int r = 0; r < size; r++) {
+        for (int c = 0; c < size; c++) {
+            float x = c - half;
+            float z = r - half;
+            float y = 0.5f * sinf(x * 0.3f) * cosf(z * 0.2f) + 0.05f * random(state);
+
+            snprintf(line, sizeof(line), "v %.4f %.4f %.4f\n", x, y, z);
+            file << line;
+        }
+    }
+
+    if (options.uvs) {
+        for (int r = 0; r < size; r++) {
+            for (int c = 0; c < size; c++) {
+                snprintf(line, sizeof(line), "vt %.5f %.5f\n", c / (float)(size - 1), r / (float)(size - 1));
+                file << line;
+            }
+        }
+    }
+
+    if (options.normals) {
+        for (int r = 0; r < size; r++) {
+            for (int c = 0; c < size; c++) {
+                float x = c - half;
+                float z = r - half;
+
+                // Slope of the height field, the noise tilts the normals a little
+                float nx = -0.15f * cosf(x * 0.3f) * cosf(z * 0.2f) + 0.02f * random(state);
+                float nz = 0.1f * sinf(x * 0.3f) * sinf(z * 0.2f) + 0.02f * random(state);
+                float length = sqrtf(nx * nx + 1.0f + nz * nz);
+
+                snprintf(line, sizeof(line), "vn %.5f %.5f %.5f\n", nx / length, 1.0f / length, nz / length);
+                file << line;
+            }
+        }
+    }
+
+    file << "s 1\n";
+
+    int numFaces = getNumFaces(size, options.faceArity);
+    int top = (options.faceArity + 1) / 2; // Corners on the first row of a strip
+    int bottom = options.faceArity / 2;    // Corners on the second row
+    int face = 0;
+    int nextGroup = 0;
+    int nextSwitch = 0;
+
+    for (int r = 0; r + 1 < size; r++) {
+        int step = options.faceArity == 3 ? 1 : top - 1;
+
+        for (int c = 0; c + step < size; c += step) {
+            int strips = options.faceArity == 3 ? 2 : 1;
+
+            for (int s = 0; s < strips; s++, face++) {
+                while (nextGroup < options.numGroups && face >= (long long)nextGroup * numFaces / options.numGroups) {
+                    file << "g group_" << nextGroup << "\n";
+                    nextGroup++;
+                }
+
+                while (options.numMaterials > 0 && nextSwitch < options.materialSwitches &&
+                       face >= (long long)nextSwitch * numFaces / options.materialSwitches) {
+                    file << "usemtl material_" << nextSwitch % options.numMaterials << "\n";
+                    nextSwitch++;
+                }
+
+                char *text = line;
+                char *textEnd = line + sizeof(line);
+
+                *text++ = 'f';
+
+                // Counterclockwise seen from above: along the second row, then back along the first
+                if (options.faceArity == 3 && s == 1) {
+                    writeCorner(text, textEnd, (r + 1) * size + c, options.uvs, options.normals);
+                    writeCorner(text, textEnd, (r + 1) * size + c + 1, options.uvs, options.normals);
+                    writeCorner(text, textEnd, r * size + c + 1, options.uvs, options.normals);
+                }
+                else {
+                    for (int i = 0; i < bottom; i++)
+                        writeCorner(text, textEnd, (r + 1) * size + c + i, options.uvs, options.normals);
+
+                    for (int i = top - 1; i >= 0; i--)
+                        writeCorner(text, textEnd, r * size + c + i, options.uvs, options.normals);
+                }
+
+                file << line << "\n";
+            }
+        }
+    }
+
+    return !file.fail();
+}
+
+//
+// writeMaterials
+// Description:
+//      Writes a material library with colours picked from the seed.
+// Parameters:
+//      filename <const std::string&>: Full path of the mtl file.
+//      options  <const MaterialOptions&>: Number and kind of the materials.
+// Returns:
+//      <bool>: False if the file could not be written.
+//
+bool SceneGenerator::writeMaterials(const std::string &filename, const MaterialOptions &options) {
+    std::ofstream file(filename.data());
+
+    if (!file.is_open())
+        return false;
+
+    unsigned int state = options.seed;
+    char line[256];
+
+    file << "# Generated material library, " << options.numMaterials << " materials\n";
+
+    for (int m = 0; m < options.numMaterials; m++) {
+        float red = 0.2f + 0.8f * random(state);
+        float green = 0.2f + 0.8f * random(state);
+        float blue = 0.2f + 0.8f * random(state);
+
+        file << "\nnewmtl material_" << m << "\n";
+
+        snprintf(line, sizeof(line), "Ka %.3f %.3f %.3f\nKd %.3f %.3f %.3f\nKs 0.500 0.500 0.500\nNs %.1f\n",
+                 red * 0.2f, green * 0.2f, blue * 0.2f, red, green, blue, 8.0f + 120.0f * random(state));
+        file << line;
+
+        snprintf(line, sizeof(line), "d %.3f\nillum 2\n", options.alpha);
+        file << line;
+
+        if (!options.diffuseMap.empty())
+            file << "map_Kd " << options.diffuseMap << "\n";
+
+        if (!options.bumpMap.empty())
+            file << "map_Bump " << options.bumpMap << "\n";
+    }
+
+    return !file.fail();
+}
+
+//
+// writeTGA
+// Description:
+//      Writes an uncompressed true colour tga image of a checker pattern with noise.
+// Parameters:
+//      filename <const std::string&>: Full path of the tga file.
+//      width    <int>: Width in pixels.
+//      height   <int>: Height in pixels.
+//      bpp      <int>: Bits per pixel, 24 or 32.
+//      seed     <unsigned int>: Seed of the noise.
+// Returns:
+//      <bool>: False if the file could not be written or the format is not supported.
+//
+bool SceneGenerator::writeTGA(const std::string &filename, int width, int height, int bpp, unsigned int seed) {
+    if (width <= 0 || height <= 0 || width > 32767 || height > 32767 || (bpp != 24 && bpp != 32))
+        return false;
+
+    std::ofstream file(filename.data(), std::ios_base::binary);
+
+    if (!file.is_open())
+        return false;
+
+    // 18 byte header, little endian
+    unsigned char header[18] = {0};
+    header[2] = 2; // Uncompressed true colour
+    header[12] = (unsigned char)(width & 0xff);
+    header[13] = (unsigned char)(width >> 8);
+    header[14] = (unsigned char)(height & 0xff);
+    header[15] = (unsigned char)(height >> 8);
+    header[16] = (unsigned char)bpp;
+    header[17] = bpp == 32 ? 8 : 0; // Alpha bits
+
+    file.write((const char *)header, sizeof(header));
+
+    unsigned int state = seed;
+    int bytesPerPixel = bpp / 8;
+    std::vector<unsigned char> row(width * bytesPerPixel);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            bool light = ((x / 8) + (y / 8)) % 2 == 0;
+            int base = light ? 200 : 60;
+            unsigned char *pixel = &row[x * bytesPerPixel];
+
+            for (int channel = 0; channel < 3; channel++)
+                pixel[channel] = (unsigned char)(base + (int)(40.0f * random(state)));
+
+            if (bytesPerPixel == 4)
+                pixel[3] = 255;
+        }
+
+        file.write((const char *)&row[0], row.size());
+    }
+
+    return !file.fail();
+}
+
+//
+// writeLevel
+// Description:
+//      Writes a grid of rooms as an obj file without normals. Every room is a group object holding its
+//      floor, the walls on its -x and -z sides with a doorway in the middle, and a crate at a place picked
+//      from the seed. The rooms on the +x and +z edges get closing walls too.
+// Parameters:
+//      filename <const std::string&>: Full path of the obj file.
+//      roomsX   <int>: Rooms along x.
+//      roomsZ   <int>: Rooms along z.
+//      seed     <unsigned int>: Seed of the crate placement.
+// Returns:
+//      <bool>: False if the file could not be written.
+//
+bool SceneGenerator::writeLevel(const std::string &filename, int roomsX, int roomsZ, unsigned int seed) {
+    std::ofstream file(filename.data());
+
+    if (!file.is_open())
+        return false;
+
+    unsigned int state = seed;
+    int numVertices = 0;
+    char line[256];
+
+    file << "# Generated level, " << roomsX << " x " << roomsZ << " rooms\n";
+
+    for (int rz = 0; rz < roomsZ; rz++) {
+        for (int rx = 0; rx < roomsX; rx++) {
+            float x0 = rx * ROOM_SIZE;
+            float z0 = rz * ROOM_SIZE;
+            float x1 = x0 + ROOM_SIZE;
+            float z1 = z0 + ROOM_SIZE;
+
+            file << "g room_" << rx << "_" << rz << "\n";
+
+            snprintf(line, sizeof(line), "v %.3f 0 %.3f\nv %.3f 0 %.3f\nv %.3f 0 %.3f\nv %.3f 0 %.3f\n",
+                     x0, z0, x0, z1, x1, z1, x1, z0);
+            file << line;
+            file << "f " << numVertices + 1 << " " << numVertices + 2 << " " << numVertices + 3 << " " << numVertices + 4 << "\n";
+            numVertices += 4;
+
+            // Walls along x at z0 (and z1 on the last row), along z at x0 (and x1 on the last column)
+            for (int wall = 0; wall < 4; wall++) {
+                bool alongX = wall % 2 == 0;
+
+                if (wall == 2 && rz + 1 < roomsZ)
+                    continue;
+
+                if (wall == 3 && rx + 1 < roomsX)
+                    continue;
+
+                float position = wall == 0 ? z0 : wall == 1 ? x0 : wall == 2 ? z1 : x1;
+                float start = alongX ? x0 : z0;
+                float doorStart = start + (ROOM_SIZE - DOOR_WIDTH) * 0.5f;
+                float doorEnd = doorStart + DOOR_WIDTH;
+
+                // Outer walls have no doorway
+                bool outer = (wall == 0 && rz == 0) || (wall == 1 && rx == 0) || wall >= 2;
+
+                float parts[3][4] = {
+                    {start, outer ? start + ROOM_SIZE : doorStart, 0.0f, WALL_HEIGHT},
+                    {doorEnd, start + ROOM_SIZE, 0.0f, WALL_HEIGHT},
+                    {doorStart, doorEnd, DOOR_HEIGHT, WALL_HEIGHT}
+                };
+
+                for (int p = 0; p < (outer ? 1 : 3); p++) {
+                    float min[3], max[3];
+                    min[1] = parts[p][2];
+                    max[1] = parts[p][3];
+
+                    if (alongX) {
+                        min[0] = parts[p][0]; max[0] = parts[p][1];
+                        min[2] = position - WALL_THICKNESS * 0.5f; max[2] = position + WALL_THICKNESS * 0.5f;
+                    }
+                    else {
+                        min[0] = position - WALL_THICKNESS * 0.5f; max[0] = position + WALL_THICKNESS * 0.5f;
+                        min[2] = parts[p][0]; max[2] = parts[p][1];
+                    }
+
+                    writeBox(file, min, max, numVertices);
+                }
+            }
+
+            // Crate away from the doorways
+            float crateSize = 0.6f + 0.6f * random(state);
+            float crateX = x0 + 1.0f + (ROOM_SIZE * 0.5f - 2.0f) * random(state);
+            float crateZ = z0 + 1.0f + (ROOM_SIZE * 0.5f - 2.0f) * random(state);
+            float min[3] = {crateX, 0.0f, crateZ};
+            float max[3] = {crateX + crateSize, crateSize, crateZ + crateSize};
+
+            writeBox(file, min, max, numVertices);
+        }
+    }
+
+    return !file.fail();
+}
+
+//
+// getGridSize
+// Description:
+//      Getter function for the number of vertices along a side of the height field of an object.
+// Parameters:
+//      numVertices <int>: Vertices asked for.
+// Returns:
+//      <int>: The side, at least 2.
+//
+int SceneGenerator::getGridSize(int numVertices) {
+    int size = (int)ceil(sqrt((double)numVertices));
+    return size < 2 ? 2 : size;
+}
+
+//
+// getNumFaces
+// Description:
+//      Getter function for the number of faces 'writeObject' writes.
+// Parameters:
+//      gridSize  <int>: Side of the height field from 'getGridSize'.
+//      faceArity <int>: Corners of every face.
+// Returns:
+//      <int>: The faces.
+//
+int SceneGenerator::getNumFaces(int gridSize, int faceArity) {
+    if (faceArity == 3)
+        return 2 * (gridSize - 1) * (gridSize - 1);
+
+    int step = (faceArity + 1) / 2 - 1;
+    return (gridSize - 1) * ((gridSize - 1) / step);
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// random
+// Description:
+//      Steps a xorshift generator, the same on every platform.
+// Parameters:
+//      state <unsigned int&>: State of the generator, not zero.
+// Returns:
+//      <float>: A number from 0 up to but not including 1.
+//
+float SceneGenerator::random(unsigned int &state) {
+    if (state == 0)
+        state = 0x9e3779b9u;
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return (state >> 8) / 16777216.0f;
+}
+
+//
+// writeBox
+// Description:
+//      Writes an axis aligned box as eight vertices and six quads facing outwards.
+// Parameters:
+//      file        <std::ofstream&>: The obj file.
+//      min         <const float*>: Lowest corner, x y z.
+//      max         <const float*>: Highest corner.
+//      numVertices <int&>: Vertices written to the file so far, raised by eight.
+// Returns:
+//      None (void).
+//
+void SceneGenerator::writeBox(std::ofstream &file, const float *min, const float *max, int &numVertices) {
+    char line[128];
+
+    for (int v = 0; v < 8; v++) {
+        snprintf(line, sizeof(line), "v %.3f %.3f %.3f\n",
+                 (v == 1 || v == 2 || v == 5 || v == 6) ? max[0] : min[0],
+                 (v == 2 || v == 3 || v == 6 || v == 7) ? max[1] : min[1],
+                 v >= 4 ? max[2] : min[2]);
+        file << line;
+    }
+
+    for (int f = 0; f < 6; f++) {
+        snprintf(line, sizeof(line), "f %d %d %d %d\n",
+                 numVertices + BOX_FACES[f][0] + 1, numVertices + BOX_FACES[f][1] + 1,
+                 numVertices + BOX_FACES[f][2] + 1, numVertices + BOX_FACES[f][3] + 1);
+        file << line;
+    }
+
+    numVertices += 8;
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// writeCorner
+// Description:
+//      Appends a face corner in the v/vt/vn form matching the records of the object.
+// Parameters:
+//      text    <char*&>: End of the line so far, moved past the corner.
+//      textEnd <char*>: End of the line buffer.
+//      index   <int>: Vertex of the grid, from 0. Vertices, uvs and normals share the index.
+//      uvs     <bool>: The object has 'vt' records.
+//      normals <bool>: The object has 'vn' records.
+// Returns:
+//      None (void).
+//
+static void writeCorner(char *&text, char *textEnd, int index, bool uvs, bool normals) {
+    int written;
+
+    if (uvs && normals)
+        written = snprintf(text, textEnd - text, " %d/%d/%d", index + 1, index + 1, index + 1);
+    else if (normals)
+        written = snprintf(text, textEnd - text, " %d//%d", index + 1, index + 1);
+    else if (uvs)
+        written = snprintf(text, textEnd - text, " %d/%d", index + 1, index + 1);
+    else
+        written = snprintf(text, textEnd - text, " %d", index + 1);
+
+    if (written > 0 && written < textEnd - text)
+        text += written;
+}
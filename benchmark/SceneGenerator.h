@@ -0,0 +1,86 @@
+// SceneGenerator.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// SceneGenerator
+// Description:
+// Writes synthetic obj, mtl and tga files for the benchmarks. The output only depends on the options and the
+// seed, so the same options give the same bytes on every machine and every run, which keeps benchmark results
+// comparable over time.
+// Objects are a gently rolling height field split into faces with any number of corners, grouped and switching
+// materials as often as asked. Levels are a grid of rooms joined by doorways, with a crate in every room, for
+// the culling, collision and navigation benchmarks.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __SCENEGENERATOR_H
+#define __SCENEGENERATOR_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <string>
+#include <fstream>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+struct ObjectOptions {
+    int numVertices;        // Rounded up to a square grid
+    int faceArity;          // Corners of every face, 3 or more
+    int numGroups;          // 'g' records the faces are split into
+    int numMaterials;       // Materials cycled through by 'usemtl', 0 for none
+    int materialSwitches;   // 'usemtl' records spread evenly over the faces
+    bool uvs;               // Write 'vt' records
+    bool normals;           // Write 'vn' records, without them the loader generates normals
+    std::string materialLibrary; // Written as 'mtllib' when there are materials
+    unsigned int seed;
+
+    ObjectOptions() {
+        numVertices = 10000;
+        faceArity = 3;
+        numGroups = 1;
+        numMaterials = 0;
+        materialSwitches = 0;
+        uvs = true;
+        normals = true;
+        seed = 1;
+    }
+};
+
+struct MaterialOptions {
+    int numMaterials;       // Named material_0, material_1, ...
+    float alpha;            // Opacity of every material, below 1 makes them transparent
+    std::string diffuseMap; // Written as 'map_Kd' of every material when not empty
+    std::string bumpMap;    // Written as 'map_Bump' of every material when not empty
+    unsigned int seed;
+
+    MaterialOptions() {
+        numMaterials = 1;
+        alpha = 1.0f;
+        seed = 1;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class SceneGenerator {
+    public:
+        // Public class functions
+        static bool writeObject(const std::string &filename, const ObjectOptions &options);
+        static bool writeMaterials(const std::string &filename, const MaterialOptions &options);
+        static bool writeTGA(const std::string &filename, int width, int height, int bpp, unsigned int seed = 1);
+        static bool writeLevel(const std::string &filename, int roomsX, int roomsZ, unsigned int seed = 1);
+
+        static int getGridSize(int numVertices);
+        static int getNumFaces(int gridSize, int faceArity);
+
+    private:
+        // Private class functions
+        static float random(unsigned int &state);
+        static void writeBox(std::ofstream &file, const float *min, const float *max, int &numVertices);
+};
+
+#endif
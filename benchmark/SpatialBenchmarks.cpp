@@ -0,0 +1,477 @@
+// SpatialBenchmarks.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Benchmarks of the spatial structures: building, refitting and tracing rays through the BVH on one and on
+// several threads, the spatial hash broad-phase, capsule sweeps, the octree scene index against a linear scan,
+// and baking and searching the navmesh.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <benchmark/benchmark.h>
+#include <math.h>
+#include <vector>
+#include "BenchmarkData.h"
+#include "../include/BVH.h"
+#include "../include/CharacterController.h"
+#include "../include/NavMesh.h"
+#include "../include/Octree.h"
+#include "../include/Parallel.h"
+#include "../include/SpatialHash.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int RAY_GRID = 128;             // Rays per side of the camera image
+static const int NUM_ENTITIES = 10000;       // Entities moved every spatial hash tick
+static const int NUM_CAPSULE_MOVES = 1024;
+static const int NUM_PATHS = 256;
+static const float LEVEL_ROOM_SIZE = 8.0f;   // Matches the rooms of SceneGenerator::writeLevel
+
+static Model &getTerrain(void);
+static void makeCameraRays(const BoundingBox &bounds, std::vector<Ray> &rays);
+static float random(unsigned int &state);
+
+//*********************************************************************************
+// Benchmarks
+//*********************************************************************************
+
+//
+// BM_BVHBuild
+// Description:
+//      Builds the BVH of a height field of 200k triangles, by number of threads.
+// Parameters:
+//      state <benchmark::State&>: Range (threads).
+// Returns:
+//      None (void).
+//
+static void BM_BVHBuild(benchmark::State &state) {
+    Model &model = getTerrain();
+    BVH bvh;
+
+    Parallel::setNumThreads((int)state.range(0));
+
+    for (auto _ : state)
+        bvh.build(model);
+
+    Parallel::setNumThreads(0);
+
+    state.SetItemsProcessed(state.iterations() * bvh.triangles.size());
+    state.counters["nodes"] = (double)bvh.nodes.size();
+    state.counters["depth"] = bvh.getDepth();
+}
+BENCHMARK(BM_BVHBuild)->ArgName("threads")->Apply(BenchmarkData::addThreadCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//
+// BM_BVHRefit
+// Description:
+//      Refits the BVH of a height field of 200k triangles after its vertices moved.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_BVHRefit(benchmark::State &state) {
+    Model &model = getTerrain();
+    BVH bvh;
+    bvh.build(model);
+
+    for (auto _ : state)
+        bvh.refit();
+
+    state.SetItemsProcessed(state.iterations() * bvh.triangles.size());
+}
+BENCHMARK(BM_BVHRefit)->Unit(benchmark::kMillisecond);
+
+//
+// BM_BVHRays
+// Description:
+//      Traces the rays of a camera looking down on a height field one by one (range 0) or as packets
+//      (range 1), on one thread.
+// Parameters:
+//      state <benchmark::State&>: Range (packets).
+// Returns:
+//      None (void).
+//
+static void BM_BVHRays(benchmark::State &state) {
+    Model &model = getTerrain();
+    BVH bvh;
+    bvh.build(model);
+
+    std::vector<Ray> rays;
+    makeCameraRays(bvh.getBounds(), rays);
+
+    std::vector<RayHit> hits(rays.size());
+    int count = (int)rays.size();
+
+    Parallel::setNumThreads(1);
+
+    for (auto _ : state) {
+        if (state.range(0) != 0) {
+            bvh.intersectRays(&rays[0], &hits[0], count);
+        }
+        else {
+            for (int r = 0; r < count; r++)
+                bvh.intersect(rays[r], hits[r]);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    Parallel::setNumThreads(0);
+
+    int numHits = 0;
+
+    for (int r = 0; r < count; r++)
+        numHits += hits[r].triangle >= 0;
+
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["hit_fraction"] = (double)numHits / count;
+}
+BENCHMARK(BM_BVHRays)->ArgName("packets")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+//
+// BM_BVHRaysThreaded
+// Description:
+//      Traces the rays of a camera as packets split over threads, by number of threads.
+// Parameters:
+//      state <benchmark::State&>: Range (threads).
+// Returns:
+//      None (void).
+//
+static void BM_BVHRaysThreaded(benchmark::State &state) {
+    Model &model = getTerrain();
+    BVH bvh;
+    bvh.build(model);
+
+    std::vector<Ray> rays;
+    makeCameraRays(bvh.getBounds(), rays);
+
+    std::vector<RayHit> hits(rays.size());
+
+    Parallel::setNumThreads((int)state.range(0));
+
+    for (auto _ : state) {
+        bvh.intersectRays(&rays[0], &hits[0], (int)rays.size());
+        benchmark::ClobberMemory();
+    }
+
+    Parallel::setNumThreads(0);
+
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+BENCHMARK(BM_BVHRaysThreaded)->ArgName("threads")->Apply(BenchmarkData::addThreadCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//
+// BM_SpatialHashTick
+// Description:
+//      Moves 10k entities bouncing around a square, updates the spatial hash and finds the overlapping
+//      pairs, once per iteration like a game tick.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_SpatialHashTick(benchmark::State &state) {
+    float side = 400.0f;
+    unsigned int seed = 1;
+
+    std::vector<int> ids(NUM_ENTITIES);
+    std::vector<Vector3> positions(NUM_ENTITIES);
+    std::vector<Vector3> velocities(NUM_ENTITIES);
+    std::vector<BoundingBox> boxes(NUM_ENTITIES);
+
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        ids[i] = i;
+        positions[i] = Vector3(side * random(seed), 0.0f, side * random(seed));
+        velocities[i] = Vector3(random(seed) - 0.5f, 0.0f, random(seed) - 0.5f);
+        boxes[i].min = positions[i] - Vector3(0.5f, 0.0f, 0.5f);
+        boxes[i].max = positions[i] + Vector3(0.5f, 2.0f, 0.5f);
+    }
+
+    SpatialHash hash(4.0f);
+    hash.insert(&ids[0], &boxes[0], NUM_ENTITIES);
+
+    std::vector<SpatialPair> pairs;
+    long long numPairs = 0;
+
+    for (auto _ : state) {
+        for (int i = 0; i < NUM_ENTITIES; i++) {
+            positions[i] += velocities[i];
+
+            if (positions[i].x < 0.0f || positions[i].x > side)
+                velocities[i].x = -velocities[i].x;
+
+            if (positions[i].z < 0.0f || positions[i].z > side)
+                velocities[i].z = -velocities[i].z;
+
+            boxes[i].min = positions[i] - Vector3(0.5f, 0.0f, 0.5f);
+            boxes[i].max = positions[i] + Vector3(0.5f, 2.0f, 0.5f);
+        }
+
+        hash.update(&ids[0], &boxes[0], NUM_ENTITIES);
+
+        pairs.clear();
+        hash.findPairs(pairs);
+        numPairs += pairs.size();
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_ENTITIES);
+    state.counters["pairs"] = state.iterations() > 0 ? (double)numPairs / state.iterations() : 0.0;
+    state.counters["cells"] = hash.getNumCells();
+}
+BENCHMARK(BM_SpatialHashTick)->Unit(benchmark::kMicrosecond);
+
+//
+// BM_CapsuleMove
+// Description:
+//      Moves capsules through a level of rooms, sliding along walls and crates.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_CapsuleMove(benchmark::State &state) {
+    int rooms = 8;
+    Model &level = BenchmarkData::getModel(BenchmarkData::getLevel(rooms, rooms));
+    BVH bvh;
+    bvh.build(level);
+
+    CharacterController controller(bvh);
+
+    std::vector<Capsule> capsules(NUM_CAPSULE_MOVES);
+    std::vector<Vector3> displacements(NUM_CAPSULE_MOVES);
+    unsigned int seed = 2;
+
+    for (int i = 0; i < NUM_CAPSULE_MOVES; i++) {
+        float x = (rooms * LEVEL_ROOM_SIZE) * random(seed);
+        float z = (rooms * LEVEL_ROOM_SIZE) * random(seed);
+        float angle = 6.2831853f * random(seed);
+
+        capsules[i] = Capsule(Vector3(x, 0.45f, z), Vector3(x, 1.35f, z), 0.4f);
+        displacements[i] = Vector3(cosf(angle) * 2.0f, -0.2f, sinf(angle) * 2.0f);
+    }
+
+    int numGrounded = 0;
+
+    for (auto _ : state) {
+        numGrounded = 0;
+
+        for (int i = 0; i < NUM_CAPSULE_MOVES; i++) {
+            bool grounded;
+            Vector3 moved = controller.move(capsules[i], displacements[i], &grounded);
+            benchmark::DoNotOptimize(moved);
+            numGrounded += grounded;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_CAPSULE_MOVES);
+    state.counters["grounded_fraction"] = (double)numGrounded / NUM_CAPSULE_MOVES;
+}
+BENCHMARK(BM_CapsuleMove)->Unit(benchmark::kMillisecond);
+
+//
+// BM_SceneQuery
+// Description:
+//      Finds the instances in the view frustum with the octree (range 1) or by testing the bounding sphere
+//      of every instance (range 0), by number of instances spread over a square.
+// Parameters:
+//      state <benchmark::State&>: Ranges (octree, instances).
+// Returns:
+//      None (void).
+//
+static void BM_SceneQuery(benchmark::State &state) {
+    bool useOctree = state.range(0) != 0;
+    int numInstances = (int)state.range(1);
+
+    ObjectOptions options;
+    options.numVertices = 64;
+
+    Model &model = BenchmarkData::getModel(BenchmarkData::getObject(options));
+
+    float side = sqrtf((float)numInstances) * 10.0f;
+    BoundingBox bounds;
+    bounds.min = Vector3(0.0f, -10.0f, 0.0f);
+    bounds.max = Vector3(side, 10.0f, side);
+
+    Octree octree(bounds);
+    std::vector<Vector3> centers(numInstances);
+    std::vector<float> radii(numInstances);
+    unsigned int seed = 3;
+
+    for (int i = 0; i < numInstances; i++) {
+        float transform[16] = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+                               side * random(seed), 0.0f, side * random(seed), 1.0f};
+
+        int id = octree.insert(&model, transform);
+        centers[i] = octree.getCenter(id);
+        radii[i] = octree.getRadius(id);
+    }
+
+    float matrix[16];
+    BenchmarkData::makeViewProjection(Vector3(side * 0.5f, 20.0f, -10.0f), Vector3(side * 0.5f, 0.0f, side * 0.5f), matrix);
+
+    Frustum frustum;
+    frustum.setFromMatrix(matrix);
+
+    std::vector<int> results;
+
+    for (auto _ : state) {
+        results.clear();
+
+        if (useOctree) {
+            octree.queryFrustum(frustum, results);
+        }
+        else {
+            for (int i = 0; i < numInstances; i++) {
+                if (frustum.testSphere(centers[i], radii[i]))
+                    results.push_back(i);
+            }
+        }
+
+        benchmark::DoNotOptimize(results.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * numInstances);
+    state.counters["visible"] = (double)results.size();
+}
+BENCHMARK(BM_SceneQuery)->ArgNames({"octree", "instances"})
+    ->ArgsProduct({{0, 1}, {1000, 10000, 100000}})
+    ->Unit(benchmark::kMicrosecond);
+
+//
+// BM_NavMeshBuild
+// Description:
+//      Bakes the navmesh of a level, by rooms per side.
+// Parameters:
+//      state <benchmark::State&>: Range (rooms per side).
+// Returns:
+//      None (void).
+//
+static void BM_NavMeshBuild(benchmark::State &state) {
+    int rooms = (int)state.range(0);
+    Model &level = BenchmarkData::getModel(BenchmarkData::getLevel(rooms, rooms));
+    NavMesh navMesh;
+
+    for (auto _ : state)
+        navMesh.build(level);
+
+    state.counters["polygons"] = navMesh.getStats().numPolygons;
+    state.counters["tiles"] = navMesh.getStats().numTiles;
+}
+BENCHMARK(BM_NavMeshBuild)->ArgName("rooms")->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond);
+
+//
+// BM_NavMeshPaths
+// Description:
+//      Finds paths between random rooms of an 8 x 8 room level.
+// Parameters:
+//      state <benchmark::State&>: No ranges.
+// Returns:
+//      None (void).
+//
+static void BM_NavMeshPaths(benchmark::State &state) {
+    int rooms = 8;
+    Model &level = BenchmarkData::getModel(BenchmarkData::getLevel(rooms, rooms));
+    NavMesh navMesh;
+    navMesh.build(level);
+
+    // Points in the corner of a room away from its crate and doorways
+    std::vector<Vector3> starts(NUM_PATHS), ends(NUM_PATHS);
+    unsigned int seed = 4;
+
+    for (int i = 0; i < NUM_PATHS; i++) {
+        int from = (int)(random(seed) * rooms * rooms);
+        int to = (int)(random(seed) * rooms * rooms);
+
+        starts[i] = Vector3((from % rooms) * LEVEL_ROOM_SIZE + 6.0f, 0.0f, (from / rooms) * LEVEL_ROOM_SIZE + 6.0f);
+        ends[i] = Vector3((to % rooms) * LEVEL_ROOM_SIZE + 6.0f, 0.0f, (to / rooms) * LEVEL_ROOM_SIZE + 6.0f);
+    }
+
+    std::vector<Vector3> path;
+    int numFound = 0;
+
+    for (auto _ : state) {
+        numFound = 0;
+
+        for (int i = 0; i < NUM_PATHS; i++)
+            numFound += navMesh.findPath(starts[i], ends[i], path);
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_PATHS);
+    state.counters["found_fraction"] = (double)numFound / NUM_PATHS;
+}
+BENCHMARK(BM_NavMeshPaths)->Unit(benchmark::kMillisecond);
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// getTerrain
+// Description:
+//      Getter function for the height field of 100k vertices and 200k triangles the BVH benchmarks share.
+// Parameters:
+//      None (void).
+// Returns:
+//      <Model&>: The model.
+//
+static Model &getTerrain(void) {
+    ObjectOptions options;
+    options.numVertices = 100000;
+
+    return BenchmarkData::getModel(BenchmarkData::getObject(options));
+}
+
+//
+// makeCameraRays
+// Description:
+//      Makes the rays of a camera above one edge of a box looking at its center, in rows so that
+//      neighbouring rays are stored next to each other.
+// Parameters:
+//      bounds <const BoundingBox&>: The box.
+//      rays   <std::vector<Ray>&>: Receives RAY_GRID * RAY_GRID rays.
+// Returns:
+//      None (void).
+//
+static void makeCameraRays(const BoundingBox &bounds, std::vector<Ray> &rays) {
+    Vector3 size = Vector3(bounds.max) - bounds.min;
+    Vector3 center = Vector3(bounds.min) + size * 0.5f;
+    Vector3 eye(center.x, bounds.max.y + size.x * 0.25f, bounds.min.z - size.z * 0.1f);
+
+    Vector3 forward = center - eye;
+    forward.Normalize();
+
+    Vector3 side = forward * Vector3(0.0f, 1.0f, 0.0f);
+    side.Normalize();
+    Vector3 up = side * forward;
+
+    rays.resize(RAY_GRID * RAY_GRID);
+
+    for (int y = 0; y < RAY_GRID; y++) {
+        for (int x = 0; x < RAY_GRID; x++) {
+            float u = (x + 0.5f) / RAY_GRID * 2.0f - 1.0f;
+            float v = (y + 0.5f) / RAY_GRID * 2.0f - 1.0f;
+
+            Vector3 direction = forward + side * (u * 0.6f) + up * (v * 0.4f);
+            direction.Normalize();
+
+            rays[y * RAY_GRID + x] = Ray(eye, direction);
+        }
+    }
+}
+
+//
+// random
+// Description:
+//      Steps a linear congruential generator.
+// Parameters:
+//      state <unsigned int&>: State of the generator.
+// Returns:
+//      <float>: A number from 0 up to but not including 1.
+//
+static float random(unsigned int &state) {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) / 16777216.0f;
+}
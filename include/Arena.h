@@ -0,0 +1,91 @@
+// Arena.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Arena
+// Description:
+// Linear allocator for data which lives and dies together, such as the faces of a loaded model. Memory is taken
+// from large blocks by moving a pointer, and nothing is freed on its own: 'clear' gives every block back at once.
+// Millions of small allocations become a few block allocations, the data of consecutive allocations lies next
+// to each other in memory, and freeing costs one call per block. Objects placed in the arena are never
+// destroyed, so only types without destructors may be created in it.
+// The blocks are counted by the MemoryTracker under the tag the arena was made with.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __ARENA_H
+#define __ARENA_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <stddef.h>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "MemoryTracker.h"
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class Arena {
+    public:
+        // Constructors and destructors
+        Arena(size_t in_blockSize = 65536, MEMORY_TAG in_tag = MEMORY_MESH);
+        ~Arena();
+
+        // Public class functions
+        void *allocate(size_t bytes, size_t alignment = 16);
+        void clear(void);
+
+        //
+        // allocateArray
+        // Description:
+        //      Allocates an uninitialized array of a type without constructors, such as pointers.
+        // Parameters:
+        //      count <size_t>: Number of elements.
+        // Returns:
+        //      <T*>: The array.
+        //
+        template<class T>
+        T *allocateArray(size_t count) {
+            return (T *)allocate(count * sizeof(T), std::alignment_of<T>::value);
+        }
+
+        //
+        // create
+        // Description:
+        //      Allocates and default constructs an object.
+        // Parameters:
+        //      None (void).
+        // Returns:
+        //      <T*>: The object, it is not destroyed by 'clear'.
+        //
+        template<class T>
+        T *create(void) {
+            static_assert(std::is_trivially_destructible<T>::value, "Arena objects are never destroyed");
+            return new (allocate(sizeof(T), std::alignment_of<T>::value)) T();
+        }
+
+        size_t getUsedBytes(void) const;
+        size_t getReservedBytes(void) const;
+        int getNumBlocks(void) const;
+
+    private:
+        // Private class members
+        std::vector<unsigned char *> blocks;
+        size_t blockSize;
+        MEMORY_TAG tag;
+
+        unsigned char *current;     // Next free byte of the last block
+        unsigned char *end;         // End of the last block
+        size_t usedBytes;           // Bytes handed out, alignment padding included
+        size_t reservedBytes;       // Bytes of all blocks
+
+        // An arena owns its blocks and cannot be copied
+        Arena(const Arena &);
+        Arena &operator=(const Arena &);
+};
+
+#endif
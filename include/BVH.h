@@ -0,0 +1,132 @@
+// BVH.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// BVH
+// Description:
+// Bounding volume hierarchy over the triangles of a Model, used for ray queries such as hitscan, line of sight
+// and picking. Polygons are fan triangulated and every triangle is binned by the center of the face it comes
+// from. Splits are chosen with the surface area heuristic evaluated over a fixed number of bins per axis.
+// The tree is flattened into an array of 32 byte nodes where the two children of a node are stored next to
+// each other, and the triangles are reordered so that every leaf references a contiguous range.
+// The tree is built in parallel: large nodes are binned by several threads and the two halves of a split are
+// built as separate tasks. Props which move by changing the vertices of their Model can refit the existing
+// tree in linear time instead of building it again.
+// Queries only read the tree, so any number of threads can trace rays against the same BVH.
+// Arrays of rays can be traced in packets of 4 (SSE) or 8 (AVX) rays which walk the tree together, one ray per
+// SIMD lane. This pays off for coherent rays such as the line of sight checks of many bots towards one player.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __BVH_H
+#define __BVH_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+#include <float.h>
+#include "Model.h"
+#include "Vector3.h"
+#include "BoundingBox.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+
+// Flattened tree node, 32 bytes. Leaves have numTriangles > 0, inner nodes have their children at
+// firstChild and firstChild + 1
+struct BVHNode {
+    float min[3];
+    int firstChild; // First triangle for leaves
+    float max[3];
+    int numTriangles;
+};
+
+// Triangle prepared for the Möller-Trumbore intersection test
+struct BVHTriangle {
+    Vector3 vertex0;
+    Vector3 edge1;
+    Vector3 edge2;
+    int faceIndex;
+    Face *face;
+};
+
+// Temporary data used while building, defined in BVH.cpp
+struct BVHBuildData;
+
+struct Ray {
+    Vector3 origin;
+    Vector3 direction;
+    float tMax; // Rays only hit triangles closer than tMax
+
+    Ray() {
+        tMax = FLT_MAX;
+    }
+
+    Ray(const Vector3 &in_origin, const Vector3 &in_direction, float in_tMax = FLT_MAX) {
+        origin = in_origin;
+        direction = in_direction;
+        tMax = in_tMax;
+    }
+};
+
+struct RayHit {
+    float t;        // Distance along the ray direction
+    float u, v;     // Barycentric coordinates in the hit triangle
+    int triangle;   // Index into BVH::triangles, -1 if nothing was hit
+    int faceIndex;  // Index of the face counted over all group objects of the model, -1 if nothing was hit
+    Face *face;
+
+    RayHit() {
+        t = FLT_MAX;
+        u = 0.0f;
+        v = 0.0f;
+        triangle = -1;
+        faceIndex = -1;
+        face = NULL;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class BVH {
+    public:
+        // Constructors and destructors
+        BVH();
+
+        // Public class functions
+        void build(Model &model);
+        void refit(void);
+        void clear(void);
+
+        bool intersect(const Ray &ray, RayHit &hit) const;
+        bool occluded(const Ray &ray) const;
+
+        void queryBox(const BoundingBox &box, std::vector<int> &results) const;
+
+        void intersectRays(const Ray *rays, RayHit *hits, int count) const;
+        void occludedRays(const Ray *rays, unsigned char *results, int count) const;
+
+        int getDepth(void) const;
+        BoundingBox getBounds(void) const;
+
+        // Public class members
+        std::vector<BVHNode> nodes;
+        std::vector<BVHTriangle> triangles;
+
+    private:
+        // Private class functions
+        int subdivide(int nodeIndex, int level, BVHBuildData &data);
+
+        void intersectPacket(const Ray *rays, RayHit *hits, int count) const;
+        void occludedPacket(const Ray *rays, unsigned char *results, int count) const;
+
+        // Private class members
+        std::vector<int> triangleCorners; // Fan corner of every triangle in its face, used by refit
+        int depth;
+};
+
+#endif
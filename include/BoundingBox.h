@@ -0,0 +1,153 @@
+// BoundingBox.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __BOUNDINGBOX_H
+#define __BOUNDINGBOX_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <float.h>
+#include "Vector3.h"
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class BoundingBox {
+    public:
+        //Constructors and destructors
+
+        //
+        // BoundingBox
+        // Description:
+        //      Constructor.
+        //      Creates an empty box, expanding it with any point makes it valid.
+        // Parameters:
+        //      None (void).
+        // Returns:
+        //      None (void).
+        //
+        BoundingBox() {
+            min = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+            max = Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        }
+
+        //
+        // BoundingBox
+        // Description:
+        //      Constructor.
+        //      Creates a box from its minimum and maximum corner.
+        // Parameters:
+        //      in_min <const Vector3&>: Minimum corner.
+        //      in_max <const Vector3&>: Maximum corner.
+        // Returns:
+        //      None (void).
+        //
+        BoundingBox(const Vector3 &in_min, const Vector3 &in_max) {
+            min = in_min;
+            max = in_max;
+        }
+
+        // Public class functions
+
+        //
+        // expand
+        // Description:
+        //      Grows the box to contain a point.
+        // Parameters:
+        //      point <const Vector3&>: The point.
+        // Returns:
+        //      None (void).
+        //
+        void expand(const Vector3 &point) {
+            min.x = point.x < min.x ? point.x : min.x;
+            min.y = point.y < min.y ? point.y : min.y;
+            min.z = point.z < min.z ? point.z : min.z;
+            max.x = point.x > max.x ? point.x : max.x;
+            max.y = point.y > max.y ? point.y : max.y;
+            max.z = point.z > max.z ? point.z : max.z;
+        }
+
+        //
+        // expand
+        // Description:
+        //      Grows the box to contain another box.
+        // Parameters:
+        //      box <const BoundingBox&>: The box.
+        // Returns:
+        //      None (void).
+        //
+        void expand(const BoundingBox &box) {
+            expand(box.min);
+            expand(box.max);
+        }
+
+        //
+        // isEmpty
+        // Description:
+        //      Checks if the box has not been expanded by any point.
+        // Parameters:
+        //      None (void).
+        // Returns:
+        //      <bool>: If the box is empty or not.
+        //
+        bool isEmpty(void) const {
+            return min.x > max.x || min.y > max.y || min.z > max.z;
+        }
+
+        //
+        // getCenter
+        // Description:
+        //      Calculates the center of the box.
+        // Parameters:
+        //      None (void).
+        // Returns:
+        //      <Vector3>: The center.
+        //
+        Vector3 getCenter(void) const {
+            return Vector3((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f);
+        }
+
+        //
+        // getExtent
+        // Description:
+        //      Calculates the size of the box along every axis.
+        // Parameters:
+        //      None (void).
+        // Returns:
+        //      <Vector3>: The extent.
+        //
+        Vector3 getExtent(void) const {
+            return Vector3(max.x - min.x, max.y - min.y, max.z - min.z);
+        }
+
+        //
+        // getSurfaceArea
+        // Description:
+        //      Calculates the surface area of the box, zero for an empty box.
+        // Parameters:
+        //      None (void).
+        // Returns:
+        //      <float>: The surface area.
+        //
+        float getSurfaceArea(void) const {
+            if (isEmpty())
+                return 0.0f;
+
+            float x = max.x - min.x;
+            float y = max.y - min.y;
+            float z = max.z - min.z;
+
+            return 2.0f * (x * y + y * z + z * x);
+        }
+
+        // Public class members
+        Vector3 min;
+        Vector3 max;
+};
+
+#endif
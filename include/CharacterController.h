@@ -0,0 +1,95 @@
+// CharacterController.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// CharacterController
+// Description:
+// Player movement against level geometry. The player is a capsule, a line segment with a radius, which is swept
+// along a displacement against the triangles of a BVH built from the level Model. A sweep returns the time of
+// impact, the contact normal and the part of the remaining displacement which slides along the contact.
+// The time of impact with each candidate triangle is found by stepping along the displacement with Newton
+// steps on the distance between the capsule segment and the triangle. The distance between two convex shapes
+// is convex in the amount one of them is translated, so the steps approach the contact from the front and never
+// step past it.
+// 'move' repeatedly sweeps and slides, climbs steps up to the step height and reports if the capsule ended up
+// on walkable ground. The y axis is up.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __CHARACTERCONTROLLER_H
+#define __CHARACTERCONTROLLER_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+#include "BVH.h"
+#include "Vector3.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+struct Capsule {
+    Vector3 point0; // Centers of the two end spheres
+    Vector3 point1;
+    float radius;
+
+    Capsule() {
+        radius = 0.0f;
+    }
+
+    Capsule(const Vector3 &in_point0, const Vector3 &in_point1, float in_radius) {
+        point0 = in_point0;
+        point1 = in_point1;
+        radius = in_radius;
+    }
+};
+
+struct CapsuleHit {
+    float time;         // Fraction of the displacement moved before the contact, 0 to 1
+    Vector3 point;      // Contact point on the triangle
+    Vector3 normal;     // Unit contact normal pointing towards the capsule
+    Vector3 faceNormal; // Unit normal of the hit face, on the side of the capsule
+    Vector3 slide;      // Remaining displacement after the contact, projected onto the contact plane
+    bool startSolid;    // The capsule already overlapped the triangle before moving
+    int faceIndex;
+    Face *face;
+
+    CapsuleHit() {
+        time = 1.0f;
+        startSolid = false;
+        faceIndex = -1;
+        face = NULL;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class CharacterController {
+    public:
+        // Constructors and destructors
+        CharacterController(const BVH &in_bvh);
+
+        // Public class functions
+        bool sweepCapsule(const Capsule &capsule, const Vector3 &displacement, CapsuleHit &hit) const;
+        Vector3 move(const Capsule &capsule, const Vector3 &displacement, bool *grounded = NULL) const;
+
+        void setStepHeight(float value);
+        void setMaxSlope(float degrees);
+        void setSkinWidth(float value);
+
+    private:
+        // Private class functions
+        bool tryStep(Capsule &capsule, const Vector3 &displacement) const;
+
+        // Private class members
+        const BVH &bvh;
+
+        float stepHeight;
+        float minGroundNormal; // Smallest normal y component of walkable ground
+        float skinWidth;
+};
+
+#endif
@@ -0,0 +1,145 @@
+// CompiledMesh.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// CompiledMesh
+// Description:
+// This class represents a Model compiled into indexed triangle lists. Every run of faces sharing a group object
+// and a material gets its own contiguous vertex and index range where identical (vertex, uvw, normal) corners
+// are shared. The vertex stream can be kept as full floats or quantized into a compact format (16-bit positions
+// relative to the bounding box of the model, octahedral 2x16 normals and half float UVs), and the compiled data
+// can be written to and read back from a binary cache file, optionally compressed with MeshCodec.
+// Ranges with a bump mapped material also get tangents, kept in a separate stream that lines up with the
+// vertices of the range, so ranges without bump maps do not pay for them.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __COMPILEDMESH_H
+#define __COMPILEDMESH_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <string>
+#include <vector>
+#include <fstream>
+#include "Model.h"
+#include "Vector3.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+enum VERTEX_FORMAT {
+    VERTEX_FORMAT_FLOAT,
+    VERTEX_FORMAT_QUANTIZED
+};
+
+// Full precision vertex, 32 bytes
+struct CompiledVertex {
+    float position[3];
+    float normal[3];
+    float uv[2];
+};
+
+// Quantized vertex, 16 bytes
+struct QuantizedVertex {
+    unsigned short position[4]; // unorm16 relative to the bounding box, w is padding
+    short normal[2];            // octahedral snorm16
+    unsigned short uv[2];       // half floats
+};
+
+// Tangent frame of a vertex, the bitangent is tangent[3] * cross(normal, tangent)
+struct CompiledTangent {
+    float tangent[4];
+};
+
+// Contiguous range of the compiled mesh sharing one group object and material
+struct CompiledGroup {
+    int objectIndex;   // index into Model::getObjects()
+    int firstVertex;
+    int vertexCount;
+    int firstIndex;
+    int indexCount;
+    int materialIndex; // index into Model::getMaterials(), -1 if none
+    int firstTangent;  // index into CompiledMesh::tangents, -1 if the material has no bump map
+
+    CompiledGroup() {
+        objectIndex = 0;
+        firstVertex = 0;
+        vertexCount = 0;
+        firstIndex = 0;
+        indexCount = 0;
+        materialIndex = -1;
+        firstTangent = -1;
+    }
+};
+
+// Error introduced by quantizing the vertex stream
+struct QuantizationReport {
+    float maxPositionError; // world units
+    float avgPositionError;
+    float maxNormalError;   // degrees
+    float avgNormalError;
+    float maxUVError;
+
+    size_t floatBytes;
+    size_t quantizedBytes;
+
+    QuantizationReport() {
+        maxPositionError = avgPositionError = 0.0f;
+        maxNormalError = avgNormalError = 0.0f;
+        maxUVError = 0.0f;
+        floatBytes = quantizedBytes = 0;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class CompiledMesh {
+    public:
+        // Constructors and destructors
+        CompiledMesh();
+        ~CompiledMesh();
+
+        // Public class functions
+        bool compile(Model &model, VERTEX_FORMAT in_format = VERTEX_FORMAT_FLOAT);
+        void clear(void);
+
+        void setFormat(VERTEX_FORMAT in_format);
+        VERTEX_FORMAT getFormat(void);
+
+        const void *getVertexData(void);
+        int getVertexStride(void);
+        int getNumVertices(void);
+        size_t getVertexBytes(void);
+
+        void decodeVertex(int index, CompiledVertex &out);
+        QuantizationReport getQuantizationReport(void);
+
+        bool saveCache(std::string filename, bool compress = false);
+        bool loadCache(std::string filename);
+
+        // Public class members
+        std::vector<CompiledVertex> vertices;
+        std::vector<QuantizedVertex> quantizedVertices;
+        std::vector<unsigned int> indices;
+        std::vector<CompiledGroup> groups;
+        std::vector<CompiledTangent> tangents;
+
+        Vector3 boundsMin;
+        Vector3 boundsMax;
+
+    private:
+        // Private class functions
+        void quantize(void);
+        void dequantize(void);
+        bool hasValidRanges(void);
+
+        // Private class members
+        VERTEX_FORMAT format;
+        QuantizationReport report;
+};
+
+#endif
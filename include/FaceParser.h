@@ -0,0 +1,48 @@
+// FaceParser.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// FaceParser
+// Description:
+// Parses the corners of an OBJ face record ('f') in a single pass over the characters, without any stream
+// state. Every corner can be given as v, v/vt, v//vn or v/vt/vn, with positive indices counted from the start
+// of the file or negative indices counted back from the last element read so far. All indices are validated
+// against the number of elements read so far and returned zero based.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __FACEPARSER_H
+#define __FACEPARSER_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+
+// Zero based indices of one face corner, -1 if not given
+struct FaceCorner {
+    int vertex;
+    int uvw;
+    int normal;
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class FaceParser {
+    public:
+        // Public class functions
+        static bool parseFace(const char *text, int numVertices, int numUVWs, int numNormals,
+                              std::vector<FaceCorner> &corners);
+
+    private:
+        // Private class functions
+        static bool parseIndex(const char *&text, int count, int &index);
+};
+
+#endif
@@ -0,0 +1,90 @@
+// Frustum.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Frustum
+// Description:
+// The six clip planes of a view frustum, extracted from a combined projection * modelview matrix. Boxes are
+// culled in batches from a structure of arrays layout, testing 4 boxes per plane at a time with SSE (8 with
+// AVX) and falling back to scalar code on other targets. Boxes are tested against each plane with their
+// corner furthest along the plane normal, which is conservative: a box is only rejected if it is completely
+// outside one plane.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __FRUSTUM_H
+#define __FRUSTUM_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#define GL_SILENCE_DEPRECATION
+
+#ifdef WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif
+
+#if defined(__APPLE__) && defined(__MACH__)
+    #include <OpenGL/gl.h>
+#else
+    #include <GL/gl.h>
+#endif
+
+#include <vector>
+#include "BoundingBox.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+
+// Boxes in structure of arrays layout, padded so batches of 8 can always be loaded
+struct BoundingBoxArray {
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+    int count;
+
+    BoundingBoxArray() {
+        count = 0;
+    }
+
+    void clear(void) {
+        minX.clear(); minY.clear(); minZ.clear();
+        maxX.clear(); maxY.clear(); maxZ.clear();
+        count = 0;
+    }
+
+    void add(const BoundingBox &box) {
+        int padded = (count + 8) & ~7;
+
+        minX.resize(padded); minY.resize(padded); minZ.resize(padded);
+        maxX.resize(padded); maxY.resize(padded); maxZ.resize(padded);
+
+        minX[count] = box.min.x; minY[count] = box.min.y; minZ[count] = box.min.z;
+        maxX[count] = box.max.x; maxY[count] = box.max.y; maxZ[count] = box.max.z;
+        count++;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class Frustum {
+    public:
+        // Constructors and destructors
+        Frustum();
+
+        // Public class functions
+        void setFromMatrix(const float *matrix);
+        void extractFromGL(void);
+
+        bool testBox(const BoundingBox &box);
+        bool testSphere(const Vector3 &center, float radius);
+        int cullBoxes(const BoundingBoxArray &boxes, unsigned char *visible, int first = 0, int last = -1);
+
+        // Public class members
+        float planes[6][4]; // (a, b, c, d), inside where a*x + b*y + c*z + d >= 0
+};
+
+#endif
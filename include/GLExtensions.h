@@ -0,0 +1,158 @@
+// GLExtensions.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// GLExtensions
+// Description:
+// Entry points past OpenGL 1.1, which the system headers of every platform do not declare, looked up at
+// runtime from the current context. Functions the context does not have stay NULL, so callers check the
+// version or extension they need and the functions they use before taking a path that needs them.
+// Sync objects are passed around as void pointers, which is what a GLsync is.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __GLEXTENSIONS_H
+#define __GLEXTENSIONS_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#define GL_SILENCE_DEPRECATION
+
+#ifdef WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif
+
+#if defined(__APPLE__) && defined(__MACH__)
+    #include <OpenGL/gl.h>
+#else
+    #include <GL/gl.h>
+#endif
+
+#include <stddef.h>
+#include <string>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+#ifndef APIENTRY
+    #define APIENTRY
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+    #define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+    #define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_STREAM_DRAW
+    #define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_STATIC_DRAW
+    #define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_FRAGMENT_SHADER
+    #define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+    #define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+    #define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+    #define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_MAP_WRITE_BIT
+    #define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+    #define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+    #define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+#ifndef GL_ALREADY_SIGNALED
+    #define GL_ALREADY_SIGNALED 0x911A
+#endif
+#ifndef GL_TIMEOUT_EXPIRED
+    #define GL_TIMEOUT_EXPIRED 0x911B
+#endif
+#ifndef GL_CONDITION_SATISFIED
+    #define GL_CONDITION_SATISFIED 0x911C
+#endif
+#ifndef GL_WAIT_FAILED
+    #define GL_WAIT_FAILED 0x911D
+#endif
+
+struct GLFunctions {
+    // Buffer objects, OpenGL 1.5
+    void (APIENTRY *genBuffers)(GLsizei, GLuint *);
+    void (APIENTRY *deleteBuffers)(GLsizei, const GLuint *);
+    void (APIENTRY *bindBuffer)(GLenum, GLuint);
+    void (APIENTRY *bufferData)(GLenum, ptrdiff_t, const void *, GLenum);
+    void (APIENTRY *bufferSubData)(GLenum, ptrdiff_t, ptrdiff_t, const void *);
+
+    // Shaders, OpenGL 2.0
+    GLuint (APIENTRY *createShader)(GLenum);
+    void (APIENTRY *shaderSource)(GLuint, GLsizei, const char *const *, const GLint *);
+    void (APIENTRY *compileShader)(GLuint);
+    void (APIENTRY *getShaderiv)(GLuint, GLenum, GLint *);
+    void (APIENTRY *deleteShader)(GLuint);
+    GLuint (APIENTRY *createProgram)(void);
+    void (APIENTRY *deleteProgram)(GLuint);
+    void (APIENTRY *attachShader)(GLuint, GLuint);
+    void (APIENTRY *bindAttribLocation)(GLuint, GLuint, const char *);
+    void (APIENTRY *linkProgram)(GLuint);
+    void (APIENTRY *getProgramiv)(GLuint, GLenum, GLint *);
+    void (APIENTRY *useProgram)(GLuint);
+    GLint (APIENTRY *getUniformLocation)(GLuint, const char *);
+    void (APIENTRY *uniform1i)(GLint, GLint);
+    void (APIENTRY *enableVertexAttribArray)(GLuint);
+    void (APIENTRY *disableVertexAttribArray)(GLuint);
+    void (APIENTRY *vertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *);
+
+    // Instancing, OpenGL 3.3 or ARB_draw_instanced and ARB_instanced_arrays
+    void (APIENTRY *vertexAttribDivisor)(GLuint, GLuint);
+    void (APIENTRY *drawElementsInstanced)(GLenum, GLsizei, GLenum, const void *, GLsizei);
+
+    // Mapping and sync objects, OpenGL 3.2 or ARB_sync, and OpenGL 4.4 or ARB_buffer_storage
+    void *(APIENTRY *mapBufferRange)(GLenum, ptrdiff_t, ptrdiff_t, GLbitfield);
+    GLboolean (APIENTRY *unmapBuffer)(GLenum);
+    void (APIENTRY *bufferStorage)(GLenum, ptrdiff_t, const void *, GLbitfield);
+    void *(APIENTRY *fenceSync)(GLenum, GLbitfield);
+    GLenum (APIENTRY *clientWaitSync)(void *, GLbitfield, unsigned long long);
+    void (APIENTRY *deleteSync)(void *);
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class GLExtensions {
+    public:
+        // Public class functions
+        static bool load(void);
+        static bool isLoaded(void);
+
+        static int getVersion(void);
+        static bool hasExtension(const char *name);
+
+        // Public class members
+        static GLFunctions gl;
+
+    private:
+        // Private class members
+        static bool loaded;
+        static int version;
+        static std::string extensions;
+};
+
+#endif
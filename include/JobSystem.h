@@ -0,0 +1,132 @@
+// JobSystem.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// JobSystem
+// Description:
+// Work stealing task scheduler shared by the whole engine. A pool of persistent worker threads, one less than
+// the hardware threads but at least one, is started on first use. Every worker owns a Chase-Lev deque: it
+// pushes and pops its own jobs at the bottom without locks, and idle workers steal the oldest jobs from the
+// top of the other deques. Jobs submitted by threads which are not workers go to a shared queue behind a
+// mutex. There are no fibers; a thread waiting for jobs to finish runs other jobs meanwhile, so nested
+// 'parallelFor' and 'wait' calls inside jobs cannot deadlock, and the waiting thread takes part in the work.
+// Jobs are grouped with JobCounters: 'run' counts a job up on its counter and finishing it counts down, and
+// a job can be held back until another counter reaches zero, which builds dependency chains and graphs.
+// A counter has to outlive its jobs, wait for it before it goes out of scope.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __JOBSYSTEM_H
+#define __JOBSYSTEM_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+struct JobCounter;
+
+struct Job {
+    std::function<void(void)> function;
+    JobCounter *counter;    // Counted down when the job has run, NULL if none
+};
+
+// Number of unfinished jobs of a group, and the jobs waiting for the group to finish
+struct JobCounter {
+    std::atomic<int> count;
+    std::mutex mutex;           // Guards 'waiting' against the job bringing the count to zero
+    std::vector<Job *> waiting; // Submitted when the count reaches zero
+
+    JobCounter() {
+        count = 0;
+    }
+};
+
+// Chase-Lev deque of one worker. Only the owner pushes and pops at the bottom, any thread steals at the top.
+struct JobDeque {
+    std::atomic<long long> top;
+    char padding[64];               // Keeps the owner and the thieves off each other's cache line
+    std::atomic<long long> bottom;
+    std::atomic<Job *> *slots;      // Ring of JOB_DEQUE_SIZE entries
+    std::atomic<long long> executed;
+    std::atomic<long long> stolen;
+};
+
+struct JobSystemStats {
+    int numWorkers;
+    long long executed;     // Jobs run since the last reset, by workers and waiting threads
+    long long stolen;       // Jobs taken from the deque of another worker
+    long long injected;     // Jobs submitted through the shared queue
+    long long sleeps;       // Times a worker found no work and went to sleep
+
+    JobSystemStats() {
+        numWorkers = 0;
+        executed = 0;
+        stolen = 0;
+        injected = 0;
+        sleeps = 0;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class JobSystem {
+    public:
+        // Public class functions
+        static void start(int numThreads = 0);
+        static void stop(void);
+
+        static void run(const std::function<void(void)> &function, JobCounter *counter = NULL,
+                        JobCounter *dependency = NULL);
+        static void wait(JobCounter &counter);
+        static void parallelFor(int begin, int end, const std::function<void(int, int)> &function,
+                                int minRange = 1024, int maxJobs = 0);
+
+        static int getNumWorkers(void);
+        static bool isWorker(void);
+        static JobSystemStats getStats(void);
+        static void resetStats(void);
+
+    private:
+        // Private class functions
+        static void ensureStarted(void);
+        static void workerLoop(int index);
+        static void submit(Job *job);
+        static Job *findJob(int index);
+        static void execute(Job *job);
+        static void finish(JobCounter *counter);
+
+        static bool push(JobDeque &deque, Job *job);
+        static Job *pop(JobDeque &deque);
+        static Job *steal(JobDeque &deque);
+
+        // Private class members
+        static std::atomic<bool> started;
+        static std::atomic<bool> stopping;
+        static std::vector<JobDeque *> deques;
+        static std::vector<std::thread> workers;
+
+        static std::mutex mutex;                   // Guards 'injected' and the sleeping workers
+        static std::condition_variable wake;
+        static std::deque<Job *> injected;
+        static std::atomic<int> numInjected;
+        static std::atomic<int> numQueued;         // Jobs in the deques and the shared queue
+        static std::atomic<int> numSleeping;
+
+        static std::atomic<long long> externalExecuted;
+        static std::atomic<long long> injectedJobs;
+        static std::atomic<long long> sleeps;
+};
+
+#endif
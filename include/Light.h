@@ -1,6 +1,6 @@
 // Light.h
 // Created by Edward Glöckner 2023-06-29.
-// Last modified: 2023-08-08.
+// Last modified: 2026-10-17.
 
 //*********************************************************************************
 // Header guard
@@ -27,6 +27,7 @@
 #endif
 
 #include <vector>
+#include "MemoryTracker.h"
 
 //*********************************************************************************
 // Globals
@@ -40,7 +41,7 @@ enum LIGHT_TYPE {
 //*********************************************************************************
 // Class
 //*********************************************************************************
-class Light {
+class Light : public MemoryTracked<MEMORY_LIGHT> {
     public:
         // Constructors and destructors
         Light(LIGHT_TYPE light_type);
@@ -0,0 +1,168 @@
+// MemoryTracker.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// MemoryTracker
+// Description:
+// Accounting of the heap memory of the engine by subsystem. Every allocation made through the tracker carries a
+// tag, and the tracker keeps the live bytes, the live and total allocation counts and the peak of the live bytes
+// of every tag and of all tags together, which 'writeReport' prints as a table.
+// Classes deriving from MemoryTracked<tag> are counted under the tag by plain new and delete. Plain data, such as
+// the index arrays of faces and the pixels of textures, is allocated with 'allocateArray', and other single
+// objects with 'create', both freed with 'deallocate' and 'destroy'. Memory is prefixed with a small header
+// holding its size and tag, so it must never be freed with delete or free. Containers owned by tracked objects
+// allocate through the standard allocator and are not counted.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __MEMORYTRACKER_H
+#define __MEMORYTRACKER_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <stddef.h>
+#include <atomic>
+#include <new>
+#include <ostream>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+enum MEMORY_TAG {
+    MEMORY_MESH,        // Vertices, faces and group objects
+    MEMORY_MATERIAL,
+    MEMORY_TEXTURE,     // Texture objects and their pixels in system memory
+    MEMORY_LIGHT,
+    MEMORY_OTHER,
+    MEMORY_NUM_TAGS
+};
+
+struct MemoryStats {
+    long long liveBytes;
+    long long peakBytes;        // Most live bytes since the start or the last 'resetPeaks'
+    long long liveAllocations;
+    long long totalAllocations; // Allocations ever made
+    long long totalBytes;       // Bytes ever allocated
+
+    MemoryStats() {
+        liveBytes = 0;
+        peakBytes = 0;
+        liveAllocations = 0;
+        totalAllocations = 0;
+        totalBytes = 0;
+    }
+};
+
+struct MemoryCounters {
+    std::atomic<long long> liveBytes;
+    std::atomic<long long> peakBytes;
+    std::atomic<long long> liveAllocations;
+    std::atomic<long long> totalAllocations;
+    std::atomic<long long> totalBytes;
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class MemoryTracker {
+    public:
+        // Public class functions
+        static void *allocate(size_t bytes, MEMORY_TAG tag);
+        static void deallocate(void *memory);
+
+        //
+        // allocateArray
+        // Description:
+        //      Allocates an uninitialized array of a type without constructors, such as pointers or bytes.
+        // Parameters:
+        //      count <size_t>: Number of elements.
+        //      tag   <MEMORY_TAG>: Subsystem the memory is counted under.
+        // Returns:
+        //      <T*>: The array, free it with 'deallocate'.
+        //
+        template<class T>
+        static T *allocateArray(size_t count, MEMORY_TAG tag) {
+            return (T *)allocate(count * sizeof(T), tag);
+        }
+
+        //
+        // create
+        // Description:
+        //      Allocates and default constructs an object of a type which is not MemoryTracked.
+        // Parameters:
+        //      tag <MEMORY_TAG>: Subsystem the memory is counted under.
+        // Returns:
+        //      <T*>: The object, free it with 'destroy'.
+        //
+        template<class T>
+        static T *create(MEMORY_TAG tag) {
+            return new (allocate(sizeof(T), tag)) T();
+        }
+
+        //
+        // destroy
+        // Description:
+        //      Destroys and frees an object made with 'create'.
+        // Parameters:
+        //      object <T*>: The object, may be NULL.
+        // Returns:
+        //      None (void).
+        //
+        template<class T>
+        static void destroy(T *object) {
+            if (object != NULL) {
+                object->~T();
+                deallocate(object);
+            }
+        }
+
+        static MemoryStats getStats(MEMORY_TAG tag);
+        static MemoryStats getTotalStats(void);
+        static void resetPeaks(void);
+
+        static const char *getTagName(MEMORY_TAG tag);
+        static void writeReport(std::ostream &stream);
+
+    private:
+        // Private class functions
+        static void count(MemoryCounters &counters, long long bytes, bool allocation);
+        static MemoryStats readCounters(const MemoryCounters &counters);
+
+        // Private class members
+        static MemoryCounters counters[MEMORY_NUM_TAGS];
+        static MemoryCounters total;
+};
+
+// Base class counting the objects of a class under a tag
+template<MEMORY_TAG TAG>
+class MemoryTracked {
+    public:
+        // Public class functions
+        static void *operator new(size_t size) {
+            return MemoryTracker::allocate(size, TAG);
+        }
+
+        static void *operator new[](size_t size) {
+            return MemoryTracker::allocate(size, TAG);
+        }
+
+        // Construction in memory someone else owns, such as an arena, is not counted
+        static void *operator new(size_t, void *place) {
+            return place;
+        }
+
+        static void operator delete(void *memory) {
+            MemoryTracker::deallocate(memory);
+        }
+
+        static void operator delete[](void *memory) {
+            MemoryTracker::deallocate(memory);
+        }
+
+        static void operator delete(void *, void *) {
+        }
+};
+
+#endif
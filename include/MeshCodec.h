@@ -0,0 +1,45 @@
+// MeshCodec.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// MeshCodec
+// Description:
+// Lossless codecs for compiled mesh data, used to shrink the binary mesh cache.
+// The index codec walks the triangles in order and references edges and vertices of recently seen triangles
+// through two small FIFOs, so that a typical triangle costs one code byte. Indices that can not be referenced
+// are stored as zigzag varint deltas. Triangles may come back rotated (a, b, c) -> (b, c, a), which keeps
+// the winding and the rendered mesh identical.
+// The vertex codec splits the vertex stream into blocks and transposes each block into byte planes. Every
+// byte plane is delta coded against the previous vertex and packed in groups of 16 with 0, 2, 4 or 8 bits
+// per value, selected by a 2-bit header per group.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __MESHCODEC_H
+#define __MESHCODEC_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+#include <cstddef>
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class MeshCodec {
+    public:
+        // Public class functions
+        static void encodeIndexBuffer(const unsigned int *indices, size_t indexCount,
+                                      std::vector<unsigned char> &out);
+        static bool decodeIndexBuffer(const unsigned char *data, size_t size,
+                                      unsigned int *indices, size_t indexCount);
+
+        static bool encodeVertexBuffer(const void *vertices, size_t vertexCount, size_t vertexSize,
+                                       std::vector<unsigned char> &out);
+        static bool decodeVertexBuffer(const unsigned char *data, size_t size,
+                                       void *vertices, size_t vertexCount, size_t vertexSize);
+};
+
+#endif
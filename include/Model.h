@@ -1,6 +1,6 @@
 // model.h
 // Created by Edward Glöckner 2023-06-29.
-// Last modified: 2023-08-09.
+// Last modified: 2026-10-17.
 
 //*********************************************************************************
 // Header guard
@@ -26,19 +26,28 @@
     #include <GL/glu.h>
 #endif
 
+#include <cstring>
 #include <string>
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include "Texture.h"
+#include "MemoryTracker.h"
+#include "Arena.h"
 #include "Vector3.h"
+#include "BoundingBox.h"
+#include "Frustum.h"
+#include "OcclusionBuffer.h"
 
 //*********************************************************************************
 // Globals
 //*********************************************************************************
+class PVS;
+class RenderQueue;
+class TransparencySorter;
 
 // Material properties
-struct Material {
+struct Material : public MemoryTracked<MEMORY_MATERIAL> {
     float Ka[4]; // (r,g,b,a)
     float Kd[4];
     float Ks[4];
@@ -84,7 +93,7 @@ struct Material {
 };
 
 // Face data
-struct Face {
+struct Face : public MemoryTracked<MEMORY_MESH> {
     Vector3 **vertices;
     int numVertices;
 
@@ -99,17 +108,39 @@ struct Face {
     Vector3 faceCenter;
     Vector3 faceNormal;
 
+    int smoothingGroup; // -1 if not given, 0 if smoothing is off
+
     Face() {
         vertices = NULL;
         normals = NULL;
         UVWs = NULL;
 
         material = NULL;
+
+        smoothingGroup = -1;
     }
 };
 
-struct GroupObject {
+// Run of faces in a group object sharing one material
+struct FaceBatch {
+    int firstFace;
+    int numFaces;
+    Material *material;
+    BoundingBox bounds;
+    GLuint displayList;
+
+    FaceBatch() {
+        firstFace = 0;
+        numFaces = 0;
+        material = NULL;
+        displayList = 0;
+    }
+};
+
+struct GroupObject : public MemoryTracked<MEMORY_MESH> {
     std::vector<Face *> faces;
+    std::vector<FaceBatch> batches;
+    BoundingBox bounds;
     std::string objectName;
     std::string groupName;
 };
@@ -126,23 +157,49 @@ class Model {
         // Public class functions
         void drawModel(void);
         void drawObject(bool transparency = false);
+        void drawBatch(int object, int batch);
         void drawFace(Face &face);
+        void applyMaterial(Material *material);
+
+        void setCulling(bool value);
+        void setTransparencySorting(bool value);
+        TransparencySorter *getTransparencySorter(void);
+        int cullObjects(Frustum &frustum);
+        int cullOccludedObjects(OcclusionBuffer &buffer);
+        void setOcclusionBuffer(OcclusionBuffer *buffer);
+        int cullInvisibleObjects(PVS &pvs, const Vector3 &viewPoint);
+        void setPVS(PVS *pvs);
+        int submit(RenderQueue &queue, const float *transform = NULL);
 
         void deleteObjects(void);
         
         bool loadObject(std::string in_filename);
         void loadMaterials(std::string in_filename);
 
+        void generateNormals(float creaseAngle = 60.0f);
+
         float getRadius(void);
         Vector3 getCenter(void);
         std::string getPath(void);
 
+        std::vector<GroupObject *> &getObjects(void);
+        std::vector<Material *> &getMaterials(void);
+        Vector3 *getBoundingPoints(void);
+
     private:
+        // Private class functions
+        void computeBounds(void);
+        int countVisibleBatches(void);
+        Vector3 getViewPoint(void);
+        void deleteDisplayLists(void);
+
         // Private class members
         std::vector<GroupObject *> objects;
         std::vector<Vector3 *> vertices;
         std::vector<Vector3 *> normals;
         std::vector<Vector3 *> UVWs;
+        std::vector<Vector3> generatedNormals;
+        Arena faceArena; // Faces, their index arrays and the vertex records, freed together
 
         std::vector <Material *> materials;
 
@@ -152,7 +209,14 @@ class Model {
 
         bool objectLoaded;
 
-        GLuint displayList;
+        bool cullingEnabled;
+        BoundingBoxArray objectBounds;
+        BoundingBoxArray batchBounds;
+        std::vector<unsigned char> objectVisible;
+        std::vector<unsigned char> batchVisible;
+        OcclusionBuffer *occlusionBuffer;
+        PVS *visibleSet;
+        TransparencySorter *transparencySorter;
 
         std::string filename;
 };
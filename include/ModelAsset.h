@@ -0,0 +1,101 @@
+// ModelAsset.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// ModelAsset
+// Description:
+// Shared mesh data of a Model for drawing the same object many times. An asset holds the loaded Model with its
+// materials and textures together with the Model compiled into indexed triangle lists, and is never changed
+// after loading. Assets are loaded through a cache keyed by the filename, so loading crate.obj a second time
+// returns the asset already in memory, and an asset is deleted when the last reference to it is released.
+// A ModelInstance is a placement of an asset: a transform and a tint, nothing else. Instances are drawn in
+// runs of the same asset. When the OpenGL context supports instanced arrays the vertices and indices of the
+// asset are kept in buffer objects and every material range of the asset is drawn once for all the instances
+// of the run with glDrawElementsInstanced, the transforms and tints being read per instance by a small shader.
+// Otherwise the ranges are drawn from client side vertex arrays, once per instance, through the RenderBackend.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __MODELASSET_H
+#define __MODELASSET_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <string>
+#include <vector>
+#include "Model.h"
+#include "CompiledMesh.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+class ModelAsset;
+
+// Placement of an asset in the scene, 88 bytes with 64-bit pointers
+struct ModelInstance {
+    ModelAsset *asset;
+    float transform[16]; // Column major, the same layout as glMultMatrixf
+    float tint[4];       // Multiplies the diffuse colour of every material, (r,g,b,a)
+
+    ModelInstance() {
+        asset = NULL;
+
+        for (int i = 0; i < 16; i++)
+            transform[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+
+        for (int i = 0; i < 4; i++)
+            tint[i] = 1.0f;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class ModelAsset {
+    public:
+        // Public class functions
+        static ModelAsset *load(std::string in_filename);
+        static void release(ModelAsset *asset);
+
+        static void drawInstances(const ModelInstance *instances, int count);
+
+        static bool isInstancingSupported(void);
+        static void setInstancingEnabled(bool value);
+
+        Model &getModel(void);
+        CompiledMesh &getMesh(void);
+        std::string getFilename(void);
+        int getReferences(void);
+
+        // Public class members
+        static std::vector<ModelAsset *> assets;
+
+    private:
+        // Constructors and destructors
+        ModelAsset(std::string in_filename);
+        ~ModelAsset();
+
+        // Private class functions
+        void drawRun(const ModelInstance *const *instances, int count, bool transparency);
+        void drawInstanced(const ModelInstance *const *instances, int count, bool transparency);
+        void createBuffers(void);
+        void deleteBuffers(void);
+
+        // Private class members
+        Model model;
+        CompiledMesh mesh;
+        std::string filename;
+        int references;
+
+        GLuint vertexBuffer;
+        GLuint indexBuffer;
+        GLuint instanceBuffer;
+        std::vector<float> instanceData; // Transform and tint of every instance of a run, 20 floats each
+
+        static int instancingSupport; // -1 until checked, then 0 or 1
+        static bool instancingEnabled;
+};
+
+#endif
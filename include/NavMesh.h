@@ -0,0 +1,145 @@
+// NavMesh.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// NavMesh
+// Description:
+// Navigation mesh for bots, built from the triangles of a level Model. The level is voxelized into columns of
+// solid spans, a span is walkable when the face on top of it is not steeper than the walkable slope. The top of
+// a walkable span with room for the agent above it becomes a floor cell, and floor cells are connected to the
+// floor cells next to them if the agent can climb the height difference. Cells closer to an edge than the agent
+// radius are removed, and the remaining cells are merged into rectangles which form the polygons of the mesh.
+// Polygons sharing part of an edge are linked by a portal, the shared part of the edge.
+// The level is built in square tiles of cells which run in parallel, every tile voxelizes a border of cells
+// around itself so the edges are found the same way as without tiles.
+// Paths are searched with A* over the polygons and then straightened with the funnel algorithm (string pulling)
+// through the portals of the polygon corridor. Queries only read the mesh, so bots can search paths from several
+// threads at the same time. The y axis is up.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __NAVMESH_H
+#define __NAVMESH_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+#include "Model.h"
+#include "Vector3.h"
+#include "BoundingBox.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+struct NavMeshConfig {
+    float cellSize;    // Width of a voxel column
+    float cellHeight;  // Height of a voxel
+    float agentHeight; // Free space needed above the floor
+    float agentRadius; // Distance kept from edges and walls
+    float agentClimb;  // Highest step the agent walks up
+    float maxSlope;    // Steepest walkable slope in degrees
+    int tileSize;      // Width of a tile in cells
+
+    NavMeshConfig() {
+        cellSize = 0.2f;
+        cellHeight = 0.1f;
+        agentHeight = 1.8f;
+        agentRadius = 0.4f;
+        agentClimb = 0.3f;
+        maxSlope = 45.0f;
+        tileSize = 64;
+    }
+};
+
+// Rectangle of floor cells
+struct NavPolygon {
+    float minX, minZ;
+    float maxX, maxZ;
+    float heights[4]; // Floor height at the corners (minX, minZ), (maxX, minZ), (maxX, maxZ), (minX, maxZ)
+    Vector3 center;
+    int firstLink;
+    int numLinks;
+};
+
+// Part of an edge shared with a neighbouring polygon
+struct NavLink {
+    int polygon; // The neighbour
+    Vector3 point0;
+    Vector3 point1;
+};
+
+// Floor cells of one tile, kept for finding the polygon below a point
+struct NavTile {
+    std::vector<int> columnStart; // First cell of every column of the tile, one extra entry for the end
+    std::vector<int> cellHeights; // Floor height of every cell in voxels
+    std::vector<int> cellPolygons;
+};
+
+struct NavMeshStats {
+    double buildTime;  // Milliseconds spent in the last 'build'
+    int numTriangles;  // Triangles voxelized
+    int numTiles;
+    int numCells;      // Floor cells left after removing the edges
+    int numPolygons;
+    int numLinks;
+
+    NavMeshStats() {
+        buildTime = 0.0;
+        numTriangles = 0;
+        numTiles = 0;
+        numCells = 0;
+        numPolygons = 0;
+        numLinks = 0;
+    }
+};
+
+// Temporary data used while building, defined in NavMesh.cpp
+struct NavBuildData;
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class NavMesh {
+    public:
+        // Constructors and destructors
+        NavMesh();
+
+        // Public class functions
+        void build(Model &model, const NavMeshConfig &in_config = NavMeshConfig());
+        void clear(void);
+
+        int findPolygon(const Vector3 &point) const;
+        bool findPath(const Vector3 &start, const Vector3 &end, std::vector<Vector3> &path) const;
+
+        const NavMeshConfig &getConfig(void) const;
+        const NavMeshStats &getStats(void) const;
+
+        // Public class members
+        std::vector<NavPolygon> polygons;
+        std::vector<NavLink> links;
+
+    private:
+        // Private class functions
+        void buildTile(int tile, NavBuildData &data, std::vector<NavPolygon> &tilePolygons);
+        void connectPolygons(void);
+        int findCell(int x, int z, int height, int *polygon) const;
+        bool findCorridor(int startPolygon, int endPolygon, const Vector3 &end, std::vector<int> &corridor) const;
+        void pullString(const Vector3 &start, const Vector3 &end, const std::vector<int> &corridor,
+                        std::vector<Vector3> &path) const;
+
+        // Private class members
+        NavMeshConfig config;
+        NavMeshStats stats;
+
+        BoundingBox bounds;
+        int columnsX;
+        int columnsZ;
+        int tilesX;
+        int tilesZ;
+
+        std::vector<NavTile> tiles;
+};
+
+#endif
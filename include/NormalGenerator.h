@@ -0,0 +1,45 @@
+// NormalGenerator.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// NormalGenerator
+// Description:
+// Generates smooth vertex normals for models without 'vn' records. Every face corner gets the weighted sum of
+// the normals of all faces sharing its vertex, as long as the faces are in the same smoothing group and the
+// angle between the face normals is below the crease angle. Corners of a vertex ending up with the same normal
+// share one normal. Face normals, weights and the per vertex sums are computed in parallel.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __NORMALGENERATOR_H
+#define __NORMALGENERATOR_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+#include "Model.h"
+#include "Arena.h"
+#include "Vector3.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+enum NORMAL_WEIGHT {
+    NORMAL_WEIGHT_AREA,
+    NORMAL_WEIGHT_ANGLE
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class NormalGenerator {
+    public:
+        // Public class functions
+        static void generate(std::vector<GroupObject *> &objects, std::vector<Vector3 *> &vertices,
+                             std::vector<Vector3> &normals, Arena &arena, float creaseAngle = 60.0f,
+                             NORMAL_WEIGHT weight = NORMAL_WEIGHT_ANGLE);
+};
+
+#endif
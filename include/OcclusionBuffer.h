@@ -0,0 +1,111 @@
+// OcclusionBuffer.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// OcclusionBuffer
+// Description:
+// Software occlusion culling. A few large occluders, normally simplified versions of the level walls and floors
+// loaded as their own Models, are rasterized depth only into a small depth buffer on the CPU. Bounding boxes are
+// then tested against a hierarchical Z pyramid built from that buffer, where every texel holds the farthest depth
+// of the pixels below it. A box whose nearest depth is behind every texel its screen rectangle covers is hidden.
+// The screen is divided into tiles which are rasterized by several threads, each tile by one thread only, so no
+// locking is needed. Pixels are filled 8 (AVX) or 4 (SSE) at a time with a scalar fallback on other targets.
+// Nothing here uses OpenGL, so it also runs on servers and in tools without a GPU.
+// Depth is the OpenGL window depth, 0 at the near plane and 1 at the far plane.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __OCCLUSIONBUFFER_H
+#define __OCCLUSIONBUFFER_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+#include "BoundingBox.h"
+#include "Frustum.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+class Model;
+
+// Triangle set up for rasterizing, in pixels. The edge functions are positive inside.
+struct OcclusionTriangle {
+    float edgeA[3], edgeB[3], edgeC[3]; // edge(x, y) = A * x + B * y + C
+    float depthA, depthB, depthC;       // depth(x, y) = A * x + B * y + C
+    int minX, minY, maxX, maxY;         // Pixel bounds, inclusive
+};
+
+struct OcclusionStats {
+    int numOccluderTriangles;   // Triangles added as occluders
+    int numRasterizedTriangles; // Triangles left after clipping and rejecting those outside the screen
+    int numTested;              // Boxes tested since the last 'render'
+    int numOccluded;            // Boxes found hidden since the last 'render'
+    double rasterTime;          // Milliseconds spent in the last 'render'
+    double testTime;            // Milliseconds spent testing boxes since the last 'render'
+
+    OcclusionStats() {
+        numOccluderTriangles = 0;
+        numRasterizedTriangles = 0;
+        numTested = 0;
+        numOccluded = 0;
+        rasterTime = 0.0;
+        testTime = 0.0;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class OcclusionBuffer {
+    public:
+        // Constructors and destructors
+        OcclusionBuffer(int in_width = 256, int in_height = 128);
+
+        // Public class functions
+        void addOccluder(Model &model);
+        void addOccluder(const float *in_positions, int numVertices, const int *in_indices, int numIndices);
+        void clearOccluders(void);
+
+        void setViewProjection(const float *in_matrix);
+        void render(void);
+
+        bool testBox(const BoundingBox &box) const;
+        int cullBoxes(const BoundingBoxArray &boxes, unsigned char *visible);
+
+        int getWidth(void) const;
+        int getHeight(void) const;
+        const float *getDepth(void) const;
+        const OcclusionStats &getStats(void) const;
+
+    private:
+        // Private class functions
+        void setupTriangles(void);
+        void rasterizeTile(int tile);
+        void buildPyramid(void);
+
+        // Private class members
+        int width;
+        int height;
+        int tilesX;
+        int tilesY;
+
+        float matrix[16]; // Projection * modelview, column major
+
+        std::vector<float> positions; // Occluder vertices, x y z
+        std::vector<int> indices;     // Occluder triangles
+
+        std::vector<float> clipVertices; // Occluder vertices after the matrix, x y z w
+        std::vector<OcclusionTriangle> triangles;
+        std::vector<std::vector<int> > tileTriangles;
+
+        std::vector<std::vector<float> > pyramid; // Level 0 is the depth buffer, every level halves the size
+        std::vector<int> levelWidths;
+        std::vector<int> levelHeights;
+
+        OcclusionStats stats;
+};
+
+#endif
@@ -0,0 +1,103 @@
+// Octree.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Octree
+// Description:
+// Scene index over Model instances, each instance being a Model drawn with its own transform. An instance is
+// bounded by the sphere of its Model (getCenter and getRadius) moved by the transform.
+// The tree is a loose octree: the bounds of every node are twice as large as its cell, so an instance only has to
+// have its center in the cell and a radius up to half the cell size to fit. The node of an instance follows
+// directly from its center and radius, which makes inserting and moving an instance a walk down the tree without
+// any splitting or merging, and moving an instance within its cell touches nothing but the instance itself.
+// Nodes are 32 bytes and kept in one array, the eight children of a node are stored next to each other and only
+// created when an instance needs them. The instances of a node form a linked list through the instance array.
+// Instances whose center is outside of the bounds given to the tree are kept in the root node.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __OCTREE_H
+#define __OCTREE_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+#include "BVH.h"
+#include "Model.h"
+#include "Frustum.h"
+#include "Vector3.h"
+#include "BoundingBox.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+
+// Tree node, 32 bytes. The children are at firstChild to firstChild + 7, in the order of the octant bits
+// x = 1, y = 2, z = 4
+struct OctreeNode {
+    float center[3];
+    float halfSize;   // Half the edge length of the cell, the loose bounds reach twice as far
+    int firstChild;   // -1 for leaves
+    int parent;       // -1 for the root
+    int firstEntry;   // First instance in the node, -1 if none
+    int numEntries;   // Instances in the node and all nodes below it
+};
+
+// Bounding sphere and list links of an instance, kept apart from the model and transform so queries only
+// read what they test
+struct OctreeEntry {
+    Vector3 center;
+    float radius;
+    int node;     // -1 for removed instances
+    int previous;
+    int next;     // Next instance in the same node, or the next free id for removed instances
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class Octree {
+    public:
+        // Constructors and destructors
+        Octree(const BoundingBox &in_bounds, int in_maxDepth = 5);
+
+        // Public class functions
+        int insert(Model *model, const float *transform);
+        void update(int id, const float *transform);
+        void remove(int id);
+        void clear(void);
+
+        void queryFrustum(Frustum &frustum, std::vector<int> &results) const;
+        void querySphere(const Vector3 &center, float radius, std::vector<int> &results) const;
+        void queryRay(const Ray &ray, std::vector<int> &results) const;
+
+        Model *getModel(int id) const;
+        const float *getTransform(int id) const;
+        Vector3 getCenter(int id) const;
+        float getRadius(int id) const;
+
+        int getNumInstances(void) const;
+        int getNumNodes(void) const;
+
+    private:
+        // Private class functions
+        int findNode(const Vector3 &center, float radius);
+        void link(int id, int node);
+        void unlink(int id);
+        void setSphere(int id, const float *transform);
+
+        // Private class members
+        BoundingBox bounds;
+        int maxDepth;
+        int numInstances;
+        int firstFree; // First removed id to reuse, -1 if none
+
+        std::vector<OctreeNode> nodes;
+        std::vector<OctreeEntry> entries;
+        std::vector<Model *> models;
+        std::vector<float> transforms; // 16 floats per instance, column major
+};
+
+#endif
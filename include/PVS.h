@@ -0,0 +1,108 @@
+// PVS.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// PVS
+// Description:
+// Potentially visible set of a static level Model. The bounding box of the level is divided into a grid of cubic
+// cells and for every cell the baker decides which group objects can be seen from somewhere inside it, by tracing
+// rays from random points in the cell to random points on the faces of the group object through the level BVH.
+// A group object is visible as soon as one ray gets through, cells are baked in parallel.
+// Sampling can miss a group object that is only visible through a small gap, more samples make that less likely.
+// The visibility of a cell is one bit per group object, run length compressed the same way as the old Quake
+// PVS: non zero bytes are stored as they are and runs of zero bytes as a zero followed by the run length.
+// At runtime the cell of the view point is looked up and the group objects it cannot see are culled, which costs
+// a few hundred byte reads instead of any geometry tests. Baked sets are saved to and loaded from a binary file.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __PVS_H
+#define __PVS_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <string>
+#include <vector>
+#include "BVH.h"
+#include "Model.h"
+#include "Vector3.h"
+#include "BoundingBox.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+struct PVSStats {
+    double bakeTime;        // Milliseconds spent in the last 'bake'
+    long long numRays;      // Rays traced by the last 'bake'
+    int numCells;
+    int numObjects;
+    int compressedBytes;    // Size of all cell bitsets
+    int uncompressedBytes;  // Size the bitsets would have without compression
+    float averageVisible;   // Fraction of the group objects visible from a cell, averaged over the cells
+
+    int numQueries;         // Calls to 'cullObjects' since the last 'resetStats'
+    int numTested;          // Group objects tested by those calls
+    int numCulled;          // Group objects culled by those calls
+    double queryTime;       // Milliseconds spent in those calls
+
+    PVSStats() {
+        bakeTime = 0.0;
+        numRays = 0;
+        numCells = 0;
+        numObjects = 0;
+        compressedBytes = 0;
+        uncompressedBytes = 0;
+        averageVisible = 0.0f;
+        numQueries = 0;
+        numTested = 0;
+        numCulled = 0;
+        queryTime = 0.0;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class PVS {
+    public:
+        // Constructors and destructors
+        PVS();
+
+        // Public class functions
+        void bake(Model &model, const BVH &bvh, float in_cellSize, int numSamples = 64);
+        void clear(void);
+
+        bool save(std::string filename) const;
+        bool load(std::string filename);
+
+        int getCell(const Vector3 &point) const;
+        bool isVisible(int cell, int object) const;
+        int cullObjects(const Vector3 &viewPoint, unsigned char *visible, int count);
+
+        int getNumCells(void) const;
+        int getNumObjects(void) const;
+        BoundingBox getBounds(void) const;
+
+        const PVSStats &getStats(void) const;
+        void resetStats(void);
+
+    private:
+        // Private class functions
+        void decompressCell(int cell, std::vector<unsigned char> &output) const;
+
+        // Private class members
+        BoundingBox bounds;
+        float cellSize;
+        int cellsX, cellsY, cellsZ;
+        int numObjects;
+
+        std::vector<unsigned char> data; // Compressed bitsets of all cells
+        std::vector<int> cellOffsets;    // Start of every cell in 'data', one extra entry for the end
+        std::vector<unsigned char> bits; // Decompressed bitset used by 'cullObjects'
+
+        PVSStats stats;
+};
+
+#endif
@@ -0,0 +1,39 @@
+// Parallel.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Parallel
+// Description:
+// Small helper for data parallel loops over index ranges. The range is split into contiguous chunks which are
+// processed as jobs on the workers of the JobSystem, the calling thread takes part in the work and returns when
+// every chunk is done. The number of threads only limits the number of chunks.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __PARALLEL_H
+#define __PARALLEL_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <functional>
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class Parallel {
+    public:
+        // Public class functions
+        static void forRange(int begin, int end, const std::function<void(int, int)> &function,
+                             int minRange = 1024);
+
+        static int getNumThreads(void);
+        static void setNumThreads(int value);
+
+    private:
+        // Private class members
+        static int numThreads;
+};
+
+#endif
@@ -0,0 +1,140 @@
+// Profiler.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Profiler
+// Description:
+// Scoped CPU profiler. A PROFILE_SCOPE at the top of a block records the steady clock time spent in the block,
+// and scopes inside scopes record their depth, so the trace shows the hierarchy. Every thread writes its
+// events to a ring of its own without locks; 'collect', called once a frame or after the work of interest,
+// drains the rings into a rolling window of durations per scope, which 'getSummary' turns into the median
+// and 99th percentile, and, while capturing, into a trace 'writeChromeTrace' saves for chrome://tracing
+// or Perfetto. Events which do not fit in a full ring are dropped and counted.
+// Scope names are not copied and have to be string literals. Defining PROFILER_DISABLED compiles the scopes
+// out, and 'setEnabled(false)' turns them off at runtime at the cost of one check per scope.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+#define PROFILE_CONCAT_LINE(name, line) name##line
+#define PROFILE_CONCAT(name, line) PROFILE_CONCAT_LINE(name, line)
+
+#ifdef PROFILER_DISABLED
+    #define PROFILE_SCOPE(name)
+#else
+    #define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#endif
+
+struct ProfileEvent {
+    const char *name;
+    long long start;    // Steady clock nanoseconds
+    long long end;
+    int thread;         // Profiler thread number, from 1 in the order threads recorded their first event
+    int depth;          // Scopes the event is nested in
+};
+
+struct ProfileSummary {
+    std::string name;
+    long long count;    // Events since the last reset
+    double last;        // Milliseconds of the last event
+    double p50;         // Median of the window in milliseconds
+    double p99;         // 99th percentile of the window
+    double max;         // Longest event of the window
+
+    ProfileSummary() {
+        count = 0;
+        last = 0.0;
+        p50 = 0.0;
+        p99 = 0.0;
+        max = 0.0;
+    }
+};
+
+// Rolling window of the durations of a scope
+struct ProfileWindow {
+    std::vector<long long> durations; // Nanoseconds, oldest overwritten first
+    int next;
+    long long count;
+    long long last;
+};
+
+// Single producer ring of the events of one thread, reused after the thread exits
+struct ProfilerBuffer {
+    std::vector<ProfileEvent> events;
+    std::atomic<unsigned int> head;     // Written by the thread
+    std::atomic<unsigned int> tail;     // Written by 'collect'
+    std::atomic<long long> dropped;
+    int thread;
+    bool inUse;
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class Profiler {
+    public:
+        // Public class functions
+        static void setEnabled(bool value);
+        static bool isEnabled(void);
+        static void setCapture(bool value);
+        static bool isCapturing(void);
+
+        static void collect(void);
+        static std::vector<ProfileSummary> getSummary(void);
+        static bool writeChromeTrace(const std::string &filename);
+        static long long getDroppedEvents(void);
+        static void reset(void);
+
+        static long long now(void);
+        static int beginScope(void);
+        static void endScope(const char *name, long long start, int depth);
+
+    private:
+        // Private class functions
+        static ProfilerBuffer *getBuffer(void);
+        static void releaseBuffer(ProfilerBuffer *buffer);
+
+        // Private class members
+        static std::atomic<bool> enabled;
+        static bool capturing;
+
+        static std::mutex mutex;                     // Guards everything below
+        static std::vector<ProfilerBuffer *> buffers;
+        static int numThreads;
+        static std::map<std::string, ProfileWindow> windows;
+        static std::vector<ProfileEvent> capture;
+        static long long droppedEvents;             // Dropped by rings since reused or collected, and by a full capture
+
+        friend struct ProfilerThread;
+};
+
+// Records the time from its construction to its destruction, use through PROFILE_SCOPE
+class ProfileScope {
+    public:
+        // Constructors and destructors
+        ProfileScope(const char *in_name);
+        ~ProfileScope();
+
+    private:
+        // Private class members
+        const char *name;
+        long long start;
+        int depth;          // -1 if the profiler was disabled when the scope began
+};
+
+#endif
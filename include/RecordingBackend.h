@@ -0,0 +1,157 @@
+// RecordingBackend.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// RecordingBackend
+// Description:
+// Render backend which needs no OpenGL context. It counts the calls made to it, the draw calls, state changes
+// and bytes sent to the GPU, and can log every call as text, so the cost of submitting a frame can be measured
+// and compared in benchmarks and tests on machines without a GPU.
+// Enough state is kept to answer what the drawing code asks for and to spot redundant state changes: enabled
+// capabilities, material and light parameters, the bound texture, a modelview matrix stack and a projection
+// matrix, which 'setMatrix' places a camera in. Display lists remember the geometry compiled into them,
+// so calling a list counts its draw calls and vertices again, the way the driver would draw them again.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __RECORDINGBACKEND_H
+#define __RECORDINGBACKEND_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <map>
+#include <string>
+#include <vector>
+#include "RenderBackend.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+struct RenderBackendStats {
+    long long calls;                // Calls to the backend, each immediate mode vertex attribute is one
+    int drawCalls;                  // Primitives executed between 'begin' and 'end', including those of called lists,
+                                    // and 'drawElements' calls
+    long long vertices;             // Vertices of those draw calls, indices for 'drawElements'
+    int listCalls;                  // Display lists executed
+    int listsCompiled;              // Display lists compiled
+    int stateChanges;               // Capability, client array, material, light and texture parameter changes and
+                                    // texture binds
+    int redundantStateChanges;      // Of those, changes to the value the state already had
+    int textureBinds;               // Texture binds, redundant ones included
+    int matrixChanges;              // Pushes, pops and multiplies of the matrix stack
+    int textureUploads;             // Texture images uploaded
+    long long textureBytes;         // Bytes of those images
+    long long vertexBytes;          // Bytes of immediate mode vertex data, counted again when a list is called
+
+    RenderBackendStats() {
+        calls = 0;
+        drawCalls = 0;
+        vertices = 0;
+        listCalls = 0;
+        listsCompiled = 0;
+        stateChanges = 0;
+        redundantStateChanges = 0;
+        textureBinds = 0;
+        matrixChanges = 0;
+        textureUploads = 0;
+        textureBytes = 0;
+        vertexBytes = 0;
+    }
+};
+
+// Geometry compiled into a display list
+struct RecordedList {
+    int drawCalls;
+    long long vertices;
+    long long vertexBytes;
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class RecordingBackend : public RenderBackend {
+    public:
+        // Constructors and destructors
+        RecordingBackend();
+
+        // Public class functions
+        void enable(GLenum capability);
+        void disable(GLenum capability);
+
+        void setMaterial(GLenum face, GLenum name, const GLfloat *values);
+        void setMaterial(GLenum face, GLenum name, GLfloat value);
+        void setLight(GLenum light, GLenum name, const GLfloat *values);
+        void setLight(GLenum light, GLenum name, GLfloat value);
+
+        GLuint createTexture(void);
+        void bindTexture(GLenum target, GLuint texture);
+        void setTextureParameter(GLenum target, GLenum name, GLfloat value);
+        void uploadTexture(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                           GLenum format, GLenum type, const void *data);
+
+        void begin(GLenum mode);
+        void end(void);
+        void vertex(double x, double y, double z);
+        void normal(double x, double y, double z);
+        void texCoord(float s, float t);
+
+        GLuint createList(void);
+        void beginList(GLuint list, GLenum mode);
+        void endList(void);
+        void callList(GLuint list);
+        void deleteList(GLuint list);
+
+        void enableClientState(GLenum array);
+        void disableClientState(GLenum array);
+        void vertexPointer(GLint size, GLenum type, GLsizei stride, const void *pointer);
+        void normalPointer(GLenum type, GLsizei stride, const void *pointer);
+        void texCoordPointer(GLint size, GLenum type, GLsizei stride, const void *pointer);
+        void drawElements(GLenum mode, GLsizei count, GLenum type, const void *indices);
+
+        void pushMatrix(void);
+        void popMatrix(void);
+        void multMatrix(const GLfloat *matrix);
+        void getFloat(GLenum name, GLfloat *values);
+        void getInteger(GLenum name, GLint *values);
+
+        void setMatrix(GLenum mode, const GLfloat *matrix);
+        void setMaxLights(int value);
+
+        void setLogging(bool value);
+        const std::vector<std::string> &getLog(void) const;
+        void clearLog(void);
+
+        const RenderBackendStats &getStats(void) const;
+        void resetStats(void);
+
+    private:
+        // Private class functions
+        bool changeState(unsigned long long key, const GLfloat *values, int count);
+        void addVertexData(long long bytes);
+        void log(const char *format, ...);
+
+        // Private class members
+        RenderBackendStats stats;
+
+        std::map<unsigned long long, std::vector<GLfloat> > state; // Last value of every state, by kind and name
+        GLuint boundTexture;
+        GLuint nextTexture;
+
+        std::map<GLuint, RecordedList> lists;
+        GLuint nextList;
+        GLuint compilingList;   // List between 'beginList' and 'endList', 0 if none
+        bool executeList;       // If the geometry of the list being compiled is drawn too
+
+        int primitiveVertices;  // Vertices since the last 'begin'
+        int maxLights;
+
+        std::vector<GLfloat> modelview;  // Stack of column major matrices, the top is the current one
+        std::vector<GLfloat> projection;
+
+        bool logging;
+        std::vector<std::string> callLog;
+};
+
+#endif
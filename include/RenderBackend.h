@@ -0,0 +1,145 @@
+// RenderBackend.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// RenderBackend
+// Description:
+// The OpenGL calls made by Model, Light, Texture and the draw paths built on them, behind one small interface.
+// Every call goes to the current backend, which is a GLRenderBackend forwarding straight to OpenGL unless
+// another one is set with 'RenderBackend::set'. A RecordingBackend set there instead counts and logs the calls
+// without a context, which is how drawing, light updates and texture uploads are measured on machines
+// without a GPU. The functions follow their OpenGL namesakes and take the same enums.
+// Display lists are created one at a time, which is the only way they are used.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __RENDERBACKEND_H
+#define __RENDERBACKEND_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#define GL_SILENCE_DEPRECATION
+
+#ifdef WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif
+
+#if defined(__APPLE__) && defined(__MACH__)
+    #include <OpenGL/gl.h>
+#else
+    #include <GL/gl.h>
+#endif
+
+#include <stddef.h>
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class RenderBackend {
+    public:
+        // Constructors and destructors
+        virtual ~RenderBackend() {}
+
+        // Public class functions
+        static RenderBackend *get(void);
+        static void set(RenderBackend *backend);
+
+        // Capabilities
+        virtual void enable(GLenum capability) = 0;
+        virtual void disable(GLenum capability) = 0;
+
+        // Materials and lights
+        virtual void setMaterial(GLenum face, GLenum name, const GLfloat *values) = 0;
+        virtual void setMaterial(GLenum face, GLenum name, GLfloat value) = 0;
+        virtual void setLight(GLenum light, GLenum name, const GLfloat *values) = 0;
+        virtual void setLight(GLenum light, GLenum name, GLfloat value) = 0;
+
+        // Textures
+        virtual GLuint createTexture(void) = 0;
+        virtual void bindTexture(GLenum target, GLuint texture) = 0;
+        virtual void setTextureParameter(GLenum target, GLenum name, GLfloat value) = 0;
+        virtual void uploadTexture(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                                   GLenum format, GLenum type, const void *data) = 0;
+
+        // Immediate mode geometry
+        virtual void begin(GLenum mode) = 0;
+        virtual void end(void) = 0;
+        virtual void vertex(double x, double y, double z) = 0;
+        virtual void normal(double x, double y, double z) = 0;
+        virtual void texCoord(float s, float t) = 0;
+
+        // Display lists
+        virtual GLuint createList(void) = 0;
+        virtual void beginList(GLuint list, GLenum mode) = 0;
+        virtual void endList(void) = 0;
+        virtual void callList(GLuint list) = 0;
+        virtual void deleteList(GLuint list) = 0;
+
+        // Vertex arrays
+        virtual void enableClientState(GLenum array) = 0;
+        virtual void disableClientState(GLenum array) = 0;
+        virtual void vertexPointer(GLint size, GLenum type, GLsizei stride, const void *pointer) = 0;
+        virtual void normalPointer(GLenum type, GLsizei stride, const void *pointer) = 0;
+        virtual void texCoordPointer(GLint size, GLenum type, GLsizei stride, const void *pointer) = 0;
+        virtual void drawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) = 0;
+
+        // Matrices and queries
+        virtual void pushMatrix(void) = 0;
+        virtual void popMatrix(void) = 0;
+        virtual void multMatrix(const GLfloat *matrix) = 0;
+        virtual void getFloat(GLenum name, GLfloat *values) = 0;
+        virtual void getInteger(GLenum name, GLint *values) = 0;
+
+    private:
+        // Private class members
+        static RenderBackend *current;
+};
+
+// Forwards every call to the OpenGL context current on the calling thread
+class GLRenderBackend : public RenderBackend {
+    public:
+        // Public class functions
+        void enable(GLenum capability);
+        void disable(GLenum capability);
+
+        void setMaterial(GLenum face, GLenum name, const GLfloat *values);
+        void setMaterial(GLenum face, GLenum name, GLfloat value);
+        void setLight(GLenum light, GLenum name, const GLfloat *values);
+        void setLight(GLenum light, GLenum name, GLfloat value);
+
+        GLuint createTexture(void);
+        void bindTexture(GLenum target, GLuint texture);
+        void setTextureParameter(GLenum target, GLenum name, GLfloat value);
+        void uploadTexture(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                           GLenum format, GLenum type, const void *data);
+
+        void begin(GLenum mode);
+        void end(void);
+        void vertex(double x, double y, double z);
+        void normal(double x, double y, double z);
+        void texCoord(float s, float t);
+
+        GLuint createList(void);
+        void beginList(GLuint list, GLenum mode);
+        void endList(void);
+        void callList(GLuint list);
+        void deleteList(GLuint list);
+
+        void enableClientState(GLenum array);
+        void disableClientState(GLenum array);
+        void vertexPointer(GLint size, GLenum type, GLsizei stride, const void *pointer);
+        void normalPointer(GLenum type, GLsizei stride, const void *pointer);
+        void texCoordPointer(GLint size, GLenum type, GLsizei stride, const void *pointer);
+        void drawElements(GLenum mode, GLsizei count, GLenum type, const void *indices);
+
+        void pushMatrix(void);
+        void popMatrix(void);
+        void multMatrix(const GLfloat *matrix);
+        void getFloat(GLenum name, GLfloat *values);
+        void getInteger(GLenum name, GLint *values);
+};
+
+#endif
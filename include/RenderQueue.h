@@ -0,0 +1,113 @@
+// RenderQueue.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// RenderQueue
+// Description:
+// Frame render queue shared by all models. Models submit their visible face batches as draw items and every
+// item gets a 64-bit sort key; the keys are radix sorted once per frame and the items drawn in key order from a
+// single loop, which only changes the material, texture or transform when the next item needs a different one.
+// Key layout, from the highest bit down:
+//      opaque:      pass (2) | texture (16) | material (16) | depth (24) | unused (6)
+//      transparent: pass (2) | inverted depth (24) | texture (16) | material (16) | unused (6)
+// Opaque items are grouped by texture and material and drawn front to back within a material, transparent
+// items are drawn back to front across all models. Depth is the distance from the view point to the center
+// of the batch, taken as the top 24 bits of the float, which keep the order of positive floats. Textures and
+// materials get small ids in the order they are first seen in a frame. The ids start again every frame, so
+// materials and textures which were freed or are no longer drawn do not use up the 16 bits of the key.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __RENDERQUEUE_H
+#define __RENDERQUEUE_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+#include <unordered_map>
+#include "Model.h"
+#include "Vector3.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+enum RENDER_PASS {
+    RENDER_PASS_OPAQUE = 0,
+    RENDER_PASS_TRANSPARENT = 1
+};
+
+// Face batch of a model to draw
+struct RenderItem {
+    Model *model;
+    Material *material;
+    const float *transform; // Column major model transform, NULL to draw the model as it is
+    int object;             // Group object of the model
+    int batch;              // Face batch of the group object
+};
+
+// Sort key of an item, 16 bytes
+struct RenderKey {
+    unsigned long long key;
+    int item;
+};
+
+struct RenderQueueStats {
+    int numItems;        // Items submitted this frame
+    int materialChanges; // Materials applied by the last 'draw'
+    int textureChanges;  // Of those, the ones which bound another texture
+    int transformChanges;
+    double sortTime;     // Milliseconds spent in the last 'sort'
+    double drawTime;     // Milliseconds spent in the last 'draw'
+
+    RenderQueueStats() {
+        numItems = 0;
+        materialChanges = 0;
+        textureChanges = 0;
+        transformChanges = 0;
+        sortTime = 0.0;
+        drawTime = 0.0;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class RenderQueue {
+    public:
+        // Constructors and destructors
+        RenderQueue();
+
+        // Public class functions
+        void begin(const Vector3 &in_viewPoint);
+        void add(const RenderItem &item, const Vector3 &center);
+        void sort(void);
+        void draw(void);
+
+        static unsigned long long makeKey(RENDER_PASS pass, float depth, int material, int texture);
+
+        int getNumItems(void) const;
+        const RenderItem &getItem(int index) const;
+        const RenderKey *getKeys(void) const;
+        const RenderQueueStats &getStats(void) const;
+
+    private:
+        // Private class functions
+        int getMaterialId(Material *material);
+        int getTextureId(Texture *texture);
+
+        // Private class members
+        Vector3 viewPoint;
+
+        std::vector<RenderItem> items;
+        std::vector<RenderKey> keys;
+        std::vector<RenderKey> sortBuffer;
+
+        std::unordered_map<Material *, int> materialIds;
+        std::unordered_map<Texture *, int> textureIds;
+
+        RenderQueueStats stats;
+};
+
+#endif
@@ -0,0 +1,123 @@
+// RingBuffer.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// RingBuffer
+// Description:
+// Allocator for geometry written by the CPU every frame, such as particles, decals, debug lines and UI. Data is
+// written into one large vertex buffer used as a ring: every write takes the next free range, and at the end of
+// a frame a fence is placed behind the draws of that frame. A range is only written again after the fence of
+// the frame that last used it has passed, so the CPU never overwrites data the GPU still reads, and waits
+// (stalls) only when the ring is too small for the frames in flight.
+// Three modes are used, the best the context supports:
+//      persistent: OpenGL 4.4 or ARB_buffer_storage with sync objects. The buffer is mapped once, persistent
+//                  and coherent, and writes go straight into it.
+//      orphan:     buffer objects only. Writes go to a copy in system memory and 'commit' uploads them with
+//                  glBufferSubData; when the ring wraps the buffer storage is orphaned instead of fenced.
+//      cpu:        no OpenGL at all, for headless tests and tools. The ring lives in system memory, can be
+//                  drawn from with client side arrays, and fences are simulated to pass a fixed number of
+//                  frames after they were placed, so stalls behave like they would with a GPU.
+// Writes are made with 'begin', which returns the memory to write to, and 'commit', which returns the offset of
+// the data in the buffer; 'getPointer' turns the offset into what gl*Pointer calls expect in every mode.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __RINGBUFFER_H
+#define __RINGBUFFER_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <deque>
+#include <vector>
+#include "GLExtensions.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+enum RING_BUFFER_MODE {
+    RING_BUFFER_PERSISTENT,
+    RING_BUFFER_ORPHAN,
+    RING_BUFFER_CPU
+};
+
+struct RingBufferStats {
+    size_t frameBytes;      // Bytes written in the current frame
+    size_t lastFrameBytes;  // Bytes written in the last finished frame
+    long long totalBytes;   // Bytes written since the buffer was created
+    int frameWrites;        // Writes in the current frame
+    int stalls;             // Waits for a fence which had not passed yet
+    double stallTime;       // Milliseconds spent in those waits
+    int wraps;              // Times the ring went back to the start
+    int failedWrites;       // Writes larger than the free part of the ring
+
+    RingBufferStats() {
+        frameBytes = 0;
+        lastFrameBytes = 0;
+        totalBytes = 0;
+        frameWrites = 0;
+        stalls = 0;
+        stallTime = 0.0;
+        wraps = 0;
+        failedWrites = 0;
+    }
+};
+
+// Fence behind the draws of a frame and the range of the ring the frame wrote
+struct RingFence {
+    void *sync;        // OpenGL sync object, NULL in the cpu mode
+    long long frame;   // Frame the fence was placed in
+    size_t begin;
+    size_t end;        // May be smaller than 'begin' if the frame wrapped around
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class RingBuffer {
+    public:
+        // Constructors and destructors
+        RingBuffer(size_t in_size, int in_framesInFlight = 3, bool headless = false);
+        ~RingBuffer();
+
+        // Public class functions
+        void *begin(size_t bytes, size_t alignment = 16);
+        size_t commit(void);
+        void endFrame(void);
+
+        const void *getPointer(size_t offset) const;
+        GLuint getBuffer(void) const;
+        RING_BUFFER_MODE getMode(void) const;
+        size_t getSize(void) const;
+
+        const RingBufferStats &getStats(void) const;
+        void resetStats(void);
+
+    private:
+        // Private class functions
+        bool overlaps(const RingFence &fence, size_t first, size_t last) const;
+        void waitForFence(RingFence &fence);
+
+        // Private class members
+        RING_BUFFER_MODE mode;
+        size_t size;
+        int framesInFlight;
+
+        GLuint buffer;
+        unsigned char *mapped;          // Persistently mapped buffer, NULL in the other modes
+        std::vector<unsigned char> memory; // System memory copy in the orphan and cpu modes
+
+        size_t head;        // Next free byte
+        size_t frameBegin;  // First byte written in the current frame
+        size_t writeOffset; // Start of the write between 'begin' and 'commit'
+        size_t writeBytes;
+        bool frameWrapped;
+
+        long long frame;
+        std::deque<RingFence> fences;
+
+        RingBufferStats stats;
+};
+
+#endif
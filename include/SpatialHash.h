@@ -0,0 +1,107 @@
+// SpatialHash.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// SpatialHash
+// Description:
+// Broad-phase for dynamic entities such as players, projectiles and pickups. Space is divided into cubic cells
+// and only the cells that are in use are stored, in an open addressing hash table keyed on the integer cell
+// coordinates which points into a flat array of cells. Every
+// entity is listed in all cells its bounding box overlaps. Entities are identified by small non-negative ids,
+// normally their index in the game's entity array, and are inserted, updated and removed in batches; an update
+// only touches the table if the entity moved into a different range of cells. Cells left empty are kept for
+// reuse and only deleted once they make up half of the table, so entities moving back and forth between cells
+// do not allocate every tick.
+// An entity overlapping several cells is only reported once per query, by the first cell shared by the entity
+// and the query. This needs no per query state, so queries can run from several threads at the same time.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __SPATIALHASH_H
+#define __SPATIALHASH_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+#include "Vector3.h"
+#include "BoundingBox.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+
+// Two entities with overlapping bounding boxes, first < second
+struct SpatialPair {
+    int first;
+    int second;
+};
+
+struct SpatialCell {
+    int x, y, z;
+    std::vector<int> entities;
+};
+
+struct SpatialEntity {
+    BoundingBox box;
+    int minCell[3];
+    int maxCell[3];
+    bool active;
+
+    SpatialEntity() {
+        active = false;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class SpatialHash {
+    public:
+        // Constructors and destructors
+        SpatialHash(float in_cellSize = 4.0f);
+
+        // Public class functions
+        void insert(const int *ids, const BoundingBox *boxes, int count);
+        void update(const int *ids, const BoundingBox *boxes, int count);
+        void remove(const int *ids, int count);
+        void clear(void);
+
+        void queryBox(const BoundingBox &box, std::vector<int> &results) const;
+        void querySphere(const Vector3 &center, float radius, std::vector<int> &results) const;
+        void findPairs(std::vector<SpatialPair> &pairs) const;
+
+        bool contains(int id) const;
+        int getNumEntities(void) const;
+        int getNumCells(void) const;
+        float getCellSize(void) const;
+
+    private:
+        // Private class functions
+        void getCellRange(const BoundingBox &box, int *minCell, int *maxCell) const;
+        void addToCells(int id);
+        void removeFromCells(int id);
+        void deleteEmptyCells(void);
+
+        int findCell(int x, int y, int z) const;
+        int getCell(int x, int y, int z);
+        void rebuildTable(int capacity);
+
+        static long long getKey(int x, int y, int z);
+        static unsigned int getHash(long long key);
+
+        // Private class members
+        float cellSize;
+        float inverseCellSize;
+        int numEntities;
+        int numEmptyCells;
+
+        std::vector<SpatialEntity> entities;
+        std::vector<SpatialCell> cells;
+
+        std::vector<long long> tableKeys;
+        std::vector<int> tableCells; // Index into cells, -1 for unused slots
+};
+
+#endif
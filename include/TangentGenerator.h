@@ -0,0 +1,35 @@
+// TangentGenerator.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// TangentGenerator
+// Description:
+// Generates tangent frames for the compiled ranges whose material has a bump map (map_Bump), following the
+// MikkTSpace conventions: per triangle tangent directions are normalized and weighted by the corner angle,
+// orthogonalized against the vertex normal, and the handedness of the bitangent is stored in the w component.
+// Ranges are independent and processed in parallel.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __TANGENTGENERATOR_H
+#define __TANGENTGENERATOR_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+#include "Model.h"
+
+class CompiledMesh;
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class TangentGenerator {
+    public:
+        // Public class functions
+        static void generate(CompiledMesh &mesh, std::vector<Material *> &materials);
+};
+
+#endif
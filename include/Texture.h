@@ -1,6 +1,6 @@
 // Texture.h
 // Created by Edward Glöckner 2023-06-29.
-// Last modified: 2023-08-08.
+// Last modified: 2026-10-17.
 
 // Texture
 // Description:
@@ -38,6 +38,7 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include "MemoryTracker.h"
 
 //*********************************************************************************
 // Globals
@@ -57,7 +58,7 @@ struct TGA_Header {
 //*********************************************************************************
 // Class
 //*********************************************************************************
-class Texture {
+class Texture : public MemoryTracked<MEMORY_TEXTURE> {
     public:
         // Constructors and destructors
         Texture(std::string in_filename, std::string in_name = "");
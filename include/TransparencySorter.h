@@ -0,0 +1,103 @@
+// TransparencySorter.h
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// TransparencySorter
+// Description:
+// Back to front ordering of the transparent faces of a Model. The faces with a material alpha below one are
+// collected once, and every frame they are sorted by the squared distance from the view point to their
+// 'faceCenter', farthest first, and drawn one by one in that order.
+// The sort is a radix sort over the bits of the distances: positive floats compare like their bit patterns,
+// so the inverted bits make a 32-bit key sorted in three passes of 11 bits. When the view point moved less
+// than the incremental distance since the last sort, the order of the last frame is nearly right and an
+// insertion sort fixes it in close to linear time; if it has to move too many faces the radix sort takes over
+// and the distance the insertion sort is tried for is lowered.
+
+//*********************************************************************************
+// Header guard
+//*********************************************************************************
+#ifndef __TRANSPARENCYSORTER_H
+#define __TRANSPARENCYSORTER_H
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <vector>
+#include "Model.h"
+#include "Vector3.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+
+// Sort key of a face, the inverted bits of its squared distance
+struct TransparentKey {
+    unsigned int key;
+    int face;
+};
+
+struct TransparencyStats {
+    int numFaces;          // Transparent faces of the model
+    int numDrawn;          // Faces drawn by the last 'draw'
+    int fullSorts;         // Radix sorts since the last 'build'
+    int incrementalSorts;  // Insertion sorts since the last 'build'
+    int moves;             // Faces moved by the last insertion sort
+    double sortTime;       // Milliseconds spent in the last 'sort'
+
+    TransparencyStats() {
+        numFaces = 0;
+        numDrawn = 0;
+        fullSorts = 0;
+        incrementalSorts = 0;
+        moves = 0;
+        sortTime = 0.0;
+    }
+};
+
+//*********************************************************************************
+// Class
+//*********************************************************************************
+class TransparencySorter {
+    public:
+        // Constructors and destructors
+        TransparencySorter();
+
+        // Public class functions
+        void build(Model &in_model);
+        void clear(void);
+        bool isBuilt(void) const;
+
+        void sort(const Vector3 &viewPoint);
+        void draw(const unsigned char *objectVisible = NULL, const unsigned char *batchVisible = NULL);
+
+        void setIncrementalDistance(float value);
+        const TransparentKey *getOrder(void) const;
+        Face *getFace(int index) const;
+        const TransparencyStats &getStats(void) const;
+
+    private:
+        // Private class functions
+        void computeKeys(const Vector3 &viewPoint);
+        void radixSort(void);
+        bool insertionSort(void);
+
+        // Private class members
+        Model *model;
+        bool built;
+
+        std::vector<Face *> faces;
+        std::vector<int> faceObjects; // Group object of every face
+        std::vector<int> faceBatches; // Face batch of every face, counted over the whole model
+        std::vector<float> centers;   // x, y and z of every face center
+
+        std::vector<TransparentKey> keys; // Sorted order of the last frame
+        std::vector<TransparentKey> sortBuffer;
+
+        Vector3 lastViewPoint;
+        float incrementalDistance;
+        float adaptiveDistance; // Longest move the insertion sort is tried for, lowered when it gives up
+
+        TransparencyStats stats;
+};
+
+#endif
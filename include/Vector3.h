@@ -1,6 +1,6 @@
 // Vector3.h
 // Created by Edward Glöckner 2023-06-29.
-// Last modified: 2023-08-08.
+// Last modified: 2026-10-17.
 
 //*********************************************************************************
 // Header guard
@@ -102,7 +102,7 @@ class Vector3 {
         //      <Vector3>: The scaled vector.
         //
         Vector3 operator*(float num) {
-            return (*this = (*this * num)); 
+            return Vector3(x * num, y * num, z * num);
         }        
          
         // 
@@ -115,7 +115,7 @@ class Vector3 {
         //      <Vector3>: The scaled vector.
         //
         Vector3 operator*=(float num) {
-            return Vector3(x * num , y * num, z * num);
+            return (*this = (*this * num));
         }
          
         // 
@@ -128,7 +128,7 @@ class Vector3 {
         //      <Vector3>: The scaled vector.
         //
         Vector3 operator/(float num) {
-            return (*this = (*this / num)); 
+            return Vector3(x / num, y / num, z / num);
         }        
          
         // 
@@ -141,7 +141,7 @@ class Vector3 {
         //      <Vector3>: The scaled vector.
         //
         Vector3 operator/=(float num) {
-            return Vector3(x / num , y / num, z / num);
+            return (*this = (*this / num));
         }
          
         // 
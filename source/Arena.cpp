@@ -0,0 +1,146 @@
+// Arena.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/Arena.h"
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// Arena
+// Description:
+//      Constructor.
+//      Creates an empty arena, the first block is allocated with the first allocation.
+// Parameters:
+//      in_blockSize <size_t>: Size of the blocks, larger allocations get a block of their own.
+//      in_tag       <MEMORY_TAG>: Subsystem the blocks are counted under.
+// Returns:
+//      None (void).
+//
+Arena::Arena(size_t in_blockSize, MEMORY_TAG in_tag) {
+    blockSize = in_blockSize;
+    tag = in_tag;
+
+    current = NULL;
+    end = NULL;
+    usedBytes = 0;
+    reservedBytes = 0;
+}
+
+//
+// ~Arena
+// Description:
+//      Destructor.
+//      Frees all blocks.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+Arena::~Arena() {
+    clear();
+}
+
+//
+// allocate
+// Description:
+//      Takes memory from the current block, starting a new block when it does not fit.
+// Parameters:
+//      bytes     <size_t>: Size of the memory.
+//      alignment <size_t>: Alignment of the memory, a power of two up to 16.
+// Returns:
+//      <void*>: The memory, valid until 'clear'.
+//
+void *Arena::allocate(size_t bytes, size_t alignment) {
+    unsigned char *memory = (unsigned char *)(((size_t)current + alignment - 1) & ~(alignment - 1));
+
+    if (current == NULL || memory + bytes > end) {
+        size_t size = bytes > blockSize ? bytes : blockSize;
+        unsigned char *block = (unsigned char *)MemoryTracker::allocate(size, tag);
+
+        // An oversized allocation gets its own block, the current block stays the one to fill
+        if (bytes > blockSize && current != NULL) {
+            blocks.insert(blocks.end() - 1, block);
+            reservedBytes += size;
+            usedBytes += bytes;
+            return block;
+        }
+
+        blocks.push_back(block);
+        reservedBytes += size;
+
+        current = block;
+        end = block + size;
+        memory = block;
+    }
+
+    usedBytes += (memory - current) + bytes;
+    current = memory + bytes;
+
+    return memory;
+}
+
+//
+// clear
+// Description:
+//      Frees all blocks, everything allocated from the arena is gone.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void Arena::clear(void) {
+    for (int b = 0; b < (int)blocks.size(); b++)
+        MemoryTracker::deallocate(blocks[b]);
+
+    blocks.clear();
+
+    current = NULL;
+    end = NULL;
+    usedBytes = 0;
+    reservedBytes = 0;
+}
+
+//
+// getUsedBytes
+// Description:
+//      Getter function for the bytes handed out since the last 'clear'.
+// Parameters:
+//      None (void).
+// Returns:
+//      usedBytes <size_t>: The bytes, alignment padding included.
+//
+size_t Arena::getUsedBytes(void) const {
+    return usedBytes;
+}
+
+//
+// getReservedBytes
+// Description:
+//      Getter function for the bytes of the blocks.
+// Parameters:
+//      None (void).
+// Returns:
+//      reservedBytes <size_t>: The bytes.
+//
+size_t Arena::getReservedBytes(void) const {
+    return reservedBytes;
+}
+
+//
+// getNumBlocks
+// Description:
+//      Getter function for the number of blocks.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: The blocks.
+//
+int Arena::getNumBlocks(void) const {
+    return (int)blocks.size();
+}
@@ -0,0 +1,1197 @@
+// BVH.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/BVH.h"
+#include "../include/Parallel.h"
+#include <atomic>
+#include <mutex>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define BVH_PACKET_AVX
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define BVH_PACKET_SSE
+#endif
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int BVH_NUM_BINS = 16;
+static const int BVH_MAX_LEAF_TRIANGLES = 8;
+static const int BVH_MAX_DEPTH = 64;
+static const int BVH_STACK_SIZE = BVH_MAX_DEPTH * 2;
+
+// Nodes with fewer triangles than this are built on a single thread
+static const int BVH_MIN_PARALLEL_TRIANGLES = 16384;
+
+// Relative cost of one node traversal step compared to one triangle test
+static const float BVH_TRAVERSAL_COST = 1.0f;
+
+// Packets smaller than this many rays are traced on the calling thread
+static const int BVH_MIN_PARALLEL_PACKETS = 64;
+
+// SIMD wrappers so the packet traversal is written once for SSE and AVX
+#if defined(BVH_PACKET_AVX)
+    static const int BVH_PACKET_SIZE = 8;
+    typedef __m256 PacketFloat;
+
+    static inline PacketFloat packetSet(float value) { return _mm256_set1_ps(value); }
+    static inline PacketFloat packetLoad(const float *values) { return _mm256_loadu_ps(values); }
+    static inline void packetStore(float *values, PacketFloat a) { _mm256_storeu_ps(values, a); }
+    static inline PacketFloat packetAdd(PacketFloat a, PacketFloat b) { return _mm256_add_ps(a, b); }
+    static inline PacketFloat packetSub(PacketFloat a, PacketFloat b) { return _mm256_sub_ps(a, b); }
+    static inline PacketFloat packetMul(PacketFloat a, PacketFloat b) { return _mm256_mul_ps(a, b); }
+    static inline PacketFloat packetMin(PacketFloat a, PacketFloat b) { return _mm256_min_ps(a, b); }
+    static inline PacketFloat packetMax(PacketFloat a, PacketFloat b) { return _mm256_max_ps(a, b); }
+    static inline PacketFloat packetLess(PacketFloat a, PacketFloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static inline PacketFloat packetLessEqual(PacketFloat a, PacketFloat b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static inline PacketFloat packetAnd(PacketFloat a, PacketFloat b) { return _mm256_and_ps(a, b); }
+    static inline PacketFloat packetOr(PacketFloat a, PacketFloat b) { return _mm256_or_ps(a, b); }
+    static inline PacketFloat packetSelect(PacketFloat mask, PacketFloat a, PacketFloat b) { return _mm256_blendv_ps(b, a, mask); }
+    static inline int packetMask(PacketFloat mask) { return _mm256_movemask_ps(mask); }
+#elif defined(BVH_PACKET_SSE)
+    static const int BVH_PACKET_SIZE = 4;
+    typedef __m128 PacketFloat;
+
+    static inline PacketFloat packetSet(float value) { return _mm_set1_ps(value); }
+    static inline PacketFloat packetLoad(const float *values) { return _mm_loadu_ps(values); }
+    static inline void packetStore(float *values, PacketFloat a) { _mm_storeu_ps(values, a); }
+    static inline PacketFloat packetAdd(PacketFloat a, PacketFloat b) { return _mm_add_ps(a, b); }
+    static inline PacketFloat packetSub(PacketFloat a, PacketFloat b) { return _mm_sub_ps(a, b); }
+    static inline PacketFloat packetMul(PacketFloat a, PacketFloat b) { return _mm_mul_ps(a, b); }
+    static inline PacketFloat packetMin(PacketFloat a, PacketFloat b) { return _mm_min_ps(a, b); }
+    static inline PacketFloat packetMax(PacketFloat a, PacketFloat b) { return _mm_max_ps(a, b); }
+    static inline PacketFloat packetLess(PacketFloat a, PacketFloat b) { return _mm_cmplt_ps(a, b); }
+    static inline PacketFloat packetLessEqual(PacketFloat a, PacketFloat b) { return _mm_cmple_ps(a, b); }
+    static inline PacketFloat packetAnd(PacketFloat a, PacketFloat b) { return _mm_and_ps(a, b); }
+    static inline PacketFloat packetOr(PacketFloat a, PacketFloat b) { return _mm_or_ps(a, b); }
+    static inline PacketFloat packetSelect(PacketFloat mask, PacketFloat a, PacketFloat b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    static inline int packetMask(PacketFloat mask) { return _mm_movemask_ps(mask); }
+#else
+    static const int BVH_PACKET_SIZE = 1;
+#endif
+
+#if defined(BVH_PACKET_AVX) || defined(BVH_PACKET_SSE)
+    // Rays of a packet in structure of arrays layout, one ray per lane
+    struct RayPacket {
+        PacketFloat originX, originY, originZ;
+        PacketFloat directionX, directionY, directionZ;
+        PacketFloat inverseX, inverseY, inverseZ;
+        PacketFloat tMax;
+        int activeMask; // Lanes holding a ray
+    };
+
+    static void loadPacket(const Ray *rays, int count, RayPacket &packet);
+    static PacketFloat packetBoxMask(const BVHNode &node, const RayPacket &packet, PacketFloat tMax);
+    static PacketFloat packetTriangle(const BVHTriangle &triangle, const RayPacket &packet, PacketFloat tMax,
+                                      PacketFloat &t, PacketFloat &u, PacketFloat &v);
+#endif
+
+struct BVHBuildData {
+    std::vector<int> indices;
+    std::vector<BoundingBox> bounds;
+    std::vector<Vector3> centers;
+    std::atomic<int> numNodes;
+    int numThreads;
+};
+
+// Triangle bounds binned along all three axes
+struct BVHBins {
+    BoundingBox bounds[3][BVH_NUM_BINS];
+    int counts[3][BVH_NUM_BINS];
+
+    BVHBins() {
+        for (int axis = 0; axis < 3; axis++) {
+            for (int b = 0; b < BVH_NUM_BINS; b++)
+                counts[axis][b] = 0;
+        }
+    }
+};
+
+static void setTriangle(BVHTriangle &triangle, Face *face, int faceIndex, int corner);
+static BoundingBox getTriangleBounds(Face *face, int corner);
+static int getBin(float value, float minimum, float scale);
+static float rayBoxDistance(const BVHNode &node, const Vector3 &origin, const Vector3 &inverseDirection,
+                            float tMax);
+static bool rayTriangle(const BVHTriangle &triangle, const Ray &ray, float tMax, float &t, float &u, float &v);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// BVH
+// Description:
+//      Constructor.
+//      Creates an empty hierarchy which no ray hits.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+BVH::BVH() {
+    depth = 0;
+}
+
+//
+// build
+// Description:
+//      Builds the hierarchy over all faces of a loaded model, replacing any previous tree.
+//      The faces are referenced by pointer, so the model has to outlive the BVH or be rebuilt.
+//      The work is split over Parallel::getNumThreads() threads.
+// Parameters:
+//      model <Model&>: The model.
+// Returns:
+//      None (void).
+//
+void BVH::build(Model &model) {
+    clear();
+
+    std::vector<GroupObject *> &objects = model.getObjects();
+    std::vector<Face *> faces;
+    std::vector<int> firstTriangle;
+    int numTriangles = 0;
+
+    for (int i = 0; i < (int)objects.size(); i++) {
+        for (int f = 0; f < (int)objects[i]->faces.size(); f++) {
+            Face *face = objects[i]->faces[f];
+
+            faces.push_back(face);
+            firstTriangle.push_back(numTriangles);
+
+            if (face->numVertices > 2)
+                numTriangles += face->numVertices - 2;
+        }
+    }
+
+    if (numTriangles == 0)
+        return;
+
+    BVHBuildData data;
+    data.indices.resize(numTriangles);
+    data.bounds.resize(numTriangles);
+    data.centers.resize(numTriangles);
+    data.numThreads = Parallel::getNumThreads();
+
+    triangles.resize(numTriangles);
+    triangleCorners.resize(numTriangles);
+
+    Parallel::forRange(0, (int)faces.size(), [&](int begin, int end) {
+        for (int f = begin; f < end; f++) {
+            Face *face = faces[f];
+
+            for (int v = 1; v + 1 < face->numVertices; v++) {
+                int t = firstTriangle[f] + v - 1;
+
+                setTriangle(triangles[t], face, f, v);
+                triangleCorners[t] = v;
+
+                data.indices[t] = t;
+                data.bounds[t] = getTriangleBounds(face, v);
+                data.centers[t] = face->faceCenter;
+            }
+        }
+    });
+
+    // A binary tree with at least one triangle per leaf has fewer than twice as many nodes as triangles
+    nodes.resize(numTriangles * 2 - 1);
+    nodes[0].firstChild = 0;
+    nodes[0].numTriangles = numTriangles;
+    data.numNodes = 1;
+
+    depth = subdivide(0, 1, data);
+
+    nodes.resize(data.numNodes);
+
+    // Store the triangles in leaf order
+    std::vector<BVHTriangle> orderedTriangles(numTriangles);
+    std::vector<int> orderedCorners(numTriangles);
+
+    Parallel::forRange(0, numTriangles, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            orderedTriangles[i] = triangles[data.indices[i]];
+            orderedCorners[i] = triangleCorners[data.indices[i]];
+        }
+    }, 4096);
+
+    triangles.swap(orderedTriangles);
+    triangleCorners.swap(orderedCorners);
+}
+
+//
+// refit
+// Description:
+//      Updates the triangles and node bounds after the vertices of the model have been moved,
+//      keeping the structure of the tree. This is linear in the size of the tree, but the tree
+//      gets slower to trace the further the triangles move from where they were when it was built.
+//      The model must still have the same faces as when the BVH was built.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void BVH::refit(void) {
+    Parallel::forRange(0, (int)triangles.size(), [&](int begin, int end) {
+        for (int i = begin; i < end; i++)
+            setTriangle(triangles[i], triangles[i].face, triangles[i].faceIndex, triangleCorners[i]);
+    }, 4096);
+
+    // Children are always stored after their parent, so walking backwards visits them first
+    for (int n = (int)nodes.size() - 1; n >= 0; n--) {
+        BVHNode &node = nodes[n];
+        BoundingBox box;
+
+        if (node.numTriangles > 0) {
+            for (int i = node.firstChild; i < node.firstChild + node.numTriangles; i++)
+                box.expand(getTriangleBounds(triangles[i].face, triangleCorners[i]));
+        }
+        else {
+            for (int c = node.firstChild; c <= node.firstChild + 1; c++) {
+                box.expand(Vector3(nodes[c].min[0], nodes[c].min[1], nodes[c].min[2]));
+                box.expand(Vector3(nodes[c].max[0], nodes[c].max[1], nodes[c].max[2]));
+            }
+        }
+
+        node.min[0] = box.min.x; node.min[1] = box.min.y; node.min[2] = box.min.z;
+        node.max[0] = box.max.x; node.max[1] = box.max.y; node.max[2] = box.max.z;
+    }
+}
+
+//
+// clear
+// Description:
+//      Removes the tree and all triangles.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void BVH::clear(void) {
+    nodes.clear();
+    triangles.clear();
+    triangleCorners.clear();
+    depth = 0;
+}
+
+//
+// intersect
+// Description:
+//      Finds the closest triangle hit by a ray. Children are visited front to back and skipped
+//      once they start behind the closest hit found so far.
+// Parameters:
+//      ray <const Ray&>: The ray, the direction does not have to be normalized.
+//      hit <RayHit&>: Receives the closest hit. Only written if something was hit.
+// Returns:
+//      <bool>: If the ray hit a triangle or not.
+//
+bool BVH::intersect(const Ray &ray, RayHit &hit) const {
+    if (nodes.empty())
+        return false;
+
+    Vector3 inverseDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+
+    float closest = ray.tMax;
+    float closestU = 0.0f, closestV = 0.0f;
+    int closestTriangle = -1;
+
+    int stack[BVH_STACK_SIZE];
+    float stackDistance[BVH_STACK_SIZE];
+    int stackSize = 0;
+
+    if (rayBoxDistance(nodes[0], ray.origin, inverseDirection, closest) == FLT_MAX)
+        return false;
+
+    stack[stackSize] = 0;
+    stackDistance[stackSize++] = 0.0f;
+
+    while (stackSize > 0) {
+        stackSize--;
+
+        if (stackDistance[stackSize] >= closest)
+            continue;
+
+        const BVHNode *node = &nodes[stack[stackSize]];
+
+        for (;;) {
+            if (node->numTriangles > 0) {
+                for (int i = node->firstChild; i < node->firstChild + node->numTriangles; i++) {
+                    float t, u, v;
+
+                    if (rayTriangle(triangles[i], ray, closest, t, u, v)) {
+                        closest = t;
+                        closestU = u;
+                        closestV = v;
+                        closestTriangle = i;
+                    }
+                }
+                break;
+            }
+
+            int near = node->firstChild;
+            int far = node->firstChild + 1;
+
+            float nearDistance = rayBoxDistance(nodes[near], ray.origin, inverseDirection, closest);
+            float farDistance = rayBoxDistance(nodes[far], ray.origin, inverseDirection, closest);
+
+            if (farDistance < nearDistance) {
+                int swapNode = near;
+                near = far;
+                far = swapNode;
+
+                float swapDistance = nearDistance;
+                nearDistance = farDistance;
+                farDistance = swapDistance;
+            }
+
+            if (nearDistance == FLT_MAX)
+                break;
+
+            if (farDistance != FLT_MAX) {
+                stack[stackSize] = far;
+                stackDistance[stackSize++] = farDistance;
+            }
+            node = &nodes[near];
+        }
+    }
+
+    if (closestTriangle < 0)
+        return false;
+
+    hit.t = closest;
+    hit.u = closestU;
+    hit.v = closestV;
+    hit.triangle = closestTriangle;
+    hit.faceIndex = triangles[closestTriangle].faceIndex;
+    hit.face = triangles[closestTriangle].face;
+    return true;
+}
+
+//
+// occluded
+// Description:
+//      Checks if a ray hits any triangle closer than its tMax, returning at the first hit found.
+//      Faster than 'intersect' for line of sight checks where the hit itself is not needed.
+// Parameters:
+//      ray <const Ray&>: The ray.
+// Returns:
+//      <bool>: If anything blocks the ray or not.
+//
+bool BVH::occluded(const Ray &ray) const {
+    if (nodes.empty())
+        return false;
+
+    Vector3 inverseDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+
+    int stack[BVH_STACK_SIZE];
+    int stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const BVHNode &node = nodes[stack[--stackSize]];
+
+        if (rayBoxDistance(node, ray.origin, inverseDirection, ray.tMax) == FLT_MAX)
+            continue;
+
+        if (node.numTriangles > 0) {
+            for (int i = node.firstChild; i < node.firstChild + node.numTriangles; i++) {
+                float t, u, v;
+
+                if (rayTriangle(triangles[i], ray, ray.tMax, t, u, v))
+                    return true;
+            }
+            continue;
+        }
+
+        stack[stackSize++] = node.firstChild + 1;
+        stack[stackSize++] = node.firstChild;
+    }
+    return false;
+}
+
+//
+// queryBox
+// Description:
+//      Finds the triangles whose bounds overlap a box, for example the candidates for a collision test.
+// Parameters:
+//      box     <const BoundingBox&>: The box.
+//      results <std::vector<int>&>: Indices into 'triangles' are appended to this.
+// Returns:
+//      None (void).
+//
+void BVH::queryBox(const BoundingBox &box, std::vector<int> &results) const {
+    if (nodes.empty())
+        return;
+
+    int stack[BVH_STACK_SIZE];
+    int stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const BVHNode &node = nodes[stack[--stackSize]];
+
+        if (node.min[0] > box.max.x || node.max[0] < box.min.x ||
+            node.min[1] > box.max.y || node.max[1] < box.min.y ||
+            node.min[2] > box.max.z || node.max[2] < box.min.z)
+            continue;
+
+        if (node.numTriangles > 0) {
+            for (int i = node.firstChild; i < node.firstChild + node.numTriangles; i++) {
+                BoundingBox triangleBounds = getTriangleBounds(triangles[i].face, triangleCorners[i]);
+
+                if (triangleBounds.min.x <= box.max.x && triangleBounds.max.x >= box.min.x &&
+                    triangleBounds.min.y <= box.max.y && triangleBounds.max.y >= box.min.y &&
+                    triangleBounds.min.z <= box.max.z && triangleBounds.max.z >= box.min.z)
+                    results.push_back(i);
+            }
+            continue;
+        }
+
+        stack[stackSize++] = node.firstChild + 1;
+        stack[stackSize++] = node.firstChild;
+    }
+}
+
+//
+// intersectRays
+// Description:
+//      Finds the closest hit of every ray in an array. Consecutive rays are traced together as
+//      packets, so rays which start close to each other and point in similar directions should be
+//      stored next to each other. Large batches are split over several threads.
+// Parameters:
+//      rays  <const Ray*>: The rays.
+//      hits  <RayHit*>: Receives the closest hit of every ray, a default RayHit for rays that miss.
+//      count <int>: Number of rays.
+// Returns:
+//      None (void).
+//
+void BVH::intersectRays(const Ray *rays, RayHit *hits, int count) const {
+    int numPackets = (count + BVH_PACKET_SIZE - 1) / BVH_PACKET_SIZE;
+
+    Parallel::forRange(0, numPackets, [&](int begin, int end) {
+        for (int p = begin; p < end; p++) {
+            int first = p * BVH_PACKET_SIZE;
+            int size = count - first < BVH_PACKET_SIZE ? count - first : BVH_PACKET_SIZE;
+
+            intersectPacket(rays + first, hits + first, size);
+        }
+    }, BVH_MIN_PARALLEL_PACKETS);
+}
+
+//
+// occludedRays
+// Description:
+//      Checks if each ray of an array hits anything closer than its tMax, see 'intersectRays' for how
+//      the rays are grouped.
+// Parameters:
+//      rays    <const Ray*>: The rays.
+//      results <unsigned char*>: Receives 1 for every blocked ray and 0 otherwise.
+//      count   <int>: Number of rays.
+// Returns:
+//      None (void).
+//
+void BVH::occludedRays(const Ray *rays, unsigned char *results, int count) const {
+    int numPackets = (count + BVH_PACKET_SIZE - 1) / BVH_PACKET_SIZE;
+
+    Parallel::forRange(0, numPackets, [&](int begin, int end) {
+        for (int p = begin; p < end; p++) {
+            int first = p * BVH_PACKET_SIZE;
+            int size = count - first < BVH_PACKET_SIZE ? count - first : BVH_PACKET_SIZE;
+
+            occludedPacket(rays + first, results + first, size);
+        }
+    }, BVH_MIN_PARALLEL_PACKETS);
+}
+
+//
+// getDepth
+// Description:
+//      Getter function for the depth of the tree.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: Number of levels, 0 for an empty tree.
+//
+int BVH::getDepth(void) const {
+    return depth;
+}
+
+//
+// getBounds
+// Description:
+//      Getter function for the bounding box of all triangles.
+// Parameters:
+//      None (void).
+// Returns:
+//      <BoundingBox>: The bounds of the root node, empty for an empty tree.
+//
+BoundingBox BVH::getBounds(void) const {
+    if (nodes.empty())
+        return BoundingBox();
+
+    return BoundingBox(Vector3(nodes[0].min[0], nodes[0].min[1], nodes[0].min[2]),
+                       Vector3(nodes[0].max[0], nodes[0].max[1], nodes[0].max[2]));
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// subdivide
+// Description:
+//      Computes the bounds of a node and splits it in two if the surface area heuristic says that
+//      it is cheaper than testing all of its triangles. The triangle centers are sorted into
+//      BVH_NUM_BINS bins along every axis and every bin boundary is evaluated as a split plane.
+//      Near the root, where there are fewer subtrees than threads, the binning of large nodes is
+//      shared by the idle threads and the two children are built in parallel.
+//      This function is recursive.
+// Parameters:
+//      nodeIndex <int>: The node, its firstChild and numTriangles give the triangle range.
+//      level     <int>: Level of the node, the root is at level 1.
+//      data      <BVHBuildData&>: Triangle data and node allocation shared by all tasks.
+// Returns:
+//      <int>: The deepest level below the node.
+//
+int BVH::subdivide(int nodeIndex, int level, BVHBuildData &data) {
+    int first = nodes[nodeIndex].firstChild;
+    int count = nodes[nodeIndex].numTriangles;
+
+    // Threads available to this subtree, assuming the levels above were split evenly
+    int available = level < 31 ? data.numThreads >> (level - 1) : 0;
+    bool parallel = available >= 2 && count >= BVH_MIN_PARALLEL_TRIANGLES;
+    int minRange = parallel ? (count + available - 1) / available : count;
+
+    std::mutex mutex;
+    BoundingBox nodeBounds;
+    BoundingBox centerBounds;
+
+    Parallel::forRange(first, first + count, [&](int begin, int end) {
+        BoundingBox rangeBounds;
+        BoundingBox rangeCenters;
+
+        for (int i = begin; i < end; i++) {
+            rangeBounds.expand(data.bounds[data.indices[i]]);
+            rangeCenters.expand(data.centers[data.indices[i]]);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        nodeBounds.expand(rangeBounds);
+        centerBounds.expand(rangeCenters);
+    }, minRange);
+
+    BVHNode &node = nodes[nodeIndex];
+    node.min[0] = nodeBounds.min.x; node.min[1] = nodeBounds.min.y; node.min[2] = nodeBounds.min.z;
+    node.max[0] = nodeBounds.max.x; node.max[1] = nodeBounds.max.y; node.max[2] = nodeBounds.max.z;
+
+    if (count <= 1 || level >= BVH_MAX_DEPTH)
+        return level;
+
+    float centerMin[3] = {centerBounds.min.x, centerBounds.min.y, centerBounds.min.z};
+    float centerMax[3] = {centerBounds.max.x, centerBounds.max.y, centerBounds.max.z};
+    float scale[3];
+
+    for (int axis = 0; axis < 3; axis++) {
+        float extent = centerMax[axis] - centerMin[axis];
+        scale[axis] = extent > 0.0f ? BVH_NUM_BINS / extent : 0.0f;
+    }
+
+    BVHBins bins;
+
+    Parallel::forRange(first, first + count, [&](int begin, int end) {
+        BVHBins rangeBins;
+
+        for (int i = begin; i < end; i++) {
+            const Vector3 &center = data.centers[data.indices[i]];
+            const BoundingBox &box = data.bounds[data.indices[i]];
+
+            int x = getBin(center.x, centerMin[0], scale[0]);
+            int y = getBin(center.y, centerMin[1], scale[1]);
+            int z = getBin(center.z, centerMin[2], scale[2]);
+
+            rangeBins.bounds[0][x].expand(box); rangeBins.counts[0][x]++;
+            rangeBins.bounds[1][y].expand(box); rangeBins.counts[1][y]++;
+            rangeBins.bounds[2][z].expand(box); rangeBins.counts[2][z]++;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (int axis = 0; axis < 3; axis++) {
+            for (int b = 0; b < BVH_NUM_BINS; b++) {
+                bins.bounds[axis][b].expand(rangeBins.bounds[axis][b]);
+                bins.counts[axis][b] += rangeBins.counts[axis][b];
+            }
+        }
+    }, minRange);
+
+    float bestCost = FLT_MAX;
+    int bestAxis = -1;
+    int bestSplit = 0;
+
+    for (int axis = 0; axis < 3; axis++) {
+        if (scale[axis] == 0.0f)
+            continue;
+
+        // Sweep from the right to get the cost of the right side of every split
+        float rightCost[BVH_NUM_BINS];
+        BoundingBox rightBounds;
+        int rightCount = 0;
+
+        for (int b = BVH_NUM_BINS - 1; b > 0; b--) {
+            rightBounds.expand(bins.bounds[axis][b]);
+            rightCount += bins.counts[axis][b];
+            rightCost[b] = rightBounds.getSurfaceArea() * rightCount;
+        }
+
+        BoundingBox leftBounds;
+        int leftCount = 0;
+
+        for (int b = 0; b < BVH_NUM_BINS - 1; b++) {
+            leftBounds.expand(bins.bounds[axis][b]);
+            leftCount += bins.counts[axis][b];
+
+            if (leftCount == 0 || leftCount == count)
+                continue;
+
+            float cost = leftBounds.getSurfaceArea() * leftCount + rightCost[b + 1];
+
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = b + 1;
+            }
+        }
+    }
+
+    int leftCount = 0;
+
+    if (bestAxis >= 0) {
+        float area = nodeBounds.getSurfaceArea();
+        float splitCost = BVH_TRAVERSAL_COST + (area > 0.0f ? bestCost / area : 0.0f);
+
+        if (splitCost >= (float)count && count <= BVH_MAX_LEAF_TRIANGLES)
+            return level;
+
+        int left = first;
+        int right = first + count - 1;
+
+        while (left <= right) {
+            const Vector3 &center = data.centers[data.indices[left]];
+            float value = bestAxis == 0 ? center.x : (bestAxis == 1 ? center.y : center.z);
+
+            if (getBin(value, centerMin[bestAxis], scale[bestAxis]) < bestSplit) {
+                left++;
+            }
+            else {
+                int swap = data.indices[left];
+                data.indices[left] = data.indices[right];
+                data.indices[right--] = swap;
+            }
+        }
+        leftCount = left - first;
+    }
+    else {
+        // All centers are in the same place, only split ranges that are too big for a leaf
+        if (count <= BVH_MAX_LEAF_TRIANGLES)
+            return level;
+
+        leftCount = count / 2;
+    }
+
+    int childIndex = data.numNodes.fetch_add(2);
+
+    nodes[childIndex].firstChild = first;
+    nodes[childIndex].numTriangles = leftCount;
+    nodes[childIndex + 1].firstChild = first + leftCount;
+    nodes[childIndex + 1].numTriangles = count - leftCount;
+
+    nodes[nodeIndex].firstChild = childIndex;
+    nodes[nodeIndex].numTriangles = 0;
+
+    int childDepth[2];
+
+    Parallel::forRange(0, 2, [&](int begin, int end) {
+        for (int c = begin; c < end; c++)
+            childDepth[c] = subdivide(childIndex + c, level + 1, data);
+    }, parallel ? 1 : 2);
+
+    return childDepth[0] > childDepth[1] ? childDepth[0] : childDepth[1];
+}
+
+//
+// intersectPacket
+// Description:
+//      Traces up to BVH_PACKET_SIZE rays together through the tree. A node is visited if any ray of
+//      the packet hits it, and its children are visited in the order seen by the first ray.
+//      Without SIMD support every ray is traced on its own.
+// Parameters:
+//      rays  <const Ray*>: The rays.
+//      hits  <RayHit*>: Receives the closest hit of every ray.
+//      count <int>: Number of rays, at most BVH_PACKET_SIZE.
+// Returns:
+//      None (void).
+//
+void BVH::intersectPacket(const Ray *rays, RayHit *hits, int count) const {
+#if defined(BVH_PACKET_AVX) || defined(BVH_PACKET_SSE)
+    for (int r = 0; r < count; r++)
+        hits[r] = RayHit();
+
+    if (nodes.empty())
+        return;
+
+    RayPacket packet;
+    loadPacket(rays, count, packet);
+
+    PacketFloat closest = packet.tMax;
+    PacketFloat closestU = packetSet(0.0f);
+    PacketFloat closestV = packetSet(0.0f);
+    int closestTriangle[BVH_PACKET_SIZE];
+
+    for (int r = 0; r < BVH_PACKET_SIZE; r++)
+        closestTriangle[r] = -1;
+
+    const Vector3 &origin = rays[0].origin;
+    const Vector3 &direction = rays[0].direction;
+
+    int stack[BVH_STACK_SIZE];
+    int stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const BVHNode &node = nodes[stack[--stackSize]];
+
+        if (packetMask(packetBoxMask(node, packet, closest)) == 0)
+            continue;
+
+        if (node.numTriangles > 0) {
+            for (int i = node.firstChild; i < node.firstChild + node.numTriangles; i++) {
+                PacketFloat t, u, v;
+                PacketFloat hit = packetTriangle(triangles[i], packet, closest, t, u, v);
+                int mask = packetMask(hit);
+
+                if (mask == 0)
+                    continue;
+
+                closest = packetSelect(hit, t, closest);
+                closestU = packetSelect(hit, u, closestU);
+                closestV = packetSelect(hit, v, closestV);
+
+                for (int r = 0; r < BVH_PACKET_SIZE; r++) {
+                    if (mask & (1 << r))
+                        closestTriangle[r] = i;
+                }
+            }
+            continue;
+        }
+
+        // Visit the child whose center is closest along the first ray first
+        const BVHNode &left = nodes[node.firstChild];
+        const BVHNode &right = nodes[node.firstChild + 1];
+
+        float leftDistance = (left.min[0] + left.max[0] - 2.0f * origin.x) * direction.x +
+                             (left.min[1] + left.max[1] - 2.0f * origin.y) * direction.y +
+                             (left.min[2] + left.max[2] - 2.0f * origin.z) * direction.z;
+        float rightDistance = (right.min[0] + right.max[0] - 2.0f * origin.x) * direction.x +
+                              (right.min[1] + right.max[1] - 2.0f * origin.y) * direction.y +
+                              (right.min[2] + right.max[2] - 2.0f * origin.z) * direction.z;
+
+        if (leftDistance < rightDistance) {
+            stack[stackSize++] = node.firstChild + 1;
+            stack[stackSize++] = node.firstChild;
+        }
+        else {
+            stack[stackSize++] = node.firstChild;
+            stack[stackSize++] = node.firstChild + 1;
+        }
+    }
+
+    float t[BVH_PACKET_SIZE], u[BVH_PACKET_SIZE], v[BVH_PACKET_SIZE];
+    packetStore(t, closest);
+    packetStore(u, closestU);
+    packetStore(v, closestV);
+
+    for (int r = 0; r < count; r++) {
+        int triangle = closestTriangle[r];
+
+        if (triangle < 0)
+            continue;
+
+        hits[r].t = t[r];
+        hits[r].u = u[r];
+        hits[r].v = v[r];
+        hits[r].triangle = triangle;
+        hits[r].faceIndex = triangles[triangle].faceIndex;
+        hits[r].face = triangles[triangle].face;
+    }
+#else
+    for (int r = 0; r < count; r++) {
+        hits[r] = RayHit();
+        intersect(rays[r], hits[r]);
+    }
+#endif
+}
+
+//
+// occludedPacket
+// Description:
+//      Checks up to BVH_PACKET_SIZE rays together for any hit. Rays drop out of the packet as soon
+//      as they are blocked, and the traversal stops when every ray is blocked.
+//      Without SIMD support every ray is traced on its own.
+// Parameters:
+//      rays    <const Ray*>: The rays.
+//      results <unsigned char*>: Receives 1 for every blocked ray and 0 otherwise.
+//      count   <int>: Number of rays, at most BVH_PACKET_SIZE.
+// Returns:
+//      None (void).
+//
+void BVH::occludedPacket(const Ray *rays, unsigned char *results, int count) const {
+#if defined(BVH_PACKET_AVX) || defined(BVH_PACKET_SSE)
+    for (int r = 0; r < count; r++)
+        results[r] = 0;
+
+    if (nodes.empty())
+        return;
+
+    RayPacket packet;
+    loadPacket(rays, count, packet);
+
+    // Blocked rays get a negative tMax so that they miss every node and triangle
+    PacketFloat tMax = packet.tMax;
+    int blockedMask = 0;
+
+    int stack[BVH_STACK_SIZE];
+    int stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const BVHNode &node = nodes[stack[--stackSize]];
+
+        if (packetMask(packetBoxMask(node, packet, tMax)) == 0)
+            continue;
+
+        if (node.numTriangles > 0) {
+            for (int i = node.firstChild; i < node.firstChild + node.numTriangles; i++) {
+                PacketFloat t, u, v;
+                PacketFloat hit = packetTriangle(triangles[i], packet, tMax, t, u, v);
+
+                blockedMask |= packetMask(hit);
+                tMax = packetSelect(hit, packetSet(-1.0f), tMax);
+            }
+
+            if (blockedMask == packet.activeMask)
+                break;
+
+            continue;
+        }
+
+        stack[stackSize++] = node.firstChild + 1;
+        stack[stackSize++] = node.firstChild;
+    }
+
+    for (int r = 0; r < count; r++)
+        results[r] = (unsigned char)((blockedMask >> r) & 1);
+#else
+    for (int r = 0; r < count; r++)
+        results[r] = occluded(rays[r]) ? 1 : 0;
+#endif
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// setTriangle
+// Description:
+//      Sets up one fan triangle of a face for intersection tests.
+// Parameters:
+//      triangle  <BVHTriangle&>: Receives the triangle.
+//      face      <Face*>: The face.
+//      faceIndex <int>: Index of the face counted over all group objects.
+//      corner    <int>: The triangle is made of face corners 0, corner and corner + 1.
+// Returns:
+//      None (void).
+//
+static void setTriangle(BVHTriangle &triangle, Face *face, int faceIndex, int corner) {
+    Vector3 &vertex0 = *face->vertices[0];
+
+    triangle.vertex0 = vertex0;
+    triangle.edge1 = *face->vertices[corner] - vertex0;
+    triangle.edge2 = *face->vertices[corner + 1] - vertex0;
+    triangle.faceIndex = faceIndex;
+    triangle.face = face;
+}
+
+//
+// getTriangleBounds
+// Description:
+//      Calculates the bounding box of one fan triangle of a face.
+// Parameters:
+//      face   <Face*>: The face.
+//      corner <int>: The triangle is made of face corners 0, corner and corner + 1.
+// Returns:
+//      <BoundingBox>: The bounds.
+//
+static BoundingBox getTriangleBounds(Face *face, int corner) {
+    BoundingBox box;
+
+    box.expand(*face->vertices[0]);
+    box.expand(*face->vertices[corner]);
+    box.expand(*face->vertices[corner + 1]);
+
+    return box;
+}
+
+//
+// getBin
+// Description:
+//      Finds the bin of a triangle center along one axis.
+// Parameters:
+//      value   <float>: Center of the triangle along the axis.
+//      minimum <float>: Smallest center of the node along the axis.
+//      scale   <float>: Number of bins divided by the extent of the centers along the axis.
+// Returns:
+//      <int>: The bin, 0 to BVH_NUM_BINS - 1.
+//
+static int getBin(float value, float minimum, float scale) {
+    int bin = (int)((value - minimum) * scale);
+    return bin < BVH_NUM_BINS ? bin : BVH_NUM_BINS - 1;
+}
+
+//
+// rayBoxDistance
+// Description:
+//      Slab test of a ray against the bounds of a node.
+// Parameters:
+//      node             <const BVHNode&>: The node.
+//      origin           <const Vector3&>: Origin of the ray.
+//      inverseDirection <const Vector3&>: One divided by every component of the ray direction.
+//      tMax             <float>: Boxes starting after this distance are missed.
+// Returns:
+//      <float>: Distance to where the ray enters the box (0 if it starts inside), FLT_MAX if missed.
+//
+static float rayBoxDistance(const BVHNode &node, const Vector3 &origin, const Vector3 &inverseDirection,
+                            float tMax) {
+    float x0 = (node.min[0] - origin.x) * inverseDirection.x;
+    float x1 = (node.max[0] - origin.x) * inverseDirection.x;
+    float y0 = (node.min[1] - origin.y) * inverseDirection.y;
+    float y1 = (node.max[1] - origin.y) * inverseDirection.y;
+    float z0 = (node.min[2] - origin.z) * inverseDirection.z;
+    float z1 = (node.max[2] - origin.z) * inverseDirection.z;
+
+    float tNear = x0 < x1 ? x0 : x1;
+    float tFar = x0 < x1 ? x1 : x0;
+
+    float yNear = y0 < y1 ? y0 : y1;
+    float yFar = y0 < y1 ? y1 : y0;
+    tNear = yNear > tNear ? yNear : tNear;
+    tFar = yFar < tFar ? yFar : tFar;
+
+    float zNear = z0 < z1 ? z0 : z1;
+    float zFar = z0 < z1 ? z1 : z0;
+    tNear = zNear > tNear ? zNear : tNear;
+    tFar = zFar < tFar ? zFar : tFar;
+
+    tNear = tNear > 0.0f ? tNear : 0.0f;
+
+    if (tNear > tFar || tNear >= tMax)
+        return FLT_MAX;
+
+    return tNear;
+}
+
+//
+// rayTriangle
+// Description:
+//      Möller-Trumbore ray triangle intersection. Both sides of the triangle are hit.
+// Parameters:
+//      triangle <const BVHTriangle&>: The triangle.
+//      ray      <const Ray&>: The ray.
+//      tMax     <float>: Only hits closer than this are reported.
+//      t        <float&>: Receives the distance along the ray.
+//      u        <float&>: Receives the barycentric coordinate of the second vertex.
+//      v        <float&>: Receives the barycentric coordinate of the third vertex.
+// Returns:
+//      <bool>: If the triangle is hit in front of the origin and closer than tMax.
+//
+static bool rayTriangle(const BVHTriangle &triangle, const Ray &ray, float tMax, float &t, float &u, float &v) {
+    const Vector3 &d = ray.direction;
+    const Vector3 &e1 = triangle.edge1;
+    const Vector3 &e2 = triangle.edge2;
+
+    // p = d x e2
+    float px = d.y * e2.z - d.z * e2.y;
+    float py = d.z * e2.x - d.x * e2.z;
+    float pz = d.x * e2.y - d.y * e2.x;
+
+    float determinant = e1.x * px + e1.y * py + e1.z * pz;
+
+    if (determinant > -1e-12f && determinant < 1e-12f)
+        return false;
+
+    float inverseDeterminant = 1.0f / determinant;
+
+    float sx = ray.origin.x - triangle.vertex0.x;
+    float sy = ray.origin.y - triangle.vertex0.y;
+    float sz = ray.origin.z - triangle.vertex0.z;
+
+    u = (sx * px + sy * py + sz * pz) * inverseDeterminant;
+
+    if (u < 0.0f || u > 1.0f)
+        return false;
+
+    // q = s x e1
+    float qx = sy * e1.z - sz * e1.y;
+    float qy = sz * e1.x - sx * e1.z;
+    float qz = sx * e1.y - sy * e1.x;
+
+    v = (d.x * qx + d.y * qy + d.z * qz) * inverseDeterminant;
+
+    if (v < 0.0f || u + v > 1.0f)
+        return false;
+
+    t = (e2.x * qx + e2.y * qy + e2.z * qz) * inverseDeterminant;
+
+    return t > 0.0f && t < tMax;
+}
+
+#if defined(BVH_PACKET_AVX) || defined(BVH_PACKET_SSE)
+//
+// loadPacket
+// Description:
+//      Transposes rays into a packet. Lanes without a ray get a negative tMax so they never hit.
+// Parameters:
+//      rays   <const Ray*>: The rays.
+//      count  <int>: Number of rays, at most BVH_PACKET_SIZE.
+//      packet <RayPacket&>: Receives the rays.
+// Returns:
+//      None (void).
+//
+static void loadPacket(const Ray *rays, int count, RayPacket &packet) {
+    float values[10][BVH_PACKET_SIZE];
+
+    for (int r = 0; r < BVH_PACKET_SIZE; r++) {
+        const Ray &ray = rays[r < count ? r : 0];
+
+        values[0][r] = ray.origin.x;
+        values[1][r] = ray.origin.y;
+        values[2][r] = ray.origin.z;
+        values[3][r] = ray.direction.x;
+        values[4][r] = ray.direction.y;
+        values[5][r] = ray.direction.z;
+        values[6][r] = 1.0f / ray.direction.x;
+        values[7][r] = 1.0f / ray.direction.y;
+        values[8][r] = 1.0f / ray.direction.z;
+        values[9][r] = r < count ? ray.tMax : -1.0f;
+    }
+
+    packet.originX = packetLoad(values[0]);
+    packet.originY = packetLoad(values[1]);
+    packet.originZ = packetLoad(values[2]);
+    packet.directionX = packetLoad(values[3]);
+    packet.directionY = packetLoad(values[4]);
+    packet.directionZ = packetLoad(values[5]);
+    packet.inverseX = packetLoad(values[6]);
+    packet.inverseY = packetLoad(values[7]);
+    packet.inverseZ = packetLoad(values[8]);
+    packet.tMax = packetLoad(values[9]);
+    packet.activeMask = (1 << count) - 1;
+}
+
+//
+// packetBoxMask
+// Description:
+//      Slab test of every ray of a packet against the bounds of a node.
+// Parameters:
+//      node   <const BVHNode&>: The node.
+//      packet <const RayPacket&>: The rays.
+//      tMax   <PacketFloat>: Per ray, boxes starting after this distance are missed.
+// Returns:
+//      <PacketFloat>: Lane mask of the rays which hit the box.
+//
+static PacketFloat packetBoxMask(const BVHNode &node, const RayPacket &packet, PacketFloat tMax) {
+    PacketFloat x0 = packetMul(packetSub(packetSet(node.min[0]), packet.originX), packet.inverseX);
+    PacketFloat x1 = packetMul(packetSub(packetSet(node.max[0]), packet.originX), packet.inverseX);
+    PacketFloat y0 = packetMul(packetSub(packetSet(node.min[1]), packet.originY), packet.inverseY);
+    PacketFloat y1 = packetMul(packetSub(packetSet(node.max[1]), packet.originY), packet.inverseY);
+    PacketFloat z0 = packetMul(packetSub(packetSet(node.min[2]), packet.originZ), packet.inverseZ);
+    PacketFloat z1 = packetMul(packetSub(packetSet(node.max[2]), packet.originZ), packet.inverseZ);
+
+    PacketFloat tNear = packetMax(packetMax(packetMin(x0, x1), packetMin(y0, y1)),
+                                  packetMax(packetMin(z0, z1), packetSet(0.0f)));
+    PacketFloat tFar = packetMin(packetMin(packetMax(x0, x1), packetMax(y0, y1)), packetMax(z0, z1));
+
+    return packetAnd(packetLessEqual(tNear, tFar), packetLess(tNear, tMax));
+}
+
+//
+// packetTriangle
+// Description:
+//      Möller-Trumbore intersection of every ray of a packet with one triangle.
+// Parameters:
+//      triangle <const BVHTriangle&>: The triangle.
+//      packet   <const RayPacket&>: The rays.
+//      tMax     <PacketFloat>: Per ray, only hits closer than this are reported.
+//      t        <PacketFloat&>: Receives the distance along every ray.
+//      u        <PacketFloat&>: Receives the barycentric coordinate of the second vertex.
+//      v        <PacketFloat&>: Receives the barycentric coordinate of the third vertex.
+// Returns:
+//      <PacketFloat>: Lane mask of the rays which hit the triangle.
+//
+static PacketFloat packetTriangle(const BVHTriangle &triangle, const RayPacket &packet, PacketFloat tMax,
+                                  PacketFloat &t, PacketFloat &u, PacketFloat &v) {
+    PacketFloat e1x = packetSet(triangle.edge1.x), e1y = packetSet(triangle.edge1.y), e1z = packetSet(triangle.edge1.z);
+    PacketFloat e2x = packetSet(triangle.edge2.x), e2y = packetSet(triangle.edge2.y), e2z = packetSet(triangle.edge2.z);
+
+    // p = d x e2
+    PacketFloat px = packetSub(packetMul(packet.directionY, e2z), packetMul(packet.directionZ, e2y));
+    PacketFloat py = packetSub(packetMul(packet.directionZ, e2x), packetMul(packet.directionX, e2z));
+    PacketFloat pz = packetSub(packetMul(packet.directionX, e2y), packetMul(packet.directionY, e2x));
+
+    PacketFloat determinant = packetAdd(packetAdd(packetMul(e1x, px), packetMul(e1y, py)), packetMul(e1z, pz));
+    PacketFloat valid = packetOr(packetLess(determinant, packetSet(-1e-12f)),
+                                 packetLess(packetSet(1e-12f), determinant));
+
+    // Parallel lanes divide by one instead of zero
+    PacketFloat inverseDeterminant = packetSelect(valid, determinant, packetSet(1.0f));
+#if defined(BVH_PACKET_AVX)
+    inverseDeterminant = _mm256_div_ps(packetSet(1.0f), inverseDeterminant);
+#else
+    inverseDeterminant = _mm_div_ps(packetSet(1.0f), inverseDeterminant);
+#endif
+
+    PacketFloat sx = packetSub(packet.originX, packetSet(triangle.vertex0.x));
+    PacketFloat sy = packetSub(packet.originY, packetSet(triangle.vertex0.y));
+    PacketFloat sz = packetSub(packet.originZ, packetSet(triangle.vertex0.z));
+
+    u = packetMul(packetAdd(packetAdd(packetMul(sx, px), packetMul(sy, py)), packetMul(sz, pz)), inverseDeterminant);
+
+    // q = s x e1
+    PacketFloat qx = packetSub(packetMul(sy, e1z), packetMul(sz, e1y));
+    PacketFloat qy = packetSub(packetMul(sz, e1x), packetMul(sx, e1z));
+    PacketFloat qz = packetSub(packetMul(sx, e1y), packetMul(sy, e1x));
+
+    v = packetMul(packetAdd(packetAdd(packetMul(packet.directionX, qx), packetMul(packet.directionY, qy)),
+                            packetMul(packet.directionZ, qz)), inverseDeterminant);
+    t = packetMul(packetAdd(packetAdd(packetMul(e2x, qx), packetMul(e2y, qy)), packetMul(e2z, qz)), inverseDeterminant);
+
+    PacketFloat zero = packetSet(0.0f);
+    PacketFloat one = packetSet(1.0f);
+
+    valid = packetAnd(valid, packetLessEqual(zero, u));
+    valid = packetAnd(valid, packetLessEqual(zero, v));
+    valid = packetAnd(valid, packetLessEqual(packetAdd(u, v), one));
+    valid = packetAnd(valid, packetLess(zero, t));
+    valid = packetAnd(valid, packetLess(t, tMax));
+
+    return valid;
+}
+#endif
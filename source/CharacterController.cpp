@@ -0,0 +1,655 @@
+// CharacterController.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/CharacterController.h"
+#include <math.h>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int CHARACTER_MAX_ITERATIONS = 32;  // Newton steps per triangle
+static const int CHARACTER_MAX_SLIDES = 4;       // Sweeps per move
+static const float CHARACTER_CONTACT_TOLERANCE = 1e-4f;
+static const float CHARACTER_MIN_MOVE = 1e-5f;
+static const float CHARACTER_EDGE_COSINE = 0.999f; // Contact normals further from the face normal touch an edge
+static const float CHARACTER_SAME_CONTACT = 1e-3f; // Contacts closer than this are on the same edge or corner
+
+static Vector3 add(const Vector3 &a, const Vector3 &b);
+static Vector3 sub(const Vector3 &a, const Vector3 &b);
+static Vector3 scale(const Vector3 &a, float value);
+static float dot(const Vector3 &a, const Vector3 &b);
+static Vector3 cross(const Vector3 &a, const Vector3 &b);
+static void translate(Capsule &capsule, const Vector3 &offset);
+static Vector3 closestPointTriangle(const Vector3 &p, const Vector3 &a, const Vector3 &b, const Vector3 &c,
+                                   bool &onFace);
+static float closestSegmentSegment(const Vector3 &p1, const Vector3 &q1, const Vector3 &p2, const Vector3 &q2,
+                                   Vector3 &closest1, Vector3 &closest2);
+static float closestSegmentTriangle(const Vector3 &p, const Vector3 &q, const Vector3 &a, const Vector3 &b,
+                                    const Vector3 &c, Vector3 &onSegment, Vector3 &onTriangle, bool &onFace);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// CharacterController
+// Description:
+//      Constructor.
+//      Creates a controller moving against the triangles of a BVH. By default steps up to 0.3 units
+//      are climbed, slopes up to 45 degrees are walkable and 0.01 units are kept from surfaces.
+// Parameters:
+//      in_bvh <const BVH&>: The level geometry, it has to outlive the controller.
+// Returns:
+//      None (void).
+//
+CharacterController::CharacterController(const BVH &in_bvh) : bvh(in_bvh) {
+    stepHeight = 0.3f;
+    minGroundNormal = cosf(45.0f * 3.14159265f / 180.0f);
+    skinWidth = 0.01f;
+}
+
+//
+// sweepCapsule
+// Description:
+//      Moves a capsule along a displacement and finds the first triangle it touches.
+// Parameters:
+//      capsule      <const Capsule&>: The capsule at the start of the move.
+//      displacement <const Vector3&>: The move.
+//      hit          <CapsuleHit&>: Receives the first contact. Only written if there is one.
+// Returns:
+//      <bool>: If the capsule touches a triangle before the end of the move.
+//
+bool CharacterController::sweepCapsule(const Capsule &capsule, const Vector3 &displacement, CapsuleHit &hit) const {
+    BoundingBox sweptBounds;
+    sweptBounds.expand(capsule.point0);
+    sweptBounds.expand(capsule.point1);
+    sweptBounds.expand(add(capsule.point0, displacement));
+    sweptBounds.expand(add(capsule.point1, displacement));
+
+    float margin = capsule.radius + CHARACTER_CONTACT_TOLERANCE;
+    sweptBounds.min = sub(sweptBounds.min, Vector3(margin, margin, margin));
+    sweptBounds.max = add(sweptBounds.max, Vector3(margin, margin, margin));
+
+    std::vector<int> candidates;
+    bvh.queryBox(sweptBounds, candidates);
+
+    float length = sqrtf(dot(displacement, displacement));
+    float timeMargin = length > 0.0f ? CHARACTER_SAME_CONTACT / length : 0.0f;
+
+    float bestTime = 2.0f;
+    int bestTriangle = -1;
+    Vector3 bestOnSegment, bestOnTriangle;
+    bool bestOnFace = false;
+
+    for (int i = 0; i < (int)candidates.size(); i++) {
+        const BVHTriangle &triangle = bvh.triangles[candidates[i]];
+
+        Vector3 a = triangle.vertex0;
+        Vector3 b = add(triangle.vertex0, triangle.edge1);
+        Vector3 c = add(triangle.vertex0, triangle.edge2);
+
+        Vector3 triangleNormal = cross(triangle.edge1, triangle.edge2);
+        if (dot(triangleNormal, triangleNormal) < 1e-20f)
+            continue;
+
+        float time = 0.0f;
+
+        for (int iteration = 0; iteration < CHARACTER_MAX_ITERATIONS; iteration++) {
+            Vector3 onSegment, onTriangle;
+            bool onFace;
+
+            Vector3 p = add(capsule.point0, scale(displacement, time));
+            Vector3 q = add(capsule.point1, scale(displacement, time));
+
+            float distanceSquared = closestSegmentTriangle(p, q, a, b, c, onSegment, onTriangle, onFace);
+            float distance = sqrtf(distanceSquared);
+            float gap = distance - capsule.radius;
+
+            if (gap <= CHARACTER_CONTACT_TOLERANCE) {
+                // Several triangles sharing the touched edge or corner are hit at the same time, prefer
+                // the one facing the move so that landing on a step edge reports the top of the step
+                bool better = time < bestTime;
+                Vector3 contactOffset = sub(onTriangle, bestOnTriangle);
+
+                if (bestTriangle >= 0 && fabsf(time - bestTime) <= timeMargin &&
+                    dot(contactOffset, contactOffset) < CHARACTER_SAME_CONTACT * CHARACTER_SAME_CONTACT) {
+                    const BVHTriangle &best = bvh.triangles[bestTriangle];
+                    Vector3 bestNormal = cross(best.edge1, best.edge2);
+
+                    float facing = fabsf(dot(triangleNormal, displacement)) / sqrtf(dot(triangleNormal, triangleNormal));
+                    float bestFacing = fabsf(dot(bestNormal, displacement)) / sqrtf(dot(bestNormal, bestNormal));
+
+                    better = facing > bestFacing;
+                }
+
+                if (better) {
+                    bestTime = time;
+                    bestTriangle = candidates[i];
+                    bestOnSegment = onSegment;
+                    bestOnTriangle = onTriangle;
+                    bestOnFace = onFace;
+                }
+                break;
+            }
+
+            // Rate at which the gap closes per unit of time, the gap never shrinks faster later on
+            float approach = -dot(sub(onSegment, onTriangle), displacement) / distance;
+
+            if (approach <= 1e-12f)
+                break;
+
+            time += gap / approach;
+
+            if (time > 1.0f || time > bestTime + timeMargin)
+                break;
+        }
+    }
+
+    if (bestTriangle < 0)
+        return false;
+
+    const BVHTriangle &triangle = bvh.triangles[bestTriangle];
+
+    Vector3 faceNormal = triangle.face->faceNormal;
+    if (dot(faceNormal, faceNormal) < 1e-20f)
+        faceNormal = cross(triangle.edge1, triangle.edge2);
+    faceNormal = scale(faceNormal, 1.0f / sqrtf(dot(faceNormal, faceNormal)));
+
+    Vector3 separation = sub(bestOnSegment, bestOnTriangle);
+    float separationLength = sqrtf(dot(separation, separation));
+
+    // Turn the face normal towards the capsule
+    Vector3 center = scale(add(capsule.point0, capsule.point1), 0.5f);
+    float side = dot(faceNormal, sub(center, bestOnTriangle));
+
+    if (side == 0.0f)
+        side = -dot(faceNormal, displacement);
+
+    if (side < 0.0f)
+        faceNormal = scale(faceNormal, -1.0f);
+
+    // Edge and corner contacts push straight away from the closest point
+    Vector3 normal = faceNormal;
+
+    if (!bestOnFace && separationLength > 1e-6f)
+        normal = scale(separation, 1.0f / separationLength);
+
+    Vector3 remaining = scale(displacement, 1.0f - bestTime);
+    float into = dot(remaining, normal);
+
+    hit.time = bestTime;
+    hit.point = bestOnTriangle;
+    hit.normal = normal;
+    hit.faceNormal = faceNormal;
+    hit.slide = into < 0.0f ? sub(remaining, scale(normal, into)) : remaining;
+    hit.startSolid = bestTime == 0.0f && separationLength < capsule.radius;
+    hit.faceIndex = triangle.faceIndex;
+    hit.face = triangle.face;
+    return true;
+}
+
+//
+// move
+// Description:
+//      Moves a capsule as far as possible along a displacement, sliding along the surfaces it
+//      touches. Walls lower than the step height are climbed. Sliding into a crease between two
+//      surfaces continues along the crease, so corners do not make the capsule jitter.
+//      Gravity should be part of the displacement for 'grounded' to be reported reliably.
+// Parameters:
+//      capsule      <const Capsule&>: The capsule at the start of the move.
+//      displacement <const Vector3&>: The wanted move.
+//      grounded     <bool*>: Set to true if the capsule touched walkable ground, false otherwise. May be NULL.
+// Returns:
+//      <Vector3>: The move which was actually made.
+//
+Vector3 CharacterController::move(const Capsule &capsule, const Vector3 &displacement, bool *grounded) const {
+    Capsule current = capsule;
+    Vector3 remaining = displacement;
+    Vector3 planes[CHARACTER_MAX_SLIDES];
+    int numPlanes = 0;
+    bool onGround = false;
+    bool stepped = false;
+
+    for (int i = 0; i < CHARACTER_MAX_SLIDES; i++) {
+        float distance = sqrtf(dot(remaining, remaining));
+
+        if (distance < CHARACTER_MIN_MOVE)
+            break;
+
+        CapsuleHit hit;
+
+        if (!sweepCapsule(current, remaining, hit)) {
+            translate(current, remaining);
+            break;
+        }
+
+        // Stop short of the contact to keep a small gap to the surface
+        float travel = hit.time * distance - skinWidth;
+        if (travel > 0.0f)
+            translate(current, scale(remaining, travel / distance));
+
+        // Rolling over the edge of a step tilts the contact normal until it looks walkable, so edge contacts
+        // try to step as well
+        bool edge = dot(hit.normal, hit.faceNormal) < CHARACTER_EDGE_COSINE;
+
+        if ((hit.normal.y < minGroundNormal || edge) && !stepped && stepHeight > 0.0f) {
+            stepped = true;
+
+            if (tryStep(current, scale(remaining, 1.0f - hit.time))) {
+                onGround = true;
+                break;
+            }
+        }
+
+        if (hit.normal.y >= minGroundNormal)
+            onGround = true;
+
+        remaining = hit.slide;
+        planes[numPlanes++] = hit.normal;
+
+        // Sliding along the new surface pushes back into the previous one, follow the crease instead
+        if (numPlanes >= 2 && dot(remaining, planes[numPlanes - 2]) < 0.0f) {
+            Vector3 crease = cross(planes[numPlanes - 2], planes[numPlanes - 1]);
+            float creaseLength = sqrtf(dot(crease, crease));
+
+            if (creaseLength > 1e-4f) {
+                crease = scale(crease, 1.0f / creaseLength);
+                remaining = scale(crease, dot(remaining, crease));
+            }
+        }
+    }
+
+    if (grounded != NULL)
+        *grounded = onGround;
+
+    return sub(current.point0, capsule.point0);
+}
+
+//
+// setStepHeight
+// Description:
+//      Sets the highest wall which is climbed as a step, 0 disables stepping.
+// Parameters:
+//      value <float>: The step height.
+// Returns:
+//      None (void).
+//
+void CharacterController::setStepHeight(float value) {
+    stepHeight = value > 0.0f ? value : 0.0f;
+}
+
+//
+// setMaxSlope
+// Description:
+//      Sets the steepest slope which counts as walkable ground.
+// Parameters:
+//      degrees <float>: Angle between the slope and the horizontal plane.
+// Returns:
+//      None (void).
+//
+void CharacterController::setMaxSlope(float degrees) {
+    minGroundNormal = cosf(degrees * 3.14159265f / 180.0f);
+}
+
+//
+// setSkinWidth
+// Description:
+//      Sets the gap kept between the capsule and surfaces after a move.
+// Parameters:
+//      value <float>: The gap.
+// Returns:
+//      None (void).
+//
+void CharacterController::setSkinWidth(float value) {
+    skinWidth = value > 0.0f ? value : 0.0f;
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// tryStep
+// Description:
+//      Tries to climb onto a step by moving up by the step height, then along the horizontal
+//      part of the displacement and then down onto walkable ground. The capsule may land on the
+//      edge of the step, so the face normal decides if the ground is walkable.
+// Parameters:
+//      capsule      <Capsule&>: The capsule, moved onto the step if it succeeds.
+//      displacement <const Vector3&>: The blocked part of the move.
+// Returns:
+//      <bool>: If the capsule is standing on the step.
+//
+bool CharacterController::tryStep(Capsule &capsule, const Vector3 &displacement) const {
+    Vector3 horizontal(displacement.x, 0.0f, displacement.z);
+    float horizontalLength = sqrtf(dot(horizontal, horizontal));
+
+    if (horizontalLength < CHARACTER_MIN_MOVE)
+        return false;
+
+    Capsule raised = capsule;
+    CapsuleHit hit;
+
+    float rise = stepHeight;
+    if (sweepCapsule(raised, Vector3(0.0f, stepHeight, 0.0f), hit))
+        rise = hit.time * stepHeight - skinWidth;
+
+    if (rise <= 0.0f)
+        return false;
+
+    translate(raised, Vector3(0.0f, rise, 0.0f));
+
+    float forward = horizontalLength;
+    if (sweepCapsule(raised, horizontal, hit))
+        forward = hit.time * horizontalLength - skinWidth;
+
+    if (forward < skinWidth)
+        return false;
+
+    translate(raised, scale(horizontal, forward / horizontalLength));
+
+    float drop = rise + skinWidth;
+    if (!sweepCapsule(raised, Vector3(0.0f, -drop, 0.0f), hit) || hit.startSolid || hit.faceNormal.y < minGroundNormal)
+        return false;
+
+    translate(raised, Vector3(0.0f, -(hit.time * drop - skinWidth), 0.0f));
+
+    capsule = raised;
+    return true;
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// add
+// Description:
+//      Adds two vectors, the Vector3 operators do not take const operands.
+// Parameters:
+//      a <const Vector3&>: First vector.
+//      b <const Vector3&>: Second vector.
+// Returns:
+//      <Vector3>: The sum.
+//
+static Vector3 add(const Vector3 &a, const Vector3 &b) {
+    return Vector3(a.x + b.x, a.y + b.y, a.z + b.z);
+}
+
+//
+// sub
+// Description:
+//      Subtracts two vectors.
+// Parameters:
+//      a <const Vector3&>: First vector.
+//      b <const Vector3&>: Second vector.
+// Returns:
+//      <Vector3>: The difference a - b.
+//
+static Vector3 sub(const Vector3 &a, const Vector3 &b) {
+    return Vector3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+//
+// scale
+// Description:
+//      Multiplies a vector by a scalar.
+// Parameters:
+//      a     <const Vector3&>: The vector.
+//      value <float>: The scalar.
+// Returns:
+//      <Vector3>: The scaled vector.
+//
+static Vector3 scale(const Vector3 &a, float value) {
+    return Vector3(a.x * value, a.y * value, a.z * value);
+}
+
+//
+// dot
+// Description:
+//      Dot product.
+// Parameters:
+//      a <const Vector3&>: First vector.
+//      b <const Vector3&>: Second vector.
+// Returns:
+//      <float>: The dot product.
+//
+static float dot(const Vector3 &a, const Vector3 &b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+//
+// cross
+// Description:
+//      Cross product.
+// Parameters:
+//      a <const Vector3&>: First vector.
+//      b <const Vector3&>: Second vector.
+// Returns:
+//      <Vector3>: The cross product a x b.
+//
+static Vector3 cross(const Vector3 &a, const Vector3 &b) {
+    return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+//
+// translate
+// Description:
+//      Moves a capsule.
+// Parameters:
+//      capsule <Capsule&>: The capsule.
+//      offset  <const Vector3&>: The move.
+// Returns:
+//      None (void).
+//
+static void translate(Capsule &capsule, const Vector3 &offset) {
+    capsule.point0 = add(capsule.point0, offset);
+    capsule.point1 = add(capsule.point1, offset);
+}
+
+//
+// closestPointTriangle
+// Description:
+//      Finds the point of a triangle closest to a point by checking which vertex, edge or face
+//      region of the triangle the point projects into.
+// Parameters:
+//      p      <const Vector3&>: The point.
+//      a      <const Vector3&>: First corner of the triangle.
+//      b      <const Vector3&>: Second corner of the triangle.
+//      c      <const Vector3&>: Third corner of the triangle.
+//      onFace <bool&>: Receives true if the closest point is inside the triangle, not on an edge or corner.
+// Returns:
+//      <Vector3>: The closest point.
+//
+static Vector3 closestPointTriangle(const Vector3 &p, const Vector3 &a, const Vector3 &b, const Vector3 &c,
+                                   bool &onFace) {
+    onFace = false;
+
+    Vector3 ab = sub(b, a);
+    Vector3 ac = sub(c, a);
+    Vector3 ap = sub(p, a);
+
+    float d1 = dot(ab, ap);
+    float d2 = dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+        return a;
+
+    Vector3 bp = sub(p, b);
+    float d3 = dot(ab, bp);
+    float d4 = dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3)
+        return b;
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        return add(a, scale(ab, d1 / (d1 - d3)));
+
+    Vector3 cp = sub(p, c);
+    float d5 = dot(ab, cp);
+    float d6 = dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6)
+        return c;
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        return add(a, scale(ac, d2 / (d2 - d6)));
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        return add(b, scale(sub(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+
+    float denominator = 1.0f / (va + vb + vc);
+    onFace = true;
+
+    return add(a, add(scale(ab, vb * denominator), scale(ac, vc * denominator)));
+}
+
+//
+// closestSegmentSegment
+// Description:
+//      Finds the closest points of two line segments.
+// Parameters:
+//      p1       <const Vector3&>: Start of the first segment.
+//      q1       <const Vector3&>: End of the first segment.
+//      p2       <const Vector3&>: Start of the second segment.
+//      q2       <const Vector3&>: End of the second segment.
+//      closest1 <Vector3&>: Receives the closest point on the first segment.
+//      closest2 <Vector3&>: Receives the closest point on the second segment.
+// Returns:
+//      <float>: The squared distance between the closest points.
+//
+static float closestSegmentSegment(const Vector3 &p1, const Vector3 &q1, const Vector3 &p2, const Vector3 &q2,
+                                   Vector3 &closest1, Vector3 &closest2) {
+    Vector3 d1 = sub(q1, p1);
+    Vector3 d2 = sub(q2, p2);
+    Vector3 r = sub(p1, p2);
+
+    float a = dot(d1, d1);
+    float e = dot(d2, d2);
+    float f = dot(d2, r);
+    float s = 0.0f;
+    float t = 0.0f;
+
+    if (a <= 1e-12f && e <= 1e-12f) {
+        s = 0.0f;
+        t = 0.0f;
+    }
+    else if (a <= 1e-12f) {
+        t = f / e;
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    }
+    else {
+        float c = dot(d1, r);
+
+        if (e <= 1e-12f) {
+            s = -c / a;
+            s = s < 0.0f ? 0.0f : (s > 1.0f ? 1.0f : s);
+        }
+        else {
+            float b = dot(d1, d2);
+            float denominator = a * e - b * b;
+
+            if (denominator != 0.0f) {
+                s = (b * f - c * e) / denominator;
+                s = s < 0.0f ? 0.0f : (s > 1.0f ? 1.0f : s);
+            }
+
+            t = (b * s + f) / e;
+
+            if (t < 0.0f) {
+                t = 0.0f;
+                s = -c / a;
+                s = s < 0.0f ? 0.0f : (s > 1.0f ? 1.0f : s);
+            }
+            else if (t > 1.0f) {
+                t = 1.0f;
+                s = (b - c) / a;
+                s = s < 0.0f ? 0.0f : (s > 1.0f ? 1.0f : s);
+            }
+        }
+    }
+
+    closest1 = add(p1, scale(d1, s));
+    closest2 = add(p2, scale(d2, t));
+
+    Vector3 difference = sub(closest1, closest2);
+    return dot(difference, difference);
+}
+
+//
+// closestSegmentTriangle
+// Description:
+//      Finds the closest points of a line segment and a triangle. If the segment does not cross the
+//      triangle, the closest points are found between an end point of the segment and the triangle
+//      or between the segment and an edge of the triangle.
+// Parameters:
+//      p          <const Vector3&>: Start of the segment.
+//      q          <const Vector3&>: End of the segment.
+//      a          <const Vector3&>: First corner of the triangle.
+//      b          <const Vector3&>: Second corner of the triangle.
+//      c          <const Vector3&>: Third corner of the triangle.
+//      onSegment  <Vector3&>: Receives the closest point on the segment.
+//      onTriangle <Vector3&>: Receives the closest point on the triangle.
+//      onFace     <bool&>: Receives true if the closest point is inside the triangle.
+// Returns:
+//      <float>: The squared distance between the closest points.
+//
+static float closestSegmentTriangle(const Vector3 &p, const Vector3 &q, const Vector3 &a, const Vector3 &b,
+                                    const Vector3 &c, Vector3 &onSegment, Vector3 &onTriangle, bool &onFace) {
+    Vector3 normal = cross(sub(b, a), sub(c, a));
+    float dp = dot(sub(p, a), normal);
+    float dq = dot(sub(q, a), normal);
+
+    // The segment crosses the plane of the triangle
+    if (((dp <= 0.0f && dq >= 0.0f) || (dp >= 0.0f && dq <= 0.0f)) && dp != dq) {
+        Vector3 crossing = add(p, scale(sub(q, p), dp / (dp - dq)));
+        bool inside;
+
+        closestPointTriangle(crossing, a, b, c, inside);
+
+        if (inside) {
+            onSegment = crossing;
+            onTriangle = crossing;
+            onFace = true;
+            return 0.0f;
+        }
+    }
+
+    bool face;
+    Vector3 point = closestPointTriangle(p, a, b, c, face);
+    Vector3 difference = sub(p, point);
+    float best = dot(difference, difference);
+
+    onSegment = p;
+    onTriangle = point;
+    onFace = face;
+
+    point = closestPointTriangle(q, a, b, c, face);
+    difference = sub(q, point);
+
+    if (dot(difference, difference) < best) {
+        best = dot(difference, difference);
+        onSegment = q;
+        onTriangle = point;
+        onFace = face;
+    }
+
+    const Vector3 *corners[4] = {&a, &b, &c, &a};
+
+    for (int e = 0; e < 3; e++) {
+        Vector3 closest1, closest2;
+        float distanceSquared = closestSegmentSegment(p, q, *corners[e], *corners[e + 1], closest1, closest2);
+
+        if (distanceSquared < best) {
+            best = distanceSquared;
+            onSegment = closest1;
+            onTriangle = closest2;
+            onFace = false;
+        }
+    }
+    return best;
+}
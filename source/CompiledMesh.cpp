@@ -0,0 +1,853 @@
+// CompiledMesh.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/CompiledMesh.h"
+#include "../include/MeshCodec.h"
+#include "../include/TangentGenerator.h"
+#include <cstring>
+#include <map>
+#include <unordered_map>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+
+static const char MESH_CACHE_MAGIC[8] = {'F', 'P', 'S', 'M', 'E', 'S', 'H', 0};
+static const unsigned int MESH_CACHE_VERSION = 3;
+
+static const unsigned int MESH_CACHE_COMPRESSED = 1;
+
+struct MeshCacheHeader {
+    char magic[8];
+    unsigned int version;
+    unsigned int format;
+    unsigned int flags;
+    unsigned int vertexDataSize; // bytes stored for the vertex stream
+    unsigned int indexDataSize;  // bytes stored for the indices
+    unsigned int numVertices;
+    unsigned int numIndices;
+    unsigned int numGroups;
+    unsigned int numTangents;
+    float boundsMin[3];
+    float boundsMax[3];
+};
+
+// Corner of a face, identified by the shared data it points to
+struct CornerKey {
+    const Vector3 *vertex;
+    const Vector3 *uvw;
+    const Vector3 *normal;
+
+    bool operator==(const CornerKey &key) const {
+        return vertex == key.vertex && uvw == key.uvw && normal == key.normal;
+    }
+};
+
+struct CornerKeyHash {
+    size_t operator()(const CornerKey &key) const {
+        size_t hash = (size_t)key.vertex;
+        hash ^= (size_t)key.uvw + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= (size_t)key.normal + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// floatToHalf
+// Description:
+//      Converts a 32-bit float to a 16-bit half float with round to nearest even.
+//      Values out of range become infinity, tiny values become denormals or zero.
+// Parameters:
+//      value <float>: The value to convert.
+// Returns:
+//      <unsigned short>: The half float bit pattern.
+//
+static unsigned short floatToHalf(float value) {
+    unsigned int bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    unsigned int sign = (bits >> 16) & 0x8000;
+    unsigned int exponent = (bits >> 23) & 0xff;
+    unsigned int mantissa = bits & 0x7fffff;
+
+    if (exponent == 0xff) // inf or nan
+        return (unsigned short)(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+    int halfExponent = (int)exponent - 127 + 15;
+
+    if (halfExponent >= 31) // overflow
+        return (unsigned short)(sign | 0x7c00);
+
+    if (halfExponent <= 0) { // denormal or zero
+        if (halfExponent < -10)
+            return (unsigned short)sign;
+
+        mantissa |= 0x800000;
+        int shift = 14 - halfExponent;
+        unsigned int halfMantissa = mantissa >> shift;
+        unsigned int rest = mantissa & ((1u << shift) - 1);
+        unsigned int halfway = 1u << (shift - 1);
+
+        if (rest > halfway || (rest == halfway && (halfMantissa & 1)))
+            halfMantissa++;
+
+        return (unsigned short)(sign | halfMantissa);
+    }
+
+    unsigned int half = sign | ((unsigned int)halfExponent << 10) | (mantissa >> 13);
+    unsigned int rest = mantissa & 0x1fff;
+
+    // Rounding may carry into the exponent, which is the correct result
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+        half++;
+
+    return (unsigned short)half;
+}
+
+//
+// halfToFloat
+// Description:
+//      Converts a 16-bit half float to a 32-bit float.
+// Parameters:
+//      half <unsigned short>: The half float bit pattern.
+// Returns:
+//      <float>: The converted value.
+//
+static float halfToFloat(unsigned short half) {
+    unsigned int sign = (unsigned int)(half & 0x8000) << 16;
+    unsigned int exponent = (half >> 10) & 0x1f;
+    unsigned int mantissa = half & 0x3ff;
+    unsigned int bits;
+
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        }
+        else { // denormal, renormalize
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400) == 0) {
+                mantissa <<= 1;
+                exponent--;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+        }
+    }
+    else if (exponent == 31) {
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    }
+    else {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+//
+// encodeOctahedral
+// Description:
+//      Encodes a normal with octahedral mapping into two signed normalized 16-bit values.
+// Parameters:
+//      normal <const float*>: The normal (x, y, z), does not need to be normalized.
+//      out    <short*>: The two encoded components.
+// Returns:
+//      None (void).
+//
+static void encodeOctahedral(const float *normal, short *out) {
+    float l1 = fabsf(normal[0]) + fabsf(normal[1]) + fabsf(normal[2]);
+
+    if (l1 == 0.0f) {
+        out[0] = 0;
+        out[1] = 0;
+        return;
+    }
+
+    float x = normal[0] / l1;
+    float y = normal[1] / l1;
+
+    if (normal[2] < 0.0f) {
+        float foldedX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float foldedY = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+
+    out[0] = (short)floorf(fminf(fmaxf(x, -1.0f), 1.0f) * 32767.0f + 0.5f);
+    out[1] = (short)floorf(fminf(fmaxf(y, -1.0f), 1.0f) * 32767.0f + 0.5f);
+}
+
+//
+// decodeOctahedral
+// Description:
+//      Decodes an octahedral encoded normal into a unit vector.
+// Parameters:
+//      in     <const short*>: The two encoded components.
+//      normal <float*>: The decoded normal (x, y, z).
+// Returns:
+//      None (void).
+//
+static void decodeOctahedral(const short *in, float *normal) {
+    float x = fmaxf(in[0] / 32767.0f, -1.0f);
+    float y = fmaxf(in[1] / 32767.0f, -1.0f);
+    float z = 1.0f - fabsf(x) - fabsf(y);
+
+    if (z < 0.0f) {
+        float foldedX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float foldedY = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+
+    float length = sqrtf(x * x + y * y + z * z);
+
+    normal[0] = x / length;
+    normal[1] = y / length;
+    normal[2] = z / length;
+}
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// CompiledMesh
+// Description:
+//      Constructor.
+//      Creates an empty mesh in the full precision format.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+CompiledMesh::CompiledMesh() {
+    format = VERTEX_FORMAT_FLOAT;
+}
+
+//
+// ~CompiledMesh
+// Description:
+//      Destructor.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+CompiledMesh::~CompiledMesh() {
+    clear();
+}
+
+//
+// compile
+// Description:
+//      Compiles a loaded model into indexed triangle lists.
+//      Polygons are triangulated as fans. Faces without normals get the normalized face normal so that
+//      flat shaded corners are never shared between faces.
+// Parameters:
+//      model     <Model&>: The loaded model.
+//      in_format <VERTEX_FORMAT>: The vertex format to keep after compiling.
+// Returns:
+//      <bool>: False if the model has no geometry.
+//
+bool CompiledMesh::compile(Model &model, VERTEX_FORMAT in_format) {
+    clear();
+
+    std::vector<GroupObject *> &objects = model.getObjects();
+    std::vector<Material *> &materials = model.getMaterials();
+
+    std::map<Material *, int> materialIndices;
+    for (int m = 0; m < (int)materials.size(); m++)
+        materialIndices[materials[m]] = m;
+
+    Vector3 *boundingPoints = model.getBoundingPoints();
+    boundsMin = boundingPoints[6];
+    boundsMax = boundingPoints[7];
+
+    std::unordered_map<CornerKey, unsigned int, CornerKeyHash> corners;
+
+    for (int i = 0; i < (int)objects.size(); i++) {
+        GroupObject *object = objects[i];
+
+        for (int f = 0; f < (int)object->faces.size(); f++) {
+            Face *face = object->faces[f];
+
+            if (face->numVertices < 3)
+                continue;
+
+            int materialIndex = -1;
+            if (face->material != NULL)
+                materialIndex = materialIndices[face->material];
+
+            // Start a new range when the group object or the material changes
+            if (groups.empty() || groups.back().objectIndex != i || groups.back().materialIndex != materialIndex) {
+                CompiledGroup group;
+                group.objectIndex = i;
+                group.materialIndex = materialIndex;
+                group.firstVertex = (int)vertices.size();
+                group.firstIndex = (int)indices.size();
+                groups.push_back(group);
+
+                corners.clear();
+            }
+
+            Vector3 faceNormal = face->faceNormal;
+            if (faceNormal.Length() > 0.0f)
+                faceNormal.Normalize();
+
+            unsigned int faceCorners[3];
+
+            for (int v = 0; v < face->numVertices; v++) {
+                CornerKey key;
+                key.vertex = face->vertices[v];
+                key.uvw = (face->UVWs != NULL && v < face->numUVWs) ? face->UVWs[v] : NULL;
+                key.normal = (face->normals != NULL && v < face->numNormals) ? face->normals[v] : &face->faceNormal;
+
+                std::unordered_map<CornerKey, unsigned int, CornerKeyHash>::iterator it = corners.find(key);
+                unsigned int index;
+
+                if (it != corners.end()) {
+                    index = it->second;
+                }
+                else {
+                    CompiledVertex vertex;
+                    const Vector3 *normal = (key.normal == &face->faceNormal) ? &faceNormal : key.normal;
+
+                    vertex.position[0] = key.vertex->x;
+                    vertex.position[1] = key.vertex->y;
+                    vertex.position[2] = key.vertex->z;
+                    vertex.normal[0] = normal->x;
+                    vertex.normal[1] = normal->y;
+                    vertex.normal[2] = normal->z;
+                    vertex.uv[0] = key.uvw != NULL ? key.uvw->x : 0.0f;
+                    vertex.uv[1] = key.uvw != NULL ? key.uvw->y : 0.0f;
+
+                    index = (unsigned int)vertices.size();
+                    vertices.push_back(vertex);
+                    corners[key] = index;
+                }
+
+                // Triangle fan: (0, v - 1, v)
+                if (v == 0) {
+                    faceCorners[0] = index;
+                }
+                else if (v == 1) {
+                    faceCorners[2] = index;
+                }
+                else {
+                    faceCorners[1] = faceCorners[2];
+                    faceCorners[2] = index;
+
+                    indices.push_back(faceCorners[0]);
+                    indices.push_back(faceCorners[1]);
+                    indices.push_back(faceCorners[2]);
+                }
+            }
+
+            groups.back().vertexCount = (int)vertices.size() - groups.back().firstVertex;
+            groups.back().indexCount = (int)indices.size() - groups.back().firstIndex;
+        }
+    }
+
+    if (vertices.empty())
+        return false;
+
+    TangentGenerator::generate(*this, materials);
+
+    setFormat(in_format);
+    return true;
+}
+
+//
+// clear
+// Description:
+//      Releases all compiled data.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void CompiledMesh::clear(void) {
+    vertices.clear();
+    quantizedVertices.clear();
+    indices.clear();
+    groups.clear();
+    tangents.clear();
+
+    format = VERTEX_FORMAT_FLOAT;
+    report = QuantizationReport();
+}
+
+//
+// setFormat
+// Description:
+//      Converts the vertex stream to the given format. Only the stream of the active format is kept
+//      in memory. Quantizing a full precision stream updates the quantization report.
+// Parameters:
+//      in_format <VERTEX_FORMAT>: The new vertex format.
+// Returns:
+//      None (void).
+//
+void CompiledMesh::setFormat(VERTEX_FORMAT in_format) {
+    if (in_format == format)
+        return;
+
+    if (in_format == VERTEX_FORMAT_QUANTIZED)
+        quantize();
+    else
+        dequantize();
+}
+
+//
+// getFormat
+// Description:
+//      Getter function for the active vertex format.
+// Parameters:
+//      None (void).
+// Returns:
+//      format <VERTEX_FORMAT>: The active vertex format.
+//
+VERTEX_FORMAT CompiledMesh::getFormat(void) {
+    return format;
+}
+
+//
+// getVertexData
+// Description:
+//      Getter function for the vertex stream of the active format, ready to be uploaded.
+// Parameters:
+//      None (void).
+// Returns:
+//      <const void*>: The first vertex, NULL if the mesh is empty.
+//
+const void *CompiledMesh::getVertexData(void) {
+    if (format == VERTEX_FORMAT_QUANTIZED)
+        return quantizedVertices.empty() ? NULL : &quantizedVertices[0];
+
+    return vertices.empty() ? NULL : &vertices[0];
+}
+
+//
+// getVertexStride
+// Description:
+//      Getter function for the size in bytes of one vertex in the active format.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: The vertex stride.
+//
+int CompiledMesh::getVertexStride(void) {
+    if (format == VERTEX_FORMAT_QUANTIZED)
+        return (int)sizeof(QuantizedVertex);
+
+    return (int)sizeof(CompiledVertex);
+}
+
+//
+// getNumVertices
+// Description:
+//      Getter function for the number of vertices in the active format.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: The number of vertices.
+//
+int CompiledMesh::getNumVertices(void) {
+    if (format == VERTEX_FORMAT_QUANTIZED)
+        return (int)quantizedVertices.size();
+
+    return (int)vertices.size();
+}
+
+//
+// getVertexBytes
+// Description:
+//      Getter function for the memory used by the vertex stream of the active format.
+// Parameters:
+//      None (void).
+// Returns:
+//      <size_t>: The size in bytes.
+//
+size_t CompiledMesh::getVertexBytes(void) {
+    return (size_t)getNumVertices() * (size_t)getVertexStride();
+}
+
+//
+// decodeVertex
+// Description:
+//      Reads one vertex of the active format back as full precision.
+// Parameters:
+//      index <int>: The vertex index.
+//      out   <CompiledVertex&>: The decoded vertex.
+// Returns:
+//      None (void).
+//
+void CompiledMesh::decodeVertex(int index, CompiledVertex &out) {
+    if (format == VERTEX_FORMAT_FLOAT) {
+        out = vertices[index];
+        return;
+    }
+
+    const QuantizedVertex &vertex = quantizedVertices[index];
+
+    float extent[3] = {boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y, boundsMax.z - boundsMin.z};
+    float origin[3] = {boundsMin.x, boundsMin.y, boundsMin.z};
+
+    for (int c = 0; c < 3; c++)
+        out.position[c] = origin[c] + vertex.position[c] * (extent[c] / 65535.0f);
+
+    decodeOctahedral(vertex.normal, out.normal);
+
+    out.uv[0] = halfToFloat(vertex.uv[0]);
+    out.uv[1] = halfToFloat(vertex.uv[1]);
+}
+
+//
+// getQuantizationReport
+// Description:
+//      Getter function for the error and memory reduction measured the last time the vertex stream was quantized.
+// Parameters:
+//      None (void).
+// Returns:
+//      report <QuantizationReport>: The measured errors and stream sizes.
+//
+QuantizationReport CompiledMesh::getQuantizationReport(void) {
+    return report;
+}
+
+//
+// saveCache
+// Description:
+//      Writes the compiled mesh in its active format to a binary cache file.
+//      Compressing the cache trades a fast decode on load for a much smaller file.
+// Parameters:
+//      filename <std::string>: Full path of the cache file.
+//      compress <bool>: Encode vertices and indices with MeshCodec.
+// Returns:
+//      <bool>: If the file was written correctly or not.
+//
+bool CompiledMesh::saveCache(std::string filename, bool compress) {
+    std::ofstream file(filename.data(), std::ios_base::binary);
+
+    if (!file.is_open())
+        return false;
+
+    std::vector<unsigned char> vertexData;
+    std::vector<unsigned char> indexData;
+
+    if (compress) {
+        if (!MeshCodec::encodeVertexBuffer(getVertexData(), getNumVertices(), getVertexStride(), vertexData))
+            return false;
+
+        MeshCodec::encodeIndexBuffer(indices.empty() ? NULL : &indices[0], indices.size(), indexData);
+    }
+
+    MeshCacheHeader header;
+    std::memcpy(header.magic, MESH_CACHE_MAGIC, sizeof(header.magic));
+    header.version = MESH_CACHE_VERSION;
+    header.format = (unsigned int)format;
+    header.flags = compress ? MESH_CACHE_COMPRESSED : 0;
+    header.vertexDataSize = (unsigned int)(compress ? vertexData.size() : getVertexBytes());
+    header.indexDataSize = (unsigned int)(compress ? indexData.size() : indices.size() * sizeof(unsigned int));
+    header.numVertices = (unsigned int)getNumVertices();
+    header.numIndices = (unsigned int)indices.size();
+    header.numGroups = (unsigned int)groups.size();
+    header.numTangents = (unsigned int)tangents.size();
+    header.boundsMin[0] = boundsMin.x;
+    header.boundsMin[1] = boundsMin.y;
+    header.boundsMin[2] = boundsMin.z;
+    header.boundsMax[0] = boundsMax.x;
+    header.boundsMax[1] = boundsMax.y;
+    header.boundsMax[2] = boundsMax.z;
+
+    file.write((const char*)&header, sizeof(header));
+
+    if (!groups.empty())
+        file.write((const char*)&groups[0], groups.size() * sizeof(CompiledGroup));
+
+    if (compress) {
+        file.write((const char*)vertexData.data(), vertexData.size());
+        file.write((const char*)indexData.data(), indexData.size());
+    }
+    else {
+        if (getNumVertices() > 0)
+            file.write((const char*)getVertexData(), getVertexBytes());
+
+        if (!indices.empty())
+            file.write((const char*)&indices[0], indices.size() * sizeof(unsigned int));
+    }
+
+    if (!tangents.empty())
+        file.write((const char*)&tangents[0], tangents.size() * sizeof(CompiledTangent));
+
+    return file.good();
+}
+
+//
+// loadCache
+// Description:
+//      Reads a compiled mesh from a binary cache file written by 'saveCache'.
+//      The mesh keeps the format stored in the file. Truncated or corrupt files, whose counts,
+//      ranges or indices do not fit the stored data, are rejected and leave the mesh empty, so
+//      the caller compiles the model again.
+// Parameters:
+//      filename <std::string>: Full path of the cache file.
+// Returns:
+//      <bool>: If the file was read correctly or not.
+//
+bool CompiledMesh::loadCache(std::string filename) {
+    std::ifstream file(filename.data(), std::ios_base::binary);
+
+    if (!file.is_open())
+        return false;
+
+    MeshCacheHeader header;
+
+    if (!file.read((char*)&header, sizeof(header)))
+        return false;
+
+    if (std::memcmp(header.magic, MESH_CACHE_MAGIC, sizeof(header.magic)) != 0 || header.version != MESH_CACHE_VERSION)
+        return false;
+
+    if (header.format != VERTEX_FORMAT_FLOAT && header.format != VERTEX_FORMAT_QUANTIZED)
+        return false;
+
+    if (header.numIndices % 3 != 0)
+        return false;
+
+    // The counts decide what is allocated, check that the file is large enough to hold them first
+    std::streamoff dataStart = file.tellg();
+    file.seekg(0, std::ios_base::end);
+    unsigned long long available = (unsigned long long)(file.tellg() - dataStart);
+    file.seekg(dataStart);
+
+    unsigned long long vertexSize = header.format == VERTEX_FORMAT_QUANTIZED ? sizeof(QuantizedVertex)
+                                                                             : sizeof(CompiledVertex);
+    unsigned long long expected = (unsigned long long)header.numGroups * sizeof(CompiledGroup) +
+                                  (unsigned long long)header.numTangents * sizeof(CompiledTangent);
+
+    if (header.flags & MESH_CACHE_COMPRESSED)
+        expected += (unsigned long long)header.vertexDataSize + header.indexDataSize;
+    else
+        expected += header.numVertices * vertexSize + header.numIndices * (unsigned long long)sizeof(unsigned int);
+
+    if (expected > available)
+        return false;
+
+    // The codecs write at least one byte per 64 values of a byte plane and one byte per triangle
+    if (header.flags & MESH_CACHE_COMPRESSED) {
+        if (header.vertexDataSize < 1 || header.indexDataSize < 1)
+            return false;
+
+        if ((header.numVertices + 63ULL) / 64 * vertexSize > header.vertexDataSize - 1ULL ||
+            header.numIndices / 3ULL > header.indexDataSize - 1ULL)
+            return false;
+    }
+
+    clear();
+
+    format = (VERTEX_FORMAT)header.format;
+    boundsMin = Vector3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    boundsMax = Vector3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+
+    groups.resize(header.numGroups);
+    indices.resize(header.numIndices);
+    tangents.resize(header.numTangents);
+
+    if (format == VERTEX_FORMAT_QUANTIZED)
+        quantizedVertices.resize(header.numVertices);
+    else
+        vertices.resize(header.numVertices);
+
+    bool ok = true;
+
+    if (!groups.empty())
+        ok = ok && file.read((char*)&groups[0], groups.size() * sizeof(CompiledGroup));
+
+    if (header.flags & MESH_CACHE_COMPRESSED) {
+        std::vector<unsigned char> data(header.vertexDataSize + header.indexDataSize);
+
+        ok = ok && !data.empty() && file.read((char*)data.data(), data.size());
+
+        ok = ok && MeshCodec::decodeVertexBuffer(data.data(), header.vertexDataSize, (void*)getVertexData(),
+                                                 header.numVertices, getVertexStride());
+
+        ok = ok && MeshCodec::decodeIndexBuffer(data.data() + header.vertexDataSize, header.indexDataSize,
+                                                indices.empty() ? NULL : &indices[0], indices.size());
+    }
+    else {
+        if (header.numVertices > 0)
+            ok = ok && file.read((char*)getVertexData(), getVertexBytes());
+
+        if (!indices.empty())
+            ok = ok && file.read((char*)&indices[0], indices.size() * sizeof(unsigned int));
+    }
+
+    if (!tangents.empty())
+        ok = ok && file.read((char*)&tangents[0], tangents.size() * sizeof(CompiledTangent));
+
+    ok = ok && hasValidRanges();
+
+    if (!ok) {
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// quantize
+// Description:
+//      Quantizes the full precision vertex stream and measures the introduced error.
+//      Positions are stored as 16-bit values relative to the bounding box, normals with octahedral mapping
+//      and UVs as half floats. The full precision stream is released afterwards.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void CompiledMesh::quantize(void) {
+    float origin[3] = {boundsMin.x, boundsMin.y, boundsMin.z};
+    float extent[3] = {boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y, boundsMax.z - boundsMin.z};
+    float scale[3];
+
+    for (int c = 0; c < 3; c++)
+        scale[c] = extent[c] > 0.0f ? 65535.0f / extent[c] : 0.0f;
+
+    quantizedVertices.resize(vertices.size());
+    format = VERTEX_FORMAT_QUANTIZED;
+
+    report = QuantizationReport();
+    report.floatBytes = vertices.size() * sizeof(CompiledVertex);
+    report.quantizedBytes = quantizedVertices.size() * sizeof(QuantizedVertex);
+
+    double positionErrorSum = 0.0;
+    double normalErrorSum = 0.0;
+
+    for (int v = 0; v < (int)vertices.size(); v++) {
+        const CompiledVertex &vertex = vertices[v];
+        QuantizedVertex &quantized = quantizedVertices[v];
+
+        for (int c = 0; c < 3; c++) {
+            float value = (vertex.position[c] - origin[c]) * scale[c];
+            quantized.position[c] = (unsigned short)(fminf(fmaxf(value, 0.0f), 65535.0f) + 0.5f);
+        }
+        quantized.position[3] = 0;
+
+        encodeOctahedral(vertex.normal, quantized.normal);
+
+        quantized.uv[0] = floatToHalf(vertex.uv[0]);
+        quantized.uv[1] = floatToHalf(vertex.uv[1]);
+
+        // Measure the error against the source vertex
+        CompiledVertex decoded;
+        decodeVertex(v, decoded);
+
+        float dx = decoded.position[0] - vertex.position[0];
+        float dy = decoded.position[1] - vertex.position[1];
+        float dz = decoded.position[2] - vertex.position[2];
+        float positionError = sqrtf(dx * dx + dy * dy + dz * dz);
+
+        float length = sqrtf(vertex.normal[0] * vertex.normal[0] +
+                             vertex.normal[1] * vertex.normal[1] +
+                             vertex.normal[2] * vertex.normal[2]);
+        float normalError = 0.0f;
+
+        if (length > 0.0f) {
+            float cosine = (decoded.normal[0] * vertex.normal[0] +
+                            decoded.normal[1] * vertex.normal[1] +
+                            decoded.normal[2] * vertex.normal[2]) / length;
+            normalError = acosf(fminf(fmaxf(cosine, -1.0f), 1.0f)) * (180.0f / (float)M_PI);
+        }
+
+        float uvError = fmaxf(fabsf(decoded.uv[0] - vertex.uv[0]), fabsf(decoded.uv[1] - vertex.uv[1]));
+
+        report.maxPositionError = fmaxf(report.maxPositionError, positionError);
+        report.maxNormalError = fmaxf(report.maxNormalError, normalError);
+        report.maxUVError = fmaxf(report.maxUVError, uvError);
+
+        positionErrorSum += positionError;
+        normalErrorSum += normalError;
+    }
+
+    if (!vertices.empty()) {
+        report.avgPositionError = (float)(positionErrorSum / vertices.size());
+        report.avgNormalError = (float)(normalErrorSum / vertices.size());
+    }
+
+    std::vector<CompiledVertex>().swap(vertices);
+}
+
+//
+// dequantize
+// Description:
+//      Expands the quantized vertex stream back to full precision and releases the quantized stream.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void CompiledMesh::dequantize(void) {
+    vertices.resize(quantizedVertices.size());
+
+    for (int v = 0; v < (int)quantizedVertices.size(); v++)
+        decodeVertex(v, vertices[v]);
+
+    format = VERTEX_FORMAT_FLOAT;
+    std::vector<QuantizedVertex>().swap(quantizedVertices);
+}
+
+//
+// hasValidRanges
+// Description:
+//      Checks that the ranges of every group lie within the vertex, index and tangent streams, and
+//      that every index refers to a vertex of its own range. Used on meshes read from a cache file.
+// Parameters:
+//      None (void).
+// Returns:
+//      <bool>: If the mesh can be drawn without reading outside its streams.
+//
+bool CompiledMesh::hasValidRanges(void) {
+    long long numVertices = getNumVertices();
+    long long numIndices = (long long)indices.size();
+    long long numTangents = (long long)tangents.size();
+
+    for (int g = 0; g < (int)groups.size(); g++) {
+        const CompiledGroup &group = groups[g];
+
+        if (group.firstVertex < 0 || group.vertexCount < 0 ||
+            (long long)group.firstVertex + group.vertexCount > numVertices)
+            return false;
+
+        if (group.firstIndex < 0 || group.indexCount < 0 || group.indexCount % 3 != 0 ||
+            (long long)group.firstIndex + group.indexCount > numIndices)
+            return false;
+
+        if (group.objectIndex < 0 || group.materialIndex < -1)
+            return false;
+
+        if (group.firstTangent < -1 ||
+            (group.firstTangent >= 0 && (long long)group.firstTangent + group.vertexCount > numTangents))
+            return false;
+
+        for (int i = group.firstIndex; i < group.firstIndex + group.indexCount; i++) {
+            if (indices[i] < (unsigned int)group.firstVertex ||
+                indices[i] >= (unsigned int)(group.firstVertex + group.vertexCount))
+                return false;
+        }
+    }
+
+    return true;
+}
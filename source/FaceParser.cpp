@@ -0,0 +1,130 @@
+// FaceParser.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/FaceParser.h"
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// parseFace
+// Description:
+//      Parses the corners of a face record. The text starts after the 'f' keyword and ends at the end
+//      of the line or at a comment. The face is rejected if any corner is malformed or out of range,
+//      or if it has fewer than three corners. Texture coordinates and normals are only kept if every
+//      corner has them, so that the corner arrays of a face always line up.
+// Parameters:
+//      text        <const char*>: The rest of the line, null terminated.
+//      numVertices <int>: Number of 'v' records read so far.
+//      numUVWs     <int>: Number of 'vt' records read so far.
+//      numNormals  <int>: Number of 'vn' records read so far.
+//      corners     <std::vector<FaceCorner>&>: Receives the corners, cleared first.
+// Returns:
+//      <bool>: If the face is valid or not.
+//
+bool FaceParser::parseFace(const char *text, int numVertices, int numUVWs, int numNormals,
+                           std::vector<FaceCorner> &corners) {
+    corners.clear();
+
+    bool allUVWs = true;
+    bool allNormals = true;
+
+    for (;;) {
+        while (*text == ' ' || *text == '\t')
+            text++;
+
+        if (*text == '\0' || *text == '\r' || *text == '\n' || *text == '#')
+            break;
+
+        FaceCorner corner;
+        corner.uvw = -1;
+        corner.normal = -1;
+
+        if (!parseIndex(text, numVertices, corner.vertex))
+            return false;
+
+        if (*text == '/') {
+            text++;
+
+            if (*text != '/' && !parseIndex(text, numUVWs, corner.uvw))
+                return false;
+
+            if (*text == '/') {
+                text++;
+
+                if (!parseIndex(text, numNormals, corner.normal))
+                    return false;
+            }
+        }
+
+        // A corner has to end at whitespace or the end of the line
+        if (*text != ' ' && *text != '\t' && *text != '\0' && *text != '\r' && *text != '\n' && *text != '#')
+            return false;
+
+        allUVWs = allUVWs && corner.uvw >= 0;
+        allNormals = allNormals && corner.normal >= 0;
+
+        corners.push_back(corner);
+    }
+
+    if ((int)corners.size() < 3)
+        return false;
+
+    for (int c = 0; c < (int)corners.size(); c++) {
+        if (!allUVWs)
+            corners[c].uvw = -1;
+
+        if (!allNormals)
+            corners[c].normal = -1;
+    }
+    return true;
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// parseIndex
+// Description:
+//      Parses one signed OBJ index and converts it to a zero based index.
+//      Positive indices start at 1, negative indices count back from the last element.
+// Parameters:
+//      text  <const char*&>: Read position, advanced past the digits.
+//      count <int>: Number of elements the index can refer to.
+//      index <int&>: The zero based index.
+// Returns:
+//      <bool>: False if there are no digits, the value is zero or out of range.
+//
+bool FaceParser::parseIndex(const char *&text, int count, int &index) {
+    bool negative = false;
+
+    if (*text == '-' || *text == '+') {
+        negative = *text == '-';
+        text++;
+    }
+
+    if (*text < '0' || *text > '9')
+        return false;
+
+    long long value = 0;
+
+    while (*text >= '0' && *text <= '9') {
+        value = value * 10 + (*text - '0');
+        text++;
+
+        if (value > count) // also guards against overflow
+            return false;
+    }
+
+    if (value == 0)
+        return false;
+
+    index = negative ? count - (int)value : (int)value - 1;
+    return true;
+}
@@ -0,0 +1,229 @@
+// Frustum.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/Frustum.h"
+#include "../include/RenderBackend.h"
+#include <math.h>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define FRUSTUM_AVX
+#elif defined(__SSE__) || defined(_M_X64)
+    #include <xmmintrin.h>
+    #define FRUSTUM_SSE
+#endif
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// Frustum
+// Description:
+//      Constructor.
+//      Creates a frustum that contains everything until a matrix is set.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+Frustum::Frustum() {
+    for (int p = 0; p < 6; p++) {
+        planes[p][0] = 0.0f;
+        planes[p][1] = 0.0f;
+        planes[p][2] = 0.0f;
+        planes[p][3] = 1.0f;
+    }
+}
+
+//
+// setFromMatrix
+// Description:
+//      Extracts the clip planes from a combined projection * modelview matrix (Gribb and Hartmann).
+//      Boxes tested afterwards are in the space the modelview matrix transforms from.
+// Parameters:
+//      matrix <const float*>: 4x4 matrix in OpenGL column major order.
+// Returns:
+//      None (void).
+//
+void Frustum::setFromMatrix(const float *matrix) {
+    for (int i = 0; i < 3; i++) {
+        for (int c = 0; c < 4; c++) {
+            planes[i * 2 + 0][c] = matrix[c * 4 + 3] + matrix[c * 4 + i]; // left, bottom, near
+            planes[i * 2 + 1][c] = matrix[c * 4 + 3] - matrix[c * 4 + i]; // right, top, far
+        }
+    }
+
+    // Normalized planes give real distances for sphere tests
+    for (int p = 0; p < 6; p++) {
+        float length = sqrtf(planes[p][0] * planes[p][0] + planes[p][1] * planes[p][1] + planes[p][2] * planes[p][2]);
+
+        if (length > 0.0f) {
+            for (int c = 0; c < 4; c++)
+                planes[p][c] /= length;
+        }
+    }
+}
+
+//
+// extractFromGL
+// Description:
+//      Extracts the clip planes from the current OpenGL projection and modelview matrices.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void Frustum::extractFromGL(void) {
+    float projection[16];
+    float modelview[16];
+    float combined[16];
+
+    RenderBackend::get()->getFloat(GL_PROJECTION_MATRIX, projection);
+    RenderBackend::get()->getFloat(GL_MODELVIEW_MATRIX, modelview);
+
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            combined[c * 4 + r] = projection[0 * 4 + r] * modelview[c * 4 + 0] +
+                                  projection[1 * 4 + r] * modelview[c * 4 + 1] +
+                                  projection[2 * 4 + r] * modelview[c * 4 + 2] +
+                                  projection[3 * 4 + r] * modelview[c * 4 + 3];
+        }
+    }
+
+    setFromMatrix(combined);
+}
+
+//
+// testBox
+// Description:
+//      Tests a single box against the frustum.
+// Parameters:
+//      box <const BoundingBox&>: The box.
+// Returns:
+//      <bool>: False if the box is completely outside one of the planes.
+//
+bool Frustum::testBox(const BoundingBox &box) {
+    for (int p = 0; p < 6; p++) {
+        float x = planes[p][0] >= 0.0f ? box.max.x : box.min.x;
+        float y = planes[p][1] >= 0.0f ? box.max.y : box.min.y;
+        float z = planes[p][2] >= 0.0f ? box.max.z : box.min.z;
+
+        if (planes[p][0] * x + planes[p][1] * y + planes[p][2] * z + planes[p][3] < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+//
+// testSphere
+// Description:
+//      Tests a sphere against the frustum.
+// Parameters:
+//      center <const Vector3&>: Center of the sphere.
+//      radius <float>: Radius of the sphere.
+// Returns:
+//      <bool>: False if the sphere is completely outside one of the planes.
+//
+bool Frustum::testSphere(const Vector3 &center, float radius) {
+    for (int p = 0; p < 6; p++) {
+        if (planes[p][0] * center.x + planes[p][1] * center.y + planes[p][2] * center.z + planes[p][3] < -radius)
+            return false;
+    }
+    return true;
+}
+
+//
+// cullBoxes
+// Description:
+//      Tests the boxes of the array from 'first' to 'last' against the frustum, several boxes at a time.
+//      Ranges of one array can be tested on different threads; 'first' has to be a multiple of eight,
+//      as the boxes are read in blocks of up to eight from there.
+// Parameters:
+//      boxes   <const BoundingBoxArray&>: The boxes.
+//      visible <unsigned char*>: Receives 1 for every box that may be visible and 0 otherwise,
+//              one entry per box of the array.
+//      first   <int>: First box to test.
+//      last    <int>: One past the last box to test, -1 for the end of the array.
+// Returns:
+//      <int>: The number of tested boxes that may be visible.
+//
+int Frustum::cullBoxes(const BoundingBoxArray &boxes, unsigned char *visible, int first, int last) {
+    int numVisible = 0;
+    int i = first;
+
+    if (last < 0 || last > boxes.count)
+        last = boxes.count;
+
+#if defined(FRUSTUM_AVX)
+    for (; i < last; i += 8) {
+        __m256 minX = _mm256_loadu_ps(&boxes.minX[i]), maxX = _mm256_loadu_ps(&boxes.maxX[i]);
+        __m256 minY = _mm256_loadu_ps(&boxes.minY[i]), maxY = _mm256_loadu_ps(&boxes.maxY[i]);
+        __m256 minZ = _mm256_loadu_ps(&boxes.minZ[i]), maxZ = _mm256_loadu_ps(&boxes.maxZ[i]);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (int p = 0; p < 6; p++) {
+            __m256 x = planes[p][0] >= 0.0f ? maxX : minX;
+            __m256 y = planes[p][1] >= 0.0f ? maxY : minY;
+            __m256 z = planes[p][2] >= 0.0f ? maxZ : minZ;
+
+            __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(planes[p][0])),
+                                                          _mm256_mul_ps(y, _mm256_set1_ps(planes[p][1]))),
+                                            _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(planes[p][2])),
+                                                          _mm256_set1_ps(planes[p][3])));
+
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+
+        int mask = _mm256_movemask_ps(inside);
+        int numBoxes = last - i < 8 ? last - i : 8;
+
+        for (int b = 0; b < numBoxes; b++) {
+            visible[i + b] = (unsigned char)((mask >> b) & 1);
+            numVisible += visible[i + b];
+        }
+    }
+#elif defined(FRUSTUM_SSE)
+    for (; i < last; i += 4) {
+        __m128 minX = _mm_loadu_ps(&boxes.minX[i]), maxX = _mm_loadu_ps(&boxes.maxX[i]);
+        __m128 minY = _mm_loadu_ps(&boxes.minY[i]), maxY = _mm_loadu_ps(&boxes.maxY[i]);
+        __m128 minZ = _mm_loadu_ps(&boxes.minZ[i]), maxZ = _mm_loadu_ps(&boxes.maxZ[i]);
+        __m128 inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+
+        for (int p = 0; p < 6; p++) {
+            __m128 x = planes[p][0] >= 0.0f ? maxX : minX;
+            __m128 y = planes[p][1] >= 0.0f ? maxY : minY;
+            __m128 z = planes[p][2] >= 0.0f ? maxZ : minZ;
+
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(planes[p][0])),
+                                                    _mm_mul_ps(y, _mm_set1_ps(planes[p][1]))),
+                                         _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(planes[p][2])),
+                                                    _mm_set1_ps(planes[p][3])));
+
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+
+        int mask = _mm_movemask_ps(inside);
+        int numBoxes = last - i < 4 ? last - i : 4;
+
+        for (int b = 0; b < numBoxes; b++) {
+            visible[i + b] = (unsigned char)((mask >> b) & 1);
+            numVisible += visible[i + b];
+        }
+    }
+#else
+    for (; i < last; i++) {
+        BoundingBox box(Vector3(boxes.minX[i], boxes.minY[i], boxes.minZ[i]),
+                        Vector3(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]));
+
+        visible[i] = testBox(box) ? 1 : 0;
+        numVisible += visible[i];
+    }
+#endif
+
+    return numVisible;
+}
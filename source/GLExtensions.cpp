@@ -0,0 +1,186 @@
+// GLExtensions.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/GLExtensions.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__APPLE__) && defined(__MACH__)
+    #include <dlfcn.h>
+#elif !defined(WIN32)
+    #include <GL/glx.h>
+#endif
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+GLFunctions GLExtensions::gl;
+bool GLExtensions::loaded = false;
+int GLExtensions::version = 0;
+std::string GLExtensions::extensions;
+
+static void *getFunction(const char *name);
+static void loadFunction(void *slot, const char *name, const char *alternative = NULL);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// load
+// Description:
+//      Reads the version and extensions of the current OpenGL context and looks up the entry
+//      points. Only the first successful call does anything.
+// Parameters:
+//      None (void).
+// Returns:
+//      <bool>: If a context was current, otherwise nothing is loaded.
+//
+bool GLExtensions::load(void) {
+    if (loaded)
+        return true;
+
+    const char *versionString = (const char *)glGetString(GL_VERSION);
+    const char *extensionString = (const char *)glGetString(GL_EXTENSIONS);
+    int major = 0, minor = 0;
+
+    if (versionString == NULL || sscanf(versionString, "%d.%d", &major, &minor) != 2)
+        return false;
+
+    version = major * 10 + minor;
+    extensions = extensionString != NULL ? extensionString : "";
+
+    memset(&gl, 0, sizeof(gl));
+
+    loadFunction(&gl.genBuffers, "glGenBuffers", "glGenBuffersARB");
+    loadFunction(&gl.deleteBuffers, "glDeleteBuffers", "glDeleteBuffersARB");
+    loadFunction(&gl.bindBuffer, "glBindBuffer", "glBindBufferARB");
+    loadFunction(&gl.bufferData, "glBufferData", "glBufferDataARB");
+    loadFunction(&gl.bufferSubData, "glBufferSubData", "glBufferSubDataARB");
+
+    loadFunction(&gl.createShader, "glCreateShader");
+    loadFunction(&gl.shaderSource, "glShaderSource");
+    loadFunction(&gl.compileShader, "glCompileShader");
+    loadFunction(&gl.getShaderiv, "glGetShaderiv");
+    loadFunction(&gl.deleteShader, "glDeleteShader");
+    loadFunction(&gl.createProgram, "glCreateProgram");
+    loadFunction(&gl.deleteProgram, "glDeleteProgram");
+    loadFunction(&gl.attachShader, "glAttachShader");
+    loadFunction(&gl.bindAttribLocation, "glBindAttribLocation");
+    loadFunction(&gl.linkProgram, "glLinkProgram");
+    loadFunction(&gl.getProgramiv, "glGetProgramiv");
+    loadFunction(&gl.useProgram, "glUseProgram");
+    loadFunction(&gl.getUniformLocation, "glGetUniformLocation");
+    loadFunction(&gl.uniform1i, "glUniform1i");
+    loadFunction(&gl.enableVertexAttribArray, "glEnableVertexAttribArray");
+    loadFunction(&gl.disableVertexAttribArray, "glDisableVertexAttribArray");
+    loadFunction(&gl.vertexAttribPointer, "glVertexAttribPointer");
+
+    loadFunction(&gl.vertexAttribDivisor, "glVertexAttribDivisor", "glVertexAttribDivisorARB");
+    loadFunction(&gl.drawElementsInstanced, "glDrawElementsInstanced", "glDrawElementsInstancedARB");
+
+    loadFunction(&gl.mapBufferRange, "glMapBufferRange");
+    loadFunction(&gl.unmapBuffer, "glUnmapBuffer", "glUnmapBufferARB");
+    loadFunction(&gl.bufferStorage, "glBufferStorage");
+    loadFunction(&gl.fenceSync, "glFenceSync");
+    loadFunction(&gl.clientWaitSync, "glClientWaitSync");
+    loadFunction(&gl.deleteSync, "glDeleteSync");
+
+    loaded = true;
+    return true;
+}
+
+//
+// isLoaded
+// Description:
+//      Checks if the entry points have been loaded.
+// Parameters:
+//      None (void).
+// Returns:
+//      loaded <bool>: If 'load' succeeded.
+//
+bool GLExtensions::isLoaded(void) {
+    return loaded;
+}
+
+//
+// getVersion
+// Description:
+//      Getter function for the OpenGL version of the context 'load' was called with.
+// Parameters:
+//      None (void).
+// Returns:
+//      version <int>: Major version times ten plus minor version, 33 for OpenGL 3.3, 0 if not loaded.
+//
+int GLExtensions::getVersion(void) {
+    return version;
+}
+
+//
+// hasExtension
+// Description:
+//      Searches the extension string of the context for a whole extension name.
+// Parameters:
+//      name <const char*>: The extension, for example "GL_ARB_sync".
+// Returns:
+//      <bool>: If the context has the extension.
+//
+bool GLExtensions::hasExtension(const char *name) {
+    size_t length = strlen(name);
+
+    for (size_t found = extensions.find(name); found != std::string::npos; found = extensions.find(name, found + length)) {
+        bool startsWord = found == 0 || extensions[found - 1] == ' ';
+        bool endsWord = found + length == extensions.length() || extensions[found + length] == ' ';
+
+        if (startsWord && endsWord)
+            return true;
+    }
+    return false;
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// getFunction
+// Description:
+//      Looks up an OpenGL entry point of the current platform.
+// Parameters:
+//      name <const char*>: Name of the function.
+// Returns:
+//      <void*>: The function, NULL if it does not exist.
+//
+static void *getFunction(const char *name) {
+#if defined(__APPLE__) && defined(__MACH__)
+    return dlsym(RTLD_DEFAULT, name);
+#elif defined(WIN32)
+    return (void *)wglGetProcAddress(name);
+#else
+    return (void *)glXGetProcAddressARB((const GLubyte *)name);
+#endif
+}
+
+//
+// loadFunction
+// Description:
+//      Looks up an entry point and stores it in a function pointer.
+// Parameters:
+//      slot        <void*>: Address of the function pointer.
+//      name        <const char*>: Name of the function.
+//      alternative <const char*>: Name to try when the first is missing, normally the ARB one.
+// Returns:
+//      None (void).
+//
+static void loadFunction(void *slot, const char *name, const char *alternative) {
+    void *function = getFunction(name);
+
+    if (function == NULL && alternative != NULL)
+        function = getFunction(alternative);
+
+    memcpy(slot, &function, sizeof(function));
+}
@@ -0,0 +1,596 @@
+// JobSystem.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/JobSystem.h"
+#include <stdlib.h>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const long long JOB_DEQUE_SIZE = 4096;  // Jobs per worker deque, a power of two
+static const int JOB_SPIN_COUNT = 64;          // Attempts to find work before a worker sleeps
+static const int JOB_JOBS_PER_THREAD = 4;      // Default split of 'parallelFor', leaves room for stealing
+
+// Deque owned by the calling thread, -1 if it is not a worker
+static thread_local int workerIndex = -1;
+
+std::atomic<bool> JobSystem::started(false);
+std::atomic<bool> JobSystem::stopping(false);
+std::vector<JobDeque *> JobSystem::deques;
+std::vector<std::thread> JobSystem::workers;
+std::mutex JobSystem::mutex;
+std::condition_variable JobSystem::wake;
+std::deque<Job *> JobSystem::injected;
+std::atomic<int> JobSystem::numInjected(0);
+std::atomic<int> JobSystem::numQueued(0);
+std::atomic<int> JobSystem::numSleeping(0);
+std::atomic<long long> JobSystem::externalExecuted(0);
+std::atomic<long long> JobSystem::injectedJobs(0);
+std::atomic<long long> JobSystem::sleeps(0);
+
+static void stopAtExit(void);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// start
+// Description:
+//      Starts the worker threads. Called on the first use of the job system, call it earlier to choose
+//      the number of threads or to keep the thread start out of the first frame. Does nothing if the
+//      workers are running already. The workers are stopped at exit.
+// Parameters:
+//      numThreads <int>: Threads taking part in the work including the thread waiting for it, so
+//                        one less worker is started, but at least one. Zero for the hardware threads.
+// Returns:
+//      None (void).
+//
+void JobSystem::start(int numThreads) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (started.load())
+        return;
+
+    if (numThreads <= 0)
+        numThreads = (int)std::thread::hardware_concurrency();
+
+    int numWorkers = numThreads > 1 ? numThreads - 1 : 1;
+
+    stopping = false;
+    deques.resize(numWorkers);
+
+    for (int w = 0; w < numWorkers; w++) {
+        JobDeque *deque = new JobDeque;
+        deque->top = 0;
+        deque->bottom = 0;
+        deque->slots = new std::atomic<Job *>[JOB_DEQUE_SIZE];
+        deque->executed = 0;
+        deque->stolen = 0;
+        deques[w] = deque;
+    }
+
+    for (int w = 0; w < numWorkers; w++)
+        workers.push_back(std::thread(workerLoop, w));
+
+    static bool registered = false;
+    if (!registered) {
+        atexit(stopAtExit);
+        registered = true;
+    }
+
+    started = true;
+}
+
+//
+// stop
+// Description:
+//      Lets the workers run the queued jobs and joins them. Jobs still waiting for a counter are not
+//      run. Must not be called from a job or while other threads submit jobs; the next use starts
+//      the workers again.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void JobSystem::stop(void) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!started.load())
+            return;
+
+        stopping = true;
+    }
+
+    wake.notify_all();
+
+    for (int w = 0; w < (int)workers.size(); w++)
+        workers[w].join();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (int w = 0; w < (int)deques.size(); w++) {
+        delete[] deques[w]->slots;
+        delete deques[w];
+    }
+
+    deques.clear();
+    workers.clear();
+    started = false;
+}
+
+//
+// run
+// Description:
+//      Submits a job. It runs on any worker, or on a thread waiting in 'wait', in no particular order
+//      relative to other jobs. A job held back by a dependency is submitted by the job which brings
+//      the dependency to zero, or right away if it is zero already.
+// Parameters:
+//      function   <std::function<void(void)>>: The work.
+//      counter    <JobCounter*>: Counted up now and down when the job has run, NULL if none.
+//      dependency <JobCounter*>: The job runs only after this counter reaches zero, NULL if none.
+// Returns:
+//      None (void).
+//
+void JobSystem::run(const std::function<void(void)> &function, JobCounter *counter, JobCounter *dependency) {
+    ensureStarted();
+
+    Job *job = new Job;
+    job->function = function;
+    job->counter = counter;
+
+    if (counter != NULL)
+        counter->count.fetch_add(1);
+
+    if (dependency != NULL) {
+        std::lock_guard<std::mutex> lock(dependency->mutex);
+
+        if (dependency->count.load() > 0) {
+            dependency->waiting.push_back(job);
+            return;
+        }
+    }
+
+    submit(job);
+}
+
+//
+// wait
+// Description:
+//      Returns when every job of a counter has run. Runs other jobs while waiting instead of blocking,
+//      which may include jobs unrelated to the counter.
+// Parameters:
+//      counter <JobCounter&>: The counter.
+// Returns:
+//      None (void).
+//
+void JobSystem::wait(JobCounter &counter) {
+    while (counter.count.load() > 0) {
+        Job *job = findJob(workerIndex);
+
+        if (job != NULL)
+            execute(job);
+        else
+            std::this_thread::yield();
+    }
+
+    // The job which finished last may still hold the lock, the counter must not go away before it is free
+    std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+//
+// parallelFor
+// Description:
+//      Calls 'function' for contiguous sub ranges covering [begin, end) as jobs and waits for them.
+//      The calling thread runs the first sub range itself. Ranges smaller than twice 'minRange' run
+//      directly on the calling thread.
+// Parameters:
+//      begin    <int>: First index.
+//      end      <int>: One past the last index.
+//      function <std::function<void(int, int)>>: Called with (first, last) of each sub range.
+//      minRange <int>: Smallest number of indices worth a job.
+//      maxJobs  <int>: Most sub ranges to split into, zero for a few per thread so idle workers
+//                      can steal from busy ones.
+// Returns:
+//      None (void).
+//
+void JobSystem::parallelFor(int begin, int end, const std::function<void(int, int)> &function, int minRange,
+                            int maxJobs) {
+    int count = end - begin;
+
+    if (count <= 0)
+        return;
+
+    if (minRange < 1)
+        minRange = 1;
+
+    if (maxJobs <= 0)
+        maxJobs = (getNumWorkers() + 1) * JOB_JOBS_PER_THREAD;
+
+    int numJobs = count / minRange < maxJobs ? count / minRange : maxJobs;
+
+    if (numJobs <= 1) {
+        function(begin, end);
+        return;
+    }
+
+    JobCounter counter;
+
+    // Pushed last to first, so the owner pops the sub ranges next to the one it runs and thieves take the far end
+    for (int j = numJobs - 1; j >= 1; j--) {
+        int first = begin + (int)((long long)count * j / numJobs);
+        int last = begin + (int)((long long)count * (j + 1) / numJobs);
+
+        run([&function, first, last]() { function(first, last); }, &counter);
+    }
+
+    function(begin, begin + (int)((long long)count / numJobs));
+
+    wait(counter);
+}
+
+//
+// getNumWorkers
+// Description:
+//      Getter function for the number of worker threads, starting them if needed.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: The number of workers, at least one.
+//
+int JobSystem::getNumWorkers(void) {
+    ensureStarted();
+
+    return (int)deques.size();
+}
+
+//
+// isWorker
+// Description:
+//      Checks if the calling thread is a worker of the job system.
+// Parameters:
+//      None (void).
+// Returns:
+//      <bool>: If the calling thread is a worker.
+//
+bool JobSystem::isWorker(void) {
+    return workerIndex >= 0;
+}
+
+//
+// getStats
+// Description:
+//      Getter function for the counters of the job system since the last reset.
+// Parameters:
+//      None (void).
+// Returns:
+//      <JobSystemStats>: The counters.
+//
+JobSystemStats JobSystem::getStats(void) {
+    ensureStarted();
+
+    JobSystemStats stats;
+    stats.numWorkers = (int)deques.size();
+    stats.executed = externalExecuted.load(std::memory_order_relaxed);
+    stats.injected = injectedJobs.load(std::memory_order_relaxed);
+    stats.sleeps = sleeps.load(std::memory_order_relaxed);
+
+    for (int w = 0; w < (int)deques.size(); w++) {
+        stats.executed += deques[w]->executed.load(std::memory_order_relaxed);
+        stats.stolen += deques[w]->stolen.load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
+//
+// resetStats
+// Description:
+//      Sets the counters of the job system to zero.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void JobSystem::resetStats(void) {
+    ensureStarted();
+
+    externalExecuted = 0;
+    injectedJobs = 0;
+    sleeps = 0;
+
+    for (int w = 0; w < (int)deques.size(); w++) {
+        deques[w]->executed = 0;
+        deques[w]->stolen = 0;
+    }
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// ensureStarted
+// Description:
+//      Starts the workers with the default number of threads if they are not running.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void JobSystem::ensureStarted(void) {
+    if (!started.load())
+        start();
+}
+
+//
+// workerLoop
+// Description:
+//      Body of a worker thread. Runs jobs while there are any, spins a little when it runs out and
+//      then sleeps until a job is submitted.
+// Parameters:
+//      index <int>: Index of the deque of the worker.
+// Returns:
+//      None (void).
+//
+void JobSystem::workerLoop(int index) {
+    workerIndex = index;
+
+    for (;;) {
+        Job *job = findJob(index);
+
+        for (int spin = 0; job == NULL && spin < JOB_SPIN_COUNT; spin++) {
+            std::this_thread::yield();
+            job = findJob(index);
+        }
+
+        if (job != NULL) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        // Submitting threads count the job before they look for sleepers, and sleepers count
+        // themselves before they look for jobs, so one of the two always sees the other
+        numSleeping.fetch_add(1);
+
+        if (numQueued.load() == 0 && !stopping.load())
+            sleeps.fetch_add(1, std::memory_order_relaxed);
+
+        while (numQueued.load() == 0 && !stopping.load())
+            wake.wait(lock);
+
+        numSleeping.fetch_sub(1);
+
+        if (stopping.load() && numQueued.load() == 0)
+            break;
+    }
+
+    workerIndex = -1;
+}
+
+//
+// submit
+// Description:
+//      Queues a job which is ready to run, on the deque of the calling worker or on the shared queue,
+//      and wakes a sleeping worker.
+// Parameters:
+//      job <Job*>: The job.
+// Returns:
+//      None (void).
+//
+void JobSystem::submit(Job *job) {
+    if (workerIndex < 0 || !push(*deques[workerIndex], job)) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        injected.push_back(job);
+        numInjected.fetch_add(1);
+        injectedJobs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    numQueued.fetch_add(1);
+
+    if (numSleeping.load() > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        wake.notify_one();
+    }
+}
+
+//
+// findJob
+// Description:
+//      Takes the next job for a thread: the newest of its own deque, then the oldest of the shared
+//      queue, then the oldest of another deque, starting with the one after its own.
+// Parameters:
+//      index <int>: Deque of the calling worker, -1 if it is not a worker.
+// Returns:
+//      <Job*>: The job, NULL if none was found.
+//
+Job *JobSystem::findJob(int index) {
+    Job *job = NULL;
+
+    if (index >= 0)
+        job = pop(*deques[index]);
+
+    if (job == NULL && numInjected.load() > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!injected.empty()) {
+            job = injected.front();
+            injected.pop_front();
+            numInjected.fetch_sub(1);
+        }
+    }
+
+    int numDeques = (int)deques.size();
+
+    for (int d = 1; job == NULL && d <= numDeques; d++) {
+        int victim = (index + d) % numDeques;
+
+        if (victim == index)
+            continue;
+
+        job = steal(*deques[victim]);
+
+        if (job != NULL && index >= 0)
+            deques[index]->stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (job != NULL)
+        numQueued.fetch_sub(1);
+
+    return job;
+}
+
+//
+// execute
+// Description:
+//      Runs a job, counts down its counter and frees it.
+// Parameters:
+//      job <Job*>: The job.
+// Returns:
+//      None (void).
+//
+void JobSystem::execute(Job *job) {
+    job->function();
+
+    if (workerIndex >= 0)
+        deques[workerIndex]->executed.fetch_add(1, std::memory_order_relaxed);
+    else
+        externalExecuted.fetch_add(1, std::memory_order_relaxed);
+
+    JobCounter *counter = job->counter;
+    delete job;
+
+    finish(counter);
+}
+
+//
+// finish
+// Description:
+//      Counts down a counter and submits the jobs waiting for it when it reaches zero.
+// Parameters:
+//      counter <JobCounter*>: The counter, NULL if none.
+// Returns:
+//      None (void).
+//
+void JobSystem::finish(JobCounter *counter) {
+    if (counter == NULL)
+        return;
+
+    std::vector<Job *> ready;
+
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex);
+
+        if (counter->count.fetch_sub(1) == 1)
+            ready.swap(counter->waiting);
+    }
+
+    // The counter may be gone from here on
+    for (int j = 0; j < (int)ready.size(); j++)
+        submit(ready[j]);
+}
+
+//
+// push
+// Description:
+//      Adds a job at the bottom of a deque. Only called by the owner of the deque.
+// Parameters:
+//      deque <JobDeque&>: The deque.
+//      job   <Job*>: The job.
+// Returns:
+//      <bool>: False if the deque is full.
+//
+bool JobSystem::push(JobDeque &deque, Job *job) {
+    long long bottom = deque.bottom.load(std::memory_order_relaxed);
+    long long top = deque.top.load(std::memory_order_acquire);
+
+    if (bottom - top >= JOB_DEQUE_SIZE)
+        return false;
+
+    deque.slots[bottom & (JOB_DEQUE_SIZE - 1)].store(job, std::memory_order_release);
+    deque.bottom.store(bottom + 1, std::memory_order_release);
+
+    return true;
+}
+
+//
+// pop
+// Description:
+//      Takes the newest job from the bottom of a deque. Only called by the owner of the deque; races
+//      with thieves only for the last job, which goes to whoever advances 'top' first.
+// Parameters:
+//      deque <JobDeque&>: The deque.
+// Returns:
+//      <Job*>: The job, NULL if the deque is empty.
+//
+Job *JobSystem::pop(JobDeque &deque) {
+    long long bottom = deque.bottom.load(std::memory_order_relaxed) - 1;
+    deque.bottom.store(bottom, std::memory_order_seq_cst);
+
+    long long top = deque.top.load(std::memory_order_seq_cst);
+
+    if (top > bottom) {
+        deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+        return NULL;
+    }
+
+    Job *job = deque.slots[bottom & (JOB_DEQUE_SIZE - 1)].load(std::memory_order_acquire);
+
+    if (top == bottom) {
+        if (!deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst))
+            job = NULL;
+
+        deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return job;
+}
+
+//
+// steal
+// Description:
+//      Takes the oldest job from the top of a deque. Called by any thread.
+// Parameters:
+//      deque <JobDeque&>: The deque.
+// Returns:
+//      <Job*>: The job, NULL if the deque is empty or another thread took the job first.
+//
+Job *JobSystem::steal(JobDeque &deque) {
+    long long top = deque.top.load(std::memory_order_seq_cst);
+    long long bottom = deque.bottom.load(std::memory_order_seq_cst);
+
+    if (top >= bottom)
+        return NULL;
+
+    Job *job = deque.slots[top & (JOB_DEQUE_SIZE - 1)].load(std::memory_order_acquire);
+
+    if (!deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst))
+        return NULL;
+
+    return job;
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// stopAtExit
+// Description:
+//      Joins the workers before the statics they use are destroyed.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+static void stopAtExit(void) {
+    JobSystem::stop();
+}
@@ -1,12 +1,13 @@
 // Light.cpp
 // Created by Edward Glöckner 2023-06-29.
-// Last modified: 2023-08-08.
+// Last modified: 2026-10-17.
 
 //*********************************************************************************
 // Headers
 //*********************************************************************************
 #include "../include/Light.h"
-#include <OpenGL/OpenGL.h>
+#include "../include/RenderBackend.h"
+#include "../include/Profiler.h"
 
 //*********************************************************************************
 // Globals
@@ -31,7 +32,7 @@ std::vector<Light *> Light::lights;
 //      None (void).
 //
 void Light::Initialize(void) {
-    glGetIntegerv(GL_MAX_LIGHTS, &num_lights);
+    RenderBackend::get()->getInteger(GL_MAX_LIGHTS, &num_lights);
 
     for (int i = 0; i < num_lights; i++) {
         available_lights.push_back(GL_LIGHT0 + i);
@@ -94,6 +95,7 @@ Light::~Light() {
     for (std::vector<Light *>::iterator it = lights.begin(); it != lights.end(); it++) {
         if ((*it) == this) {
             lights.erase(it);
+            break;
         }
     }
 }
@@ -111,10 +113,10 @@ void Light::Visible(bool value) {
     visible = value;
 
     if (visible == true) {
-        glEnable(lightNum);
+        RenderBackend::get()->enable(lightNum);
     }
     else {
-        glDisable(lightNum);
+        RenderBackend::get()->disable(lightNum);
     }
 }
 
@@ -137,7 +139,7 @@ void Light::setDiffuse(float r, float g, float b, float a) {
     diffuse[2] = b;
     diffuse[3] = a;
 
-    glLightfv(lightNum, GL_DIFFUSE, diffuse);
+    RenderBackend::get()->setLight(lightNum, GL_DIFFUSE, diffuse);
 }
 
 //
@@ -159,7 +161,7 @@ void Light::setAmbient(float r, float g, float b, float a) {
     ambient[2] = b;
     ambient[3] = a;
 
-    glLightfv(lightNum, GL_AMBIENT, ambient);
+    RenderBackend::get()->setLight(lightNum, GL_AMBIENT, ambient);
 }
 
 //
@@ -181,7 +183,7 @@ void Light::setSpecular(float r, float g, float b, float a) {
     specularity[2] = b;
     specularity[3] = a;
     
-    glLightfv(lightNum, GL_SPECULAR, specularity);
+    RenderBackend::get()->setLight(lightNum, GL_SPECULAR, specularity);
 }
 
 //
@@ -232,7 +234,7 @@ void Light::setPosition(float x, float y, float z) {
     position[1] = y;
     position[2] = z;
     
-    glLightfv(lightNum, GL_POSITION, position);
+    RenderBackend::get()->setLight(lightNum, GL_POSITION, position);
 }
 
 //
@@ -253,7 +255,7 @@ void Light::setSpotDirection(float x, float y, float z) {
     spotDirection[1] = y;
     spotDirection[2] = z;
 
-    glLightfv(lightNum, GL_SPOT_DIRECTION, spotDirection);
+    RenderBackend::get()->setLight(lightNum, GL_SPOT_DIRECTION, spotDirection);
 
 }
 
@@ -270,7 +272,7 @@ void Light::setSpotDirection(float x, float y, float z) {
 void Light::setCutOff(float value) {
     cutoff = value;
 
-    glLightf(lightNum, GL_SPOT_CUTOFF, cutoff);
+    RenderBackend::get()->setLight(lightNum, GL_SPOT_CUTOFF, cutoff);
 }
 
 //
@@ -287,7 +289,7 @@ void Light::setCutOff(float value) {
 void Light::setExponent(float value) {
     exponent = value;
 
-    glLightf(lightNum, GL_SPOT_EXPONENT, exponent);
+    RenderBackend::get()->setLight(lightNum, GL_SPOT_EXPONENT, exponent);
 }
 
 //
@@ -303,9 +305,9 @@ void Light::setExponent(float value) {
 //      None (void).
 //
 void Light::setAttenuation(float constant, float linear, float quadratic) {
-    glLightf(lightNum, GL_CONSTANT_ATTENUATION, constant);
-    glLightf(lightNum, GL_LINEAR_ATTENUATION, linear);
-    glLightf(lightNum, GL_QUADRATIC_ATTENUATION, quadratic);
+    RenderBackend::get()->setLight(lightNum, GL_CONSTANT_ATTENUATION, constant);
+    RenderBackend::get()->setLight(lightNum, GL_LINEAR_ATTENUATION, linear);
+    RenderBackend::get()->setLight(lightNum, GL_QUADRATIC_ATTENUATION, quadratic);
 }
 
 //
@@ -335,7 +337,9 @@ int Light::getLightNum(void) {
 //      None (void).
 //
 void Light::updateLight(void) {
-    glLightfv(lightNum, GL_POSITION, position);
-    glLightfv(lightNum, GL_SPOT_DIRECTION, spotDirection);
+    PROFILE_SCOPE("Light::updateLight");
+
+    RenderBackend::get()->setLight(lightNum, GL_POSITION, position);
+    RenderBackend::get()->setLight(lightNum, GL_SPOT_DIRECTION, spotDirection);
 }
 
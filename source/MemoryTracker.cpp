@@ -0,0 +1,224 @@
+// MemoryTracker.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/MemoryTracker.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const size_t MEMORY_HEADER_SIZE = 16; // Keeps the alignment malloc gives
+
+// Header in front of every allocation
+struct MemoryHeader {
+    size_t bytes;
+    int tag;
+};
+
+MemoryCounters MemoryTracker::counters[MEMORY_NUM_TAGS];
+MemoryCounters MemoryTracker::total;
+
+static const char *MEMORY_TAG_NAMES[MEMORY_NUM_TAGS] = {
+    "mesh",
+    "material",
+    "texture",
+    "lights",
+    "other"
+};
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// allocate
+// Description:
+//      Allocates memory counted under a tag.
+// Parameters:
+//      bytes <size_t>: Size of the memory.
+//      tag   <MEMORY_TAG>: Subsystem the memory is counted under.
+// Returns:
+//      <void*>: The memory, aligned like malloc aligns. Throws std::bad_alloc when out of memory,
+//               like new does.
+//
+void *MemoryTracker::allocate(size_t bytes, MEMORY_TAG tag) {
+    unsigned char *memory = (unsigned char *)malloc(bytes + MEMORY_HEADER_SIZE);
+
+    if (memory == NULL)
+        throw std::bad_alloc();
+
+    MemoryHeader *header = (MemoryHeader *)memory;
+    header->bytes = bytes;
+    header->tag = tag;
+
+    count(counters[tag], (long long)bytes, true);
+    count(total, (long long)bytes, true);
+
+    return memory + MEMORY_HEADER_SIZE;
+}
+
+//
+// deallocate
+// Description:
+//      Frees memory from 'allocate' or 'allocateArray' and takes it off its tag.
+// Parameters:
+//      memory <void*>: The memory, may be NULL.
+// Returns:
+//      None (void).
+//
+void MemoryTracker::deallocate(void *memory) {
+    if (memory == NULL)
+        return;
+
+    unsigned char *base = (unsigned char *)memory - MEMORY_HEADER_SIZE;
+    MemoryHeader *header = (MemoryHeader *)base;
+
+    count(counters[header->tag], (long long)header->bytes, false);
+    count(total, (long long)header->bytes, false);
+
+    free(base);
+}
+
+//
+// getStats
+// Description:
+//      Getter function for the counters of a tag.
+// Parameters:
+//      tag <MEMORY_TAG>: The subsystem.
+// Returns:
+//      <MemoryStats>: Live and peak bytes and allocation counts.
+//
+MemoryStats MemoryTracker::getStats(MEMORY_TAG tag) {
+    return readCounters(counters[tag]);
+}
+
+//
+// getTotalStats
+// Description:
+//      Getter function for the counters of all tags together. The peak is the highest the sum
+//      reached, which may be lower than the sum of the peaks of the tags.
+// Parameters:
+//      None (void).
+// Returns:
+//      <MemoryStats>: Live and peak bytes and allocation counts.
+//
+MemoryStats MemoryTracker::getTotalStats(void) {
+    return readCounters(total);
+}
+
+//
+// resetPeaks
+// Description:
+//      Sets the peaks to the bytes live now, to measure the peak of a phase such as a load.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void MemoryTracker::resetPeaks(void) {
+    for (int t = 0; t < MEMORY_NUM_TAGS; t++)
+        counters[t].peakBytes.store(counters[t].liveBytes.load());
+
+    total.peakBytes.store(total.liveBytes.load());
+}
+
+//
+// getTagName
+// Description:
+//      Getter function for the name of a tag used in the report.
+// Parameters:
+//      tag <MEMORY_TAG>: The subsystem.
+// Returns:
+//      <const char*>: The name.
+//
+const char *MemoryTracker::getTagName(MEMORY_TAG tag) {
+    if (tag < 0 || tag >= MEMORY_NUM_TAGS)
+        return "unknown";
+
+    return MEMORY_TAG_NAMES[tag];
+}
+
+//
+// writeReport
+// Description:
+//      Writes a table of the counters of every tag and of the total.
+// Parameters:
+//      stream <std::ostream&>: Where to write, for example std::cout or a file.
+// Returns:
+//      None (void).
+//
+void MemoryTracker::writeReport(std::ostream &stream) {
+    char line[160];
+
+    snprintf(line, sizeof(line), "%-10s %14s %14s %12s %12s %14s\n",
+             "subsystem", "live bytes", "peak bytes", "live allocs", "allocs", "total bytes");
+    stream << line;
+
+    for (int t = 0; t <= MEMORY_NUM_TAGS; t++) {
+        MemoryStats stats = t < MEMORY_NUM_TAGS ? getStats((MEMORY_TAG)t) : getTotalStats();
+
+        snprintf(line, sizeof(line), "%-10s %14lld %14lld %12lld %12lld %14lld\n",
+                 t < MEMORY_NUM_TAGS ? MEMORY_TAG_NAMES[t] : "total",
+                 stats.liveBytes, stats.peakBytes, stats.liveAllocations, stats.totalAllocations, stats.totalBytes);
+        stream << line;
+    }
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// count
+// Description:
+//      Adds an allocation or a deallocation to counters and raises the peak.
+// Parameters:
+//      counters   <MemoryCounters&>: The counters.
+//      bytes      <long long>: Size of the memory.
+//      allocation <bool>: True for an allocation, false for a deallocation.
+// Returns:
+//      None (void).
+//
+void MemoryTracker::count(MemoryCounters &counters, long long bytes, bool allocation) {
+    if (!allocation) {
+        counters.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+        return;
+    }
+
+    long long live = counters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    long long peak = counters.peakBytes.load(std::memory_order_relaxed);
+
+    while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+//
+// readCounters
+// Description:
+//      Reads counters into plain statistics.
+// Parameters:
+//      counters <const MemoryCounters&>: The counters.
+// Returns:
+//      <MemoryStats>: The values of the counters.
+//
+MemoryStats MemoryTracker::readCounters(const MemoryCounters &counters) {
+    MemoryStats stats;
+    stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    stats.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed);
+    stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+    stats.totalBytes = counters.totalBytes.load(std::memory_order_relaxed);
+
+    return stats;
+}
@@ -0,0 +1,655 @@
+// MeshCodec.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/MeshCodec.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define MESHCODEC_SSE2
+#endif
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+
+static const unsigned char INDEX_CODEC_HEADER = 0xe1;
+static const unsigned char VERTEX_CODEC_HEADER = 0xa1;
+
+// FIFOs hold 16 entries, of which 15 edges and 14 vertices can be referenced from a code nibble
+static const int FIFO_SIZE = 16;
+static const int EDGE_LOOKUP = 15;
+static const int VERTEX_LOOKUP = 14;
+
+static const int VERTEX_CODE_NEXT = 0;
+static const int VERTEX_CODE_EXPLICIT = 15;
+static const int EDGE_CODE_NONE = 15;
+
+static const int VERTEX_BLOCK_MAX = 256;
+static const int VERTEX_BLOCK_BYTES = 8192;
+static const int VERTEX_SIZE_MAX = 256;
+
+// Packed size of a group of 16 byte plane values per group mode
+static const int GROUP_BYTES[4] = {0, 4, 8, 16};
+
+// Two FIFOs with the most recently pushed entry at lookup index 0
+struct IndexCodecState {
+    unsigned int edges[FIFO_SIZE][2];
+    unsigned int vertices[FIFO_SIZE];
+    unsigned int edgeOffset;
+    unsigned int vertexOffset;
+    unsigned int next;
+    unsigned int last;
+
+    IndexCodecState() {
+        std::memset(edges, 0xff, sizeof(edges));
+        std::memset(vertices, 0xff, sizeof(vertices));
+        edgeOffset = 0;
+        vertexOffset = 0;
+        next = 0;
+        last = 0;
+    }
+
+    void pushEdge(unsigned int a, unsigned int b) {
+        edges[edgeOffset & (FIFO_SIZE - 1)][0] = a;
+        edges[edgeOffset & (FIFO_SIZE - 1)][1] = b;
+        edgeOffset++;
+    }
+
+    void pushVertex(unsigned int v) {
+        vertices[vertexOffset & (FIFO_SIZE - 1)] = v;
+        vertexOffset++;
+    }
+
+    const unsigned int *getEdge(int index) {
+        return edges[(edgeOffset - 1 - index) & (FIFO_SIZE - 1)];
+    }
+
+    unsigned int getVertex(int index) {
+        return vertices[(vertexOffset - 1 - index) & (FIFO_SIZE - 1)];
+    }
+
+    int findEdge(unsigned int a, unsigned int b) {
+        for (int i = 0; i < EDGE_LOOKUP; i++) {
+            const unsigned int *edge = getEdge(i);
+            if (edge[0] == a && edge[1] == b)
+                return i;
+        }
+        return -1;
+    }
+
+    int findVertex(unsigned int v) {
+        for (int i = 0; i < VERTEX_LOOKUP; i++) {
+            if (getVertex(i) == v)
+                return i;
+        }
+        return -1;
+    }
+};
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// writeVarint
+// Description:
+//      Appends an unsigned value as a little endian base 128 varint.
+// Parameters:
+//      value <unsigned int>: The value to write.
+//      out   <std::vector<unsigned char>&>: The output stream.
+// Returns:
+//      None (void).
+//
+static void writeVarint(unsigned int value, std::vector<unsigned char> &out) {
+    while (value >= 0x80) {
+        out.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((unsigned char)value);
+}
+
+//
+// readVarint
+// Description:
+//      Reads a little endian base 128 varint.
+// Parameters:
+//      data  <const unsigned char*&>: Read position, advanced past the varint.
+//      end   <const unsigned char*>: End of the input.
+//      value <unsigned int&>: The decoded value.
+// Returns:
+//      <bool>: False if the input ended inside the varint.
+//
+static bool readVarint(const unsigned char *&data, const unsigned char *end, unsigned int &value) {
+    value = 0;
+
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (data >= end)
+            return false;
+
+        unsigned char byte = *data++;
+        value |= (unsigned int)(byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+//
+// encodeVertexIndex
+// Description:
+//      Finds the cheapest code for one triangle corner and updates the codec state like the decoder will.
+// Parameters:
+//      state    <IndexCodecState&>: The codec state.
+//      index    <unsigned int>: The vertex index to encode.
+//      explicitData <std::vector<unsigned char>&>: Receives the varint if the index has to be stored explicitly.
+// Returns:
+//      <int>: The 4-bit vertex code.
+//
+static int encodeVertexIndex(IndexCodecState &state, unsigned int index, std::vector<unsigned char> &explicitData) {
+    if (index == state.next) {
+        state.next++;
+        state.pushVertex(index);
+        return VERTEX_CODE_NEXT;
+    }
+
+    int fifo = state.findVertex(index);
+    if (fifo >= 0)
+        return fifo + 1;
+
+    int delta = (int)(index - state.last);
+    writeVarint(((unsigned int)delta << 1) ^ (unsigned int)(delta >> 31), explicitData);
+
+    state.last = index;
+    state.pushVertex(index);
+    return VERTEX_CODE_EXPLICIT;
+}
+
+//
+// decodeVertexIndex
+// Description:
+//      Decodes one triangle corner from its 4-bit code and updates the codec state.
+// Parameters:
+//      state <IndexCodecState&>: The codec state.
+//      code  <int>: The 4-bit vertex code.
+//      data  <const unsigned char*&>: Read position for explicit indices.
+//      end   <const unsigned char*>: End of the input.
+//      index <unsigned int&>: The decoded vertex index.
+// Returns:
+//      <bool>: False if the input is corrupt.
+//
+static bool decodeVertexIndex(IndexCodecState &state, int code, const unsigned char *&data,
+                              const unsigned char *end, unsigned int &index) {
+    if (code == VERTEX_CODE_NEXT) {
+        index = state.next++;
+        state.pushVertex(index);
+        return true;
+    }
+
+    if (code == VERTEX_CODE_EXPLICIT) {
+        unsigned int zigzag;
+        if (!readVarint(data, end, zigzag))
+            return false;
+
+        int delta = (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+        index = state.last + (unsigned int)delta;
+
+        state.last = index;
+        state.pushVertex(index);
+        return true;
+    }
+
+    if (code - 1 >= VERTEX_LOOKUP)
+        return false;
+
+    index = state.getVertex(code - 1);
+    return true;
+}
+
+//
+// getVertexBlockSize
+// Description:
+//      Number of vertices coded per block, a multiple of 16 chosen so a transposed block fits in 8 KB.
+// Parameters:
+//      vertexSize <size_t>: Size of one vertex in bytes.
+// Returns:
+//      <int>: The block size.
+//
+static int getVertexBlockSize(size_t vertexSize) {
+    int blockSize = (int)((VERTEX_BLOCK_BYTES / vertexSize) & ~(size_t)15);
+
+    if (blockSize > VERTEX_BLOCK_MAX)
+        blockSize = VERTEX_BLOCK_MAX;
+    if (blockSize < 16)
+        blockSize = 16;
+
+    return blockSize;
+}
+
+//
+// encodeBytePlane
+// Description:
+//      Packs one zigzag coded byte plane of a vertex block in groups of 16 values.
+//      Every group gets a 2-bit mode: 0 all zero, 1 two bits, 2 four bits, 3 raw bytes.
+// Parameters:
+//      deltas <const unsigned char*>: The zigzag coded deltas, padded with zeros to a multiple of 16.
+//      count  <int>: Number of deltas, a multiple of 16.
+//      out    <std::vector<unsigned char>&>: The output stream.
+// Returns:
+//      None (void).
+//
+static void encodeBytePlane(const unsigned char *deltas, int count, std::vector<unsigned char> &out) {
+    int groups = count / 16;
+    size_t headerOffset = out.size();
+
+    out.resize(out.size() + (groups + 3) / 4, 0);
+
+    for (int g = 0; g < groups; g++) {
+        const unsigned char *group = deltas + g * 16;
+
+        unsigned char largest = 0;
+        for (int i = 0; i < 16; i++)
+            largest |= group[i];
+
+        int mode = largest == 0 ? 0 : largest < 4 ? 1 : largest < 16 ? 2 : 3;
+        out[headerOffset + g / 4] |= (unsigned char)(mode << ((g % 4) * 2));
+
+        if (mode == 1) {
+            for (int i = 0; i < 16; i += 4)
+                out.push_back((unsigned char)((group[i] << 6) | (group[i + 1] << 4) | (group[i + 2] << 2) | group[i + 3]));
+        }
+        else if (mode == 2) {
+            for (int i = 0; i < 16; i += 2)
+                out.push_back((unsigned char)((group[i] << 4) | group[i + 1]));
+        }
+        else if (mode == 3) {
+            out.insert(out.end(), group, group + 16);
+        }
+    }
+}
+
+//
+// decodeBytePlane
+// Description:
+//      Unpacks one byte plane written by 'encodeBytePlane'.
+// Parameters:
+//      data   <const unsigned char*&>: Read position, advanced past the byte plane.
+//      end    <const unsigned char*>: End of the input.
+//      deltas <unsigned char*>: Receives the zigzag coded deltas, padded to a multiple of 16.
+//      count  <int>: Number of deltas.
+// Returns:
+//      <bool>: False if the input ended inside the byte plane.
+//
+static bool decodeBytePlane(const unsigned char *&data, const unsigned char *end, unsigned char *deltas,
+                            int count) {
+    int groups = (count + 15) / 16;
+    const unsigned char *header = data;
+
+    if (end - data < (groups + 3) / 4)
+        return false;
+
+    data += (groups + 3) / 4;
+
+    for (int g = 0; g < groups; g++) {
+        unsigned char *group = deltas + g * 16;
+        int mode = (header[g / 4] >> ((g % 4) * 2)) & 3;
+
+        if (end - data < GROUP_BYTES[mode])
+            return false;
+
+        if (mode == 0) {
+            std::memset(group, 0, 16);
+        }
+        else if (mode == 1) {
+#ifdef MESHCODEC_SSE2
+            int packed;
+            std::memcpy(&packed, data, 4);
+
+            __m128i bytes = _mm_cvtsi32_si128(packed);
+            __m128i mask = _mm_set1_epi8(3);
+            __m128i first = _mm_and_si128(_mm_srli_epi16(bytes, 6), mask);
+            __m128i second = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+            __m128i third = _mm_and_si128(_mm_srli_epi16(bytes, 2), mask);
+            __m128i fourth = _mm_and_si128(bytes, mask);
+
+            _mm_storeu_si128((__m128i*)group, _mm_unpacklo_epi16(_mm_unpacklo_epi8(first, second),
+                                                                 _mm_unpacklo_epi8(third, fourth)));
+#else
+            for (int i = 0; i < 4; i++) {
+                unsigned char byte = data[i];
+                group[i * 4 + 0] = byte >> 6;
+                group[i * 4 + 1] = (byte >> 4) & 3;
+                group[i * 4 + 2] = (byte >> 2) & 3;
+                group[i * 4 + 3] = byte & 3;
+            }
+#endif
+        }
+        else if (mode == 2) {
+#ifdef MESHCODEC_SSE2
+            __m128i bytes = _mm_loadl_epi64((const __m128i*)data);
+            __m128i mask = _mm_set1_epi8(15);
+            __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+            __m128i low = _mm_and_si128(bytes, mask);
+
+            _mm_storeu_si128((__m128i*)group, _mm_unpacklo_epi8(high, low));
+#else
+            for (int i = 0; i < 8; i++) {
+                unsigned char byte = data[i];
+                group[i * 2 + 0] = byte >> 4;
+                group[i * 2 + 1] = byte & 15;
+            }
+#endif
+        }
+        else {
+            std::memcpy(group, data, 16);
+        }
+        data += GROUP_BYTES[mode];
+    }
+    return true;
+}
+
+#ifdef MESHCODEC_SSE2
+//
+// decodeVertexGroup
+// Description:
+//      Transposes 16 vertices back from their byte planes and undoes the deltas, 16 bytes at a time.
+//      Four rounds of byte interleaving rotate the (row, column) bits of a 16x16 byte matrix by four,
+//      which is a transpose.
+// Parameters:
+//      planes     <const unsigned char*>: The zigzag coded byte planes of the block.
+//      blockSize  <int>: Distance in bytes between two byte planes.
+//      vertexSize <size_t>: Size of one vertex in bytes, a multiple of 16.
+//      previous   <unsigned char*>: The previous vertex, updated to the last decoded vertex.
+//      target     <unsigned char*>: Receives the 16 vertices.
+// Returns:
+//      None (void).
+//
+static void decodeVertexGroup(const unsigned char *planes, int blockSize, size_t vertexSize,
+                              unsigned char *previous, unsigned char *target) {
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i low7 = _mm_set1_epi8(0x7f);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (size_t k = 0; k < vertexSize; k += 16) {
+        __m128i rows[16];
+        __m128i temp[16];
+
+        for (int r = 0; r < 16; r++)
+            rows[r] = _mm_loadu_si128((const __m128i*)(planes + (k + r) * blockSize));
+
+        for (int round = 0; round < 4; round++) {
+            for (int r = 0; r < 8; r++) {
+                temp[r * 2 + 0] = _mm_unpacklo_epi8(rows[r], rows[r + 8]);
+                temp[r * 2 + 1] = _mm_unpackhi_epi8(rows[r], rows[r + 8]);
+            }
+            for (int r = 0; r < 16; r++)
+                rows[r] = temp[r];
+        }
+
+        __m128i last = _mm_loadu_si128((const __m128i*)(previous + k));
+
+        for (int v = 0; v < 16; v++) {
+            __m128i zigzag = rows[v];
+            __m128i delta = _mm_xor_si128(_mm_and_si128(_mm_srli_epi16(zigzag, 1), low7),
+                                          _mm_sub_epi8(zero, _mm_and_si128(zigzag, one)));
+
+            last = _mm_add_epi8(last, delta);
+            _mm_storeu_si128((__m128i*)(target + v * vertexSize + k), last);
+        }
+        _mm_storeu_si128((__m128i*)(previous + k), last);
+    }
+}
+#endif
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// encodeIndexBuffer
+// Description:
+//      Compresses a triangle list. Works best when vertices are numbered in order of first use,
+//      which is how CompiledMesh emits them.
+// Parameters:
+//      indices    <const unsigned int*>: The triangle list.
+//      indexCount <size_t>: Number of indices, a multiple of 3.
+//      out        <std::vector<unsigned char>&>: Receives the compressed data.
+// Returns:
+//      None (void).
+//
+void MeshCodec::encodeIndexBuffer(const unsigned int *indices, size_t indexCount, std::vector<unsigned char> &out) {
+    IndexCodecState state;
+    std::vector<unsigned char> explicitData;
+
+    out.clear();
+    out.reserve(indexCount / 3 + 16);
+    out.push_back(INDEX_CODEC_HEADER);
+
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        unsigned int a = indices[i + 0];
+        unsigned int b = indices[i + 1];
+        unsigned int c = indices[i + 2];
+
+        // Rotate the triangle so that a shared edge comes first
+        int edge = -1;
+        for (int rotation = 0; rotation < 3; rotation++) {
+            edge = state.findEdge(a, b);
+            if (edge >= 0)
+                break;
+
+            unsigned int temp = a;
+            a = b;
+            b = c;
+            c = temp;
+        }
+
+        explicitData.clear();
+
+        if (edge >= 0) {
+            int code = encodeVertexIndex(state, c, explicitData);
+
+            out.push_back((unsigned char)((edge << 4) | code));
+            out.insert(out.end(), explicitData.begin(), explicitData.end());
+
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+        }
+        else {
+            int codeA = encodeVertexIndex(state, a, explicitData);
+            int codeB = encodeVertexIndex(state, b, explicitData);
+            int codeC = encodeVertexIndex(state, c, explicitData);
+
+            out.push_back((unsigned char)(EDGE_CODE_NONE << 4));
+            out.push_back((unsigned char)((codeA << 4) | codeB));
+            out.push_back((unsigned char)(codeC << 4));
+            out.insert(out.end(), explicitData.begin(), explicitData.end());
+
+            state.pushEdge(b, a);
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+        }
+    }
+}
+
+//
+// decodeIndexBuffer
+// Description:
+//      Decompresses a triangle list written by 'encodeIndexBuffer'.
+// Parameters:
+//      data       <const unsigned char*>: The compressed data.
+//      size       <size_t>: Size of the compressed data in bytes.
+//      indices    <unsigned int*>: Receives the triangle list.
+//      indexCount <size_t>: Number of indices, a multiple of 3.
+// Returns:
+//      <bool>: False if the data is corrupt or does not hold 'indexCount' indices.
+//
+bool MeshCodec::decodeIndexBuffer(const unsigned char *data, size_t size, unsigned int *indices, size_t indexCount) {
+    const unsigned char *end = data + size;
+
+    if (size < 1 || *data++ != INDEX_CODEC_HEADER || indexCount % 3 != 0)
+        return false;
+
+    IndexCodecState state;
+
+    for (size_t i = 0; i < indexCount; i += 3) {
+        if (data >= end)
+            return false;
+
+        unsigned char code = *data++;
+        int edge = code >> 4;
+        unsigned int a, b, c;
+
+        if (edge != EDGE_CODE_NONE) {
+            const unsigned int *shared = state.getEdge(edge);
+            a = shared[0];
+            b = shared[1];
+
+            if (!decodeVertexIndex(state, code & 15, data, end, c))
+                return false;
+
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+        }
+        else {
+            if (end - data < 2)
+                return false;
+
+            int codeA = data[0] >> 4;
+            int codeB = data[0] & 15;
+            int codeC = data[1] >> 4;
+            data += 2;
+
+            if (!decodeVertexIndex(state, codeA, data, end, a) ||
+                !decodeVertexIndex(state, codeB, data, end, b) ||
+                !decodeVertexIndex(state, codeC, data, end, c))
+                return false;
+
+            state.pushEdge(b, a);
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+        }
+
+        indices[i + 0] = a;
+        indices[i + 1] = b;
+        indices[i + 2] = c;
+    }
+    return data == end;
+}
+
+//
+// encodeVertexBuffer
+// Description:
+//      Compresses a vertex stream. Quantized vertices compress considerably better than floats
+//      since their byte planes change slowly between neighbouring vertices.
+// Parameters:
+//      vertices    <const void*>: The vertex stream.
+//      vertexCount <size_t>: Number of vertices.
+//      vertexSize  <size_t>: Size of one vertex in bytes, at most 256.
+//      out         <std::vector<unsigned char>&>: Receives the compressed data, left empty on failure.
+// Returns:
+//      <bool>: False if the vertex size is 0 or above 256, nothing is encoded then.
+//
+bool MeshCodec::encodeVertexBuffer(const void *vertices, size_t vertexCount, size_t vertexSize,
+                                   std::vector<unsigned char> &out) {
+    const unsigned char *source = (const unsigned char*)vertices;
+
+    out.clear();
+
+    // The decoder rejects these sizes, and 'previous' holds one vertex
+    if (vertexSize == 0 || vertexSize > VERTEX_SIZE_MAX)
+        return false;
+
+    int blockSize = getVertexBlockSize(vertexSize);
+
+    unsigned char previous[VERTEX_SIZE_MAX] = {0};
+    unsigned char deltas[VERTEX_BLOCK_MAX];
+
+    out.reserve(vertexCount * vertexSize / 2 + 16);
+    out.push_back(VERTEX_CODEC_HEADER);
+
+    for (size_t start = 0; start < vertexCount; start += blockSize) {
+        int count = (int)(vertexCount - start < (size_t)blockSize ? vertexCount - start : (size_t)blockSize);
+        int padded = (count + 15) & ~15;
+
+        for (size_t k = 0; k < vertexSize; k++) {
+            unsigned char last = previous[k];
+
+            for (int i = 0; i < count; i++) {
+                unsigned char value = source[(start + i) * vertexSize + k];
+                unsigned char delta = (unsigned char)(value - last);
+
+                deltas[i] = (unsigned char)((delta << 1) ^ (unsigned char)((signed char)delta >> 7));
+                last = value;
+            }
+            std::memset(deltas + count, 0, padded - count);
+
+            encodeBytePlane(deltas, padded, out);
+            previous[k] = last;
+        }
+    }
+    return true;
+}
+
+//
+// decodeVertexBuffer
+// Description:
+//      Decompresses a vertex stream written by 'encodeVertexBuffer'.
+// Parameters:
+//      data        <const unsigned char*>: The compressed data.
+//      size        <size_t>: Size of the compressed data in bytes.
+//      vertices    <void*>: Receives the vertex stream.
+//      vertexCount <size_t>: Number of vertices.
+//      vertexSize  <size_t>: Size of one vertex in bytes, at most 256.
+// Returns:
+//      <bool>: False if the data is corrupt or does not hold 'vertexCount' vertices.
+//
+bool MeshCodec::decodeVertexBuffer(const unsigned char *data, size_t size, void *vertices, size_t vertexCount,
+                                   size_t vertexSize) {
+    const unsigned char *end = data + size;
+    unsigned char *target = (unsigned char*)vertices;
+
+    if (size < 1 || *data++ != VERTEX_CODEC_HEADER || vertexSize == 0 || vertexSize > VERTEX_SIZE_MAX)
+        return false;
+
+    int blockSize = getVertexBlockSize(vertexSize);
+
+    unsigned char previous[VERTEX_SIZE_MAX] = {0};
+    unsigned char planes[VERTEX_BLOCK_BYTES];
+
+    for (size_t start = 0; start < vertexCount; start += blockSize) {
+        int count = (int)(vertexCount - start < (size_t)blockSize ? vertexCount - start : (size_t)blockSize);
+
+        for (size_t k = 0; k < vertexSize; k++) {
+            if (!decodeBytePlane(data, end, planes + k * blockSize, count))
+                return false;
+        }
+
+        unsigned char *vertex = target + start * vertexSize;
+        int i = 0;
+
+#ifdef MESHCODEC_SSE2
+        if (vertexSize % 16 == 0) {
+            for (; i + 16 <= count; i += 16) {
+                decodeVertexGroup(planes + i, blockSize, vertexSize, previous, vertex);
+                vertex += 16 * vertexSize;
+            }
+        }
+#endif
+
+        // Transpose back one vertex at a time, so the deltas of different bytes are undone independently
+        for (; i < count; i++) {
+            for (size_t k = 0; k < vertexSize; k++) {
+                unsigned char zigzag = planes[k * blockSize + i];
+                previous[k] = (unsigned char)(previous[k] + ((zigzag >> 1) ^ -(zigzag & 1)));
+                vertex[k] = previous[k];
+            }
+            vertex += vertexSize;
+        }
+    }
+    return data == end;
+}
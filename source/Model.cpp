@@ -1,11 +1,28 @@
 // model.cpp
 // Created by Edward Glöckner 2023-06-29.
-// Last modified: 2023-08-09.
+// Last modified: 2026-10-17.
 
 //*********************************************************************************
 // Headers
 //*********************************************************************************
-#include "../include/model.h"
+#include "../include/Model.h"
+#include "../include/NormalGenerator.h"
+#include "../include/FaceParser.h"
+#include "../include/PVS.h"
+#include "../include/RenderQueue.h"
+#include "../include/TransparencySorter.h"
+#include "../include/RenderBackend.h"
+#include "../include/Profiler.h"
+#include "../include/Parallel.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int MODEL_MIN_PARALLEL_FACES = 4096;   // Faces worth a job in the passes after parsing
+static const int MODEL_MIN_PARALLEL_OBJECTS = 16;   // Group objects worth a job in 'computeBounds'
+static const int MODEL_MIN_PARALLEL_BLOCKS = 512;   // Blocks of eight boxes worth a job in 'cullObjects'
+
+static void cullBoxRanges(Frustum &frustum, const BoundingBoxArray &boxes, unsigned char *visible);
 
 //*********************************************************************************
 // Public class functions
@@ -23,18 +40,21 @@
 //
 Model::Model(std::string in_filename) {
     objectLoaded = false;
+    cullingEnabled = true;
+    occlusionBuffer = NULL;
+    visibleSet = NULL;
+    transparencySorter = NULL;
     
     if  (in_filename != "") {
         loadObject(in_filename);
     }
-    displayList = 0;
 }
 
 //
 // ~Model
 // Description:
 //      Destructors.
-//      Destroys all the objects through the 'deleteObjects' function.
+//      Destroys all the objects through the 'deleteObjects' function and the transparency sorter.
 // Parameters:
 //      None (void).
 // Returns:
@@ -42,79 +62,117 @@ Model::Model(std::string in_filename) {
 //
 Model::~Model() {
     deleteObjects();
+
+    delete transparencySorter;
 }
 
 //
 // drawModel
 // Description:
-//      Draws the entire model.
+//      Draws the entire model, opaque faces first.
+//      With culling enabled, the group objects and face batches outside the view frustum of the
+//      current OpenGL matrices are skipped, as are the group objects the potentially visible set
+//      cannot see from the camera and those hidden in the occlusion buffer, if they are set.
+//      With transparency sorting enabled, the transparent faces are drawn back to front.
 // Parameters:
 //      None (void).
 // Returns:
 //      None (void).
 //
 void Model::drawModel(void) {
+    PROFILE_SCOPE("Model::drawModel");
+
     if (!objectLoaded) 
         return;
-    
-    if (displayList != 0) {
-        glCallList(displayList);
-        return;
-    }
 
-    displayList = glGenLists(1);
-    glNewList(displayList, GL_COMPILE_AND_EXECUTE);
+    if (cullingEnabled) {
+        Frustum frustum;
+        frustum.extractFromGL();
+        cullObjects(frustum);
+
+        if (visibleSet != NULL)
+            cullInvisibleObjects(*visibleSet, getViewPoint());
+
+        if (occlusionBuffer != NULL)
+            cullOccludedObjects(*occlusionBuffer);
+    }
 
     drawObject(false);
-    drawObject(true);
 
-    glEndList();
+    if (transparencySorter != NULL) {
+        if (!transparencySorter->isBuilt())
+            transparencySorter->build(*this);
+
+        transparencySorter->sort(getViewPoint());
+        transparencySorter->draw(objectVisible.empty() ? NULL : &objectVisible[0], batchVisible.empty() ? NULL : &batchVisible[0]);
+    }
+    else {
+        drawObject(true);
+    }
 }
 
 //
 // drawObject
 // Description:
-//      Draw a specific object in the model with optional transparency.
+//      Draws the visible face batches of the model which are either opaque or transparent.
 // Parameters:
-//      transparency <bool>: To draw the object as transparent or not.
+//      transparency <bool>: Draw the transparent batches instead of the opaque ones.
 // Returns:
 //      None (void).
 //
 void Model::drawObject(bool transparency) {
-    Material *lastMaterial = NULL;
+    int batchIndex = 0;
+
     for (int i = 0; i < (int)objects.size(); i++) {
         GroupObject *object = objects[i];
 
-        for (int n = 0; n < (int)object->faces.size(); n++) {
-            Face *face = object->faces[n];
-
-            Material *material = face->material;
-
-            if (material != lastMaterial) {
-                if (transparency == false && material->alpha < 1.0f) 
-                    continue;
-                
-                material->Kd[3] = material->alpha;
-                glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, (GLfloat*)material->Ka);
-                glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, (GLfloat*)material->Kd);
-                glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, (GLfloat*)material->Ks);
-                glMaterialfv(GL_FRONT_AND_BACK, GL_EMISSION, (GLfloat*)material->Ke);
-                glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, material->shininess);
-            
-                if (material->diffuseMap != NULL) {
-                    glEnable(GL_TEXTURE_2D);
-                    glBindTexture(GL_TEXTURE_2D, material->diffuseMap->texID);
-                }
-                else {
-                    glDisable(GL_TEXTURE_2D);
-                }
-                
-                lastMaterial = material;
-            } 
-            drawFace(*face);
+        if (!objectVisible[i]) {
+            batchIndex += (int)object->batches.size();
+            continue;
+        }
+
+        for (int b = 0; b < (int)object->batches.size(); b++, batchIndex++) {
+            FaceBatch &batch = object->batches[b];
+
+            bool transparent = batch.material != NULL && batch.material->alpha < 1.0f;
+
+            if (transparent != transparency || !batchVisible[batchIndex])
+                continue;
+
+            applyMaterial(batch.material);
+            drawBatch(i, b);
         }
     }
-    glDisable(GL_TEXTURE_2D);
+    RenderBackend::get()->disable(GL_TEXTURE_2D);
+}
+
+//
+// drawBatch
+// Description:
+//      Draws the faces of a face batch without setting its material.
+//      The faces are compiled into a display list the first time the batch is drawn.
+// Parameters:
+//      object <int>: Index of the group object.
+//      batch  <int>: Index of the face batch in the group object.
+// Returns:
+//      None (void).
+//
+void Model::drawBatch(int object, int batch) {
+    FaceBatch &faceBatch = objects[object]->batches[batch];
+    RenderBackend *backend = RenderBackend::get();
+
+    if (faceBatch.displayList != 0) {
+        backend->callList(faceBatch.displayList);
+        return;
+    }
+
+    faceBatch.displayList = backend->createList();
+    backend->beginList(faceBatch.displayList, GL_COMPILE_AND_EXECUTE);
+
+    for (int f = faceBatch.firstFace; f < faceBatch.firstFace + faceBatch.numFaces; f++)
+        drawFace(*objects[object]->faces[f]);
+
+    backend->endList();
 }
 
 //
@@ -127,24 +185,236 @@ void Model::drawObject(bool transparency) {
 //      None (void).
 //
 void Model::drawFace(Face& face) {
+    RenderBackend *backend = RenderBackend::get();
+
     if ((int)face.numVertices <= 3) 
-        glBegin(GL_TRIANGLES);
+        backend->begin(GL_TRIANGLES);
     
     else 
-        glBegin(GL_POLYGON);
+        backend->begin(GL_POLYGON);
     
     for (int v = 0; v < (int)face.numVertices; v++) {
         if ((int)face.numUVWs > v && face.UVWs != NULL) 
-            glTexCoord2f(face.UVWs[v]->x, face.UVWs[v]->y);
+            backend->texCoord(face.UVWs[v]->x, face.UVWs[v]->y);
         
         if ((int)face.numNormals > v && face.normals != NULL) 
-            glNormal3d(face.normals[v]->x, face.normals[v]->y, face.normals[v]->z);
+            backend->normal(face.normals[v]->x, face.normals[v]->y, face.normals[v]->z);
         
         if ((int)face.numVertices > v && face.vertices != NULL) 
-            glVertex3d(face.vertices[v]->x, face.vertices[v]->y, face.vertices[v]->z);
+            backend->vertex(face.vertices[v]->x, face.vertices[v]->y, face.vertices[v]->z);
         
     }
-    glEnd();
+    backend->end();
+}
+
+//
+// setCulling
+// Description:
+//      Enables or disables view frustum culling in 'drawModel'.
+// Parameters:
+//      value <bool>: If culling should be enabled or not.
+// Returns:
+//      None (void).
+//
+void Model::setCulling(bool value) {
+    cullingEnabled = value;
+
+    if (!cullingEnabled) {
+        objectVisible.assign(objectVisible.size(), 1);
+        batchVisible.assign(batchVisible.size(), 1);
+    }
+}
+
+//
+// setTransparencySorting
+// Description:
+//      Enables or disables sorting the transparent faces back to front in 'drawModel'. Without
+//      sorting the transparent faces are drawn in the order of the file.
+// Parameters:
+//      value <bool>: If the transparent faces should be sorted.
+// Returns:
+//      None (void).
+//
+void Model::setTransparencySorting(bool value) {
+    if (value && transparencySorter == NULL) {
+        transparencySorter = new TransparencySorter();
+    }
+    else if (!value && transparencySorter != NULL) {
+        delete transparencySorter;
+        transparencySorter = NULL;
+    }
+}
+
+//
+// getTransparencySorter
+// Description:
+//      Getter function for the transparency sorter.
+// Parameters:
+//      None (void).
+// Returns:
+//      transparencySorter <TransparencySorter*>: The sorter, NULL if sorting is disabled.
+//
+TransparencySorter *Model::getTransparencySorter(void) {
+    return transparencySorter;
+}
+
+//
+// cullObjects
+// Description:
+//      Updates which group objects and face batches are visible in the frustum.
+//      The bounding boxes are tested several at a time, see Frustum::cullBoxes, and large
+//      arrays are split over the threads of the job system.
+// Parameters:
+//      frustum <Frustum&>: The view frustum in model space.
+// Returns:
+//      <int>: Number of visible face batches.
+//
+int Model::cullObjects(Frustum &frustum) {
+    if (objectBounds.count == 0)
+        return 0;
+
+    cullBoxRanges(frustum, objectBounds, &objectVisible[0]);
+
+    if (batchBounds.count == 0)
+        return 0;
+
+    cullBoxRanges(frustum, batchBounds, &batchVisible[0]);
+
+    return countVisibleBatches();
+}
+
+//
+// cullOccludedObjects
+// Description:
+//      Hides the visible group objects and face batches which are behind the occluders of an
+//      occlusion buffer. Run after 'cullObjects', the buffer has to be rendered with the matrix
+//      of the current view.
+// Parameters:
+//      buffer <OcclusionBuffer&>: The rendered occlusion buffer, in model space.
+// Returns:
+//      <int>: Number of visible face batches.
+//
+int Model::cullOccludedObjects(OcclusionBuffer &buffer) {
+    if (objectBounds.count == 0 || batchBounds.count == 0)
+        return 0;
+
+    buffer.cullBoxes(objectBounds, &objectVisible[0]);
+
+    // Batches of hidden objects are skipped anyway, don't spend time testing them
+    int batchIndex = 0;
+    for (int i = 0; i < (int)objects.size(); i++) {
+        for (int b = 0; b < (int)objects[i]->batches.size(); b++, batchIndex++) {
+            if (!objectVisible[i])
+                batchVisible[batchIndex] = 0;
+        }
+    }
+
+    buffer.cullBoxes(batchBounds, &batchVisible[0]);
+
+    return countVisibleBatches();
+}
+
+//
+// cullInvisibleObjects
+// Description:
+//      Hides the visible group objects which cannot be seen from the cell of the view point in a
+//      potentially visible set baked for this model. Run after 'cullObjects' and draw with 'drawObject',
+//      'drawModel' culls with the set given to 'setPVS' instead.
+// Parameters:
+//      pvs       <PVS&>: The potentially visible set.
+//      viewPoint <const Vector3&>: Position of the camera, in model space.
+// Returns:
+//      <int>: Number of visible face batches.
+//
+int Model::cullInvisibleObjects(PVS &pvs, const Vector3 &viewPoint) {
+    if (objectBounds.count == 0)
+        return 0;
+
+    pvs.cullObjects(viewPoint, &objectVisible[0], objectBounds.count);
+
+    return countVisibleBatches();
+}
+
+//
+// submit
+// Description:
+//      Adds the visible face batches of the model to a render queue, which draws them sorted
+//      together with the batches of other models. Culls with the results of the last culling
+//      calls, 'drawModel' is not involved.
+// Parameters:
+//      queue     <RenderQueue&>: The render queue of the frame.
+//      transform <const float*>: Column major transform of the model, NULL if none. Has to stay
+//                                valid until the queue is drawn.
+// Returns:
+//      <int>: Number of face batches added.
+//
+int Model::submit(RenderQueue &queue, const float *transform) {
+    if (!objectLoaded)
+        return 0;
+
+    int batchIndex = 0;
+    int numSubmitted = 0;
+
+    for (int i = 0; i < (int)objects.size(); i++) {
+        GroupObject *object = objects[i];
+
+        if (!objectVisible[i]) {
+            batchIndex += (int)object->batches.size();
+            continue;
+        }
+
+        for (int b = 0; b < (int)object->batches.size(); b++, batchIndex++) {
+            if (!batchVisible[batchIndex])
+                continue;
+
+            Vector3 center = object->batches[b].bounds.getCenter();
+
+            if (transform != NULL) {
+                center = Vector3(transform[0] * center.x + transform[4] * center.y + transform[8] * center.z + transform[12],
+                                 transform[1] * center.x + transform[5] * center.y + transform[9] * center.z + transform[13],
+                                 transform[2] * center.x + transform[6] * center.y + transform[10] * center.z + transform[14]);
+            }
+
+            RenderItem item;
+            item.model = this;
+            item.material = object->batches[b].material;
+            item.transform = transform;
+            item.object = i;
+            item.batch = b;
+
+            queue.add(item, center);
+            numSubmitted++;
+        }
+    }
+    return numSubmitted;
+}
+
+//
+// setOcclusionBuffer
+// Description:
+//      Sets the occlusion buffer 'drawModel' culls against after the view frustum. The caller
+//      renders the buffer every frame before drawing.
+// Parameters:
+//      buffer <OcclusionBuffer*>: The occlusion buffer, NULL disables occlusion culling.
+// Returns:
+//      None (void).
+//
+void Model::setOcclusionBuffer(OcclusionBuffer *buffer) {
+    occlusionBuffer = buffer;
+}
+
+//
+// setPVS
+// Description:
+//      Sets the potentially visible set 'drawModel' culls against after the view frustum, with the
+//      camera position taken from the current modelview matrix.
+// Parameters:
+//      pvs <PVS*>: The potentially visible set baked for this model, NULL disables it.
+// Returns:
+//      None (void).
+//
+void Model::setPVS(PVS *pvs) {
+    visibleSet = pvs;
 }
 
 //
@@ -159,6 +429,8 @@ void Model::drawFace(Face& face) {
 //      None (void).
 //
 void Model::deleteObjects(void) {
+    deleteDisplayLists();
+
     for (int m = 0; m < (int)materials.size(); m++) {
         if (materials[m]->ambientMap != NULL) 
             delete materials[m]->ambientMap;
@@ -184,31 +456,26 @@ void Model::deleteObjects(void) {
         delete materials[m];
     }
     
-    for (int m = 0; m < (int)vertices.size(); m++) 
-        delete vertices[m];
-    
-    for (int m = 0; m < (int)normals.size(); m++) 
-        delete normals[m];
-    
-    for (int m = 0; m < (int)UVWs.size(); m++) 
-        delete UVWs[m];
-    
-    for (int i = 0; i < (int)objects.size(); i++) {
-        GroupObject *object = objects[i];
+    for (int i = 0; i < (int)objects.size(); i++) 
+        delete objects[i];
 
-        for (int f = 0; f < (int)object->faces.size(); f++) {
-            delete object->faces[f]->vertices;
-            delete object->faces[f]->normals;
-            delete object->faces[f]->UVWs;
+    // The faces, their index arrays and the vertex records all live in the arena
+    faceArena.clear();
 
-            delete object->faces[f];
-        }
-    }
     UVWs.clear();
     normals.clear();
+    generatedNormals.clear();
     vertices.clear();
     objects.clear();
     materials.clear();
+
+    objectBounds.clear();
+    batchBounds.clear();
+    objectVisible.clear();
+    batchVisible.clear();
+
+    if (transparencySorter != NULL)
+        transparencySorter->clear();
 }
 
 //
@@ -222,6 +489,8 @@ void Model::deleteObjects(void) {
 //      <bool>: If the obj file was loaded correctly or not.
 //
 bool Model::loadObject(std::string in_filename) {
+    PROFILE_SCOPE("Model::loadObject");
+
     filename = in_filename;
     std::ifstream istr(filename.data());
     
@@ -230,7 +499,6 @@ bool Model::loadObject(std::string in_filename) {
 
     deleteObjects();
 
-    displayList = 0;
     objectLoaded = false;
 
     GroupObject *defaultObject = new GroupObject;
@@ -238,18 +506,18 @@ bool Model::loadObject(std::string in_filename) {
 
     objects.push_back(defaultObject);
 
-    char path[256];
-    strcpy(path, filename.data());
-
-    // Extract path without filename (will be passed to loadMaterials
-    for (int i = (int)filename.length(); path[i] != '\\' && path[i] != '/'; i--) 
-        path[i] = 0; 
+    // Extract path without filename (will be passed to loadMaterials), empty for a bare filename
+    std::string path = filename.substr(0, filename.find_last_of("\\/") + 1);
    
     Material *currentMaterial = NULL;
-    char line[256];
+    int currentSmoothingGroup = -1;
 
-    while (istr.getline(line, 256)) {
-        std::istringstream newLine(line, std::istringstream::in); 
+    std::vector<FaceCorner> corners;
+
+    std::string line;
+
+    while (std::getline(istr, line)) {
+        std::istringstream newLine(line, std::istringstream::in);
 
         std::string firstWord;
         newLine >> firstWord;
@@ -259,7 +527,7 @@ bool Model::loadObject(std::string in_filename) {
         else if (firstWord == "mtllib") {
             std::string materialFilename;
             while (newLine >> materialFilename) {
-                loadMaterials(std::string(path) + materialFilename);
+                loadMaterials(path + materialFilename);
             }
         }
         else if (firstWord == "usemtl") {
@@ -274,17 +542,17 @@ bool Model::loadObject(std::string in_filename) {
             }
         }
         else if (firstWord == "v") {
-            Vector3 *vertex = new Vector3;
+            Vector3 *vertex = faceArena.create<Vector3>();
             newLine >> vertex->x >> vertex->y >> vertex->z;
             vertices.push_back(vertex);
         }
         else if (firstWord == "vt") {
-            Vector3 *uvw = new Vector3;
+            Vector3 *uvw = faceArena.create<Vector3>();
             newLine >> uvw->x >> uvw->y >> uvw->z;
             UVWs.push_back(uvw);
         }
         else if (firstWord == "vn") {
-            Vector3 *normal = new Vector3;
+            Vector3 *normal = faceArena.create<Vector3>();
             newLine >> normal->x >> normal->y >> normal->z;
             normals.push_back(normal);
         }
@@ -306,94 +574,80 @@ bool Model::loadObject(std::string in_filename) {
                 objects.push_back(object);
             }
         }
+        else if (firstWord == "s") {
+            std::string smoothingGroup;
+            newLine >> smoothingGroup;
+
+            if (smoothingGroup == "off")
+                currentSmoothingGroup = 0;
+            else
+                currentSmoothingGroup = atoi(smoothingGroup.c_str());
+        }
         else if (firstWord == "f") {
-            Face *newFace = new Face;
-            newFace->material = currentMaterial;
-
-            currentGroup->faces.push_back(newFace);
-
-            std::vector<Vector3 *> tempVertices;
-            std::vector<Vector3 *> tempNormals;
-            std::vector<Vector3 *> tempUVWs;
+            std::streamoff offset = newLine.tellg();
 
-            while (newLine >> std::ws && !newLine.eof()) {
-                int normal = 0;
-                int vertex = 0;
-                int uvw = 0;
+            if (offset < 0 || !FaceParser::parseFace(line.c_str() + offset, (int)vertices.size(), (int)UVWs.size(),
+                                                     (int)normals.size(), corners))
+                continue;
 
-                bool noUV = false;
-                char temp;
+            Face *newFace = faceArena.create<Face>();
+            newFace->material = currentMaterial;
+            newFace->smoothingGroup = currentSmoothingGroup;
 
-                if ((int)vertices.size() > 0) {
-                    newLine >> vertex;
+            currentGroup->faces.push_back(newFace);
 
-                    while (newLine.get(temp)) 
-                        if (temp == '/' || temp == ' ') 
-                            break;
+            int numCorners = (int)corners.size();
 
-                    newLine.get(temp);
-                
-                    if (temp == '/') 
-                        noUV = true;
-                    
-                    else 
-                        newLine.unget();
+            newFace->numVertices = numCorners;
+            newFace->numNormals = 0;
+            newFace->numUVWs = 0;
 
-                    tempVertices.push_back(vertices[--vertex]);
-                }
+            for (int c = 0; c < numCorners; c++) {
+                if (corners[c].uvw >= 0)
+                    newFace->numUVWs++;
 
-                if ((int)UVWs.size() > 0 && noUV == false) {
-                    newLine >> uvw;
+                if (corners[c].normal >= 0)
+                    newFace->numNormals++;
+            }
 
-                    while (newLine.get(temp)) 
-                        if (temp == '/' || temp == ' ') 
-                            break;
-                    
-                    tempUVWs.push_back(UVWs[--uvw]);
-                }
+            newFace->vertices = faceArena.allocateArray<Vector3 *>(newFace->numVertices);
+            newFace->normals = faceArena.allocateArray<Vector3 *>(newFace->numNormals);
+            newFace->UVWs = faceArena.allocateArray<Vector3 *>(newFace->numUVWs);
 
-                if ((int)normals.size() > 0) {
-                    newLine >> normal;
+            for (int c = 0, n = 0, t = 0; c < numCorners; c++) {
+                newFace->vertices[c] = vertices[corners[c].vertex];
 
-                    while (newLine.get(temp)) 
-                        if (temp == '/' || temp == ' ') 
-                            break;
+                if (corners[c].uvw >= 0)
+                    newFace->UVWs[t++] = UVWs[corners[c].uvw];
 
-                    tempNormals.push_back(normals[--normal]);
-                }
+                if (corners[c].normal >= 0)
+                    newFace->normals[n++] = normals[corners[c].normal];
             }
+        }
+    }
 
-            newFace->numVertices = (int)tempVertices.size();
-            newFace->numNormals = (int)tempNormals.size();
-            newFace->numUVWs = (int)tempUVWs.size();
+    // Face centers and normals only read the parsed vertices, so the faces are split over the job system
+    std::vector<Face *> faces;
 
-            newFace->vertices = new Vector3 *[newFace->numVertices];
-            newFace->normals = new Vector3 *[newFace->numNormals];
-            newFace->UVWs = new Vector3 *[newFace->numUVWs];
-            
-            for (int v = 0; v < newFace->numVertices; v++) 
-                newFace->vertices[v] = tempVertices[v];
-            
-            for (int v = 0; v < newFace->numNormals; v++) 
-                newFace->normals[v] = tempNormals[v]; 
-            
-            for (int v = 0; v < newFace->numUVWs; v++) 
-                newFace->UVWs[v] = tempUVWs[v];
-           
+    for (int i = 0; i < (int)objects.size(); i++)
+        faces.insert(faces.end(), objects[i]->faces.begin(), objects[i]->faces.end());
 
-            for (int v = 0; v < newFace->numVertices; v++) 
-                newFace->faceCenter += (*tempVertices[v]);
-            
+    Parallel::forRange(0, (int)faces.size(), [&faces](int first, int last) {
+        for (int f = first; f < last; f++) {
+            Face *face = faces[f];
 
-            newFace->faceCenter /= (float)newFace->numVertices;
+            for (int v = 0; v < face->numVertices; v++)
+                face->faceCenter += (*face->vertices[v]);
 
-            if (newFace->numVertices >= 3) {
-                Vector3 vector1 = ((*newFace->vertices[0]) - (*newFace->vertices[1])).Normalize();
-                Vector3 vector2 = ((*newFace->vertices[0]) - (*newFace->vertices[2])).Normalize();
-                newFace->faceNormal = vector1 * vector2; // Cross product
-            }        
+            face->faceCenter /= (float)face->numVertices;
+
+            if (face->numVertices >= 3) {
+                Vector3 vector1 = ((*face->vertices[0]) - (*face->vertices[1])).Normalize();
+                Vector3 vector2 = ((*face->vertices[0]) - (*face->vertices[2])).Normalize();
+                face->faceNormal = vector1 * vector2; // Cross product
+            }
         }
-    }
+    }, MODEL_MIN_PARALLEL_FACES);
 
     float xmin, xmax;
     float ymin, ymax;
@@ -401,6 +655,8 @@ bool Model::loadObject(std::string in_filename) {
 
     center = Vector3(0, 0, 0);
     for (int n = 0; n <(int)vertices.size(); n++) {
+        center += (*vertices[n]);
+
         if (n == 0) {
             xmin = xmax = vertices[n]->x;
             ymin = ymax = vertices[n]->y;
@@ -421,8 +677,6 @@ bool Model::loadObject(std::string in_filename) {
             zmin = vertices[n]->z;
         if (vertices[n]->z > zmax)
             zmax = vertices[n]->z;
-
-        center += (*vertices[n]);
     }
     center /= (float)vertices.size();
 
@@ -439,11 +693,33 @@ bool Model::loadObject(std::string in_filename) {
 
     radius = (Vector3(xmax, ymax, zmax) - Vector3(xmin, ymin, zmin)).Length() / 2.0f;
 
+    // Without 'vn' records the faces would be drawn without normals
+    if (normals.empty())
+        generateNormals();
+
+    computeBounds();
+
     objectLoaded = true;
     //std::cout << "Object is loaded" << std::endl;
     return true;
 }
 
+//
+// generateNormals
+// Description:
+//      Generates smooth normals for every face corner through the NormalGenerator, honouring smoothing
+//      groups ('s' records). Called from 'loadObject' when the obj file has no normals, can also be called
+//      to replace the normals of the file.
+// Parameters:
+//      creaseAngle <float>: Faces meeting at a larger angle (degrees) keep a hard edge.
+// Returns:
+//      None (void).
+//
+void Model::generateNormals(float creaseAngle) {
+    NormalGenerator::generate(objects, vertices, generatedNormals, faceArena, creaseAngle);
+    deleteDisplayLists();
+}
+
 //
 // loadMaterials
 // Description:
@@ -455,17 +731,14 @@ bool Model::loadObject(std::string in_filename) {
 //      None (void).
 //
 void Model::loadMaterials(std::string in_filename) {
+    PROFILE_SCOPE("Model::loadMaterials");
+
     std::ifstream istr(in_filename.data());
 
     if (!istr) 
         return;
 
-    char path[256];
-    strcpy(path, in_filename.data());
-
-    for (int i = (int)in_filename.length(); path[i] != '\\' && path[i] != '/'; i--) {
-        path[i] = 0;
-    }
+    std::string path = in_filename.substr(0, in_filename.find_last_of("\\/") + 1);
 
     Material *material = NULL;
 
@@ -513,44 +786,44 @@ void Model::loadMaterials(std::string in_filename) {
         else if (firstWord == "map_Ka") {
             std::string filename_temp;
             newLine >> filename_temp;
-            Texture *map = new Texture(std::string(path) + filename_temp);
+            Texture *map = new Texture(path + filename_temp);
             material->ambientMap = map;
         }
         else if (firstWord == "map_Kd") {
             std::string filename_temp;
             newLine >> filename_temp;
-            Texture *map = new Texture(std::string(path) + filename_temp);
-            //std::cout << std::string(path) + filename_temp << std::endl;
+            Texture *map = new Texture(path + filename_temp);
+            //std::cout << path + filename_temp << std::endl;
             material->diffuseMap = map;
         }
         else if (firstWord == "map_Ks") {
             std::string filename_temp;
             newLine >> filename_temp;
-            Texture *map = new Texture(std::string(path) + filename_temp);
+            Texture *map = new Texture(path + filename_temp);
             material->specularMap = map;
         }
         else if (firstWord == "map_Ke") {
             std::string filename_temp;
             newLine >> filename_temp;
-            Texture *map = new Texture(std::string(path) + filename_temp);
+            Texture *map = new Texture(path + filename_temp);
             material->emissionMap = map;
         }
         else if (firstWord == "map_Ns") {
             std::string filename_temp;
             newLine >> filename_temp;
-            Texture *map = new Texture(std::string(path) + filename_temp);
+            Texture *map = new Texture(path + filename_temp);
             material->shininessMap = map;
         }
         else if (firstWord == "map_d") {
             std::string filename_temp;
             newLine >> filename_temp;
-            Texture *map = new Texture(std::string(path) + filename_temp);
+            Texture *map = new Texture(path + filename_temp);
             material->transparencyMap = map;
         }
         else if (firstWord == "map_Bump") {
             std::string filename_temp;
             newLine >> filename_temp;
-            Texture *map = new Texture(std::string(path) + filename_temp);
+            Texture *map = new Texture(path + filename_temp);
             material->bumpMap = map;
         }
     }
@@ -596,3 +869,225 @@ std::string Model::getPath(void) {
     return filename;
 }
 
+
+//
+// getObjects
+// Description:
+//      Getter function for the group objects of the loaded model.
+//      Used when compiling the model into indexed vertex buffers.
+// Parameters:
+//      None (void).
+// Returns:
+//      objects <std::vector<GroupObject *>&>: The group objects in file order.
+//
+std::vector<GroupObject *> &Model::getObjects(void) {
+    return objects;
+}
+
+//
+// getMaterials
+// Description:
+//      Getter function for the materials loaded from the material libraries.
+// Parameters:
+//      None (void).
+// Returns:
+//      materials <std::vector<Material *>&>: The materials in load order.
+//
+std::vector<Material *> &Model::getMaterials(void) {
+    return materials;
+}
+
+//
+// getBoundingPoints
+// Description:
+//      Getter function for the eight corners of the axis aligned bounding box of the model.
+//      Index 6 holds the minimum corner and index 7 the maximum corner.
+// Parameters:
+//      None (void).
+// Returns:
+//      boundingPoints <Vector3*>: Array of the eight corner points.
+//
+Vector3 *Model::getBoundingPoints(void) {
+    return boundingPoints;
+}
+
+//
+// applyMaterial
+// Description:
+//      Sets the OpenGL material state and diffuse texture of a material.
+//      Faces without a material are drawn with the default material.
+// Parameters:
+//      material <Material*>: The material, may be NULL.
+// Returns:
+//      None (void).
+//
+void Model::applyMaterial(Material *material) {
+    Material defaultMaterial;
+
+    if (material == NULL)
+        material = &defaultMaterial;
+
+    RenderBackend *backend = RenderBackend::get();
+
+    material->Kd[3] = material->alpha;
+    backend->setMaterial(GL_FRONT_AND_BACK, GL_AMBIENT, (GLfloat*)material->Ka);
+    backend->setMaterial(GL_FRONT_AND_BACK, GL_DIFFUSE, (GLfloat*)material->Kd);
+    backend->setMaterial(GL_FRONT_AND_BACK, GL_SPECULAR, (GLfloat*)material->Ks);
+    backend->setMaterial(GL_FRONT_AND_BACK, GL_EMISSION, (GLfloat*)material->Ke);
+    backend->setMaterial(GL_FRONT_AND_BACK, GL_SHININESS, material->shininess);
+
+    if (material->diffuseMap != NULL) {
+        backend->enable(GL_TEXTURE_2D);
+        backend->bindTexture(GL_TEXTURE_2D, material->diffuseMap->texID);
+    }
+    else {
+        backend->disable(GL_TEXTURE_2D);
+    }
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// computeBounds
+// Description:
+//      Splits every group object into batches of faces sharing a material and computes the
+//      bounding boxes of the group objects and batches used for culling.
+//      This function is called from the 'loadObject' function.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void Model::computeBounds(void) {
+    objectBounds.clear();
+    batchBounds.clear();
+
+    // Every group object is batched on its own, only the arrays of boxes are filled in order
+    Parallel::forRange(0, (int)objects.size(), [this](int first, int last) {
+        for (int i = first; i < last; i++) {
+            GroupObject *object = objects[i];
+
+            object->batches.clear();
+            object->bounds = BoundingBox();
+
+            for (int f = 0; f < (int)object->faces.size(); f++) {
+                Face *face = object->faces[f];
+
+                if (object->batches.empty() || object->batches.back().material != face->material) {
+                    FaceBatch batch;
+                    batch.firstFace = f;
+                    batch.material = face->material;
+                    object->batches.push_back(batch);
+                }
+
+                FaceBatch &batch = object->batches.back();
+                batch.numFaces++;
+
+                for (int v = 0; v < face->numVertices; v++)
+                    batch.bounds.expand(*face->vertices[v]);
+            }
+
+            for (int b = 0; b < (int)object->batches.size(); b++)
+                object->bounds.expand(object->batches[b].bounds);
+        }
+    }, MODEL_MIN_PARALLEL_OBJECTS);
+
+    for (int i = 0; i < (int)objects.size(); i++) {
+        for (int b = 0; b < (int)objects[i]->batches.size(); b++)
+            batchBounds.add(objects[i]->batches[b].bounds);
+
+        objectBounds.add(objects[i]->bounds);
+    }
+
+    objectVisible.assign(objectBounds.count, 1);
+    batchVisible.assign(batchBounds.count, 1);
+}
+
+//
+// countVisibleBatches
+// Description:
+//      Counts the face batches which are visible and belong to a visible group object.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: Number of visible face batches.
+//
+int Model::countVisibleBatches(void) {
+    int numVisible = 0;
+    int batchIndex = 0;
+
+    for (int i = 0; i < (int)objects.size(); i++) {
+        for (int b = 0; b < (int)objects[i]->batches.size(); b++, batchIndex++) {
+            if (objectVisible[i] && batchVisible[batchIndex])
+                numVisible++;
+        }
+    }
+    return numVisible;
+}
+
+//
+// getViewPoint
+// Description:
+//      Getter function for the camera position in model space, read from the current modelview
+//      matrix, assuming it has no scale.
+// Parameters:
+//      None (void).
+// Returns:
+//      <Vector3>: The camera position.
+//
+Vector3 Model::getViewPoint(void) {
+    GLfloat m[16];
+    RenderBackend::get()->getFloat(GL_MODELVIEW_MATRIX, m);
+
+    return Vector3(-(m[0] * m[12] + m[1] * m[13] + m[2] * m[14]),
+                   -(m[4] * m[12] + m[5] * m[13] + m[6] * m[14]),
+                   -(m[8] * m[12] + m[9] * m[13] + m[10] * m[14]));
+}
+
+//
+// deleteDisplayLists
+// Description:
+//      Deletes the display lists of all face batches, they are compiled again when drawn.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void Model::deleteDisplayLists(void) {
+    for (int i = 0; i < (int)objects.size(); i++) {
+        for (int b = 0; b < (int)objects[i]->batches.size(); b++) {
+            FaceBatch &batch = objects[i]->batches[b];
+
+            if (batch.displayList != 0) {
+                RenderBackend::get()->deleteList(batch.displayList);
+                batch.displayList = 0;
+            }
+        }
+    }
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// cullBoxRanges
+// Description:
+//      Tests an array of boxes against a frustum, in ranges of whole blocks of eight boxes split over
+//      the job system when the array is large.
+// Parameters:
+//      frustum <Frustum&>: The view frustum.
+//      boxes   <const BoundingBoxArray&>: The boxes.
+//      visible <unsigned char*>: Receives 1 for every box that may be visible and 0 otherwise.
+// Returns:
+//      None (void).
+//
+static void cullBoxRanges(Frustum &frustum, const BoundingBoxArray &boxes, unsigned char *visible) {
+    int numBlocks = (boxes.count + 7) / 8;
+
+    Parallel::forRange(0, numBlocks, [&frustum, &boxes, visible](int first, int last) {
+        frustum.cullBoxes(boxes, visible, first * 8, last * 8 < boxes.count ? last * 8 : boxes.count);
+    }, MODEL_MIN_PARALLEL_BLOCKS);
+}
@@ -0,0 +1,609 @@
+// ModelAsset.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/ModelAsset.h"
+#include "../include/GLExtensions.h"
+#include "../include/RenderBackend.h"
+#include <stddef.h>
+#include <algorithm>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+// Attribute locations of the instancing shader, the transform takes four
+enum INSTANCE_ATTRIBUTE {
+    INSTANCE_ATTRIBUTE_POSITION = 0,
+    INSTANCE_ATTRIBUTE_NORMAL = 1,
+    INSTANCE_ATTRIBUTE_UV = 2,
+    INSTANCE_ATTRIBUTE_TRANSFORM = 3,
+    INSTANCE_ATTRIBUTE_TINT = 7,
+    INSTANCE_ATTRIBUTE_COUNT = 8
+};
+
+static const int INSTANCE_FLOATS = 20;
+
+// Lights the fragments with the first OpenGL light and the current material, like the fixed function
+// pipeline does per vertex
+static const char *INSTANCE_VERTEX_SHADER =
+    "#version 120\n"
+    "attribute vec3 position;\n"
+    "attribute vec3 normal;\n"
+    "attribute vec2 uv;\n"
+    "attribute vec4 transform0;\n"
+    "attribute vec4 transform1;\n"
+    "attribute vec4 transform2;\n"
+    "attribute vec4 transform3;\n"
+    "attribute vec4 tint;\n"
+    "varying vec3 viewPosition;\n"
+    "varying vec3 viewNormal;\n"
+    "varying vec2 texCoord;\n"
+    "varying vec4 color;\n"
+    "void main() {\n"
+    "    mat4 transform = mat4(transform0, transform1, transform2, transform3);\n"
+    "    vec4 eyePosition = gl_ModelViewMatrix * (transform * vec4(position, 1.0));\n"
+    "    viewPosition = eyePosition.xyz;\n"
+    "    viewNormal = gl_NormalMatrix * (mat3(transform) * normal);\n"
+    "    texCoord = uv;\n"
+    "    color = tint;\n"
+    "    gl_Position = gl_ProjectionMatrix * eyePosition;\n"
+    "}\n";
+
+static const char *INSTANCE_FRAGMENT_SHADER =
+    "#version 120\n"
+    "uniform sampler2D diffuseMap;\n"
+    "uniform int useDiffuseMap;\n"
+    "varying vec3 viewPosition;\n"
+    "varying vec3 viewNormal;\n"
+    "varying vec2 texCoord;\n"
+    "varying vec4 color;\n"
+    "void main() {\n"
+    "    vec3 normal = normalize(viewNormal);\n"
+    "    vec3 light = normalize(gl_LightSource[0].position.xyz - viewPosition * gl_LightSource[0].position.w);\n"
+    "    vec3 eye = normalize(-viewPosition);\n"
+    "    float diffuse = max(dot(normal, light), 0.0);\n"
+    "    float specular = diffuse > 0.0 ? pow(max(dot(normal, normalize(light + eye)), 0.0), gl_FrontMaterial.shininess) : 0.0;\n"
+    "    vec4 albedo = gl_FrontMaterial.diffuse * color;\n"
+    "    if (useDiffuseMap != 0)\n"
+    "        albedo *= texture2D(diffuseMap, texCoord);\n"
+    "    vec3 result = gl_FrontMaterial.emission.rgb + gl_LightModel.ambient.rgb * gl_FrontMaterial.ambient.rgb +\n"
+    "                  gl_LightSource[0].ambient.rgb * gl_FrontMaterial.ambient.rgb +\n"
+    "                  gl_LightSource[0].diffuse.rgb * albedo.rgb * diffuse +\n"
+    "                  gl_LightSource[0].specular.rgb * gl_FrontMaterial.specular.rgb * specular;\n"
+    "    gl_FragColor = vec4(result, albedo.a);\n"
+    "}\n";
+
+static GLFunctions &gl = GLExtensions::gl;
+static GLuint instanceProgram = 0;
+static GLint useDiffuseMapLocation = -1;
+
+std::vector<ModelAsset *> ModelAsset::assets;
+int ModelAsset::instancingSupport = -1;
+bool ModelAsset::instancingEnabled = true;
+
+static GLuint compileProgram(void);
+static bool compareInstances(const ModelInstance *a, const ModelInstance *b);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// load
+// Description:
+//      Returns the asset of an obj file, loading it if it is not in the cache yet. Every call adds a
+//      reference to the asset which has to be given back with 'release'.
+// Parameters:
+//      in_filename <std::string>: Full path of the obj file.
+// Returns:
+//      <ModelAsset*>: The asset, NULL if the file could not be loaded.
+//
+ModelAsset *ModelAsset::load(std::string in_filename) {
+    for (int i = 0; i < (int)assets.size(); i++) {
+        if (assets[i]->filename == in_filename) {
+            assets[i]->references++;
+            return assets[i];
+        }
+    }
+
+    ModelAsset *asset = new ModelAsset(in_filename);
+
+    if (!asset->model.loadObject(in_filename)) {
+        delete asset;
+        return NULL;
+    }
+
+    asset->mesh.compile(asset->model, VERTEX_FORMAT_FLOAT);
+    asset->references = 1;
+    assets.push_back(asset);
+
+    return asset;
+}
+
+//
+// release
+// Description:
+//      Gives back a reference to an asset, the asset is deleted when no references are left.
+// Parameters:
+//      asset <ModelAsset*>: The asset, may be NULL.
+// Returns:
+//      None (void).
+//
+void ModelAsset::release(ModelAsset *asset) {
+    if (asset == NULL || --asset->references > 0)
+        return;
+
+    assets.erase(std::remove(assets.begin(), assets.end(), asset), assets.end());
+    delete asset;
+}
+
+//
+// drawInstances
+// Description:
+//      Draws a list of instances, opaque materials first. The instances are grouped by asset so
+//      every asset sets up its vertex data and materials once for all its instances.
+// Parameters:
+//      instances <const ModelInstance*>: The instances, instances without an asset are skipped.
+//      count     <int>: Number of instances.
+// Returns:
+//      None (void).
+//
+void ModelAsset::drawInstances(const ModelInstance *instances, int count) {
+    std::vector<const ModelInstance *> order;
+    order.reserve(count);
+
+    for (int i = 0; i < count; i++) {
+        if (instances[i].asset != NULL)
+            order.push_back(&instances[i]);
+    }
+
+    std::sort(order.begin(), order.end(), compareInstances);
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int first = 0; first < (int)order.size();) {
+            int last = first + 1;
+
+            while (last < (int)order.size() && order[last]->asset == order[first]->asset)
+                last++;
+
+            order[first]->asset->drawRun(&order[first], last - first, pass == 1);
+            first = last;
+        }
+    }
+    RenderBackend::get()->disable(GL_TEXTURE_2D);
+}
+
+//
+// isInstancingSupported
+// Description:
+//      Checks once if the current OpenGL context can draw instanced arrays, which needs OpenGL 2.0
+//      shaders and either OpenGL 3.3 or the ARB_draw_instanced and ARB_instanced_arrays extensions.
+//      Without a current OpenGL context nothing is decided and the next call checks again.
+// Parameters:
+//      None (void).
+// Returns:
+//      <bool>: If instanced drawing is supported.
+//
+bool ModelAsset::isInstancingSupported(void) {
+    if (instancingSupport >= 0)
+        return instancingSupport == 1;
+
+    if (!GLExtensions::load())
+        return false;
+
+    instancingSupport = 0;
+
+    int version = GLExtensions::getVersion();
+
+    if (version < 20)
+        return false;
+
+    if (version < 33 && (!GLExtensions::hasExtension("GL_ARB_draw_instanced") || !GLExtensions::hasExtension("GL_ARB_instanced_arrays")))
+        return false;
+
+    if (gl.genBuffers == NULL || gl.createProgram == NULL || gl.deleteProgram == NULL || gl.vertexAttribDivisor == NULL ||
+        gl.drawElementsInstanced == NULL)
+        return false;
+
+    instanceProgram = compileProgram();
+
+    if (instanceProgram == 0)
+        return false;
+
+    useDiffuseMapLocation = gl.getUniformLocation(instanceProgram, "useDiffuseMap");
+
+    gl.useProgram(instanceProgram);
+    gl.uniform1i(gl.getUniformLocation(instanceProgram, "diffuseMap"), 0);
+    gl.useProgram(0);
+
+    instancingSupport = 1;
+    return true;
+}
+
+//
+// setInstancingEnabled
+// Description:
+//      Enables or disables instanced drawing, with instancing disabled or unsupported the instances
+//      are drawn one by one. Enabled by default.
+// Parameters:
+//      value <bool>: Use instanced drawing when supported.
+// Returns:
+//      None (void).
+//
+void ModelAsset::setInstancingEnabled(bool value) {
+    instancingEnabled = value;
+}
+
+//
+// getModel
+// Description:
+//      Getter function for the loaded model, shared by all instances and not to be changed.
+// Parameters:
+//      None (void).
+// Returns:
+//      model <Model&>: The model.
+//
+Model &ModelAsset::getModel(void) {
+    return model;
+}
+
+//
+// getMesh
+// Description:
+//      Getter function for the model compiled into indexed triangle lists.
+// Parameters:
+//      None (void).
+// Returns:
+//      mesh <CompiledMesh&>: The compiled mesh.
+//
+CompiledMesh &ModelAsset::getMesh(void) {
+    return mesh;
+}
+
+//
+// getFilename
+// Description:
+//      Getter function for the obj file the asset was loaded from, the key of the cache.
+// Parameters:
+//      None (void).
+// Returns:
+//      filename <std::string>: Full path of the obj file.
+//
+std::string ModelAsset::getFilename(void) {
+    return filename;
+}
+
+//
+// getReferences
+// Description:
+//      Getter function for the number of references to the asset.
+// Parameters:
+//      None (void).
+// Returns:
+//      references <int>: References not released yet.
+//
+int ModelAsset::getReferences(void) {
+    return references;
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// ModelAsset
+// Description:
+//      Constructor.
+//      Creates an empty asset, assets are created through 'load'.
+// Parameters:
+//      in_filename <std::string>: Full path of the obj file.
+// Returns:
+//      None (void).
+//
+ModelAsset::ModelAsset(std::string in_filename) {
+    filename = in_filename;
+    references = 0;
+
+    vertexBuffer = 0;
+    indexBuffer = 0;
+    instanceBuffer = 0;
+}
+
+//
+// ~ModelAsset
+// Description:
+//      Destructor.
+//      Deletes the buffer objects of the asset, the model deletes its own data.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+ModelAsset::~ModelAsset() {
+    deleteBuffers();
+}
+
+//
+// drawRun
+// Description:
+//      Draws instances of this asset, either opaque or transparent materials. Without instancing
+//      the vertex arrays and every material are set once and each range is drawn per instance,
+//      through the render backend so the calls can be recorded without a context.
+// Parameters:
+//      instances    <const ModelInstance* const*>: The instances, all of this asset.
+//      count        <int>: Number of instances.
+//      transparency <bool>: Draw the transparent materials instead of the opaque ones.
+// Returns:
+//      None (void).
+//
+void ModelAsset::drawRun(const ModelInstance *const *instances, int count, bool transparency) {
+    if (mesh.vertices.empty())
+        return;
+
+    if (instancingEnabled && isInstancingSupported()) {
+        drawInstanced(instances, count, transparency);
+        return;
+    }
+
+    std::vector<Material *> &materials = model.getMaterials();
+    RenderBackend *backend = RenderBackend::get();
+
+    backend->enableClientState(GL_VERTEX_ARRAY);
+    backend->enableClientState(GL_NORMAL_ARRAY);
+    backend->enableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    backend->vertexPointer(3, GL_FLOAT, sizeof(CompiledVertex), mesh.vertices[0].position);
+    backend->normalPointer(GL_FLOAT, sizeof(CompiledVertex), mesh.vertices[0].normal);
+    backend->texCoordPointer(2, GL_FLOAT, sizeof(CompiledVertex), mesh.vertices[0].uv);
+
+    for (int g = 0; g < (int)mesh.groups.size(); g++) {
+        CompiledGroup &group = mesh.groups[g];
+        Material *material = group.materialIndex >= 0 ? materials[group.materialIndex] : NULL;
+
+        bool transparent = material != NULL && material->alpha < 1.0f;
+
+        if (transparent != transparency || group.indexCount == 0)
+            continue;
+
+        model.applyMaterial(material);
+
+        float diffuse[4] = {1.0f, 1.0f, 1.0f, material != NULL ? material->alpha : 1.0f};
+        if (material != NULL)
+            std::copy(material->Kd, material->Kd + 3, diffuse);
+
+        for (int i = 0; i < count; i++) {
+            const float *tint = instances[i]->tint;
+            bool tinted = tint[0] != 1.0f || tint[1] != 1.0f || tint[2] != 1.0f || tint[3] != 1.0f;
+
+            if (tinted) {
+                float color[4] = {diffuse[0] * tint[0], diffuse[1] * tint[1], diffuse[2] * tint[2], diffuse[3] * tint[3]};
+                backend->setMaterial(GL_FRONT_AND_BACK, GL_DIFFUSE, color);
+            }
+
+            backend->pushMatrix();
+            backend->multMatrix(instances[i]->transform);
+            backend->drawElements(GL_TRIANGLES, group.indexCount, GL_UNSIGNED_INT, &mesh.indices[group.firstIndex]);
+            backend->popMatrix();
+
+            if (tinted)
+                backend->setMaterial(GL_FRONT_AND_BACK, GL_DIFFUSE, diffuse);
+        }
+    }
+
+    backend->disableClientState(GL_VERTEX_ARRAY);
+    backend->disableClientState(GL_NORMAL_ARRAY);
+    backend->disableClientState(GL_TEXTURE_COORD_ARRAY);
+}
+
+//
+// drawInstanced
+// Description:
+//      Draws instances of this asset with one instanced draw call per material range. The
+//      transforms and tints of the run are streamed into the instance buffer first.
+// Parameters:
+//      instances    <const ModelInstance* const*>: The instances, all of this asset.
+//      count        <int>: Number of instances.
+//      transparency <bool>: Draw the transparent materials instead of the opaque ones.
+// Returns:
+//      None (void).
+//
+void ModelAsset::drawInstanced(const ModelInstance *const *instances, int count, bool transparency) {
+    std::vector<Material *> &materials = model.getMaterials();
+
+    // Skip the upload if the asset has no range in this pass
+    bool anyRange = false;
+
+    for (int g = 0; g < (int)mesh.groups.size() && !anyRange; g++) {
+        Material *material = mesh.groups[g].materialIndex >= 0 ? materials[mesh.groups[g].materialIndex] : NULL;
+        anyRange = (material != NULL && material->alpha < 1.0f) == transparency;
+    }
+
+    if (!anyRange)
+        return;
+
+    if (vertexBuffer == 0)
+        createBuffers();
+
+    instanceData.resize(count * INSTANCE_FLOATS);
+
+    for (int i = 0; i < count; i++) {
+        std::copy(instances[i]->transform, instances[i]->transform + 16, &instanceData[i * INSTANCE_FLOATS]);
+        std::copy(instances[i]->tint, instances[i]->tint + 4, &instanceData[i * INSTANCE_FLOATS + 16]);
+    }
+
+    gl.useProgram(instanceProgram);
+
+    gl.bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    gl.vertexAttribPointer(INSTANCE_ATTRIBUTE_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(CompiledVertex),
+                           (const void *)offsetof(CompiledVertex, position));
+    gl.vertexAttribPointer(INSTANCE_ATTRIBUTE_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(CompiledVertex),
+                           (const void *)offsetof(CompiledVertex, normal));
+    gl.vertexAttribPointer(INSTANCE_ATTRIBUTE_UV, 2, GL_FLOAT, GL_FALSE, sizeof(CompiledVertex),
+                           (const void *)offsetof(CompiledVertex, uv));
+
+    // Orphan the previous contents so the driver does not wait for draws still reading them
+    gl.bindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    gl.bufferData(GL_ARRAY_BUFFER, (ptrdiff_t)(instanceData.size() * sizeof(float)), NULL, GL_STREAM_DRAW);
+    gl.bufferData(GL_ARRAY_BUFFER, (ptrdiff_t)(instanceData.size() * sizeof(float)), &instanceData[0], GL_STREAM_DRAW);
+
+    for (int a = INSTANCE_ATTRIBUTE_TRANSFORM; a <= INSTANCE_ATTRIBUTE_TINT; a++) {
+        gl.vertexAttribPointer(a, 4, GL_FLOAT, GL_FALSE, INSTANCE_FLOATS * sizeof(float),
+                               (const void *)((a - INSTANCE_ATTRIBUTE_TRANSFORM) * 4 * sizeof(float)));
+        gl.vertexAttribDivisor(a, 1);
+    }
+
+    for (int a = 0; a < INSTANCE_ATTRIBUTE_COUNT; a++)
+        gl.enableVertexAttribArray(a);
+
+    gl.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+    for (int g = 0; g < (int)mesh.groups.size(); g++) {
+        CompiledGroup &group = mesh.groups[g];
+        Material *material = group.materialIndex >= 0 ? materials[group.materialIndex] : NULL;
+
+        bool transparent = material != NULL && material->alpha < 1.0f;
+
+        if (transparent != transparency || group.indexCount == 0)
+            continue;
+
+        model.applyMaterial(material);
+        gl.uniform1i(useDiffuseMapLocation, material != NULL && material->diffuseMap != NULL);
+
+        gl.drawElementsInstanced(GL_TRIANGLES, group.indexCount, GL_UNSIGNED_INT,
+                                 (const void *)(group.firstIndex * sizeof(unsigned int)), count);
+    }
+
+    for (int a = 0; a < INSTANCE_ATTRIBUTE_COUNT; a++) {
+        gl.disableVertexAttribArray(a);
+
+        if (a >= INSTANCE_ATTRIBUTE_TRANSFORM)
+            gl.vertexAttribDivisor(a, 0);
+    }
+
+    gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+    gl.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    gl.useProgram(0);
+}
+
+//
+// createBuffers
+// Description:
+//      Uploads the vertices and indices of the compiled mesh into buffer objects and creates the
+//      buffer for the instance data.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void ModelAsset::createBuffers(void) {
+    gl.genBuffers(1, &vertexBuffer);
+    gl.genBuffers(1, &indexBuffer);
+    gl.genBuffers(1, &instanceBuffer);
+
+    gl.bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    gl.bufferData(GL_ARRAY_BUFFER, (ptrdiff_t)(mesh.vertices.size() * sizeof(CompiledVertex)), &mesh.vertices[0], GL_STATIC_DRAW);
+    gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (!mesh.indices.empty()) {
+        gl.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+        gl.bufferData(GL_ELEMENT_ARRAY_BUFFER, (ptrdiff_t)(mesh.indices.size() * sizeof(unsigned int)), &mesh.indices[0], GL_STATIC_DRAW);
+        gl.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+}
+
+//
+// deleteBuffers
+// Description:
+//      Deletes the buffer objects of the asset, if it has any.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void ModelAsset::deleteBuffers(void) {
+    if (vertexBuffer == 0)
+        return;
+
+    GLuint buffers[3] = {vertexBuffer, indexBuffer, instanceBuffer};
+    gl.deleteBuffers(3, buffers);
+
+    vertexBuffer = 0;
+    indexBuffer = 0;
+    instanceBuffer = 0;
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// compileProgram
+// Description:
+//      Compiles and links the instancing shader.
+// Parameters:
+//      None (void).
+// Returns:
+//      <GLuint>: The shader program, 0 if it failed to compile or link.
+//
+static GLuint compileProgram(void) {
+    const char *sources[2] = {INSTANCE_VERTEX_SHADER, INSTANCE_FRAGMENT_SHADER};
+    GLenum types[2] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER};
+    GLuint shaders[2];
+    GLint status = 0;
+
+    GLuint program = gl.createProgram();
+
+    for (int i = 0; i < 2; i++) {
+        shaders[i] = gl.createShader(types[i]);
+        gl.shaderSource(shaders[i], 1, &sources[i], NULL);
+        gl.compileShader(shaders[i]);
+        gl.getShaderiv(shaders[i], GL_COMPILE_STATUS, &status);
+
+        if (!status) {
+            std::cerr << "ModelAsset: instancing shader failed to compile, drawing without instancing" << std::endl;
+
+            for (int j = 0; j <= i; j++)
+                gl.deleteShader(shaders[j]);
+
+            gl.deleteProgram(program);
+            return 0;
+        }
+        gl.attachShader(program, shaders[i]);
+    }
+
+    const char *attributes[INSTANCE_ATTRIBUTE_COUNT] = {"position", "normal", "uv", "transform0", "transform1",
+                                                        "transform2", "transform3", "tint"};
+
+    for (int a = 0; a < INSTANCE_ATTRIBUTE_COUNT; a++)
+        gl.bindAttribLocation(program, a, attributes[a]);
+
+    gl.linkProgram(program);
+    gl.getProgramiv(program, GL_LINK_STATUS, &status);
+
+    gl.deleteShader(shaders[0]);
+    gl.deleteShader(shaders[1]);
+
+    if (!status) {
+        std::cerr << "ModelAsset: instancing shader failed to link, drawing without instancing" << std::endl;
+        gl.deleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+//
+// compareInstances
+// Description:
+//      Orders instances by asset, so the instances of an asset form one run.
+// Parameters:
+//      a <const ModelInstance*>: First instance.
+//      b <const ModelInstance*>: Second instance.
+// Returns:
+//      <bool>: If 'a' goes before 'b'.
+//
+static bool compareInstances(const ModelInstance *a, const ModelInstance *b) {
+    return a->asset < b->asset;
+}
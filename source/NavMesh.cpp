@@ -0,0 +1,1045 @@
+// NavMesh.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/NavMesh.h"
+#include "../include/Parallel.h"
+#include <math.h>
+#include <limits.h>
+#include <chrono>
+#include <queue>
+#include <algorithm>
+#include <functional>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int NAV_MAX_POLYGON_CELLS = 32; // Longest polygon side in cells, keeps A* costs meaningful
+static const int NAV_MAX_CLIP_VERTICES = 12;
+static const int NAV_SEARCH_CELLS = 4;       // Extra cells searched around a point beyond the agent radius
+
+// Neighbour directions of a cell: +x, +z, -x, -z
+static const int NAV_DIRECTION_X[4] = {1, 0, -1, 0};
+static const int NAV_DIRECTION_Z[4] = {0, 1, 0, -1};
+
+struct NavTriangle {
+    float vertices[9];
+    bool walkable;
+};
+
+// Solid span of a voxel column, spans of a column are linked from bottom to top
+struct NavSpan {
+    int minY, maxY;
+    bool walkable;
+    int next;
+};
+
+struct NavBuildData {
+    std::vector<NavTriangle> triangles;
+    std::vector<std::vector<int> > tileTriangles;
+
+    int climbCells;
+    int heightCells;
+    int radiusCells;
+    int border;
+};
+
+static int clipPolygon(const float *input, int numInput, float *output, int axis, float value, bool keepAbove);
+static void addSpan(std::vector<NavSpan> &spans, int &head, int minY, int maxY, bool walkable, int mergeDistance);
+static float cross2D(const Vector3 &a, const Vector3 &b, const Vector3 &c);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// NavMesh
+// Description:
+//      Constructor.
+//      Creates an empty navigation mesh.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+NavMesh::NavMesh() {
+    clear();
+}
+
+//
+// build
+// Description:
+//      Builds the navigation mesh over the faces of a model. Polygons are fan triangulated and a
+//      triangle is walkable when its face normal is within the walkable slope of the y axis.
+// Parameters:
+//      model     <Model&>: The level.
+//      in_config <const NavMeshConfig&>: Voxel size, agent size and tile size.
+// Returns:
+//      None (void).
+//
+void NavMesh::build(Model &model, const NavMeshConfig &in_config) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    clear();
+    config = in_config;
+
+    if (config.cellSize <= 0.0f || config.cellHeight <= 0.0f || config.tileSize < 1)
+        return;
+
+    NavBuildData data;
+    float minWalkableNormal = cosf(config.maxSlope * 3.14159265f / 180.0f);
+
+    std::vector<GroupObject *> &objects = model.getObjects();
+
+    for (int i = 0; i < (int)objects.size(); i++) {
+        for (int f = 0; f < (int)objects[i]->faces.size(); f++) {
+            Face *face = objects[i]->faces[f];
+
+            for (int v = 2; v < face->numVertices; v++) {
+                const Vector3 *corners[3] = {face->vertices[0], face->vertices[v - 1], face->vertices[v]};
+                NavTriangle triangle;
+
+                for (int c = 0; c < 3; c++) {
+                    triangle.vertices[c * 3 + 0] = corners[c]->x;
+                    triangle.vertices[c * 3 + 1] = corners[c]->y;
+                    triangle.vertices[c * 3 + 2] = corners[c]->z;
+                    bounds.expand(*corners[c]);
+                }
+
+                // Face normals of polygons which are not flat still give the slope of the whole face
+                Vector3 normal = face->faceNormal;
+                float length = sqrtf(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+
+                if (length <= 0.0f) {
+                    float *p = triangle.vertices;
+                    float e1[3] = {p[3] - p[0], p[4] - p[1], p[5] - p[2]};
+                    float e2[3] = {p[6] - p[0], p[7] - p[1], p[8] - p[2]};
+
+                    normal = Vector3(e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]);
+                    length = sqrtf(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+                }
+
+                triangle.walkable = length > 0.0f && normal.y / length >= minWalkableNormal;
+                data.triangles.push_back(triangle);
+            }
+        }
+    }
+
+    if (data.triangles.empty())
+        return;
+
+    Vector3 extent = bounds.getExtent();
+
+    columnsX = (int)ceilf(extent.x / config.cellSize) > 1 ? (int)ceilf(extent.x / config.cellSize) : 1;
+    columnsZ = (int)ceilf(extent.z / config.cellSize) > 1 ? (int)ceilf(extent.z / config.cellSize) : 1;
+    tilesX = (columnsX + config.tileSize - 1) / config.tileSize;
+    tilesZ = (columnsZ + config.tileSize - 1) / config.tileSize;
+
+    data.climbCells = (int)floorf(config.agentClimb / config.cellHeight);
+    data.heightCells = (int)ceilf(config.agentHeight / config.cellHeight);
+    data.radiusCells = (int)ceilf(config.agentRadius / config.cellSize);
+    data.border = data.radiusCells + 3;
+
+    // Every tile gets the triangles overlapping it and its border
+    int numTiles = tilesX * tilesZ;
+    data.tileTriangles.resize(numTiles);
+
+    for (int t = 0; t < (int)data.triangles.size(); t++) {
+        const float *p = data.triangles[t].vertices;
+
+        float minX = fminf(p[0], fminf(p[3], p[6])), maxX = fmaxf(p[0], fmaxf(p[3], p[6]));
+        float minZ = fminf(p[2], fminf(p[5], p[8])), maxZ = fmaxf(p[2], fmaxf(p[5], p[8]));
+
+        int x0 = (int)floorf((minX - bounds.min.x) / config.cellSize) - data.border;
+        int x1 = (int)floorf((maxX - bounds.min.x) / config.cellSize) + data.border;
+        int z0 = (int)floorf((minZ - bounds.min.z) / config.cellSize) - data.border;
+        int z1 = (int)floorf((maxZ - bounds.min.z) / config.cellSize) + data.border;
+
+        int tileX0 = x0 < 0 ? 0 : x0 / config.tileSize;
+        int tileZ0 = z0 < 0 ? 0 : z0 / config.tileSize;
+        int tileX1 = x1 / config.tileSize < tilesX - 1 ? x1 / config.tileSize : tilesX - 1;
+        int tileZ1 = z1 / config.tileSize < tilesZ - 1 ? z1 / config.tileSize : tilesZ - 1;
+
+        for (int tz = tileZ0; tz <= tileZ1; tz++) {
+            for (int tx = tileX0; tx <= tileX1; tx++)
+                data.tileTriangles[tz * tilesX + tx].push_back(t);
+        }
+    }
+
+    tiles.resize(numTiles);
+    std::vector<std::vector<NavPolygon> > tilePolygons(numTiles);
+
+    Parallel::forRange(0, numTiles, [this, &data, &tilePolygons](int first, int last) {
+        for (int t = first; t < last; t++)
+            buildTile(t, data, tilePolygons[t]);
+    }, 1);
+
+    // Tiles number their polygons from 0, move them into one list
+    for (int t = 0; t < numTiles; t++) {
+        int offset = (int)polygons.size();
+
+        polygons.insert(polygons.end(), tilePolygons[t].begin(), tilePolygons[t].end());
+
+        for (int c = 0; c < (int)tiles[t].cellPolygons.size(); c++) {
+            if (tiles[t].cellPolygons[c] >= 0) {
+                tiles[t].cellPolygons[c] += offset;
+                stats.numCells++;
+            }
+        }
+    }
+
+    connectPolygons();
+
+    stats.numTriangles = (int)data.triangles.size();
+    stats.numTiles = numTiles;
+    stats.numPolygons = (int)polygons.size();
+    stats.numLinks = (int)links.size();
+    stats.buildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// clear
+// Description:
+//      Deletes the navigation mesh.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void NavMesh::clear(void) {
+    polygons.clear();
+    links.clear();
+    tiles.clear();
+
+    bounds = BoundingBox();
+    columnsX = 0;
+    columnsZ = 0;
+    tilesX = 0;
+    tilesZ = 0;
+
+    stats = NavMeshStats();
+}
+
+//
+// findPolygon
+// Description:
+//      Finds the polygon below a point, or the closest one within the agent radius and a few cells
+//      if the point is off the mesh, for example right next to a wall.
+// Parameters:
+//      point <const Vector3&>: The point, normally the feet of an agent.
+// Returns:
+//      <int>: Index of the polygon, -1 if there is none close to the point.
+//
+int NavMesh::findPolygon(const Vector3 &point) const {
+    if (polygons.empty())
+        return -1;
+
+    int x = (int)floorf((point.x - bounds.min.x) / config.cellSize);
+    int z = (int)floorf((point.z - bounds.min.z) / config.cellSize);
+    int height = (int)floorf((point.y - bounds.min.y) / config.cellHeight + 0.5f);
+
+    int searchCells = (int)ceilf(config.agentRadius / config.cellSize) + NAV_SEARCH_CELLS;
+    float maxHeight = config.agentHeight;
+
+    for (int ring = 0; ring <= searchCells; ring++) {
+        int bestPolygon = -1;
+        float bestDistance = 0.0f;
+
+        for (int dz = -ring; dz <= ring; dz++) {
+            for (int dx = -ring; dx <= ring; dx++) {
+                if (abs(dx) != ring && abs(dz) != ring)
+                    continue;
+
+                int polygon;
+                int cellHeight = findCell(x + dx, z + dz, height, &polygon);
+
+                if (polygon < 0)
+                    continue;
+
+                float rise = (cellHeight - height) * config.cellHeight;
+                if (fabsf(rise) > maxHeight)
+                    continue;
+
+                float distance = (dx * dx + dz * dz) * config.cellSize * config.cellSize + rise * rise;
+
+                if (bestPolygon < 0 || distance < bestDistance) {
+                    bestPolygon = polygon;
+                    bestDistance = distance;
+                }
+            }
+        }
+
+        if (bestPolygon >= 0)
+            return bestPolygon;
+    }
+    return -1;
+}
+
+//
+// findPath
+// Description:
+//      Finds a path between two points on the mesh.
+// Parameters:
+//      start <const Vector3&>: Start of the path.
+//      end   <const Vector3&>: End of the path.
+//      path  <std::vector<Vector3>&>: Receives the corners of the path, from 'start' to 'end'.
+// Returns:
+//      <bool>: If the points are on the mesh and connected.
+//
+bool NavMesh::findPath(const Vector3 &start, const Vector3 &end, std::vector<Vector3> &path) const {
+    path.clear();
+
+    int startPolygon = findPolygon(start);
+    int endPolygon = findPolygon(end);
+
+    if (startPolygon < 0 || endPolygon < 0)
+        return false;
+
+    std::vector<int> corridor;
+
+    if (!findCorridor(startPolygon, endPolygon, end, corridor))
+        return false;
+
+    pullString(start, end, corridor, path);
+    return true;
+}
+
+//
+// getConfig
+// Description:
+//      Getter function for the settings of the last build.
+// Parameters:
+//      None (void).
+// Returns:
+//      config <const NavMeshConfig&>: The settings.
+//
+const NavMeshConfig &NavMesh::getConfig(void) const {
+    return config;
+}
+
+//
+// getStats
+// Description:
+//      Getter function for the statistics of the last build.
+// Parameters:
+//      None (void).
+// Returns:
+//      stats <const NavMeshStats&>: Build time and sizes.
+//
+const NavMeshStats &NavMesh::getStats(void) const {
+    return stats;
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// buildTile
+// Description:
+//      Voxelizes the triangles of a tile and its border, finds the floor cells, removes the cells
+//      close to edges and merges the cells inside the tile into rectangles.
+// Parameters:
+//      tile         <int>: Index of the tile, row by row.
+//      data         <NavBuildData&>: Triangles and sizes in voxels, only read.
+//      tilePolygons <std::vector<NavPolygon>&>: Receives the polygons of the tile.
+// Returns:
+//      None (void).
+//
+void NavMesh::buildTile(int tile, NavBuildData &data, std::vector<NavPolygon> &tilePolygons) {
+    int tileSize = config.tileSize;
+    int border = data.border;
+    int size = tileSize + border * 2;
+
+    int firstX = (tile % tilesX) * tileSize - border;
+    int firstZ = (tile / tilesX) * tileSize - border;
+
+    float cellSize = config.cellSize;
+    float cellHeight = config.cellHeight;
+
+    // Voxelize, clipping every triangle to the rows and then to the columns it covers
+    std::vector<NavSpan> spans;
+    std::vector<int> columnSpans(size * size, -1);
+
+    float row[NAV_MAX_CLIP_VERTICES * 3], cell[NAV_MAX_CLIP_VERTICES * 3], temp[NAV_MAX_CLIP_VERTICES * 3];
+
+    for (int t = 0; t < (int)data.tileTriangles[tile].size(); t++) {
+        const NavTriangle &triangle = data.triangles[data.tileTriangles[tile][t]];
+        const float *p = triangle.vertices;
+
+        float minX = fminf(p[0], fminf(p[3], p[6])), maxX = fmaxf(p[0], fmaxf(p[3], p[6]));
+        float minZ = fminf(p[2], fminf(p[5], p[8])), maxZ = fmaxf(p[2], fmaxf(p[5], p[8]));
+
+        int x0 = (int)floorf((minX - bounds.min.x) / cellSize) - firstX;
+        int x1 = (int)floorf((maxX - bounds.min.x) / cellSize) - firstX;
+        int z0 = (int)floorf((minZ - bounds.min.z) / cellSize) - firstZ;
+        int z1 = (int)floorf((maxZ - bounds.min.z) / cellSize) - firstZ;
+
+        x0 = x0 < 0 ? 0 : x0;
+        z0 = z0 < 0 ? 0 : z0;
+        x1 = x1 > size - 1 ? size - 1 : x1;
+        z1 = z1 > size - 1 ? size - 1 : z1;
+
+        for (int z = z0; z <= z1; z++) {
+            float rowMin = bounds.min.z + (firstZ + z) * cellSize;
+
+            int numRow = clipPolygon(p, 3, temp, 2, rowMin, true);
+            numRow = clipPolygon(temp, numRow, row, 2, rowMin + cellSize, false);
+
+            if (numRow < 3)
+                continue;
+
+            for (int x = x0; x <= x1; x++) {
+                float columnMin = bounds.min.x + (firstX + x) * cellSize;
+
+                int numCell = clipPolygon(row, numRow, temp, 0, columnMin, true);
+                numCell = clipPolygon(temp, numCell, cell, 0, columnMin + cellSize, false);
+
+                if (numCell < 3)
+                    continue;
+
+                float minY = cell[1], maxY = cell[1];
+                for (int v = 1; v < numCell; v++) {
+                    minY = fminf(minY, cell[v * 3 + 1]);
+                    maxY = fmaxf(maxY, cell[v * 3 + 1]);
+                }
+
+                int spanMin = (int)floorf((minY - bounds.min.y) / cellHeight);
+                int spanMax = (int)ceilf((maxY - bounds.min.y) / cellHeight);
+
+                spanMin = spanMin < 0 ? 0 : spanMin;
+                spanMax = spanMax <= spanMin ? spanMin + 1 : spanMax;
+
+                addSpan(spans, columnSpans[z * size + x], spanMin, spanMax, triangle.walkable, data.climbCells);
+            }
+        }
+    }
+
+    // Low obstacles such as the edges of steps can be walked over
+    for (int c = 0; c < size * size; c++) {
+        int previous = -1;
+        bool previousWalkable = false;
+
+        for (int s = columnSpans[c]; s >= 0; s = spans[s].next) {
+            bool walkable = spans[s].walkable;
+
+            if (!walkable && previousWalkable && spans[s].maxY - spans[previous].maxY <= data.climbCells)
+                spans[s].walkable = true;
+
+            previous = s;
+            previousWalkable = walkable;
+        }
+    }
+
+    // Floor cells on top of walkable spans with room for the agent above them
+    std::vector<int> columnStart(size * size + 1);
+    std::vector<int> floors;
+    std::vector<int> ceilings;
+
+    for (int c = 0; c < size * size; c++) {
+        columnStart[c] = (int)floors.size();
+
+        for (int s = columnSpans[c]; s >= 0; s = spans[s].next) {
+            if (!spans[s].walkable)
+                continue;
+
+            int floor = spans[s].maxY;
+            int ceiling = spans[s].next >= 0 ? spans[spans[s].next].minY : INT_MAX / 2;
+
+            if (ceiling - floor >= data.heightCells) {
+                floors.push_back(floor);
+                ceilings.push_back(ceiling);
+            }
+        }
+    }
+    columnStart[size * size] = (int)floors.size();
+
+    int numCells = (int)floors.size();
+    std::vector<int> cellLinks(numCells * 4, -1);
+
+    for (int z = 0; z < size; z++) {
+        for (int x = 0; x < size; x++) {
+            for (int c = columnStart[z * size + x]; c < columnStart[z * size + x + 1]; c++) {
+                for (int d = 0; d < 4; d++) {
+                    int nx = x + NAV_DIRECTION_X[d];
+                    int nz = z + NAV_DIRECTION_Z[d];
+
+                    if (nx < 0 || nz < 0 || nx >= size || nz >= size)
+                        continue;
+
+                    for (int n = columnStart[nz * size + nx]; n < columnStart[nz * size + nx + 1]; n++) {
+                        int gap = (ceilings[c] < ceilings[n] ? ceilings[c] : ceilings[n]) -
+                                  (floors[c] > floors[n] ? floors[c] : floors[n]);
+
+                        if (abs(floors[n] - floors[c]) <= data.climbCells && gap >= data.heightCells) {
+                            cellLinks[c * 4 + d] = n;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Distance in cells to the closest edge, cells missing a neighbour are on the edge
+    std::vector<int> distances(numCells, INT_MAX);
+    std::queue<int> open;
+
+    for (int c = 0; c < numCells; c++) {
+        if (cellLinks[c * 4 + 0] < 0 || cellLinks[c * 4 + 1] < 0 || cellLinks[c * 4 + 2] < 0 || cellLinks[c * 4 + 3] < 0) {
+            distances[c] = 0;
+            open.push(c);
+        }
+    }
+
+    while (!open.empty()) {
+        int c = open.front();
+        open.pop();
+
+        for (int d = 0; d < 4; d++) {
+            int n = cellLinks[c * 4 + d];
+
+            if (n >= 0 && distances[n] > distances[c] + 1) {
+                distances[n] = distances[c] + 1;
+                open.push(n);
+            }
+        }
+    }
+
+    // Merge the cells inside the tile into rectangles
+    std::vector<int> cellPolygons(numCells, -1);
+    std::vector<int> firstRow, lastRow, nextRow, rectangle;
+
+    int lastX = border + tileSize < border + columnsX - (firstX + border) ? border + tileSize : border + columnsX - (firstX + border);
+    int lastZ = border + tileSize < border + columnsZ - (firstZ + border) ? border + tileSize : border + columnsZ - (firstZ + border);
+
+    for (int z = border; z < lastZ; z++) {
+        for (int x = border; x < lastX; x++) {
+            for (int c = columnStart[z * size + x]; c < columnStart[z * size + x + 1]; c++) {
+                if (distances[c] < data.radiusCells || cellPolygons[c] >= 0)
+                    continue;
+
+                firstRow.assign(1, c);
+
+                while ((int)firstRow.size() < NAV_MAX_POLYGON_CELLS && x + (int)firstRow.size() < lastX) {
+                    int n = cellLinks[firstRow.back() * 4 + 0];
+
+                    if (n < 0 || distances[n] < data.radiusCells || cellPolygons[n] >= 0)
+                        break;
+                    firstRow.push_back(n);
+                }
+
+                int width = (int)firstRow.size();
+                int height = 1;
+
+                rectangle = firstRow;
+                lastRow = firstRow;
+
+                while (height < NAV_MAX_POLYGON_CELLS && z + height < lastZ) {
+                    nextRow.clear();
+
+                    for (int k = 0; k < width; k++) {
+                        int n = cellLinks[lastRow[k] * 4 + 1];
+
+                        if (n < 0 || distances[n] < data.radiusCells || cellPolygons[n] >= 0)
+                            break;
+
+                        // The new row has to be connected along x as well
+                        if (k > 0 && cellLinks[nextRow[k - 1] * 4 + 0] != n)
+                            break;
+
+                        nextRow.push_back(n);
+                    }
+
+                    if ((int)nextRow.size() < width)
+                        break;
+
+                    rectangle.insert(rectangle.end(), nextRow.begin(), nextRow.end());
+                    lastRow = nextRow;
+                    height++;
+                }
+
+                int polygonIndex = (int)tilePolygons.size();
+
+                for (int r = 0; r < (int)rectangle.size(); r++)
+                    cellPolygons[rectangle[r]] = polygonIndex;
+
+                NavPolygon polygon;
+                polygon.minX = bounds.min.x + (firstX + x) * cellSize;
+                polygon.minZ = bounds.min.z + (firstZ + z) * cellSize;
+                polygon.maxX = polygon.minX + width * cellSize;
+                polygon.maxZ = polygon.minZ + height * cellSize;
+                polygon.heights[0] = bounds.min.y + floors[firstRow[0]] * cellHeight;
+                polygon.heights[1] = bounds.min.y + floors[firstRow[width - 1]] * cellHeight;
+                polygon.heights[2] = bounds.min.y + floors[lastRow[width - 1]] * cellHeight;
+                polygon.heights[3] = bounds.min.y + floors[lastRow[0]] * cellHeight;
+                polygon.center = Vector3((polygon.minX + polygon.maxX) * 0.5f,
+                                         (polygon.heights[0] + polygon.heights[1] + polygon.heights[2] + polygon.heights[3]) * 0.25f,
+                                         (polygon.minZ + polygon.maxZ) * 0.5f);
+                polygon.firstLink = 0;
+                polygon.numLinks = 0;
+
+                tilePolygons.push_back(polygon);
+            }
+        }
+    }
+
+    // Keep the cells inside the tile for finding polygons
+    NavTile &result = tiles[tile];
+    result.columnStart.assign(tileSize * tileSize + 1, 0);
+    result.cellHeights.clear();
+    result.cellPolygons.clear();
+
+    for (int z = 0; z < tileSize; z++) {
+        for (int x = 0; x < tileSize; x++) {
+            int column = (z + border) * size + x + border;
+
+            result.columnStart[z * tileSize + x] = (int)result.cellHeights.size();
+
+            for (int c = columnStart[column]; c < columnStart[column + 1]; c++) {
+                if (cellPolygons[c] < 0)
+                    continue;
+
+                result.cellHeights.push_back(floors[c]);
+                result.cellPolygons.push_back(cellPolygons[c]);
+            }
+        }
+    }
+    result.columnStart[tileSize * tileSize] = (int)result.cellHeights.size();
+}
+
+//
+// connectPolygons
+// Description:
+//      Walks along the four sides of every polygon and links it to the polygons on the other side.
+//      Every run of cells bordering the same polygon becomes one portal.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void NavMesh::connectPolygons(void) {
+    links.clear();
+
+    int climbCells = (int)floorf(config.agentClimb / config.cellHeight);
+
+    for (int p = 0; p < (int)polygons.size(); p++) {
+        NavPolygon &polygon = polygons[p];
+        polygon.firstLink = (int)links.size();
+
+        int firstX = (int)floorf((polygon.minX - bounds.min.x) / config.cellSize + 0.5f);
+        int firstZ = (int)floorf((polygon.minZ - bounds.min.z) / config.cellSize + 0.5f);
+        int width = (int)floorf((polygon.maxX - polygon.minX) / config.cellSize + 0.5f);
+        int depth = (int)floorf((polygon.maxZ - polygon.minZ) / config.cellSize + 0.5f);
+
+        for (int d = 0; d < 4; d++) {
+            // Cells along the side, the side runs along z for the x directions and along x otherwise
+            int length = NAV_DIRECTION_X[d] != 0 ? depth : width;
+            int runPolygon = -1;
+            int runStart = 0;
+            float runStartHeight = 0.0f;
+            float lastHeight = 0.0f;
+
+            for (int k = 0; k <= length; k++) {
+                int neighbour = -1;
+                float height = 0.0f;
+
+                if (k < length) {
+                    int x, z;
+
+                    if (NAV_DIRECTION_X[d] != 0) {
+                        x = NAV_DIRECTION_X[d] > 0 ? firstX + width - 1 : firstX;
+                        z = firstZ + k;
+                    }
+                    else {
+                        x = firstX + k;
+                        z = NAV_DIRECTION_Z[d] > 0 ? firstZ + depth - 1 : firstZ;
+                    }
+
+                    // Interpolate the height of the cell from the corners to find it among the cells of its column
+                    float u = width > 1 ? (float)(x - firstX) / (width - 1) : 0.0f;
+                    float v = depth > 1 ? (float)(z - firstZ) / (depth - 1) : 0.0f;
+                    float y = (polygon.heights[0] * (1.0f - u) + polygon.heights[1] * u) * (1.0f - v) +
+                              (polygon.heights[3] * (1.0f - u) + polygon.heights[2] * u) * v;
+
+                    int own;
+                    int ownHeight = findCell(x, z, (int)floorf((y - bounds.min.y) / config.cellHeight + 0.5f), &own);
+
+                    if (own == p) {
+                        int other;
+                        int otherHeight = findCell(x + NAV_DIRECTION_X[d], z + NAV_DIRECTION_Z[d], ownHeight, &other);
+
+                        if (other >= 0 && other != p && abs(otherHeight - ownHeight) <= climbCells) {
+                            neighbour = other;
+                            height = bounds.min.y + ownHeight * config.cellHeight;
+                        }
+                    }
+                }
+
+                if (neighbour == runPolygon) {
+                    lastHeight = height;
+                    continue;
+                }
+
+                // The run ended, add a link for it
+                if (runPolygon >= 0) {
+                    NavLink link;
+                    link.polygon = runPolygon;
+
+                    if (NAV_DIRECTION_X[d] != 0) {
+                        float x = NAV_DIRECTION_X[d] > 0 ? polygon.maxX : polygon.minX;
+                        link.point0 = Vector3(x, runStartHeight, polygon.minZ + runStart * config.cellSize);
+                        link.point1 = Vector3(x, lastHeight, polygon.minZ + k * config.cellSize);
+                    }
+                    else {
+                        float z = NAV_DIRECTION_Z[d] > 0 ? polygon.maxZ : polygon.minZ;
+                        link.point0 = Vector3(polygon.minX + runStart * config.cellSize, runStartHeight, z);
+                        link.point1 = Vector3(polygon.minX + k * config.cellSize, lastHeight, z);
+                    }
+
+                    links.push_back(link);
+                }
+
+                runPolygon = neighbour;
+                runStart = k;
+                runStartHeight = height;
+                lastHeight = height;
+            }
+        }
+
+        polygon.numLinks = (int)links.size() - polygon.firstLink;
+    }
+}
+
+//
+// findCell
+// Description:
+//      Finds the floor cell of a column closest to a height.
+// Parameters:
+//      x       <int>: Column along x.
+//      z       <int>: Column along z.
+//      height  <int>: The height in voxels.
+//      polygon <int*>: Receives the polygon of the cell, -1 if the column has no cells.
+// Returns:
+//      <int>: Floor height of the cell in voxels.
+//
+int NavMesh::findCell(int x, int z, int height, int *polygon) const {
+    *polygon = -1;
+
+    if (x < 0 || z < 0 || x >= columnsX || z >= columnsZ)
+        return 0;
+
+    int tileSize = config.tileSize;
+    const NavTile &tile = tiles[(z / tileSize) * tilesX + x / tileSize];
+    int column = (z % tileSize) * tileSize + x % tileSize;
+
+    int best = 0;
+
+    for (int c = tile.columnStart[column]; c < tile.columnStart[column + 1]; c++) {
+        if (*polygon < 0 || abs(tile.cellHeights[c] - height) < abs(best - height)) {
+            best = tile.cellHeights[c];
+            *polygon = tile.cellPolygons[c];
+        }
+    }
+    return best;
+}
+
+//
+// findCorridor
+// Description:
+//      A* search over the polygons, moving between polygon centers.
+// Parameters:
+//      startPolygon <int>: Polygon of the start point.
+//      endPolygon   <int>: Polygon of the end point.
+//      end          <const Vector3&>: The end point, the heuristic is the distance to it.
+//      corridor     <std::vector<int>&>: Receives the polygons from start to end.
+// Returns:
+//      <bool>: If the end polygon can be reached.
+//
+bool NavMesh::findCorridor(int startPolygon, int endPolygon, const Vector3 &end, std::vector<int> &corridor) const {
+    corridor.clear();
+
+    int numPolygons = (int)polygons.size();
+    std::vector<float> costs(numPolygons, -1.0f);
+    std::vector<int> parents(numPolygons, -1);
+    std::vector<unsigned char> closed(numPolygons, 0);
+
+    // Entries are (estimated total cost, polygon), the smallest cost first
+    typedef std::pair<float, int> OpenEntry;
+    std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry> > open;
+
+    costs[startPolygon] = 0.0f;
+    open.push(OpenEntry(0.0f, startPolygon));
+
+    while (!open.empty()) {
+        int current = open.top().second;
+        open.pop();
+
+        // Polygons are pushed again when a cheaper way is found, skip the old entries
+        if (closed[current])
+            continue;
+        closed[current] = 1;
+
+        if (current == endPolygon)
+            break;
+
+        const NavPolygon &polygon = polygons[current];
+
+        for (int l = polygon.firstLink; l < polygon.firstLink + polygon.numLinks; l++) {
+            int next = links[l].polygon;
+
+            if (closed[next])
+                continue;
+
+            const Vector3 &from = polygon.center;
+            const Vector3 &to = polygons[next].center;
+
+            float dx = to.x - from.x, dy = to.y - from.y, dz = to.z - from.z;
+            float cost = costs[current] + sqrtf(dx * dx + dy * dy + dz * dz);
+
+            if (costs[next] >= 0.0f && cost >= costs[next])
+                continue;
+
+            costs[next] = cost;
+            parents[next] = current;
+
+            float hx = end.x - to.x, hy = end.y - to.y, hz = end.z - to.z;
+            open.push(OpenEntry(cost + sqrtf(hx * hx + hy * hy + hz * hz), next));
+        }
+    }
+
+    if (!closed[endPolygon])
+        return false;
+
+    for (int p = endPolygon; p >= 0; p = parents[p])
+        corridor.push_back(p);
+
+    std::reverse(corridor.begin(), corridor.end());
+    return true;
+}
+
+//
+// pullString
+// Description:
+//      Straightens the path through a corridor with the funnel algorithm. The funnel from the last
+//      corner is narrowed portal by portal, when a side would cross the other one the corner on
+//      that side is added to the path and the funnel starts again from there.
+// Parameters:
+//      start    <const Vector3&>: Start of the path.
+//      end      <const Vector3&>: End of the path.
+//      corridor <const std::vector<int>&>: Polygons from start to end.
+//      path     <std::vector<Vector3>&>: Receives the corners of the path.
+// Returns:
+//      None (void).
+//
+void NavMesh::pullString(const Vector3 &start, const Vector3 &end, const std::vector<int> &corridor,
+                         std::vector<Vector3> &path) const {
+    // Portals with their left and right point seen along the corridor, the end point is the last portal
+    std::vector<Vector3> lefts(1, start), rights(1, start);
+
+    for (int i = 0; i + 1 < (int)corridor.size(); i++) {
+        const NavPolygon &polygon = polygons[corridor[i]];
+
+        for (int l = polygon.firstLink; l < polygon.firstLink + polygon.numLinks; l++) {
+            if (links[l].polygon != corridor[i + 1])
+                continue;
+
+            const Vector3 &to = polygons[corridor[i + 1]].center;
+            Vector3 middle((links[l].point0.x + links[l].point1.x) * 0.5f, 0.0f, (links[l].point0.z + links[l].point1.z) * 0.5f);
+
+            if (cross2D(polygon.center, to, Vector3(polygon.center.x + links[l].point0.x - middle.x, 0.0f,
+                                                    polygon.center.z + links[l].point0.z - middle.z)) < 0.0f) {
+                lefts.push_back(links[l].point0);
+                rights.push_back(links[l].point1);
+            }
+            else {
+                lefts.push_back(links[l].point1);
+                rights.push_back(links[l].point0);
+            }
+            break;
+        }
+    }
+
+    lefts.push_back(end);
+    rights.push_back(end);
+
+    path.push_back(start);
+
+    Vector3 apex = start, left = start, right = start;
+    int apexIndex = 0, leftIndex = 0, rightIndex = 0;
+
+    for (int i = 1; i < (int)lefts.size(); i++) {
+        // Narrow the right side of the funnel
+        if (cross2D(apex, right, rights[i]) <= 0.0f) {
+            bool sameAsApex = right.x == apex.x && right.z == apex.z;
+
+            if (sameAsApex || cross2D(apex, left, rights[i]) > 0.0f) {
+                right = rights[i];
+                rightIndex = i;
+            }
+            else {
+                // The right side crossed the left one, the left point is a corner
+                path.push_back(left);
+                apex = left;
+                apexIndex = leftIndex;
+                left = apex;
+                right = apex;
+                leftIndex = apexIndex;
+                rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+
+        // Narrow the left side of the funnel
+        if (cross2D(apex, left, lefts[i]) >= 0.0f) {
+            bool sameAsApex = left.x == apex.x && left.z == apex.z;
+
+            if (sameAsApex || cross2D(apex, right, lefts[i]) < 0.0f) {
+                left = lefts[i];
+                leftIndex = i;
+            }
+            else {
+                path.push_back(right);
+                apex = right;
+                apexIndex = rightIndex;
+                left = apex;
+                right = apex;
+                leftIndex = apexIndex;
+                rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+    }
+
+    Vector3 &last = path.back();
+    if (last.x != end.x || last.y != end.y || last.z != end.z)
+        path.push_back(end);
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// clipPolygon
+// Description:
+//      Clips a convex polygon against an axis aligned plane.
+// Parameters:
+//      input     <const float*>: Vertices of the polygon, x y z.
+//      numInput  <int>: Number of vertices.
+//      output    <float*>: Receives the clipped polygon, room for one vertex more than the input.
+//      axis      <int>: 0 for x, 1 for y, 2 for z.
+//      value     <float>: Position of the plane on the axis.
+//      keepAbove <bool>: Keep the part above the plane instead of the part below.
+// Returns:
+//      <int>: Number of vertices of the clipped polygon.
+//
+static int clipPolygon(const float *input, int numInput, float *output, int axis, float value, bool keepAbove) {
+    int numOutput = 0;
+
+    for (int i = 0; i < numInput; i++) {
+        const float *a = &input[i * 3];
+        const float *b = &input[((i + 1) % numInput) * 3];
+
+        float distanceA = keepAbove ? a[axis] - value : value - a[axis];
+        float distanceB = keepAbove ? b[axis] - value : value - b[axis];
+
+        if (distanceA >= 0.0f) {
+            output[numOutput * 3 + 0] = a[0];
+            output[numOutput * 3 + 1] = a[1];
+            output[numOutput * 3 + 2] = a[2];
+            numOutput++;
+        }
+
+        if ((distanceA >= 0.0f) != (distanceB >= 0.0f)) {
+            float t = distanceA / (distanceA - distanceB);
+
+            output[numOutput * 3 + 0] = a[0] + (b[0] - a[0]) * t;
+            output[numOutput * 3 + 1] = a[1] + (b[1] - a[1]) * t;
+            output[numOutput * 3 + 2] = a[2] + (b[2] - a[2]) * t;
+            numOutput++;
+        }
+    }
+    return numOutput;
+}
+
+//
+// addSpan
+// Description:
+//      Adds a solid span to a column, merging it with the spans it overlaps. The merged span is
+//      walkable if one of the spans with a top close to the merged top is.
+// Parameters:
+//      spans         <std::vector<NavSpan>&>: Span storage of the tile.
+//      head          <int&>: Lowest span of the column, -1 if it is empty.
+//      minY          <int>: Bottom of the new span in voxels.
+//      maxY          <int>: Top of the new span in voxels.
+//      walkable      <bool>: If the top of the new span is walkable.
+//      mergeDistance <int>: Tops closer than this count as the same surface.
+// Returns:
+//      None (void).
+//
+static void addSpan(std::vector<NavSpan> &spans, int &head, int minY, int maxY, bool walkable, int mergeDistance) {
+    int previous = -1;
+    int current = head;
+
+    while (current >= 0) {
+        NavSpan &span = spans[current];
+
+        if (span.minY > maxY)
+            break;
+
+        if (span.maxY < minY) {
+            previous = current;
+            current = span.next;
+            continue;
+        }
+
+        // Overlapping, merge into the new span and unlink the old one
+        int top = span.maxY > maxY ? span.maxY : maxY;
+
+        walkable = (walkable && top - maxY <= mergeDistance) || (span.walkable && top - span.maxY <= mergeDistance);
+        minY = span.minY < minY ? span.minY : minY;
+        maxY = top;
+
+        current = span.next;
+
+        if (previous >= 0)
+            spans[previous].next = current;
+        else
+            head = current;
+    }
+
+    NavSpan span;
+    span.minY = minY;
+    span.maxY = maxY;
+    span.walkable = walkable;
+    span.next = current;
+
+    spans.push_back(span);
+
+    if (previous >= 0)
+        spans[previous].next = (int)spans.size() - 1;
+    else
+        head = (int)spans.size() - 1;
+}
+
+//
+// cross2D
+// Description:
+//      Twice the signed area of a triangle in the xz plane, positive if 'c' is right of the line
+//      from 'a' to 'b' when looking from above.
+// Parameters:
+//      a <const Vector3&>: First point.
+//      b <const Vector3&>: Second point.
+//      c <const Vector3&>: Third point.
+// Returns:
+//      <float>: The signed area.
+//
+static float cross2D(const Vector3 &a, const Vector3 &b, const Vector3 &c) {
+    return (c.x - a.x) * (b.z - a.z) - (b.x - a.x) * (c.z - a.z);
+}
@@ -0,0 +1,261 @@
+// NormalGenerator.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/NormalGenerator.h"
+#include "../include/Parallel.h"
+#include <unordered_map>
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// canSmooth
+// Description:
+//      Checks if two faces sharing a vertex should share its normal.
+//      Smoothing group 0 ('s off') keeps a face flat, -1 means the file had no 's' record.
+// Parameters:
+//      a, b        <const Face*>: The two faces.
+//      unitA, unitB <const float*>: Their unit face normals.
+//      cosCrease   <float>: Cosine of the crease angle.
+// Returns:
+//      <bool>: If the normals should be smoothed together.
+//
+static bool canSmooth(const Face *a, const Face *b, const float *unitA, const float *unitB, float cosCrease) {
+    if (a == b)
+        return true;
+
+    if (a->smoothingGroup == 0 || b->smoothingGroup == 0 || a->smoothingGroup != b->smoothingGroup)
+        return false;
+
+    return unitA[0] * unitB[0] + unitA[1] * unitB[1] + unitA[2] * unitB[2] >= cosCrease;
+}
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// generate
+// Description:
+//      Generates a normal for every face corner and points the faces at them.
+//      Existing face normals are replaced.
+// Parameters:
+//      objects     <std::vector<GroupObject *>&>: The group objects of the model.
+//      vertices    <std::vector<Vector3 *>&>: The vertices of the model.
+//      normals     <std::vector<Vector3>&>: Receives the generated normals, the faces point into it
+//                  so it must not be resized while the faces are in use.
+//      arena       <Arena&>: Arena of the faces, face normal arrays too short for the new normals
+//                  are replaced by arrays from it.
+//      creaseAngle <float>: Faces meeting at a larger angle (degrees) keep separate normals.
+//      weight      <NORMAL_WEIGHT>: Weight face normals by face area or by corner angle.
+// Returns:
+//      None (void).
+//
+void NormalGenerator::generate(std::vector<GroupObject *> &objects, std::vector<Vector3 *> &vertices,
+                               std::vector<Vector3> &normals, Arena &arena, float creaseAngle, NORMAL_WEIGHT weight) {
+    std::vector<Face *> faces;
+    std::vector<int> cornerStart(1, 0);
+
+    for (int i = 0; i < (int)objects.size(); i++) {
+        for (int f = 0; f < (int)objects[i]->faces.size(); f++) {
+            Face *face = objects[i]->faces[f];
+
+            faces.push_back(face);
+            cornerStart.push_back(cornerStart.back() + face->numVertices);
+        }
+    }
+
+    int numFaces = (int)faces.size();
+    int numCorners = cornerStart.back();
+    int numVertices = (int)vertices.size();
+
+    std::unordered_map<const Vector3 *, int> vertexIndices;
+    vertexIndices.reserve(numVertices);
+    for (int v = 0; v < numVertices; v++)
+        vertexIndices[vertices[v]] = v;
+
+    std::vector<int> cornerVertex(numCorners);
+    std::vector<int> cornerFace(numCorners);
+
+    std::vector<float> faceUnit(numFaces * 3);
+    std::vector<float> contribution(numCorners * 3);
+
+    // Face normals with Newell's method, the length is twice the polygon area
+    Parallel::forRange(0, numFaces, [&](int first, int last) {
+        for (int f = first; f < last; f++) {
+            Face *face = faces[f];
+            int start = cornerStart[f];
+            int count = face->numVertices;
+
+            float nx = 0.0f, ny = 0.0f, nz = 0.0f;
+
+            for (int v = 0; v < count; v++) {
+                const Vector3 *a = face->vertices[v];
+                const Vector3 *b = face->vertices[(v + 1) % count];
+
+                nx += (a->y - b->y) * (a->z + b->z);
+                ny += (a->z - b->z) * (a->x + b->x);
+                nz += (a->x - b->x) * (a->y + b->y);
+
+                std::unordered_map<const Vector3 *, int>::const_iterator it = vertexIndices.find(a);
+                cornerVertex[start + v] = it != vertexIndices.end() ? it->second : -1;
+                cornerFace[start + v] = f;
+            }
+
+            float length = sqrtf(nx * nx + ny * ny + nz * nz);
+            float scale = length > 0.0f ? 1.0f / length : 0.0f;
+
+            float *unit = &faceUnit[f * 3];
+            unit[0] = nx * scale;
+            unit[1] = ny * scale;
+            unit[2] = nz * scale;
+
+            for (int v = 0; v < count; v++) {
+                float *out = &contribution[(start + v) * 3];
+
+                if (weight == NORMAL_WEIGHT_AREA) {
+                    out[0] = nx * 0.5f;
+                    out[1] = ny * 0.5f;
+                    out[2] = nz * 0.5f;
+                    continue;
+                }
+
+                // Angle between the two edges leaving the corner
+                const Vector3 *p = face->vertices[v];
+                const Vector3 *prev = face->vertices[(v + count - 1) % count];
+                const Vector3 *next = face->vertices[(v + 1) % count];
+
+                float e0[3] = {next->x - p->x, next->y - p->y, next->z - p->z};
+                float e1[3] = {prev->x - p->x, prev->y - p->y, prev->z - p->z};
+
+                float l0 = sqrtf(e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
+                float l1 = sqrtf(e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2]);
+                float angle = 0.0f;
+
+                if (l0 > 0.0f && l1 > 0.0f) {
+                    float cosine = (e0[0] * e1[0] + e0[1] * e1[1] + e0[2] * e1[2]) / (l0 * l1);
+                    angle = acosf(fminf(fmaxf(cosine, -1.0f), 1.0f));
+                }
+
+                out[0] = unit[0] * angle;
+                out[1] = unit[1] * angle;
+                out[2] = unit[2] * angle;
+            }
+        }
+    }, 4096);
+
+    // Corners of every vertex, compressed row storage
+    std::vector<int> vertexStart(numVertices + 1, 0);
+    std::vector<int> vertexCorners(numCorners);
+
+    for (int c = 0; c < numCorners; c++) {
+        if (cornerVertex[c] >= 0)
+            vertexStart[cornerVertex[c] + 1]++;
+    }
+    for (int v = 0; v < numVertices; v++)
+        vertexStart[v + 1] += vertexStart[v];
+
+    std::vector<int> fill(vertexStart.begin(), vertexStart.end() - 1);
+    for (int c = 0; c < numCorners; c++) {
+        if (cornerVertex[c] >= 0)
+            vertexCorners[fill[cornerVertex[c]]++] = c;
+    }
+
+    float cosCrease = cosf(creaseAngle * (float)M_PI / 180.0f);
+
+    std::vector<float> cornerNormal(numCorners * 3);
+    std::vector<int> cornerSource(numCorners); // first corner of the vertex with an identical normal
+
+    Parallel::forRange(0, numVertices, [&](int first, int last) {
+        for (int v = first; v < last; v++) {
+            int begin = vertexStart[v];
+            int end = vertexStart[v + 1];
+
+            for (int i = begin; i < end; i++) {
+                int c = vertexCorners[i];
+                int f = cornerFace[c];
+                float sum[3] = {0.0f, 0.0f, 0.0f};
+
+                for (int j = begin; j < end; j++) {
+                    int d = vertexCorners[j];
+                    int g = cornerFace[d];
+
+                    if (!canSmooth(faces[f], faces[g], &faceUnit[f * 3], &faceUnit[g * 3], cosCrease))
+                        continue;
+
+                    sum[0] += contribution[d * 3 + 0];
+                    sum[1] += contribution[d * 3 + 1];
+                    sum[2] += contribution[d * 3 + 2];
+                }
+
+                float length = sqrtf(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+                float *out = &cornerNormal[c * 3];
+
+                if (length > 0.0f) {
+                    out[0] = sum[0] / length;
+                    out[1] = sum[1] / length;
+                    out[2] = sum[2] / length;
+                }
+                else {
+                    out[0] = faceUnit[f * 3 + 0];
+                    out[1] = faceUnit[f * 3 + 1];
+                    out[2] = faceUnit[f * 3 + 2];
+                }
+
+                cornerSource[c] = c;
+                for (int j = begin; j < i; j++) {
+                    const float *other = &cornerNormal[vertexCorners[j] * 3];
+
+                    if (other[0] == out[0] && other[1] == out[1] && other[2] == out[2]) {
+                        cornerSource[c] = cornerSource[vertexCorners[j]];
+                        break;
+                    }
+                }
+            }
+        }
+    }, 4096);
+
+    // Store the unique normals in vertex order
+    std::vector<int> cornerIndex(numCorners, -1);
+
+    normals.clear();
+    normals.reserve(numVertices);
+
+    for (int i = 0; i < numCorners; i++) {
+        int c = vertexCorners[i];
+
+        if (cornerSource[c] != c) {
+            cornerIndex[c] = cornerIndex[cornerSource[c]];
+            continue;
+        }
+
+        cornerIndex[c] = (int)normals.size();
+        normals.push_back(Vector3(cornerNormal[c * 3 + 0], cornerNormal[c * 3 + 1], cornerNormal[c * 3 + 2]));
+    }
+
+    // Corners of unknown vertices keep the face normal
+    for (int c = 0; c < numCorners; c++) {
+        if (cornerVertex[c] < 0) {
+            const float *unit = &faceUnit[cornerFace[c] * 3];
+            cornerIndex[c] = (int)normals.size();
+            normals.push_back(Vector3(unit[0], unit[1], unit[2]));
+        }
+    }
+
+    for (int f = 0; f < numFaces; f++) {
+        Face *face = faces[f];
+
+        if (face->numNormals < face->numVertices)
+            face->normals = arena.allocateArray<Vector3 *>(face->numVertices);
+
+        face->numNormals = face->numVertices;
+
+        for (int v = 0; v < face->numVertices; v++)
+            face->normals[v] = &normals[cornerIndex[cornerStart[f] + v]];
+    }
+}
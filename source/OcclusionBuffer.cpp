@@ -0,0 +1,725 @@
+// OcclusionBuffer.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/OcclusionBuffer.h"
+#include "../include/Model.h"
+#include "../include/Parallel.h"
+#include <math.h>
+#include <atomic>
+#include <chrono>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define OCCLUSION_AVX
+#elif defined(__SSE__) || defined(_M_X64)
+    #include <xmmintrin.h>
+    #define OCCLUSION_SSE
+#endif
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int OCCLUSION_TILE_WIDTH = 32;   // Multiple of the SIMD width
+static const int OCCLUSION_TILE_HEIGHT = 16;
+static const int OCCLUSION_MAX_TEXELS = 4;    // Texels per axis read when testing a box
+static const int OCCLUSION_MIN_PARALLEL_VERTICES = 4096;
+static const int OCCLUSION_MIN_PARALLEL_BOXES = 256;
+static const float OCCLUSION_NEAR_EPSILON = 1e-6f;
+
+struct ClipVertex {
+    float x, y, z, w;
+};
+
+static ClipVertex transformPoint(const float *matrix, float x, float y, float z);
+static ClipVertex lerpVertex(const ClipVertex &a, const ClipVertex &b, float t);
+static double getMilliseconds(std::chrono::steady_clock::time_point start);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// OcclusionBuffer
+// Description:
+//      Constructor.
+//      Creates an empty depth buffer. The width and height are rounded up to whole tiles.
+// Parameters:
+//      in_width  <int>: Width of the depth buffer in pixels.
+//      in_height <int>: Height of the depth buffer in pixels.
+// Returns:
+//      None (void).
+//
+OcclusionBuffer::OcclusionBuffer(int in_width, int in_height) {
+    tilesX = (in_width + OCCLUSION_TILE_WIDTH - 1) / OCCLUSION_TILE_WIDTH;
+    tilesY = (in_height + OCCLUSION_TILE_HEIGHT - 1) / OCCLUSION_TILE_HEIGHT;
+
+    if (tilesX < 1)
+        tilesX = 1;
+    if (tilesY < 1)
+        tilesY = 1;
+
+    width = tilesX * OCCLUSION_TILE_WIDTH;
+    height = tilesY * OCCLUSION_TILE_HEIGHT;
+
+    tileTriangles.resize(tilesX * tilesY);
+
+    int levelWidth = width;
+    int levelHeight = height;
+
+    while (true) {
+        pyramid.push_back(std::vector<float>(levelWidth * levelHeight, 1.0f));
+        levelWidths.push_back(levelWidth);
+        levelHeights.push_back(levelHeight);
+
+        if (levelWidth == 1 && levelHeight == 1)
+            break;
+
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+
+    for (int i = 0; i < 16; i++)
+        matrix[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+}
+
+//
+// addOccluder
+// Description:
+//      Adds the faces of a model as occluders. Polygons are fan triangulated.
+//      The model should be closed and smaller than what it stands in for, so it never hides
+//      something the real geometry would show.
+// Parameters:
+//      model <Model&>: The occluder model, in the same space as the boxes which are tested.
+// Returns:
+//      None (void).
+//
+void OcclusionBuffer::addOccluder(Model &model) {
+    std::vector<GroupObject *> &objects = model.getObjects();
+
+    for (int i = 0; i < (int)objects.size(); i++) {
+        for (int f = 0; f < (int)objects[i]->faces.size(); f++) {
+            Face *face = objects[i]->faces[f];
+            int first = (int)positions.size() / 3;
+
+            for (int v = 0; v < face->numVertices; v++) {
+                positions.push_back(face->vertices[v]->x);
+                positions.push_back(face->vertices[v]->y);
+                positions.push_back(face->vertices[v]->z);
+            }
+
+            for (int v = 2; v < face->numVertices; v++) {
+                indices.push_back(first);
+                indices.push_back(first + v - 1);
+                indices.push_back(first + v);
+            }
+        }
+    }
+
+    stats.numOccluderTriangles = (int)indices.size() / 3;
+}
+
+//
+// addOccluder
+// Description:
+//      Adds an indexed triangle mesh as occluder.
+// Parameters:
+//      in_positions <const float*>: x, y, z of every vertex.
+//      numVertices  <int>: Number of vertices.
+//      in_indices   <const int*>: Three vertex indices per triangle.
+//      numIndices   <int>: Number of indices.
+// Returns:
+//      None (void).
+//
+void OcclusionBuffer::addOccluder(const float *in_positions, int numVertices, const int *in_indices, int numIndices) {
+    int first = (int)positions.size() / 3;
+
+    positions.insert(positions.end(), in_positions, in_positions + numVertices * 3);
+
+    for (int i = 0; i + 2 < numIndices; i += 3) {
+        indices.push_back(first + in_indices[i + 0]);
+        indices.push_back(first + in_indices[i + 1]);
+        indices.push_back(first + in_indices[i + 2]);
+    }
+
+    stats.numOccluderTriangles = (int)indices.size() / 3;
+}
+
+//
+// clearOccluders
+// Description:
+//      Removes all occluders. The depth buffer keeps its contents until the next 'render'.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void OcclusionBuffer::clearOccluders(void) {
+    positions.clear();
+    indices.clear();
+    stats.numOccluderTriangles = 0;
+}
+
+//
+// setViewProjection
+// Description:
+//      Sets the matrix the occluders and boxes are projected with, normally the same one the
+//      view frustum is extracted from.
+// Parameters:
+//      in_matrix <const float*>: Projection * modelview, 4x4 in OpenGL column major order.
+// Returns:
+//      None (void).
+//
+void OcclusionBuffer::setViewProjection(const float *in_matrix) {
+    for (int i = 0; i < 16; i++)
+        matrix[i] = in_matrix[i];
+}
+
+//
+// render
+// Description:
+//      Rasterizes the occluders with the current matrix and builds the depth pyramid.
+//      Resets the box test statistics.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void OcclusionBuffer::render(void) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    int numVertices = (int)positions.size() / 3;
+    clipVertices.resize(numVertices * 4);
+
+    Parallel::forRange(0, numVertices, [this](int first, int last) {
+        for (int v = first; v < last; v++) {
+            ClipVertex vertex = transformPoint(matrix, positions[v * 3 + 0], positions[v * 3 + 1], positions[v * 3 + 2]);
+
+            clipVertices[v * 4 + 0] = vertex.x;
+            clipVertices[v * 4 + 1] = vertex.y;
+            clipVertices[v * 4 + 2] = vertex.z;
+            clipVertices[v * 4 + 3] = vertex.w;
+        }
+    }, OCCLUSION_MIN_PARALLEL_VERTICES);
+
+    setupTriangles();
+
+    // Tiles take very different amounts of work, so threads take the next free tile instead of fixed ranges
+    int numTiles = tilesX * tilesY;
+    std::atomic<int> nextTile(0);
+
+    Parallel::forRange(0, Parallel::getNumThreads(), [this, numTiles, &nextTile](int, int) {
+        for (int tile = nextTile++; tile < numTiles; tile = nextTile++)
+            rasterizeTile(tile);
+    }, 1);
+
+    buildPyramid();
+
+    stats.numRasterizedTriangles = (int)triangles.size();
+    stats.numTested = 0;
+    stats.numOccluded = 0;
+    stats.testTime = 0.0;
+    stats.rasterTime = getMilliseconds(start);
+}
+
+//
+// testBox
+// Description:
+//      Tests if a box may be visible behind the occluders. Boxes crossing the near plane are always
+//      visible.
+// Parameters:
+//      box <const BoundingBox&>: The box.
+// Returns:
+//      <bool>: False if the box is completely hidden by the occluders.
+//
+bool OcclusionBuffer::testBox(const BoundingBox &box) const {
+    float minX = (float)width, minY = (float)height, maxX = 0.0f, maxY = 0.0f;
+    float minDepth = 1.0f;
+
+    for (int c = 0; c < 8; c++) {
+        ClipVertex corner = transformPoint(matrix, (c & 1) ? box.max.x : box.min.x,
+                                                   (c & 2) ? box.max.y : box.min.y,
+                                                   (c & 4) ? box.max.z : box.min.z);
+
+        if (corner.w <= OCCLUSION_NEAR_EPSILON || corner.z < -corner.w)
+            return true;
+
+        float inverseW = 1.0f / corner.w;
+        float x = (corner.x * inverseW * 0.5f + 0.5f) * width;
+        float y = (corner.y * inverseW * 0.5f + 0.5f) * height;
+        float depth = corner.z * inverseW * 0.5f + 0.5f;
+
+        minX = x < minX ? x : minX;
+        maxX = x > maxX ? x : maxX;
+        minY = y < minY ? y : minY;
+        maxY = y > maxY ? y : maxY;
+        minDepth = depth < minDepth ? depth : minDepth;
+    }
+
+    // Outside of the screen, which is up to the frustum to decide
+    if (maxX < 0.0f || maxY < 0.0f || minX >= (float)width || minY >= (float)height)
+        return true;
+
+    // Occluders cover the pixels whose center they cover, so one more pixel around the rectangle is read
+    // to stay conservative along their edges
+    int x0 = minX > 1.0f ? (int)minX - 1 : 0;
+    int y0 = minY > 1.0f ? (int)minY - 1 : 0;
+    int x1 = maxX < (float)(width - 2) ? (int)maxX + 1 : width - 1;
+    int y1 = maxY < (float)(height - 2) ? (int)maxY + 1 : height - 1;
+
+    // Read the level where the rectangle covers only a few texels
+    int level = 0;
+    while (level + 1 < (int)pyramid.size() &&
+           ((x1 >> level) - (x0 >> level) >= OCCLUSION_MAX_TEXELS || (y1 >> level) - (y0 >> level) >= OCCLUSION_MAX_TEXELS))
+        level++;
+
+    const std::vector<float> &depths = pyramid[level];
+    int levelWidth = levelWidths[level];
+
+    for (int y = y0 >> level; y <= (y1 >> level); y++) {
+        for (int x = x0 >> level; x <= (x1 >> level); x++) {
+            if (minDepth <= depths[y * levelWidth + x])
+                return true;
+        }
+    }
+    return false;
+}
+
+//
+// cullBoxes
+// Description:
+//      Tests the boxes still marked visible, typically after frustum culling, and clears the ones
+//      hidden by the occluders. Runs on several threads for large arrays.
+// Parameters:
+//      boxes   <const BoundingBoxArray&>: The boxes.
+//      visible <unsigned char*>: One entry per box, only boxes with a non zero entry are tested and
+//              hidden boxes are set to 0.
+// Returns:
+//      <int>: The number of boxes that may be visible.
+//
+int OcclusionBuffer::cullBoxes(const BoundingBoxArray &boxes, unsigned char *visible) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::atomic<int> numTested(0);
+    std::atomic<int> numOccluded(0);
+    std::atomic<int> numVisible(0);
+
+    Parallel::forRange(0, boxes.count, [&](int first, int last) {
+        int tested = 0, occluded = 0, stillVisible = 0;
+
+        for (int i = first; i < last; i++) {
+            if (!visible[i])
+                continue;
+
+            BoundingBox box(Vector3(boxes.minX[i], boxes.minY[i], boxes.minZ[i]),
+                            Vector3(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]));
+            tested++;
+
+            if (testBox(box)) {
+                stillVisible++;
+            }
+            else {
+                visible[i] = 0;
+                occluded++;
+            }
+        }
+
+        numTested += tested;
+        numOccluded += occluded;
+        numVisible += stillVisible;
+    }, OCCLUSION_MIN_PARALLEL_BOXES);
+
+    stats.numTested += numTested;
+    stats.numOccluded += numOccluded;
+    stats.testTime += getMilliseconds(start);
+
+    return numVisible;
+}
+
+//
+// getWidth
+// Description:
+//      Getter function for the width of the depth buffer.
+// Parameters:
+//      None (void).
+// Returns:
+//      width <int>: Width in pixels, a whole number of tiles.
+//
+int OcclusionBuffer::getWidth(void) const {
+    return width;
+}
+
+//
+// getHeight
+// Description:
+//      Getter function for the height of the depth buffer.
+// Parameters:
+//      None (void).
+// Returns:
+//      height <int>: Height in pixels, a whole number of tiles.
+//
+int OcclusionBuffer::getHeight(void) const {
+    return height;
+}
+
+//
+// getDepth
+// Description:
+//      Getter function for the depth buffer, for debug views.
+// Parameters:
+//      None (void).
+// Returns:
+//      <const float*>: width * height depths, row by row from the bottom of the screen.
+//
+const float *OcclusionBuffer::getDepth(void) const {
+    return &pyramid[0][0];
+}
+
+//
+// getStats
+// Description:
+//      Getter function for the statistics of the last frame.
+// Parameters:
+//      None (void).
+// Returns:
+//      stats <const OcclusionStats&>: Triangle counts, rejected boxes and timings.
+//
+const OcclusionStats &OcclusionBuffer::getStats(void) const {
+    return stats;
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// setupTriangles
+// Description:
+//      Clips the transformed occluder triangles against the near plane, computes their edge and
+//      depth equations in pixels and lists them in every tile their bounds overlap.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void OcclusionBuffer::setupTriangles(void) {
+    triangles.clear();
+
+    for (int t = 0; t < (int)tileTriangles.size(); t++)
+        tileTriangles[t].clear();
+
+    for (int i = 0; i + 2 < (int)indices.size(); i += 3) {
+        ClipVertex input[3];
+        int numInside = 0;
+
+        for (int v = 0; v < 3; v++) {
+            const float *vertex = &clipVertices[indices[i + v] * 4];
+
+            input[v].x = vertex[0];
+            input[v].y = vertex[1];
+            input[v].z = vertex[2];
+            input[v].w = vertex[3];
+
+            if (input[v].z + input[v].w >= 0.0f)
+                numInside++;
+        }
+
+        if (numInside == 0)
+            continue;
+
+        // Clip against the near plane z = -w, a triangle becomes at most a quad
+        ClipVertex polygon[4];
+        int numPolygon = 0;
+
+        for (int v = 0; v < 3; v++) {
+            const ClipVertex &a = input[v];
+            const ClipVertex &b = input[(v + 1) % 3];
+            float distanceA = a.z + a.w;
+            float distanceB = b.z + b.w;
+
+            if (distanceA >= 0.0f)
+                polygon[numPolygon++] = a;
+
+            if ((distanceA >= 0.0f) != (distanceB >= 0.0f))
+                polygon[numPolygon++] = lerpVertex(a, b, distanceA / (distanceA - distanceB));
+        }
+
+        float screenX[4], screenY[4], depth[4];
+        bool valid = true;
+
+        for (int v = 0; v < numPolygon; v++) {
+            if (polygon[v].w <= OCCLUSION_NEAR_EPSILON) {
+                valid = false;
+                break;
+            }
+
+            float inverseW = 1.0f / polygon[v].w;
+            screenX[v] = (polygon[v].x * inverseW * 0.5f + 0.5f) * width;
+            screenY[v] = (polygon[v].y * inverseW * 0.5f + 0.5f) * height;
+            depth[v] = polygon[v].z * inverseW * 0.5f + 0.5f;
+        }
+
+        if (!valid)
+            continue;
+
+        for (int v = 2; v < numPolygon; v++) {
+            int corner[3] = {0, v - 1, v};
+
+            float x0 = screenX[corner[0]], y0 = screenY[corner[0]], z0 = depth[corner[0]];
+            float x1 = screenX[corner[1]], y1 = screenY[corner[1]], z1 = depth[corner[1]];
+            float x2 = screenX[corner[2]], y2 = screenY[corner[2]], z2 = depth[corner[2]];
+
+            float area = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+
+            if (fabsf(area) < 1e-8f)
+                continue;
+
+            // Occluders are drawn from both sides, turn clockwise triangles around
+            if (area < 0.0f) {
+                float swap;
+                swap = x1; x1 = x2; x2 = swap;
+                swap = y1; y1 = y2; y2 = swap;
+                swap = z1; z1 = z2; z2 = swap;
+                area = -area;
+            }
+
+            float boundsMinX = fminf(x0, fminf(x1, x2)), boundsMaxX = fmaxf(x0, fmaxf(x1, x2));
+            float boundsMinY = fminf(y0, fminf(y1, y2)), boundsMaxY = fmaxf(y0, fmaxf(y1, y2));
+
+            if (boundsMaxX < 0.0f || boundsMaxY < 0.0f || boundsMinX >= (float)width || boundsMinY >= (float)height)
+                continue;
+
+            if (fminf(z0, fminf(z1, z2)) > 1.0f)
+                continue;
+
+            OcclusionTriangle triangle;
+
+            triangle.minX = boundsMinX > 0.0f ? (int)boundsMinX : 0;
+            triangle.minY = boundsMinY > 0.0f ? (int)boundsMinY : 0;
+            triangle.maxX = boundsMaxX < (float)(width - 1) ? (int)boundsMaxX : width - 1;
+            triangle.maxY = boundsMaxY < (float)(height - 1) ? (int)boundsMaxY : height - 1;
+
+            float edgeX[3][2] = {{x1, x2}, {x2, x0}, {x0, x1}};
+            float edgeY[3][2] = {{y1, y2}, {y2, y0}, {y0, y1}};
+
+            for (int e = 0; e < 3; e++) {
+                triangle.edgeA[e] = edgeY[e][0] - edgeY[e][1];
+                triangle.edgeB[e] = edgeX[e][1] - edgeX[e][0];
+                triangle.edgeC[e] = edgeX[e][0] * edgeY[e][1] - edgeY[e][0] * edgeX[e][1];
+            }
+
+            triangle.depthA = ((z1 - z0) * (y2 - y0) - (z2 - z0) * (y1 - y0)) / area;
+            triangle.depthB = ((x1 - x0) * (z2 - z0) - (x2 - x0) * (z1 - z0)) / area;
+            triangle.depthC = z0 - triangle.depthA * x0 - triangle.depthB * y0;
+
+            int index = (int)triangles.size();
+            triangles.push_back(triangle);
+
+            for (int ty = triangle.minY / OCCLUSION_TILE_HEIGHT; ty <= triangle.maxY / OCCLUSION_TILE_HEIGHT; ty++) {
+                for (int tx = triangle.minX / OCCLUSION_TILE_WIDTH; tx <= triangle.maxX / OCCLUSION_TILE_WIDTH; tx++)
+                    tileTriangles[ty * tilesX + tx].push_back(index);
+            }
+        }
+    }
+}
+
+//
+// rasterizeTile
+// Description:
+//      Clears one tile of the depth buffer and rasterizes the triangles listed in it, keeping the
+//      nearest depth of every pixel whose center is covered.
+// Parameters:
+//      tile <int>: Index of the tile, row by row.
+// Returns:
+//      None (void).
+//
+void OcclusionBuffer::rasterizeTile(int tile) {
+    int tileX = (tile % tilesX) * OCCLUSION_TILE_WIDTH;
+    int tileY = (tile / tilesX) * OCCLUSION_TILE_HEIGHT;
+    float *depths = &pyramid[0][0];
+
+    for (int y = tileY; y < tileY + OCCLUSION_TILE_HEIGHT; y++) {
+        for (int x = tileX; x < tileX + OCCLUSION_TILE_WIDTH; x++)
+            depths[y * width + x] = 1.0f;
+    }
+
+    const std::vector<int> &list = tileTriangles[tile];
+
+    for (int i = 0; i < (int)list.size(); i++) {
+        const OcclusionTriangle &triangle = triangles[list[i]];
+
+        int x0 = triangle.minX > tileX ? triangle.minX : tileX;
+        int y0 = triangle.minY > tileY ? triangle.minY : tileY;
+        int x1 = triangle.maxX < tileX + OCCLUSION_TILE_WIDTH - 1 ? triangle.maxX : tileX + OCCLUSION_TILE_WIDTH - 1;
+        int y1 = triangle.maxY < tileY + OCCLUSION_TILE_HEIGHT - 1 ? triangle.maxY : tileY + OCCLUSION_TILE_HEIGHT - 1;
+
+        for (int y = y0; y <= y1; y++) {
+            float centerY = (float)y + 0.5f;
+            float *row = &depths[y * width];
+
+            float rowEdge0 = triangle.edgeB[0] * centerY + triangle.edgeC[0];
+            float rowEdge1 = triangle.edgeB[1] * centerY + triangle.edgeC[1];
+            float rowEdge2 = triangle.edgeB[2] * centerY + triangle.edgeC[2];
+            float rowDepth = triangle.depthB * centerY + triangle.depthC;
+
+#if defined(OCCLUSION_AVX)
+            // Start on a multiple of 8, tiles are a whole number of 8 pixel groups wide
+            for (int x = x0 & ~7; x <= x1; x += 8) {
+                __m256 centerX = _mm256_add_ps(_mm256_set1_ps((float)x + 0.5f),
+                                               _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f));
+
+                __m256 edge0 = _mm256_add_ps(_mm256_mul_ps(centerX, _mm256_set1_ps(triangle.edgeA[0])), _mm256_set1_ps(rowEdge0));
+                __m256 edge1 = _mm256_add_ps(_mm256_mul_ps(centerX, _mm256_set1_ps(triangle.edgeA[1])), _mm256_set1_ps(rowEdge1));
+                __m256 edge2 = _mm256_add_ps(_mm256_mul_ps(centerX, _mm256_set1_ps(triangle.edgeA[2])), _mm256_set1_ps(rowEdge2));
+
+                __m256 inside = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(edge0, _mm256_setzero_ps(), _CMP_GE_OQ),
+                                                            _mm256_cmp_ps(edge1, _mm256_setzero_ps(), _CMP_GE_OQ)),
+                                              _mm256_cmp_ps(edge2, _mm256_setzero_ps(), _CMP_GE_OQ));
+
+                if (_mm256_movemask_ps(inside) == 0)
+                    continue;
+
+                __m256 depth = _mm256_add_ps(_mm256_mul_ps(centerX, _mm256_set1_ps(triangle.depthA)), _mm256_set1_ps(rowDepth));
+                __m256 current = _mm256_loadu_ps(&row[x]);
+
+                _mm256_storeu_ps(&row[x], _mm256_blendv_ps(current, _mm256_min_ps(current, depth), inside));
+            }
+#elif defined(OCCLUSION_SSE)
+            // Start on a multiple of 4, tiles are a whole number of 4 pixel groups wide
+            for (int x = x0 & ~3; x <= x1; x += 4) {
+                __m128 centerX = _mm_add_ps(_mm_set1_ps((float)x + 0.5f), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+
+                __m128 edge0 = _mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(triangle.edgeA[0])), _mm_set1_ps(rowEdge0));
+                __m128 edge1 = _mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(triangle.edgeA[1])), _mm_set1_ps(rowEdge1));
+                __m128 edge2 = _mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(triangle.edgeA[2])), _mm_set1_ps(rowEdge2));
+
+                __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, _mm_setzero_ps()),
+                                                      _mm_cmpge_ps(edge1, _mm_setzero_ps())),
+                                           _mm_cmpge_ps(edge2, _mm_setzero_ps()));
+
+                if (_mm_movemask_ps(inside) == 0)
+                    continue;
+
+                __m128 depth = _mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(triangle.depthA)), _mm_set1_ps(rowDepth));
+                __m128 current = _mm_loadu_ps(&row[x]);
+                __m128 nearest = _mm_min_ps(current, depth);
+
+                _mm_storeu_ps(&row[x], _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+            }
+#else
+            for (int x = x0; x <= x1; x++) {
+                float centerX = (float)x + 0.5f;
+
+                if (triangle.edgeA[0] * centerX + rowEdge0 < 0.0f ||
+                    triangle.edgeA[1] * centerX + rowEdge1 < 0.0f ||
+                    triangle.edgeA[2] * centerX + rowEdge2 < 0.0f)
+                    continue;
+
+                float depth = triangle.depthA * centerX + rowDepth;
+                if (depth < row[x])
+                    row[x] = depth;
+            }
+#endif
+        }
+    }
+}
+
+//
+// buildPyramid
+// Description:
+//      Builds the levels of the depth pyramid, every texel keeps the farthest depth of the 2x2
+//      texels below it.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void OcclusionBuffer::buildPyramid(void) {
+    for (int level = 1; level < (int)pyramid.size(); level++) {
+        const std::vector<float> &source = pyramid[level - 1];
+        std::vector<float> &target = pyramid[level];
+
+        int sourceWidth = levelWidths[level - 1];
+        int sourceHeight = levelHeights[level - 1];
+        int targetWidth = levelWidths[level];
+        int targetHeight = levelHeights[level];
+
+        for (int y = 0; y < targetHeight; y++) {
+            int sourceY0 = y * 2;
+            int sourceY1 = sourceY0 + 1 < sourceHeight ? sourceY0 + 1 : sourceY0;
+
+            for (int x = 0; x < targetWidth; x++) {
+                int sourceX0 = x * 2;
+                int sourceX1 = sourceX0 + 1 < sourceWidth ? sourceX0 + 1 : sourceX0;
+
+                float farthest = fmaxf(fmaxf(source[sourceY0 * sourceWidth + sourceX0], source[sourceY0 * sourceWidth + sourceX1]),
+                                       fmaxf(source[sourceY1 * sourceWidth + sourceX0], source[sourceY1 * sourceWidth + sourceX1]));
+
+                target[y * targetWidth + x] = farthest;
+            }
+        }
+    }
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// transformPoint
+// Description:
+//      Transforms a point into clip space.
+// Parameters:
+//      matrix <const float*>: 4x4 matrix in OpenGL column major order.
+//      x      <float>: x coordinate of the point.
+//      y      <float>: y coordinate of the point.
+//      z      <float>: z coordinate of the point.
+// Returns:
+//      <ClipVertex>: The point in clip space.
+//
+static ClipVertex transformPoint(const float *matrix, float x, float y, float z) {
+    ClipVertex vertex;
+
+    vertex.x = matrix[0] * x + matrix[4] * y + matrix[8] * z + matrix[12];
+    vertex.y = matrix[1] * x + matrix[5] * y + matrix[9] * z + matrix[13];
+    vertex.z = matrix[2] * x + matrix[6] * y + matrix[10] * z + matrix[14];
+    vertex.w = matrix[3] * x + matrix[7] * y + matrix[11] * z + matrix[15];
+    return vertex;
+}
+
+//
+// lerpVertex
+// Description:
+//      Linear interpolation between two clip space vertices.
+// Parameters:
+//      a <const ClipVertex&>: Vertex at t = 0.
+//      b <const ClipVertex&>: Vertex at t = 1.
+//      t <float>: Interpolation factor.
+// Returns:
+//      <ClipVertex>: The interpolated vertex.
+//
+static ClipVertex lerpVertex(const ClipVertex &a, const ClipVertex &b, float t) {
+    ClipVertex vertex;
+
+    vertex.x = a.x + (b.x - a.x) * t;
+    vertex.y = a.y + (b.y - a.y) * t;
+    vertex.z = a.z + (b.z - a.z) * t;
+    vertex.w = a.w + (b.w - a.w) * t;
+    return vertex;
+}
+
+//
+// getMilliseconds
+// Description:
+//      Time passed since a point in time.
+// Parameters:
+//      start <std::chrono::steady_clock::time_point>: The point in time.
+// Returns:
+//      <double>: Milliseconds since 'start'.
+//
+static double getMilliseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
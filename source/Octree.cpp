@@ -0,0 +1,617 @@
+// Octree.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/Octree.h"
+#include <math.h>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int OCTREE_MAX_DEPTH = 16;
+static const int OCTREE_STACK_SIZE = 8 * (OCTREE_MAX_DEPTH + 1);
+
+static int classifyBox(const Frustum &frustum, const OctreeNode &node);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// Octree
+// Description:
+//      Constructor.
+//      Creates an empty tree whose root cell is the cube around the given bounds.
+// Parameters:
+//      in_bounds   <const BoundingBox&>: Region the instances are expected in, normally the level.
+//      in_maxDepth <int>: Deepest level of nodes below the root, up to 16. Every level holds
+//                         instances of half the size, but deep trees of nearly empty nodes
+//                         cost more to walk than they save.
+// Returns:
+//      None (void).
+//
+Octree::Octree(const BoundingBox &in_bounds, int in_maxDepth) {
+    bounds = in_bounds;
+    maxDepth = in_maxDepth < 0 ? 0 : (in_maxDepth > OCTREE_MAX_DEPTH ? OCTREE_MAX_DEPTH : in_maxDepth);
+
+    clear();
+}
+
+//
+// insert
+// Description:
+//      Adds an instance of a model.
+// Parameters:
+//      model     <Model*>: The model, its bounding sphere bounds the instance.
+//      transform <const float*>: 4x4 model to world matrix in OpenGL column major order.
+// Returns:
+//      <int>: Id of the instance, ids of removed instances are reused.
+//
+int Octree::insert(Model *model, const float *transform) {
+    int id;
+
+    if (firstFree >= 0) {
+        id = firstFree;
+        firstFree = entries[id].next;
+    }
+    else {
+        id = (int)entries.size();
+        entries.push_back(OctreeEntry());
+        models.push_back(NULL);
+        transforms.resize(transforms.size() + 16);
+    }
+
+    models[id] = model;
+    setSphere(id, transform);
+    link(id, findNode(entries[id].center, entries[id].radius));
+
+    numInstances++;
+    return id;
+}
+
+//
+// update
+// Description:
+//      Moves an instance. The instance only changes node when its center leaves its cell or its
+//      size changes the level it belongs on.
+// Parameters:
+//      id        <int>: Id of the instance.
+//      transform <const float*>: New 4x4 model to world matrix in OpenGL column major order.
+// Returns:
+//      None (void).
+//
+void Octree::update(int id, const float *transform) {
+    if (id < 0 || id >= (int)entries.size() || entries[id].node < 0)
+        return;
+
+    setSphere(id, transform);
+
+    int node = findNode(entries[id].center, entries[id].radius);
+
+    if (node != entries[id].node) {
+        unlink(id);
+        link(id, node);
+    }
+}
+
+//
+// remove
+// Description:
+//      Removes an instance, its id may be handed out again by 'insert'.
+// Parameters:
+//      id <int>: Id of the instance.
+// Returns:
+//      None (void).
+//
+void Octree::remove(int id) {
+    if (id < 0 || id >= (int)entries.size() || entries[id].node < 0)
+        return;
+
+    unlink(id);
+
+    entries[id].node = -1;
+    entries[id].next = firstFree;
+    models[id] = NULL;
+    firstFree = id;
+
+    numInstances--;
+}
+
+//
+// clear
+// Description:
+//      Removes all instances and nodes below the root.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void Octree::clear(void) {
+    nodes.clear();
+    entries.clear();
+    models.clear();
+    transforms.clear();
+
+    numInstances = 0;
+    firstFree = -1;
+
+    Vector3 center = bounds.isEmpty() ? Vector3(0.0f, 0.0f, 0.0f) : bounds.getCenter();
+    Vector3 extent = bounds.isEmpty() ? Vector3(1.0f, 1.0f, 1.0f) : bounds.getExtent();
+
+    float size = extent.x > extent.y ? extent.x : extent.y;
+    size = extent.z > size ? extent.z : size;
+
+    OctreeNode root;
+    root.center[0] = center.x;
+    root.center[1] = center.y;
+    root.center[2] = center.z;
+    root.halfSize = size > 0.0f ? size * 0.5f : 0.5f;
+    root.firstChild = -1;
+    root.parent = -1;
+    root.firstEntry = -1;
+    root.numEntries = 0;
+
+    nodes.push_back(root);
+}
+
+//
+// queryFrustum
+// Description:
+//      Finds the instances whose bounding sphere may be inside a view frustum.
+// Parameters:
+//      frustum <Frustum&>: The view frustum in world space.
+//      results <std::vector<int>&>: Ids of the instances are appended to this.
+// Returns:
+//      None (void).
+//
+void Octree::queryFrustum(Frustum &frustum, std::vector<int> &results) const {
+    int stack[OCTREE_STACK_SIZE];
+    bool stackInside[OCTREE_STACK_SIZE]; // The node is known to be completely inside the frustum
+    int stackSize = 0;
+
+    stack[stackSize] = 0;
+    stackInside[stackSize++] = false;
+
+    while (stackSize > 0) {
+        stackSize--;
+
+        int index = stack[stackSize];
+        bool inside = stackInside[stackSize];
+        const OctreeNode &node = nodes[index];
+
+        if (node.numEntries == 0)
+            continue;
+
+        // The root also holds the instances outside of its bounds
+        if (!inside && index != 0) {
+            int side = classifyBox(frustum, node);
+
+            if (side < 0)
+                continue;
+
+            inside = side > 0;
+        }
+
+        for (int id = node.firstEntry; id >= 0; id = entries[id].next) {
+            if (inside || frustum.testSphere(entries[id].center, entries[id].radius))
+                results.push_back(id);
+        }
+
+        if (node.firstChild >= 0) {
+            for (int c = 0; c < 8; c++) {
+                stack[stackSize] = node.firstChild + c;
+                stackInside[stackSize++] = inside;
+            }
+        }
+    }
+}
+
+//
+// querySphere
+// Description:
+//      Finds the instances whose bounding sphere overlaps a sphere.
+// Parameters:
+//      center  <const Vector3&>: Center of the sphere.
+//      radius  <float>: Radius of the sphere.
+//      results <std::vector<int>&>: Ids of the instances are appended to this.
+// Returns:
+//      None (void).
+//
+void Octree::querySphere(const Vector3 &center, float radius, std::vector<int> &results) const {
+    int stack[OCTREE_STACK_SIZE];
+    int stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        int index = stack[--stackSize];
+        const OctreeNode &node = nodes[index];
+
+        if (node.numEntries == 0)
+            continue;
+
+        if (index != 0) {
+            // Distance from the sphere center to the loose bounds of the node
+            float distanceSquared = 0.0f;
+            float point[3] = {center.x, center.y, center.z};
+
+            for (int axis = 0; axis < 3; axis++) {
+                float offset = fabsf(point[axis] - node.center[axis]) - node.halfSize * 2.0f;
+
+                if (offset > 0.0f)
+                    distanceSquared += offset * offset;
+            }
+
+            if (distanceSquared > radius * radius)
+                continue;
+        }
+
+        for (int id = node.firstEntry; id >= 0; id = entries[id].next) {
+            const OctreeEntry &entry = entries[id];
+
+            float dx = entry.center.x - center.x;
+            float dy = entry.center.y - center.y;
+            float dz = entry.center.z - center.z;
+            float reach = entry.radius + radius;
+
+            if (dx * dx + dy * dy + dz * dz <= reach * reach)
+                results.push_back(id);
+        }
+
+        if (node.firstChild >= 0) {
+            for (int c = 0; c < 8; c++)
+                stack[stackSize++] = node.firstChild + c;
+        }
+    }
+}
+
+//
+// queryRay
+// Description:
+//      Finds the instances whose bounding sphere is hit by a ray, in no particular order.
+//      The instances can then be traced more precisely, for example with a BVH of their model.
+// Parameters:
+//      ray     <const Ray&>: The ray, only hits closer than ray.tMax count.
+//      results <std::vector<int>&>: Ids of the instances are appended to this.
+// Returns:
+//      None (void).
+//
+void Octree::queryRay(const Ray &ray, std::vector<int> &results) const {
+    float origin[3] = {ray.origin.x, ray.origin.y, ray.origin.z};
+    float inverse[3] = {1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z};
+
+    float a = ray.direction.x * ray.direction.x + ray.direction.y * ray.direction.y + ray.direction.z * ray.direction.z;
+
+    if (a <= 0.0f)
+        return;
+
+    int stack[OCTREE_STACK_SIZE];
+    int stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        int index = stack[--stackSize];
+        const OctreeNode &node = nodes[index];
+
+        if (node.numEntries == 0)
+            continue;
+
+        if (index != 0) {
+            // Slab test against the loose bounds of the node
+            float tNear = 0.0f;
+            float tFar = ray.tMax;
+
+            for (int axis = 0; axis < 3; axis++) {
+                float t0 = (node.center[axis] - node.halfSize * 2.0f - origin[axis]) * inverse[axis];
+                float t1 = (node.center[axis] + node.halfSize * 2.0f - origin[axis]) * inverse[axis];
+
+                tNear = fmaxf(tNear, fminf(t0, t1));
+                tFar = fminf(tFar, fmaxf(t0, t1));
+            }
+
+            if (tNear > tFar)
+                continue;
+        }
+
+        for (int id = node.firstEntry; id >= 0; id = entries[id].next) {
+            const OctreeEntry &entry = entries[id];
+
+            Vector3 offset(ray.origin.x - entry.center.x, ray.origin.y - entry.center.y, ray.origin.z - entry.center.z);
+
+            float b = offset.x * ray.direction.x + offset.y * ray.direction.y + offset.z * ray.direction.z;
+            float c = offset.x * offset.x + offset.y * offset.y + offset.z * offset.z - entry.radius * entry.radius;
+
+            // Starting outside and moving away
+            if (c > 0.0f && b > 0.0f)
+                continue;
+
+            float discriminant = b * b - a * c;
+
+            if (discriminant < 0.0f)
+                continue;
+
+            if ((-b - sqrtf(discriminant)) / a <= ray.tMax)
+                results.push_back(id);
+        }
+
+        if (node.firstChild >= 0) {
+            for (int c = 0; c < 8; c++)
+                stack[stackSize++] = node.firstChild + c;
+        }
+    }
+}
+
+//
+// getModel
+// Description:
+//      Getter function for the model of an instance.
+// Parameters:
+//      id <int>: Id of the instance.
+// Returns:
+//      <Model*>: The model, NULL for removed instances.
+//
+Model *Octree::getModel(int id) const {
+    return models[id];
+}
+
+//
+// getTransform
+// Description:
+//      Getter function for the transform of an instance, ready for glMultMatrixf.
+// Parameters:
+//      id <int>: Id of the instance.
+// Returns:
+//      <const float*>: 4x4 model to world matrix in OpenGL column major order.
+//
+const float *Octree::getTransform(int id) const {
+    return &transforms[id * 16];
+}
+
+//
+// getCenter
+// Description:
+//      Getter function for the center of the bounding sphere of an instance.
+// Parameters:
+//      id <int>: Id of the instance.
+// Returns:
+//      <Vector3>: The center in world space.
+//
+Vector3 Octree::getCenter(int id) const {
+    return entries[id].center;
+}
+
+//
+// getRadius
+// Description:
+//      Getter function for the radius of the bounding sphere of an instance.
+// Parameters:
+//      id <int>: Id of the instance.
+// Returns:
+//      <float>: The radius in world space.
+//
+float Octree::getRadius(int id) const {
+    return entries[id].radius;
+}
+
+//
+// getNumInstances
+// Description:
+//      Getter function for the number of instances in the tree.
+// Parameters:
+//      None (void).
+// Returns:
+//      numInstances <int>: The number of instances.
+//
+int Octree::getNumInstances(void) const {
+    return numInstances;
+}
+
+//
+// getNumNodes
+// Description:
+//      Getter function for the number of nodes, nodes are kept when they become empty.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: The number of nodes including the root.
+//
+int Octree::getNumNodes(void) const {
+    return (int)nodes.size();
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// findNode
+// Description:
+//      Finds the deepest node whose cell contains the center and whose loose bounds contain the
+//      whole sphere, creating the nodes on the way.
+// Parameters:
+//      center <const Vector3&>: Center of the bounding sphere.
+//      radius <float>: Radius of the bounding sphere.
+// Returns:
+//      <int>: Index of the node.
+//
+int Octree::findNode(const Vector3 &center, float radius) {
+    float point[3] = {center.x, center.y, center.z};
+    int index = 0;
+
+    for (int axis = 0; axis < 3; axis++) {
+        if (fabsf(point[axis] - nodes[0].center[axis]) > nodes[0].halfSize)
+            return 0;
+    }
+
+    for (int depth = 0; depth < maxDepth; depth++) {
+        float childHalfSize = nodes[index].halfSize * 0.5f;
+
+        if (radius > childHalfSize)
+            break;
+
+        if (nodes[index].firstChild < 0) {
+            int firstChild = (int)nodes.size();
+
+            for (int c = 0; c < 8; c++) {
+                OctreeNode child;
+                child.center[0] = nodes[index].center[0] + ((c & 1) ? childHalfSize : -childHalfSize);
+                child.center[1] = nodes[index].center[1] + ((c & 2) ? childHalfSize : -childHalfSize);
+                child.center[2] = nodes[index].center[2] + ((c & 4) ? childHalfSize : -childHalfSize);
+                child.halfSize = childHalfSize;
+                child.firstChild = -1;
+                child.parent = index;
+                child.firstEntry = -1;
+                child.numEntries = 0;
+
+                nodes.push_back(child);
+            }
+
+            nodes[index].firstChild = firstChild;
+        }
+
+        int octant = (point[0] >= nodes[index].center[0] ? 1 : 0) |
+                     (point[1] >= nodes[index].center[1] ? 2 : 0) |
+                     (point[2] >= nodes[index].center[2] ? 4 : 0);
+
+        index = nodes[index].firstChild + octant;
+    }
+
+    return index;
+}
+
+//
+// link
+// Description:
+//      Adds an instance to the list of a node and counts it in the node and its parents.
+// Parameters:
+//      id   <int>: Id of the instance.
+//      node <int>: Index of the node.
+// Returns:
+//      None (void).
+//
+void Octree::link(int id, int node) {
+    OctreeEntry &entry = entries[id];
+
+    entry.node = node;
+    entry.previous = -1;
+    entry.next = nodes[node].firstEntry;
+
+    if (entry.next >= 0)
+        entries[entry.next].previous = id;
+
+    nodes[node].firstEntry = id;
+
+    for (int n = node; n >= 0; n = nodes[n].parent)
+        nodes[n].numEntries++;
+}
+
+//
+// unlink
+// Description:
+//      Removes an instance from the list of its node and from the counts of the node and its parents.
+// Parameters:
+//      id <int>: Id of the instance.
+// Returns:
+//      None (void).
+//
+void Octree::unlink(int id) {
+    OctreeEntry &entry = entries[id];
+
+    if (entry.previous >= 0)
+        entries[entry.previous].next = entry.next;
+    else
+        nodes[entry.node].firstEntry = entry.next;
+
+    if (entry.next >= 0)
+        entries[entry.next].previous = entry.previous;
+
+    for (int n = entry.node; n >= 0; n = nodes[n].parent)
+        nodes[n].numEntries--;
+
+    entry.previous = -1;
+    entry.next = -1;
+}
+
+//
+// setSphere
+// Description:
+//      Stores the transform of an instance and moves the bounding sphere of its model into world space.
+//      The sphere is centered on the bounding box of the model and reaches its corners, so it contains
+//      every vertex. The radius grows with the largest scale of the transform.
+// Parameters:
+//      id        <int>: Id of the instance.
+//      transform <const float*>: 4x4 model to world matrix in OpenGL column major order.
+// Returns:
+//      None (void).
+//
+void Octree::setSphere(int id, const float *transform) {
+    float *stored = &transforms[id * 16];
+
+    for (int i = 0; i < 16; i++)
+        stored[i] = transform[i];
+
+    Vector3 center(0.0f, 0.0f, 0.0f);
+    float radius = 0.0f;
+
+    if (models[id] != NULL) {
+        const Vector3 *boundingPoints = models[id]->getBoundingPoints();
+        const Vector3 &min = boundingPoints[6];
+        const Vector3 &max = boundingPoints[7];
+        Vector3 halfSize((max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f);
+
+        center = Vector3(min.x + halfSize.x, min.y + halfSize.y, min.z + halfSize.z);
+        radius = sqrtf(halfSize.x * halfSize.x + halfSize.y * halfSize.y + halfSize.z * halfSize.z);
+    }
+
+    entries[id].center = Vector3(transform[0] * center.x + transform[4] * center.y + transform[8] * center.z + transform[12],
+                                 transform[1] * center.x + transform[5] * center.y + transform[9] * center.z + transform[13],
+                                 transform[2] * center.x + transform[6] * center.y + transform[10] * center.z + transform[14]);
+
+    float scale = 0.0f;
+
+    for (int column = 0; column < 3; column++) {
+        const float *axis = &transform[column * 4];
+        float lengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+
+        scale = lengthSquared > scale ? lengthSquared : scale;
+    }
+
+    entries[id].radius = radius * sqrtf(scale);
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// classifyBox
+// Description:
+//      Tests the loose bounds of a node against a frustum.
+// Parameters:
+//      frustum <const Frustum&>: The frustum.
+//      node    <const OctreeNode&>: The node.
+// Returns:
+//      <int>: -1 if the bounds are outside, 1 if they are completely inside and 0 otherwise.
+//
+static int classifyBox(const Frustum &frustum, const OctreeNode &node) {
+    float reach = node.halfSize * 2.0f;
+    int result = 1;
+
+    for (int p = 0; p < 6; p++) {
+        const float *plane = frustum.planes[p];
+
+        float center = plane[0] * node.center[0] + plane[1] * node.center[1] + plane[2] * node.center[2] + plane[3];
+        float extent = reach * (fabsf(plane[0]) + fabsf(plane[1]) + fabsf(plane[2]));
+
+        if (center + extent < 0.0f)
+            return -1;
+
+        if (center - extent < 0.0f)
+            result = 0;
+    }
+    return result;
+}
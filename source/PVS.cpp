@@ -0,0 +1,654 @@
+// PVS.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/PVS.h"
+#include "../include/Parallel.h"
+#include <limits.h>
+#include <math.h>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const char PVS_MAGIC[8] = {'F', 'P', 'S', 'P', 'V', 'S', 0, 0};
+static const unsigned int PVS_VERSION = 1;
+
+static const long long PVS_MAX_CELLS = 1 << 24;  // More cells than any level bakes, bounds the loaded counts
+static const int PVS_RAY_BATCH = 8;            // Rays traced together, one AVX packet
+static const float PVS_TARGET_OFFSET = 1e-3f;  // Rays stop this far before the sampled point on the target face
+
+struct PVSHeader {
+    char magic[8];
+    unsigned int version;
+    int cellsX, cellsY, cellsZ;
+    int numObjects;
+    float cellSize;
+    float boundsMin[3];
+    float boundsMax[3];
+    unsigned int dataSize;
+};
+
+static float randomFloat(unsigned int &state);
+static Vector3 randomPointInBox(const BoundingBox &box, unsigned int &state);
+static Vector3 randomPointOnObject(const GroupObject &object, unsigned int &state);
+static void compressBits(const std::vector<unsigned char> &bits, std::vector<unsigned char> &output);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// PVS
+// Description:
+//      Constructor.
+//      Creates an empty set, every group object counts as visible until a set is baked or loaded.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+PVS::PVS() {
+    clear();
+}
+
+//
+// bake
+// Description:
+//      Computes the visible group objects of every cell. The BVH has to be built from the same model.
+//      Every cell is sampled with its own random sequence, so the result does not depend on the
+//      number of threads.
+// Parameters:
+//      model       <Model&>: The static level.
+//      bvh         <const BVH&>: BVH built from 'model'.
+//      in_cellSize <float>: Edge length of the cubic cells.
+//      numSamples  <int>: Rays traced from a cell to each group object before it counts as hidden.
+// Returns:
+//      None (void).
+//
+void PVS::bake(Model &model, const BVH &bvh, float in_cellSize, int numSamples) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    clear();
+
+    std::vector<GroupObject *> &objects = model.getObjects();
+
+    for (int i = 0; i < (int)objects.size(); i++) {
+        if (!objects[i]->bounds.isEmpty())
+            bounds.expand(objects[i]->bounds);
+    }
+
+    if (bounds.isEmpty() || in_cellSize <= 0.0f)
+        return;
+
+    Vector3 extent = bounds.getExtent();
+
+    cellSize = in_cellSize;
+    cellsX = (int)ceilf(extent.x / cellSize) > 1 ? (int)ceilf(extent.x / cellSize) : 1;
+    cellsY = (int)ceilf(extent.y / cellSize) > 1 ? (int)ceilf(extent.y / cellSize) : 1;
+    cellsZ = (int)ceilf(extent.z / cellSize) > 1 ? (int)ceilf(extent.z / cellSize) : 1;
+    numObjects = (int)objects.size();
+
+    int numCells = cellsX * cellsY * cellsZ;
+    int numBytes = (numObjects + 7) / 8;
+
+    std::vector<std::vector<unsigned char> > compressed(numCells);
+    std::atomic<long long> numRays(0);
+    std::atomic<int> numVisible(0);
+
+    Parallel::forRange(0, numCells, [&](int first, int last) {
+        std::vector<unsigned char> cellBits(numBytes);
+        Ray rays[PVS_RAY_BATCH];
+        unsigned char occluded[PVS_RAY_BATCH];
+        long long cellRays = 0;
+        int cellVisible = 0;
+
+        for (int cell = first; cell < last; cell++) {
+            int x = cell % cellsX;
+            int y = (cell / cellsX) % cellsY;
+            int z = cell / (cellsX * cellsY);
+
+            BoundingBox cellBox;
+            cellBox.min = Vector3(bounds.min.x + x * cellSize, bounds.min.y + y * cellSize, bounds.min.z + z * cellSize);
+            cellBox.max = Vector3(cellBox.min.x + cellSize, cellBox.min.y + cellSize, cellBox.min.z + cellSize);
+
+            unsigned int state = (unsigned int)cell * 2654435761u + 1u;
+            std::fill(cellBits.begin(), cellBits.end(), 0);
+
+            for (int o = 0; o < numObjects; o++) {
+                const GroupObject &object = *objects[o];
+
+                if (object.faces.empty())
+                    continue;
+
+                const BoundingBox &objectBounds = object.bounds;
+                bool visible = objectBounds.min.x <= cellBox.max.x && objectBounds.max.x >= cellBox.min.x &&
+                               objectBounds.min.y <= cellBox.max.y && objectBounds.max.y >= cellBox.min.y &&
+                               objectBounds.min.z <= cellBox.max.z && objectBounds.max.z >= cellBox.min.z;
+
+                for (int s = 0; s < numSamples && !visible; s += PVS_RAY_BATCH) {
+                    int batch = numSamples - s < PVS_RAY_BATCH ? numSamples - s : PVS_RAY_BATCH;
+
+                    for (int r = 0; r < batch; r++) {
+                        Vector3 origin = randomPointInBox(cellBox, state);
+                        Vector3 target = randomPointOnObject(object, state);
+                        Vector3 direction(target.x - origin.x, target.y - origin.y, target.z - origin.z);
+
+                        float distance = sqrtf(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+
+                        if (distance <= PVS_TARGET_OFFSET) {
+                            visible = true;
+                            break;
+                        }
+
+                        float inverse = 1.0f / distance;
+                        rays[r] = Ray(origin, Vector3(direction.x * inverse, direction.y * inverse, direction.z * inverse),
+                                      distance - PVS_TARGET_OFFSET);
+                    }
+
+                    if (visible)
+                        break;
+
+                    bvh.occludedRays(rays, occluded, batch);
+                    cellRays += batch;
+
+                    for (int r = 0; r < batch; r++) {
+                        if (!occluded[r])
+                            visible = true;
+                    }
+                }
+
+                if (visible) {
+                    cellBits[o >> 3] |= (unsigned char)(1 << (o & 7));
+                    cellVisible++;
+                }
+            }
+
+            compressBits(cellBits, compressed[cell]);
+        }
+
+        numRays += cellRays;
+        numVisible += cellVisible;
+    }, 1);
+
+    cellOffsets.resize(numCells + 1);
+
+    for (int cell = 0; cell < numCells; cell++) {
+        cellOffsets[cell] = (int)data.size();
+        data.insert(data.end(), compressed[cell].begin(), compressed[cell].end());
+    }
+    cellOffsets[numCells] = (int)data.size();
+
+    stats.numRays = numRays;
+    stats.numCells = numCells;
+    stats.numObjects = numObjects;
+    stats.compressedBytes = (int)data.size();
+    stats.uncompressedBytes = numCells * numBytes;
+    stats.averageVisible = numObjects > 0 ? (float)numVisible / ((float)numCells * numObjects) : 0.0f;
+    stats.bakeTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// clear
+// Description:
+//      Deletes the baked set.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void PVS::clear(void) {
+    bounds = BoundingBox();
+    cellSize = 0.0f;
+    cellsX = 0;
+    cellsY = 0;
+    cellsZ = 0;
+    numObjects = 0;
+
+    data.clear();
+    cellOffsets.clear();
+    stats = PVSStats();
+}
+
+//
+// save
+// Description:
+//      Writes the baked set to a binary file.
+// Parameters:
+//      filename <std::string>: Full path of the file.
+// Returns:
+//      <bool>: If the file was written correctly or not.
+//
+bool PVS::save(std::string filename) const {
+    std::ofstream file(filename.data(), std::ios_base::binary);
+
+    if (!file.is_open())
+        return false;
+
+    PVSHeader header;
+    std::memcpy(header.magic, PVS_MAGIC, sizeof(header.magic));
+    header.version = PVS_VERSION;
+    header.cellsX = cellsX;
+    header.cellsY = cellsY;
+    header.cellsZ = cellsZ;
+    header.numObjects = numObjects;
+    header.cellSize = cellSize;
+    header.boundsMin[0] = bounds.min.x;
+    header.boundsMin[1] = bounds.min.y;
+    header.boundsMin[2] = bounds.min.z;
+    header.boundsMax[0] = bounds.max.x;
+    header.boundsMax[1] = bounds.max.y;
+    header.boundsMax[2] = bounds.max.z;
+    header.dataSize = (unsigned int)data.size();
+
+    file.write((const char*)&header, sizeof(header));
+
+    if (!cellOffsets.empty())
+        file.write((const char*)&cellOffsets[0], cellOffsets.size() * sizeof(int));
+
+    if (!data.empty())
+        file.write((const char*)&data[0], data.size());
+
+    return file.good();
+}
+
+//
+// load
+// Description:
+//      Reads a set written by 'save'. The header is checked against the size of the file before anything is
+//      allocated, files with a bad cell size, too many cells or missing data are rejected.
+// Parameters:
+//      filename <std::string>: Full path of the file.
+// Returns:
+//      <bool>: If the file was read correctly or not.
+//
+bool PVS::load(std::string filename) {
+    std::ifstream file(filename.data(), std::ios_base::binary);
+
+    if (!file.is_open())
+        return false;
+
+    PVSHeader header;
+
+    if (!file.read((char*)&header, sizeof(header)))
+        return false;
+
+    if (std::memcmp(header.magic, PVS_MAGIC, sizeof(header.magic)) != 0 || header.version != PVS_VERSION)
+        return false;
+
+    if (header.cellsX < 0 || header.cellsY < 0 || header.cellsZ < 0 || header.numObjects < 0)
+        return false;
+
+    // 'getCell' divides by the cell size and converts the result to int
+    if (!(header.cellSize > 0.0f) || !isfinite(header.cellSize))
+        return false;
+
+    for (int i = 0; i < 3; i++) {
+        if (!isfinite(header.boundsMin[i]) || !isfinite(header.boundsMax[i]))
+            return false;
+    }
+
+    long long cellCount = (long long)header.cellsX * header.cellsY * header.cellsZ;
+
+    if (cellCount > PVS_MAX_CELLS || header.dataSize > (unsigned int)INT_MAX)
+        return false;
+
+    // The counts decide what is allocated, check that the file is large enough to hold them first
+    std::streamoff dataStart = file.tellg();
+    file.seekg(0, std::ios_base::end);
+    unsigned long long available = (unsigned long long)(file.tellg() - dataStart);
+    file.seekg(dataStart);
+
+    unsigned long long expected = (cellCount > 0 ? (unsigned long long)(cellCount + 1) * sizeof(int) : 0ULL) +
+                                  header.dataSize;
+
+    if (expected > available)
+        return false;
+
+    clear();
+
+    int numCells = (int)cellCount;
+
+    if (numCells > 0)
+        cellOffsets.resize(numCells + 1);
+    data.resize(header.dataSize);
+
+    bool ok = true;
+
+    if (!cellOffsets.empty())
+        ok = ok && file.read((char*)&cellOffsets[0], cellOffsets.size() * sizeof(int));
+
+    if (!data.empty())
+        ok = ok && file.read((char*)&data[0], data.size());
+
+    for (int cell = 0; ok && cell < numCells; cell++)
+        ok = cellOffsets[cell] >= 0 && cellOffsets[cell] <= cellOffsets[cell + 1];
+
+    ok = ok && (numCells == 0 || cellOffsets[numCells] == (int)data.size());
+
+    if (!ok) {
+        clear();
+        return false;
+    }
+
+    cellsX = header.cellsX;
+    cellsY = header.cellsY;
+    cellsZ = header.cellsZ;
+    numObjects = header.numObjects;
+    cellSize = header.cellSize;
+    bounds.min = Vector3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    bounds.max = Vector3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+
+    stats.numCells = numCells;
+    stats.numObjects = numObjects;
+    stats.compressedBytes = (int)data.size();
+    stats.uncompressedBytes = numCells * ((numObjects + 7) / 8);
+    return true;
+}
+
+//
+// getCell
+// Description:
+//      Finds the cell containing a point.
+// Parameters:
+//      point <const Vector3&>: The point.
+// Returns:
+//      <int>: Index of the cell, -1 if the point is outside of the level or nothing is baked.
+//
+int PVS::getCell(const Vector3 &point) const {
+    if (cellOffsets.empty())
+        return -1;
+
+    // Compared as floats first, far away or NaN points do not fit in an int
+    float x = floorf((point.x - bounds.min.x) / cellSize);
+    float y = floorf((point.y - bounds.min.y) / cellSize);
+    float z = floorf((point.z - bounds.min.z) / cellSize);
+
+    if (!(x >= 0.0f && y >= 0.0f && z >= 0.0f && x < (float)cellsX && y < (float)cellsY && z < (float)cellsZ))
+        return -1;
+
+    return ((int)z * cellsY + (int)y) * cellsX + (int)x;
+}
+
+//
+// isVisible
+// Description:
+//      Tests if a group object is visible from a cell, reading the compressed bitset directly.
+// Parameters:
+//      cell   <int>: Index of the cell, see 'getCell'. Outside cells see everything.
+//      object <int>: Index of the group object in the model.
+// Returns:
+//      <bool>: If the group object may be visible from the cell.
+//
+bool PVS::isVisible(int cell, int object) const {
+    if (cell < 0 || cell >= (int)cellOffsets.size() - 1 || object < 0 || object >= numObjects)
+        return true;
+
+    int wanted = object >> 3;
+    int byte = 0;
+
+    for (int i = cellOffsets[cell]; i < cellOffsets[cell + 1]; i++) {
+        if (data[i] == 0 && i + 1 < cellOffsets[cell + 1]) {
+            byte += data[++i];
+
+            if (byte > wanted)
+                return false;
+            continue;
+        }
+
+        if (byte == wanted)
+            return (data[i] >> (object & 7)) & 1;
+        byte++;
+    }
+    return false;
+}
+
+//
+// cullObjects
+// Description:
+//      Clears the entries of the group objects which cannot be seen from the cell of the view point.
+//      Entries which are already 0 stay 0, so this can run after frustum culling.
+// Parameters:
+//      viewPoint <const Vector3&>: Position of the camera, in model space.
+//      visible   <unsigned char*>: One entry per group object of the model.
+//      count     <int>: Number of entries.
+// Returns:
+//      <int>: The number of entries left visible.
+//
+int PVS::cullObjects(const Vector3 &viewPoint, unsigned char *visible, int count) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    int cell = getCell(viewPoint);
+    int numVisible = 0;
+    int numTested = 0;
+
+    if (cell >= 0)
+        decompressCell(cell, bits);
+
+    for (int i = 0; i < count; i++) {
+        if (!visible[i])
+            continue;
+
+        numTested++;
+
+        if (cell >= 0 && i < numObjects && !((bits[i >> 3] >> (i & 7)) & 1))
+            visible[i] = 0;
+        else
+            numVisible++;
+    }
+
+    stats.numQueries++;
+    stats.numTested += numTested;
+    stats.numCulled += numTested - numVisible;
+    stats.queryTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    return numVisible;
+}
+
+//
+// getNumCells
+// Description:
+//      Getter function for the number of cells.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: The number of cells, 0 if nothing is baked.
+//
+int PVS::getNumCells(void) const {
+    return cellsX * cellsY * cellsZ;
+}
+
+//
+// getNumObjects
+// Description:
+//      Getter function for the number of group objects the set was baked for.
+// Parameters:
+//      None (void).
+// Returns:
+//      numObjects <int>: The number of group objects.
+//
+int PVS::getNumObjects(void) const {
+    return numObjects;
+}
+
+//
+// getBounds
+// Description:
+//      Getter function for the box divided into cells.
+// Parameters:
+//      None (void).
+// Returns:
+//      bounds <BoundingBox>: Bounds of the level, cells past the maximum are cut off by it.
+//
+BoundingBox PVS::getBounds(void) const {
+    return bounds;
+}
+
+//
+// getStats
+// Description:
+//      Getter function for the bake and query statistics.
+// Parameters:
+//      None (void).
+// Returns:
+//      stats <const PVSStats&>: The statistics.
+//
+const PVSStats &PVS::getStats(void) const {
+    return stats;
+}
+
+//
+// resetStats
+// Description:
+//      Resets the query statistics, for example at the start of a frame.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void PVS::resetStats(void) {
+    stats.numQueries = 0;
+    stats.numTested = 0;
+    stats.numCulled = 0;
+    stats.queryTime = 0.0;
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// decompressCell
+// Description:
+//      Expands the run length compressed bitset of a cell.
+// Parameters:
+//      cell   <int>: Index of the cell.
+//      output <std::vector<unsigned char>&>: Receives one bit per group object.
+// Returns:
+//      None (void).
+//
+void PVS::decompressCell(int cell, std::vector<unsigned char> &output) const {
+    int numBytes = (numObjects + 7) / 8;
+    output.assign(numBytes, 0);
+
+    int byte = 0;
+
+    for (int i = cellOffsets[cell]; i < cellOffsets[cell + 1] && byte < numBytes; i++) {
+        if (data[i] == 0 && i + 1 < cellOffsets[cell + 1]) {
+            byte += data[++i];
+            continue;
+        }
+        output[byte++] = data[i];
+    }
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// randomFloat
+// Description:
+//      Xorshift random number generator.
+// Parameters:
+//      state <unsigned int&>: State of the generator, must not be 0.
+// Returns:
+//      <float>: A random number in [0, 1).
+//
+static float randomFloat(unsigned int &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return (float)(state >> 8) * (1.0f / 16777216.0f);
+}
+
+//
+// randomPointInBox
+// Description:
+//      Picks a uniformly distributed point in a box.
+// Parameters:
+//      box   <const BoundingBox&>: The box.
+//      state <unsigned int&>: State of the random number generator.
+// Returns:
+//      <Vector3>: The point.
+//
+static Vector3 randomPointInBox(const BoundingBox &box, unsigned int &state) {
+    float x = randomFloat(state);
+    float y = randomFloat(state);
+    float z = randomFloat(state);
+
+    return Vector3(box.min.x + (box.max.x - box.min.x) * x,
+                   box.min.y + (box.max.y - box.min.y) * y,
+                   box.min.z + (box.max.z - box.min.z) * z);
+}
+
+//
+// randomPointOnObject
+// Description:
+//      Picks a random point on a random face of a group object, polygons are fan triangulated.
+// Parameters:
+//      object <const GroupObject&>: The group object, with at least one face.
+//      state  <unsigned int&>: State of the random number generator.
+// Returns:
+//      <Vector3>: The point.
+//
+static Vector3 randomPointOnObject(const GroupObject &object, unsigned int &state) {
+    const Face &face = *object.faces[(int)(randomFloat(state) * object.faces.size())];
+
+    if (face.numVertices < 3)
+        return *face.vertices[0];
+
+    int corner = 1 + (int)(randomFloat(state) * (face.numVertices - 2));
+
+    const Vector3 &a = *face.vertices[0];
+    const Vector3 &b = *face.vertices[corner];
+    const Vector3 &c = *face.vertices[corner + 1];
+
+    float u = randomFloat(state);
+    float v = randomFloat(state);
+
+    if (u + v > 1.0f) {
+        u = 1.0f - u;
+        v = 1.0f - v;
+    }
+
+    return Vector3(a.x + (b.x - a.x) * u + (c.x - a.x) * v,
+                   a.y + (b.y - a.y) * u + (c.y - a.y) * v,
+                   a.z + (b.z - a.z) * u + (c.z - a.z) * v);
+}
+
+//
+// compressBits
+// Description:
+//      Run length compresses a bitset, runs of zero bytes become a zero followed by the run length.
+// Parameters:
+//      bits   <const std::vector<unsigned char>&>: The bitset.
+//      output <std::vector<unsigned char>&>: Receives the compressed bytes.
+// Returns:
+//      None (void).
+//
+static void compressBits(const std::vector<unsigned char> &bits, std::vector<unsigned char> &output) {
+    output.clear();
+
+    for (int i = 0; i < (int)bits.size(); i++) {
+        if (bits[i] != 0) {
+            output.push_back(bits[i]);
+            continue;
+        }
+
+        int run = 1;
+        while (i + run < (int)bits.size() && bits[i + run] == 0 && run < 255)
+            run++;
+
+        output.push_back(0);
+        output.push_back((unsigned char)run);
+        i += run - 1;
+    }
+}
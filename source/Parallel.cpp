@@ -0,0 +1,87 @@
+// Parallel.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/Parallel.h"
+#include "../include/JobSystem.h"
+#include <thread>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+
+int Parallel::numThreads = 0;
+
+//*********************************************************************************
+// Public Class Functions
+//*********************************************************************************
+
+//
+// forRange
+// Description:
+//      Calls 'function' for contiguous sub ranges covering [begin, end), one per thread, as jobs of the
+//      JobSystem. Ranges smaller than 'minRange' are not split, so small inputs run directly on the
+//      calling thread. Can be called from inside another 'forRange'.
+// Parameters:
+//      begin    <int>: First index.
+//      end      <int>: One past the last index.
+//      function <std::function<void(int, int)>>: Called with (first, last) of each sub range.
+//      minRange <int>: Smallest number of indices worth handing to another thread.
+// Returns:
+//      None (void).
+//
+void Parallel::forRange(int begin, int end, const std::function<void(int, int)> &function, int minRange) {
+    int count = end - begin;
+
+    if (count <= 0)
+        return;
+
+    if (minRange < 1)
+        minRange = 1;
+
+    int chunks = getNumThreads();
+    if (chunks > count / minRange)
+        chunks = count / minRange;
+
+    if (chunks <= 1) {
+        function(begin, end);
+        return;
+    }
+
+    JobSystem::parallelFor(begin, end, function, minRange, chunks);
+}
+
+//
+// getNumThreads
+// Description:
+//      Getter function for the number of threads used by 'forRange'.
+//      Defaults to the number of hardware threads.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: The number of threads, at least one.
+//
+int Parallel::getNumThreads(void) {
+    if (numThreads > 0)
+        return numThreads;
+
+    int hardware = (int)std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1;
+}
+
+//
+// setNumThreads
+// Description:
+//      Limits the number of threads used by 'forRange'. Zero restores the default. The workers of the
+//      JobSystem are not changed, a range is just split into fewer jobs.
+// Parameters:
+//      value <int>: The number of threads.
+// Returns:
+//      None (void).
+//
+void Parallel::setNumThreads(int value) {
+    numThreads = value > 0 ? value : 0;
+}
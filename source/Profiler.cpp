@@ -0,0 +1,486 @@
+// Profiler.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <unordered_map>
+#include <stdio.h>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const unsigned int PROFILER_RING_SIZE = 16384;   // Events per thread ring, a power of two
+static const int PROFILER_WINDOW = 512;                 // Durations per scope the percentiles are taken over
+static const int PROFILER_MAX_CAPTURE = 1 << 20;        // Events a capture keeps, about 32 MB
+
+// Ring and scope depth of the calling thread, the ring is handed back when the thread exits
+struct ProfilerThread {
+    ProfilerBuffer *buffer;
+    int depth;
+
+    ProfilerThread() {
+        buffer = NULL;
+        depth = 0;
+    }
+
+    ~ProfilerThread() {
+        if (buffer != NULL)
+            Profiler::releaseBuffer(buffer);
+    }
+};
+
+static thread_local ProfilerThread profilerThread;
+
+std::atomic<bool> Profiler::enabled(true);
+bool Profiler::capturing = false;
+std::mutex Profiler::mutex;
+std::vector<ProfilerBuffer *> Profiler::buffers;
+int Profiler::numThreads = 0;
+std::map<std::string, ProfileWindow> Profiler::windows;
+std::vector<ProfileEvent> Profiler::capture;
+long long Profiler::droppedEvents = 0;
+
+static double toMilliseconds(long long nanoseconds);
+static void writeEscaped(std::ofstream &file, const char *text);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// setEnabled
+// Description:
+//      Enables or disables recording. Scopes which began while enabled are still recorded.
+// Parameters:
+//      value <bool>: Record scopes.
+// Returns:
+//      None (void).
+//
+void Profiler::setEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+//
+// isEnabled
+// Description:
+//      Checks if scopes are recorded.
+// Parameters:
+//      None (void).
+// Returns:
+//      <bool>: If the profiler is enabled, it is by default.
+//
+bool Profiler::isEnabled(void) {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+//
+// setCapture
+// Description:
+//      Starts or stops keeping the collected events for 'writeChromeTrace'. Starting a capture
+//      drops the events of the last one.
+// Parameters:
+//      value <bool>: Keep the events.
+// Returns:
+//      None (void).
+//
+void Profiler::setCapture(bool value) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (value && !capturing)
+        capture.clear();
+
+    capturing = value;
+}
+
+//
+// isCapturing
+// Description:
+//      Checks if the collected events are kept for a trace.
+// Parameters:
+//      None (void).
+// Returns:
+//      capturing <bool>: If a capture is running.
+//
+bool Profiler::isCapturing(void) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return capturing;
+}
+
+//
+// collect
+// Description:
+//      Drains the rings of all threads into the windows of the scopes and, while capturing, into
+//      the capture. Call often enough for the rings not to fill, once a frame is plenty.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void Profiler::collect(void) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Scope names are literals, so the same pointer comes back for almost every event
+    std::unordered_map<const char *, ProfileWindow *> byName;
+
+    for (int b = 0; b < (int)buffers.size(); b++) {
+        ProfilerBuffer *buffer = buffers[b];
+        unsigned int head = buffer->head.load(std::memory_order_acquire);
+        unsigned int tail = buffer->tail.load(std::memory_order_relaxed);
+
+        for (; tail != head; tail++) {
+            const ProfileEvent &event = buffer->events[tail & (PROFILER_RING_SIZE - 1)];
+            ProfileWindow *&window = byName[event.name];
+
+            if (window == NULL) {
+                window = &windows[event.name];
+
+                if (window->durations.empty()) {
+                    window->durations.reserve(PROFILER_WINDOW);
+                    window->next = 0;
+                    window->count = 0;
+                }
+            }
+
+            long long duration = event.end - event.start;
+
+            if ((int)window->durations.size() < PROFILER_WINDOW)
+                window->durations.push_back(duration);
+            else
+                window->durations[window->next] = duration;
+
+            window->next = (window->next + 1) % PROFILER_WINDOW;
+            window->count++;
+            window->last = duration;
+
+            if (capturing) {
+                if ((int)capture.size() < PROFILER_MAX_CAPTURE)
+                    capture.push_back(event);
+                else
+                    droppedEvents++;
+            }
+        }
+
+        buffer->tail.store(head, std::memory_order_release);
+        droppedEvents += buffer->dropped.exchange(0, std::memory_order_relaxed);
+    }
+}
+
+//
+// getSummary
+// Description:
+//      Collects the rings and summarizes the window of every scope.
+// Parameters:
+//      None (void).
+// Returns:
+//      <std::vector<ProfileSummary>>: One summary per scope, sorted by name.
+//
+std::vector<ProfileSummary> Profiler::getSummary(void) {
+    collect();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<ProfileSummary> summaries;
+    std::vector<long long> sorted;
+
+    for (std::map<std::string, ProfileWindow>::iterator it = windows.begin(); it != windows.end(); it++) {
+        const ProfileWindow &window = it->second;
+
+        if (window.durations.empty())
+            continue;
+
+        sorted = window.durations;
+        std::sort(sorted.begin(), sorted.end());
+
+        // Nearest rank percentiles
+        int size = (int)sorted.size();
+        int p50 = (size * 50 + 99) / 100 - 1;
+        int p99 = (size * 99 + 99) / 100 - 1;
+
+        ProfileSummary summary;
+        summary.name = it->first;
+        summary.count = window.count;
+        summary.last = toMilliseconds(window.last);
+        summary.p50 = toMilliseconds(sorted[p50]);
+        summary.p99 = toMilliseconds(sorted[p99]);
+        summary.max = toMilliseconds(sorted[size - 1]);
+
+        summaries.push_back(summary);
+    }
+    return summaries;
+}
+
+//
+// writeChromeTrace
+// Description:
+//      Collects the rings and writes the capture in the Chrome trace event format, one complete
+//      event per scope with times in microseconds from the first event.
+// Parameters:
+//      filename <const std::string&>: The json file to write.
+// Returns:
+//      <bool>: False if the file could not be written.
+//
+bool Profiler::writeChromeTrace(const std::string &filename) {
+    collect();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ofstream file(filename.data());
+
+    if (!file.is_open())
+        return false;
+
+    long long origin = 0;
+
+    for (int i = 0; i < (int)capture.size(); i++) {
+        if (i == 0 || capture[i].start < origin)
+            origin = capture[i].start;
+    }
+
+    file << "{\"traceEvents\":[";
+
+    char numbers[128];
+
+    for (int i = 0; i < (int)capture.size(); i++) {
+        const ProfileEvent &event = capture[i];
+
+        file << (i == 0 ? "\n" : ",\n") << "{\"name\":\"";
+        writeEscaped(file, event.name);
+
+        snprintf(numbers, sizeof(numbers), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"depth\":%d}}",
+                 (event.start - origin) / 1000.0, (event.end - event.start) / 1000.0, event.thread, event.depth);
+        file << numbers;
+    }
+
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return !file.fail();
+}
+
+//
+// getDroppedEvents
+// Description:
+//      Getter function for the number of events lost to full rings or a full capture.
+// Parameters:
+//      None (void).
+// Returns:
+//      <long long>: Events dropped since the last reset, up to the last 'collect'.
+//
+long long Profiler::getDroppedEvents(void) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return droppedEvents;
+}
+
+//
+// reset
+// Description:
+//      Drops the uncollected events, the windows of the scopes and the capture.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void Profiler::reset(void) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (int b = 0; b < (int)buffers.size(); b++) {
+        buffers[b]->tail.store(buffers[b]->head.load(std::memory_order_acquire), std::memory_order_release);
+        buffers[b]->dropped.store(0, std::memory_order_relaxed);
+    }
+
+    windows.clear();
+    capture.clear();
+    droppedEvents = 0;
+}
+
+//
+// now
+// Description:
+//      Reads the clock the events are timed with.
+// Parameters:
+//      None (void).
+// Returns:
+//      <long long>: Steady clock time in nanoseconds.
+//
+long long Profiler::now(void) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//
+// beginScope
+// Description:
+//      Enters a scope on the calling thread.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: Depth of the scope, -1 if the profiler is disabled and the scope is not recorded.
+//
+int Profiler::beginScope(void) {
+    if (!enabled.load(std::memory_order_relaxed))
+        return -1;
+
+    return profilerThread.depth++;
+}
+
+//
+// endScope
+// Description:
+//      Leaves a scope and writes its event to the ring of the calling thread. Never blocks, the
+//      event is dropped if the ring is full.
+// Parameters:
+//      name  <const char*>: Name of the scope, a string literal.
+//      start <long long>: Time the scope began, from 'now'.
+//      depth <int>: Depth returned by 'beginScope'.
+// Returns:
+//      None (void).
+//
+void Profiler::endScope(const char *name, long long start, int depth) {
+    long long end = now();
+
+    profilerThread.depth = depth;
+
+    ProfilerBuffer *buffer = getBuffer();
+    unsigned int head = buffer->head.load(std::memory_order_relaxed);
+
+    if (head - buffer->tail.load(std::memory_order_acquire) >= PROFILER_RING_SIZE) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ProfileEvent &event = buffer->events[head & (PROFILER_RING_SIZE - 1)];
+    event.name = name;
+    event.start = start;
+    event.end = end;
+    event.thread = buffer->thread;
+    event.depth = depth;
+
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+//
+// ProfileScope
+// Description:
+//      Constructor.
+//      Begins a scope.
+// Parameters:
+//      in_name <const char*>: Name of the scope, a string literal.
+// Returns:
+//      None (void).
+//
+ProfileScope::ProfileScope(const char *in_name) {
+    name = in_name;
+    depth = Profiler::beginScope();
+    start = depth >= 0 ? Profiler::now() : 0;
+}
+
+//
+// ~ProfileScope
+// Description:
+//      Destructor.
+//      Ends the scope and records it.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+ProfileScope::~ProfileScope() {
+    if (depth >= 0)
+        Profiler::endScope(name, start, depth);
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// getBuffer
+// Description:
+//      Getter function for the ring of the calling thread, taking a free one or making a new one
+//      the first time the thread records an event.
+// Parameters:
+//      None (void).
+// Returns:
+//      <ProfilerBuffer*>: The ring.
+//
+ProfilerBuffer *Profiler::getBuffer(void) {
+    if (profilerThread.buffer != NULL)
+        return profilerThread.buffer;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ProfilerBuffer *buffer = NULL;
+
+    for (int b = 0; b < (int)buffers.size() && buffer == NULL; b++) {
+        if (!buffers[b]->inUse)
+            buffer = buffers[b];
+    }
+
+    if (buffer == NULL) {
+        buffer = new ProfilerBuffer();
+        buffer->events.resize(PROFILER_RING_SIZE);
+        buffer->head.store(0, std::memory_order_relaxed);
+        buffer->tail.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+        buffers.push_back(buffer);
+    }
+
+    buffer->thread = ++numThreads;
+    buffer->inUse = true;
+
+    profilerThread.buffer = buffer;
+    return buffer;
+}
+
+//
+// releaseBuffer
+// Description:
+//      Hands the ring of an exiting thread back, its uncollected events are kept.
+// Parameters:
+//      buffer <ProfilerBuffer*>: The ring.
+// Returns:
+//      None (void).
+//
+void Profiler::releaseBuffer(ProfilerBuffer *buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    buffer->inUse = false;
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// toMilliseconds
+// Description:
+//      Converts nanoseconds to milliseconds.
+// Parameters:
+//      nanoseconds <long long>: The time.
+// Returns:
+//      <double>: The time in milliseconds.
+//
+static double toMilliseconds(long long nanoseconds) {
+    return nanoseconds / 1000000.0;
+}
+
+//
+// writeEscaped
+// Description:
+//      Writes text as the inside of a JSON string.
+// Parameters:
+//      file <std::ofstream&>: The file.
+//      text <const char*>: The text.
+// Returns:
+//      None (void).
+//
+static void writeEscaped(std::ofstream &file, const char *text) {
+    for (; *text != '\0'; text++) {
+        if (*text == '"' || *text == '\\')
+            file << '\\' << *text;
+        else if ((unsigned char)*text < 0x20)
+            file << ' ';
+        else
+            file << *text;
+    }
+}
@@ -0,0 +1,925 @@
+// RecordingBackend.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/RecordingBackend.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int RECORDING_MAX_LIGHTS = 8; // The least every OpenGL implementation has
+
+// Kinds of state, the top bits of the state keys
+static const unsigned long long STATE_CAPABILITY = 1;
+static const unsigned long long STATE_MATERIAL = 2;
+static const unsigned long long STATE_LIGHT = 3;
+static const unsigned long long STATE_TEXTURE = 4;
+static const unsigned long long STATE_CLIENT_ARRAY = 5;
+
+static unsigned long long stateKey(unsigned long long kind, unsigned int first, unsigned int second);
+static int parameterCount(GLenum name);
+static int formatComponents(GLenum format);
+static int typeBytes(GLenum type);
+static void setIdentity(GLfloat *matrix);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// RecordingBackend
+// Description:
+//      Constructor.
+//      Creates a backend with the default OpenGL state and identity matrices.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+RecordingBackend::RecordingBackend() {
+    boundTexture = 0;
+    nextTexture = 1;
+
+    nextList = 1;
+    compilingList = 0;
+    executeList = false;
+
+    primitiveVertices = 0;
+    maxLights = RECORDING_MAX_LIGHTS;
+
+    modelview.resize(16);
+    projection.resize(16);
+    setIdentity(&modelview[0]);
+    setIdentity(&projection[0]);
+
+    logging = false;
+}
+
+//
+// enable
+// Description:
+//      Records enabling a capability.
+// Parameters:
+//      capability <GLenum>: The capability.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::enable(GLenum capability) {
+    GLfloat value = 1.0f;
+    changeState(stateKey(STATE_CAPABILITY, capability, 0), &value, 1);
+    log("glEnable(0x%04X)", capability);
+}
+
+//
+// disable
+// Description:
+//      Records disabling a capability.
+// Parameters:
+//      capability <GLenum>: The capability.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::disable(GLenum capability) {
+    GLfloat value = 0.0f;
+    changeState(stateKey(STATE_CAPABILITY, capability, 0), &value, 1);
+    log("glDisable(0x%04X)", capability);
+}
+
+//
+// setMaterial
+// Description:
+//      Records setting a vector material parameter.
+// Parameters:
+//      face   <GLenum>: GL_FRONT, GL_BACK or GL_FRONT_AND_BACK.
+//      name   <GLenum>: The parameter.
+//      values <const GLfloat*>: The values.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::setMaterial(GLenum face, GLenum name, const GLfloat *values) {
+    int count = parameterCount(name);
+    changeState(stateKey(STATE_MATERIAL, face, name), values, count);
+
+    if (count == 4)
+        log("glMaterialfv(0x%04X, 0x%04X, {%g, %g, %g, %g})", face, name, values[0], values[1], values[2], values[3]);
+    else
+        log("glMaterialfv(0x%04X, 0x%04X, {%g})", face, name, values[0]);
+}
+
+//
+// setMaterial
+// Description:
+//      Records setting a single value material parameter.
+// Parameters:
+//      face  <GLenum>: GL_FRONT, GL_BACK or GL_FRONT_AND_BACK.
+//      name  <GLenum>: The parameter.
+//      value <GLfloat>: The value.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::setMaterial(GLenum face, GLenum name, GLfloat value) {
+    changeState(stateKey(STATE_MATERIAL, face, name), &value, 1);
+    log("glMaterialf(0x%04X, 0x%04X, %g)", face, name, value);
+}
+
+//
+// setLight
+// Description:
+//      Records setting a vector light parameter.
+// Parameters:
+//      light  <GLenum>: The light.
+//      name   <GLenum>: The parameter.
+//      values <const GLfloat*>: The values.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::setLight(GLenum light, GLenum name, const GLfloat *values) {
+    int count = parameterCount(name);
+    changeState(stateKey(STATE_LIGHT, light, name), values, count);
+
+    if (count == 4)
+        log("glLightfv(0x%04X, 0x%04X, {%g, %g, %g, %g})", light, name, values[0], values[1], values[2], values[3]);
+    else if (count == 3)
+        log("glLightfv(0x%04X, 0x%04X, {%g, %g, %g})", light, name, values[0], values[1], values[2]);
+    else
+        log("glLightfv(0x%04X, 0x%04X, {%g})", light, name, values[0]);
+}
+
+//
+// setLight
+// Description:
+//      Records setting a single value light parameter.
+// Parameters:
+//      light <GLenum>: The light.
+//      name  <GLenum>: The parameter.
+//      value <GLfloat>: The value.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::setLight(GLenum light, GLenum name, GLfloat value) {
+    changeState(stateKey(STATE_LIGHT, light, name), &value, 1);
+    log("glLightf(0x%04X, 0x%04X, %g)", light, name, value);
+}
+
+//
+// createTexture
+// Description:
+//      Records creating a texture name.
+// Parameters:
+//      None (void).
+// Returns:
+//      <GLuint>: The texture, names count up from 1.
+//
+GLuint RecordingBackend::createTexture(void) {
+    GLuint texture = nextTexture++;
+
+    stats.calls++;
+    log("glGenTextures(1) = %u", texture);
+
+    return texture;
+}
+
+//
+// bindTexture
+// Description:
+//      Records binding a texture.
+// Parameters:
+//      target  <GLenum>: The target.
+//      texture <GLuint>: The texture.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::bindTexture(GLenum target, GLuint texture) {
+    stats.calls++;
+    stats.stateChanges++;
+    stats.textureBinds++;
+
+    if (texture == boundTexture)
+        stats.redundantStateChanges++;
+
+    boundTexture = texture;
+    log("glBindTexture(0x%04X, %u)", target, texture);
+}
+
+//
+// setTextureParameter
+// Description:
+//      Records setting a parameter of the bound texture.
+// Parameters:
+//      target <GLenum>: The target.
+//      name   <GLenum>: The parameter.
+//      value  <GLfloat>: The value.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::setTextureParameter(GLenum target, GLenum name, GLfloat value) {
+    changeState(stateKey(STATE_TEXTURE, boundTexture, name), &value, 1);
+    log("glTexParameterf(0x%04X, 0x%04X, %g)", target, name, value);
+}
+
+//
+// uploadTexture
+// Description:
+//      Records uploading the image of the bound texture, counting the bytes of the data.
+// Parameters:
+//      target         <GLenum>: The target.
+//      level          <GLint>: The mipmap level.
+//      internalFormat <GLint>: Format the texture is stored in.
+//      width          <GLsizei>: Width in pixels.
+//      height         <GLsizei>: Height in pixels.
+//      format         <GLenum>: Format of the data.
+//      type           <GLenum>: Type of the components of the data.
+//      data           <const void*>: The pixels, NULL only allocates the texture.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::uploadTexture(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                                     GLenum format, GLenum type, const void *data) {
+    stats.calls++;
+    stats.textureUploads++;
+
+    if (data != NULL)
+        stats.textureBytes += (long long)width * height * formatComponents(format) * typeBytes(type);
+
+    log("glTexImage2D(0x%04X, %d, 0x%04X, %d, %d, 0, 0x%04X, 0x%04X)", target, level, internalFormat, width, height, format, type);
+}
+
+//
+// begin
+// Description:
+//      Records the start of immediate mode primitives.
+// Parameters:
+//      mode <GLenum>: The primitive.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::begin(GLenum mode) {
+    stats.calls++;
+    primitiveVertices = 0;
+    log("glBegin(0x%04X)", mode);
+}
+
+//
+// end
+// Description:
+//      Records the end of the primitives, one draw call with the vertices sent since 'begin'.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void RecordingBackend::end(void) {
+    stats.calls++;
+
+    if (compilingList != 0) {
+        RecordedList &list = lists[compilingList];
+        list.drawCalls++;
+        list.vertices += primitiveVertices;
+    }
+
+    if (compilingList == 0 || executeList) {
+        stats.drawCalls++;
+        stats.vertices += primitiveVertices;
+    }
+
+    log("glEnd() // %d vertices", primitiveVertices);
+}
+
+//
+// vertex
+// Description:
+//      Records a vertex position.
+// Parameters:
+//      x <double>: The x-coordinate.
+//      y <double>: The y-coordinate.
+//      z <double>: The z-coordinate.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::vertex(double x, double y, double z) {
+    primitiveVertices++;
+    addVertexData(3 * sizeof(double));
+    log("glVertex3d(%g, %g, %g)", x, y, z);
+}
+
+//
+// normal
+// Description:
+//      Records the normal of the next vertices.
+// Parameters:
+//      x <double>: The x-component.
+//      y <double>: The y-component.
+//      z <double>: The z-component.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::normal(double x, double y, double z) {
+    addVertexData(3 * sizeof(double));
+    log("glNormal3d(%g, %g, %g)", x, y, z);
+}
+
+//
+// texCoord
+// Description:
+//      Records the texture coordinate of the next vertices.
+// Parameters:
+//      s <float>: The horizontal coordinate.
+//      t <float>: The vertical coordinate.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::texCoord(float s, float t) {
+    addVertexData(2 * sizeof(float));
+    log("glTexCoord2f(%g, %g)", s, t);
+}
+
+//
+// createList
+// Description:
+//      Records creating a display list name.
+// Parameters:
+//      None (void).
+// Returns:
+//      <GLuint>: The list, names count up from 1.
+//
+GLuint RecordingBackend::createList(void) {
+    GLuint list = nextList++;
+
+    stats.calls++;
+    log("glGenLists(1) = %u", list);
+
+    return list;
+}
+
+//
+// beginList
+// Description:
+//      Records the start of compiling a display list, replacing what it held.
+// Parameters:
+//      list <GLuint>: The list.
+//      mode <GLenum>: GL_COMPILE or GL_COMPILE_AND_EXECUTE.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::beginList(GLuint list, GLenum mode) {
+    RecordedList empty = {0, 0, 0};
+
+    stats.calls++;
+    lists[list] = empty;
+    compilingList = list;
+    executeList = mode == GL_COMPILE_AND_EXECUTE;
+
+    log("glNewList(%u, 0x%04X)", list, mode);
+}
+
+//
+// endList
+// Description:
+//      Records the end of compiling a display list.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void RecordingBackend::endList(void) {
+    stats.calls++;
+    stats.listsCompiled++;
+
+    compilingList = 0;
+    executeList = false;
+
+    log("glEndList()");
+}
+
+//
+// callList
+// Description:
+//      Records executing a display list, counting the geometry compiled into it.
+// Parameters:
+//      list <GLuint>: The list.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::callList(GLuint list) {
+    stats.calls++;
+    stats.listCalls++;
+
+    std::map<GLuint, RecordedList>::iterator found = lists.find(list);
+
+    if (found != lists.end()) {
+        stats.drawCalls += found->second.drawCalls;
+        stats.vertices += found->second.vertices;
+        stats.vertexBytes += found->second.vertexBytes;
+    }
+
+    log("glCallList(%u)", list);
+}
+
+//
+// deleteList
+// Description:
+//      Records deleting a display list.
+// Parameters:
+//      list <GLuint>: The list.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::deleteList(GLuint list) {
+    stats.calls++;
+    lists.erase(list);
+    log("glDeleteLists(%u, 1)", list);
+}
+
+//
+// enableClientState
+// Description:
+//      Records enabling a client side vertex array.
+// Parameters:
+//      array <GLenum>: The array.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::enableClientState(GLenum array) {
+    GLfloat value = 1.0f;
+    changeState(stateKey(STATE_CLIENT_ARRAY, array, 0), &value, 1);
+    log("glEnableClientState(0x%04X)", array);
+}
+
+//
+// disableClientState
+// Description:
+//      Records disabling a client side vertex array.
+// Parameters:
+//      array <GLenum>: The array.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::disableClientState(GLenum array) {
+    GLfloat value = 0.0f;
+    changeState(stateKey(STATE_CLIENT_ARRAY, array, 0), &value, 1);
+    log("glDisableClientState(0x%04X)", array);
+}
+
+//
+// vertexPointer
+// Description:
+//      Records setting the vertex position array.
+// Parameters:
+//      size    <GLint>: Components per position.
+//      type    <GLenum>: Type of the components.
+//      stride  <GLsizei>: Bytes from one position to the next, 0 if packed.
+//      pointer <const void*>: The first position.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::vertexPointer(GLint size, GLenum type, GLsizei stride, const void *pointer) {
+    stats.calls++;
+    log("glVertexPointer(%d, 0x%04X, %d, %p)", size, type, stride, pointer);
+}
+
+//
+// normalPointer
+// Description:
+//      Records setting the normal array.
+// Parameters:
+//      type    <GLenum>: Type of the components.
+//      stride  <GLsizei>: Bytes from one normal to the next, 0 if packed.
+//      pointer <const void*>: The first normal.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::normalPointer(GLenum type, GLsizei stride, const void *pointer) {
+    stats.calls++;
+    log("glNormalPointer(0x%04X, %d, %p)", type, stride, pointer);
+}
+
+//
+// texCoordPointer
+// Description:
+//      Records setting the texture coordinate array.
+// Parameters:
+//      size    <GLint>: Components per coordinate.
+//      type    <GLenum>: Type of the components.
+//      stride  <GLsizei>: Bytes from one coordinate to the next, 0 if packed.
+//      pointer <const void*>: The first coordinate.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::texCoordPointer(GLint size, GLenum type, GLsizei stride, const void *pointer) {
+    stats.calls++;
+    log("glTexCoordPointer(%d, 0x%04X, %d, %p)", size, type, stride, pointer);
+}
+
+//
+// drawElements
+// Description:
+//      Records an indexed draw call from the enabled arrays, counting every index as a vertex. The
+//      arrays stay in client memory, so no vertex bytes are counted.
+// Parameters:
+//      mode    <GLenum>: The primitive.
+//      count   <GLsizei>: Number of indices.
+//      type    <GLenum>: Type of the indices.
+//      indices <const void*>: The first index.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::drawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) {
+    stats.calls++;
+    stats.drawCalls++;
+    stats.vertices += count;
+    log("glDrawElements(0x%04X, %d, 0x%04X, %p)", mode, count, type, indices);
+}
+
+//
+// pushMatrix
+// Description:
+//      Records pushing the modelview matrix.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void RecordingBackend::pushMatrix(void) {
+    stats.calls++;
+    stats.matrixChanges++;
+
+    modelview.insert(modelview.end(), modelview.end() - 16, modelview.end());
+    log("glPushMatrix()");
+}
+
+//
+// popMatrix
+// Description:
+//      Records popping the modelview matrix. Popping the last matrix is ignored, like the stack
+//      underflow error OpenGL gives.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void RecordingBackend::popMatrix(void) {
+    stats.calls++;
+    stats.matrixChanges++;
+
+    if ((int)modelview.size() > 16)
+        modelview.resize(modelview.size() - 16);
+
+    log("glPopMatrix()");
+}
+
+//
+// multMatrix
+// Description:
+//      Records multiplying the modelview matrix, keeping the product for 'getFloat'.
+// Parameters:
+//      matrix <const GLfloat*>: Column major 4x4 matrix.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::multMatrix(const GLfloat *matrix) {
+    GLfloat *current = &modelview[modelview.size() - 16];
+    GLfloat product[16];
+
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            product[c * 4 + r] = current[0 * 4 + r] * matrix[c * 4 + 0] +
+                                 current[1 * 4 + r] * matrix[c * 4 + 1] +
+                                 current[2 * 4 + r] * matrix[c * 4 + 2] +
+                                 current[3 * 4 + r] * matrix[c * 4 + 3];
+        }
+    }
+
+    for (int i = 0; i < 16; i++)
+        current[i] = product[i];
+
+    stats.calls++;
+    stats.matrixChanges++;
+    log("glMultMatrixf({%g, %g, %g, ... %g, %g, %g})", matrix[0], matrix[1], matrix[2], matrix[12], matrix[13], matrix[14]);
+}
+
+//
+// getFloat
+// Description:
+//      Answers a float state query. The matrices are answered, everything else reads as zero.
+// Parameters:
+//      name   <GLenum>: The state.
+//      values <GLfloat*>: Receives the values.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::getFloat(GLenum name, GLfloat *values) {
+    stats.calls++;
+
+    if (name == GL_MODELVIEW_MATRIX || name == GL_PROJECTION_MATRIX) {
+        const GLfloat *matrix = name == GL_MODELVIEW_MATRIX ? &modelview[modelview.size() - 16] : &projection[0];
+
+        for (int i = 0; i < 16; i++)
+            values[i] = matrix[i];
+    }
+    else {
+        values[0] = 0.0f;
+    }
+
+    log("glGetFloatv(0x%04X)", name);
+}
+
+//
+// getInteger
+// Description:
+//      Answers an integer state query. GL_MAX_LIGHTS is answered, everything else reads as zero.
+// Parameters:
+//      name   <GLenum>: The state.
+//      values <GLint*>: Receives the values.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::getInteger(GLenum name, GLint *values) {
+    stats.calls++;
+    values[0] = name == GL_MAX_LIGHTS ? maxLights : 0;
+    log("glGetIntegerv(0x%04X)", name);
+}
+
+//
+// setMatrix
+// Description:
+//      Replaces the current modelview or projection matrix without recording a call, to place the
+//      camera the drawing code finds when it reads the matrices.
+// Parameters:
+//      mode   <GLenum>: GL_MODELVIEW or GL_PROJECTION.
+//      matrix <const GLfloat*>: Column major 4x4 matrix.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::setMatrix(GLenum mode, const GLfloat *matrix) {
+    GLfloat *current = mode == GL_PROJECTION ? &projection[0] : &modelview[modelview.size() - 16];
+
+    for (int i = 0; i < 16; i++)
+        current[i] = matrix[i];
+}
+
+//
+// setMaxLights
+// Description:
+//      Sets the number of lights GL_MAX_LIGHTS reads as.
+// Parameters:
+//      value <int>: The number of lights, 8 by default.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::setMaxLights(int value) {
+    maxLights = value;
+}
+
+//
+// setLogging
+// Description:
+//      Enables or disables the text log of the calls. Logging every vertex is slow, leave it off
+//      when measuring time.
+// Parameters:
+//      value <bool>: Log the calls.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::setLogging(bool value) {
+    logging = value;
+}
+
+//
+// getLog
+// Description:
+//      Getter function for the logged calls.
+// Parameters:
+//      None (void).
+// Returns:
+//      callLog <const std::vector<std::string>&>: One line per call, in the order they were made.
+//
+const std::vector<std::string> &RecordingBackend::getLog(void) const {
+    return callLog;
+}
+
+//
+// clearLog
+// Description:
+//      Removes the logged calls.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void RecordingBackend::clearLog(void) {
+    callLog.clear();
+}
+
+//
+// getStats
+// Description:
+//      Getter function for the counters of the backend.
+// Parameters:
+//      None (void).
+// Returns:
+//      stats <const RenderBackendStats&>: Calls, draw calls, state changes and bytes.
+//
+const RenderBackendStats &RecordingBackend::getStats(void) const {
+    return stats;
+}
+
+//
+// resetStats
+// Description:
+//      Resets the counters, the recorded state, textures and lists are kept.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void RecordingBackend::resetStats(void) {
+    stats = RenderBackendStats();
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// changeState
+// Description:
+//      Counts a state change and remembers the new value.
+// Parameters:
+//      key    <unsigned long long>: Kind and name of the state.
+//      values <const GLfloat*>: The new value.
+//      count  <int>: Number of values.
+// Returns:
+//      <bool>: False if the state already had the value.
+//
+bool RecordingBackend::changeState(unsigned long long key, const GLfloat *values, int count) {
+    std::vector<GLfloat> &value = state[key];
+    bool changed = (int)value.size() != count;
+
+    for (int i = 0; i < count && !changed; i++)
+        changed = value[i] != values[i];
+
+    stats.calls++;
+    stats.stateChanges++;
+
+    if (!changed) {
+        stats.redundantStateChanges++;
+        return false;
+    }
+
+    value.assign(values, values + count);
+    return true;
+}
+
+//
+// addVertexData
+// Description:
+//      Counts immediate mode vertex data, in the list being compiled and, unless the list is only
+//      compiled, in the statistics.
+// Parameters:
+//      bytes <long long>: Bytes of the data.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::addVertexData(long long bytes) {
+    stats.calls++;
+
+    if (compilingList != 0)
+        lists[compilingList].vertexBytes += bytes;
+
+    if (compilingList == 0 || executeList)
+        stats.vertexBytes += bytes;
+}
+
+//
+// log
+// Description:
+//      Adds a line to the log if logging is enabled.
+// Parameters:
+//      format <const char*>: printf style format of the line.
+//      ...: The values of the format.
+// Returns:
+//      None (void).
+//
+void RecordingBackend::log(const char *format, ...) {
+    if (!logging)
+        return;
+
+    char line[256];
+    va_list arguments;
+
+    va_start(arguments, format);
+    vsnprintf(line, sizeof(line), format, arguments);
+    va_end(arguments);
+
+    callLog.push_back(line);
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// stateKey
+// Description:
+//      Packs the kind of a state and the two enums naming it into one key.
+// Parameters:
+//      kind   <unsigned long long>: Kind of state, one of the STATE_ constants.
+//      first  <unsigned int>: Capability, face, light or texture.
+//      second <unsigned int>: Parameter, 0 for capabilities.
+// Returns:
+//      <unsigned long long>: The key.
+//
+static unsigned long long stateKey(unsigned long long kind, unsigned int first, unsigned int second) {
+    return (kind << 56) | ((unsigned long long)(first & 0x0FFFFFFF) << 28) | (second & 0x0FFFFFFF);
+}
+
+//
+// parameterCount
+// Description:
+//      Number of values a vector material or light parameter has.
+// Parameters:
+//      name <GLenum>: The parameter.
+// Returns:
+//      <int>: 4 for colors and positions, 3 for the spot direction, 1 for the rest.
+//
+static int parameterCount(GLenum name) {
+    switch (name) {
+        case GL_AMBIENT:
+        case GL_DIFFUSE:
+        case GL_SPECULAR:
+        case GL_EMISSION:
+        case GL_AMBIENT_AND_DIFFUSE:
+        case GL_POSITION:
+            return 4;
+        case GL_SPOT_DIRECTION:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+//
+// formatComponents
+// Description:
+//      Number of components of a pixel format.
+// Parameters:
+//      format <GLenum>: The format.
+// Returns:
+//      <int>: Components per pixel, 4 for unknown formats.
+//
+static int formatComponents(GLenum format) {
+    switch (format) {
+        case GL_ALPHA:
+        case GL_LUMINANCE:
+        case GL_RED:
+            return 1;
+        case GL_LUMINANCE_ALPHA:
+            return 2;
+        case GL_RGB:
+            return 3;
+        default:
+            return 4;
+    }
+}
+
+//
+// typeBytes
+// Description:
+//      Size of a component type of pixel data.
+// Parameters:
+//      type <GLenum>: The type.
+// Returns:
+//      <int>: Bytes per component, 1 for unknown types.
+//
+static int typeBytes(GLenum type) {
+    switch (type) {
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+            return 2;
+        case GL_INT:
+        case GL_UNSIGNED_INT:
+        case GL_FLOAT:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+//
+// setIdentity
+// Description:
+//      Sets a matrix to the identity.
+// Parameters:
+//      matrix <GLfloat*>: Column major 4x4 matrix.
+// Returns:
+//      None (void).
+//
+static void setIdentity(GLfloat *matrix) {
+    for (int i = 0; i < 16; i++)
+        matrix[i] = i % 5 == 0 ? 1.0f : 0.0f;
+}
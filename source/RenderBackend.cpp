@@ -0,0 +1,494 @@
+// RenderBackend.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/RenderBackend.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static GLRenderBackend glBackend;
+
+RenderBackend *RenderBackend::current = &glBackend;
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// get
+// Description:
+//      Getter function for the backend the drawing code calls.
+// Parameters:
+//      None (void).
+// Returns:
+//      current <RenderBackend*>: The backend, the OpenGL one unless another was set.
+//
+RenderBackend *RenderBackend::get(void) {
+    return current;
+}
+
+//
+// set
+// Description:
+//      Makes a backend the one the drawing code calls. The backend is not owned and has to outlive
+//      its use. Display lists and textures made by one backend mean nothing to another, so switch
+//      before models and textures are loaded and drawn.
+// Parameters:
+//      backend <RenderBackend*>: The backend, NULL goes back to the OpenGL one.
+// Returns:
+//      None (void).
+//
+void RenderBackend::set(RenderBackend *backend) {
+    current = backend != NULL ? backend : &glBackend;
+}
+
+//*********************************************************************************
+// GLRenderBackend public class functions
+//*********************************************************************************
+
+//
+// enable
+// Description:
+//      Enables a capability with glEnable.
+// Parameters:
+//      capability <GLenum>: The capability, for example GL_TEXTURE_2D or a light.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::enable(GLenum capability) {
+    glEnable(capability);
+}
+
+//
+// disable
+// Description:
+//      Disables a capability with glDisable.
+// Parameters:
+//      capability <GLenum>: The capability.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::disable(GLenum capability) {
+    glDisable(capability);
+}
+
+//
+// setMaterial
+// Description:
+//      Sets a vector material parameter with glMaterialfv.
+// Parameters:
+//      face   <GLenum>: GL_FRONT, GL_BACK or GL_FRONT_AND_BACK.
+//      name   <GLenum>: The parameter, for example GL_DIFFUSE.
+//      values <const GLfloat*>: The values.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::setMaterial(GLenum face, GLenum name, const GLfloat *values) {
+    glMaterialfv(face, name, values);
+}
+
+//
+// setMaterial
+// Description:
+//      Sets a single value material parameter with glMaterialf.
+// Parameters:
+//      face  <GLenum>: GL_FRONT, GL_BACK or GL_FRONT_AND_BACK.
+//      name  <GLenum>: The parameter, GL_SHININESS.
+//      value <GLfloat>: The value.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::setMaterial(GLenum face, GLenum name, GLfloat value) {
+    glMaterialf(face, name, value);
+}
+
+//
+// setLight
+// Description:
+//      Sets a vector light parameter with glLightfv.
+// Parameters:
+//      light  <GLenum>: The light, GL_LIGHT0 and up.
+//      name   <GLenum>: The parameter, for example GL_POSITION.
+//      values <const GLfloat*>: The values.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::setLight(GLenum light, GLenum name, const GLfloat *values) {
+    glLightfv(light, name, values);
+}
+
+//
+// setLight
+// Description:
+//      Sets a single value light parameter with glLightf.
+// Parameters:
+//      light <GLenum>: The light, GL_LIGHT0 and up.
+//      name  <GLenum>: The parameter, for example GL_SPOT_CUTOFF.
+//      value <GLfloat>: The value.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::setLight(GLenum light, GLenum name, GLfloat value) {
+    glLightf(light, name, value);
+}
+
+//
+// createTexture
+// Description:
+//      Creates a texture name with glGenTextures.
+// Parameters:
+//      None (void).
+// Returns:
+//      <GLuint>: The texture.
+//
+GLuint GLRenderBackend::createTexture(void) {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    return texture;
+}
+
+//
+// bindTexture
+// Description:
+//      Binds a texture with glBindTexture.
+// Parameters:
+//      target  <GLenum>: The target, GL_TEXTURE_2D.
+//      texture <GLuint>: The texture, 0 for none.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::bindTexture(GLenum target, GLuint texture) {
+    glBindTexture(target, texture);
+}
+
+//
+// setTextureParameter
+// Description:
+//      Sets a parameter of the bound texture with glTexParameterf.
+// Parameters:
+//      target <GLenum>: The target, GL_TEXTURE_2D.
+//      name   <GLenum>: The parameter, for example GL_TEXTURE_MIN_FILTER.
+//      value  <GLfloat>: The value.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::setTextureParameter(GLenum target, GLenum name, GLfloat value) {
+    glTexParameterf(target, name, value);
+}
+
+//
+// uploadTexture
+// Description:
+//      Uploads the image of the bound texture with glTexImage2D.
+// Parameters:
+//      target         <GLenum>: The target, GL_TEXTURE_2D.
+//      level          <GLint>: The mipmap level.
+//      internalFormat <GLint>: Format the texture is stored in.
+//      width          <GLsizei>: Width in pixels.
+//      height         <GLsizei>: Height in pixels.
+//      format         <GLenum>: Format of the data, for example GL_RGB.
+//      type           <GLenum>: Type of the components of the data, for example GL_UNSIGNED_BYTE.
+//      data           <const void*>: The pixels.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::uploadTexture(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                                    GLenum format, GLenum type, const void *data) {
+    glTexImage2D(target, level, internalFormat, width, height, 0, format, type, data);
+}
+
+//
+// begin
+// Description:
+//      Starts immediate mode primitives with glBegin.
+// Parameters:
+//      mode <GLenum>: The primitive, for example GL_TRIANGLES.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::begin(GLenum mode) {
+    glBegin(mode);
+}
+
+//
+// end
+// Description:
+//      Ends the primitives started with 'begin'.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::end(void) {
+    glEnd();
+}
+
+//
+// vertex
+// Description:
+//      Sends a vertex position with glVertex3d.
+// Parameters:
+//      x <double>: The x-coordinate.
+//      y <double>: The y-coordinate.
+//      z <double>: The z-coordinate.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::vertex(double x, double y, double z) {
+    glVertex3d(x, y, z);
+}
+
+//
+// normal
+// Description:
+//      Sets the normal of the next vertices with glNormal3d.
+// Parameters:
+//      x <double>: The x-component.
+//      y <double>: The y-component.
+//      z <double>: The z-component.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::normal(double x, double y, double z) {
+    glNormal3d(x, y, z);
+}
+
+//
+// texCoord
+// Description:
+//      Sets the texture coordinate of the next vertices with glTexCoord2f.
+// Parameters:
+//      s <float>: The horizontal coordinate.
+//      t <float>: The vertical coordinate.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::texCoord(float s, float t) {
+    glTexCoord2f(s, t);
+}
+
+//
+// createList
+// Description:
+//      Creates a display list name with glGenLists.
+// Parameters:
+//      None (void).
+// Returns:
+//      <GLuint>: The list, 0 if none could be made.
+//
+GLuint GLRenderBackend::createList(void) {
+    return glGenLists(1);
+}
+
+//
+// beginList
+// Description:
+//      Starts compiling a display list with glNewList.
+// Parameters:
+//      list <GLuint>: The list.
+//      mode <GLenum>: GL_COMPILE or GL_COMPILE_AND_EXECUTE.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::beginList(GLuint list, GLenum mode) {
+    glNewList(list, mode);
+}
+
+//
+// endList
+// Description:
+//      Ends the display list started with 'beginList'.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::endList(void) {
+    glEndList();
+}
+
+//
+// callList
+// Description:
+//      Executes a display list with glCallList.
+// Parameters:
+//      list <GLuint>: The list.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::callList(GLuint list) {
+    glCallList(list);
+}
+
+//
+// deleteList
+// Description:
+//      Deletes a display list with glDeleteLists.
+// Parameters:
+//      list <GLuint>: The list.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::deleteList(GLuint list) {
+    glDeleteLists(list, 1);
+}
+
+//
+// enableClientState
+// Description:
+//      Enables a client side vertex array with glEnableClientState.
+// Parameters:
+//      array <GLenum>: The array, for example GL_VERTEX_ARRAY.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::enableClientState(GLenum array) {
+    glEnableClientState(array);
+}
+
+//
+// disableClientState
+// Description:
+//      Disables a client side vertex array with glDisableClientState.
+// Parameters:
+//      array <GLenum>: The array.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::disableClientState(GLenum array) {
+    glDisableClientState(array);
+}
+
+//
+// vertexPointer
+// Description:
+//      Sets the vertex position array with glVertexPointer.
+// Parameters:
+//      size    <GLint>: Components per position.
+//      type    <GLenum>: Type of the components.
+//      stride  <GLsizei>: Bytes from one position to the next, 0 if packed.
+//      pointer <const void*>: The first position.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::vertexPointer(GLint size, GLenum type, GLsizei stride, const void *pointer) {
+    glVertexPointer(size, type, stride, pointer);
+}
+
+//
+// normalPointer
+// Description:
+//      Sets the normal array with glNormalPointer.
+// Parameters:
+//      type    <GLenum>: Type of the components.
+//      stride  <GLsizei>: Bytes from one normal to the next, 0 if packed.
+//      pointer <const void*>: The first normal.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::normalPointer(GLenum type, GLsizei stride, const void *pointer) {
+    glNormalPointer(type, stride, pointer);
+}
+
+//
+// texCoordPointer
+// Description:
+//      Sets the texture coordinate array with glTexCoordPointer.
+// Parameters:
+//      size    <GLint>: Components per coordinate.
+//      type    <GLenum>: Type of the components.
+//      stride  <GLsizei>: Bytes from one coordinate to the next, 0 if packed.
+//      pointer <const void*>: The first coordinate.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::texCoordPointer(GLint size, GLenum type, GLsizei stride, const void *pointer) {
+    glTexCoordPointer(size, type, stride, pointer);
+}
+
+//
+// drawElements
+// Description:
+//      Draws indexed primitives from the enabled arrays with glDrawElements.
+// Parameters:
+//      mode    <GLenum>: The primitive, for example GL_TRIANGLES.
+//      count   <GLsizei>: Number of indices.
+//      type    <GLenum>: Type of the indices.
+//      indices <const void*>: The first index.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::drawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) {
+    glDrawElements(mode, count, type, indices);
+}
+
+//
+// pushMatrix
+// Description:
+//      Pushes the current matrix with glPushMatrix.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::pushMatrix(void) {
+    glPushMatrix();
+}
+
+//
+// popMatrix
+// Description:
+//      Pops the current matrix with glPopMatrix.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::popMatrix(void) {
+    glPopMatrix();
+}
+
+//
+// multMatrix
+// Description:
+//      Multiplies the current matrix with glMultMatrixf.
+// Parameters:
+//      matrix <const GLfloat*>: Column major 4x4 matrix.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::multMatrix(const GLfloat *matrix) {
+    glMultMatrixf(matrix);
+}
+
+//
+// getFloat
+// Description:
+//      Reads a state value with glGetFloatv.
+// Parameters:
+//      name   <GLenum>: The state, for example GL_MODELVIEW_MATRIX.
+//      values <GLfloat*>: Receives the values.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::getFloat(GLenum name, GLfloat *values) {
+    glGetFloatv(name, values);
+}
+
+//
+// getInteger
+// Description:
+//      Reads a state value with glGetIntegerv.
+// Parameters:
+//      name   <GLenum>: The state, for example GL_MAX_LIGHTS.
+//      values <GLint*>: Receives the values.
+// Returns:
+//      None (void).
+//
+void GLRenderBackend::getInteger(GLenum name, GLint *values) {
+    glGetIntegerv(name, values);
+}
@@ -0,0 +1,362 @@
+// RenderQueue.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/RenderQueue.h"
+#include "../include/RenderBackend.h"
+#include <math.h>
+#include <chrono>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int RENDER_KEY_ID_BITS = 16;
+static const int RENDER_KEY_DEPTH_BITS = 24;
+static const unsigned int RENDER_KEY_ID_MASK = (1u << RENDER_KEY_ID_BITS) - 1;
+static const unsigned int RENDER_KEY_DEPTH_MASK = (1u << RENDER_KEY_DEPTH_BITS) - 1;
+
+static void radixSort(RenderKey *keys, RenderKey *buffer, int count, RenderKey **sorted);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// RenderQueue
+// Description:
+//      Constructor.
+//      Creates an empty queue.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+RenderQueue::RenderQueue() {
+    viewPoint = Vector3(0.0f, 0.0f, 0.0f);
+}
+
+//
+// begin
+// Description:
+//      Starts a new frame, removing the items and the material and texture ids of the last one.
+// Parameters:
+//      in_viewPoint <const Vector3&>: Position of the camera, depths are measured from it.
+// Returns:
+//      None (void).
+//
+void RenderQueue::begin(const Vector3 &in_viewPoint) {
+    viewPoint = in_viewPoint;
+
+    items.clear();
+    keys.clear();
+    materialIds.clear();
+    textureIds.clear();
+
+    stats.numItems = 0;
+}
+
+//
+// add
+// Description:
+//      Adds an item to the frame. Materials with an alpha below one go to the transparent pass.
+// Parameters:
+//      item   <const RenderItem&>: The face batch to draw.
+//      center <const Vector3&>: Center of the batch in world space, gives its depth.
+// Returns:
+//      None (void).
+//
+void RenderQueue::add(const RenderItem &item, const Vector3 &center) {
+    float dx = center.x - viewPoint.x;
+    float dy = center.y - viewPoint.y;
+    float dz = center.z - viewPoint.z;
+
+    RENDER_PASS pass = (item.material != NULL && item.material->alpha < 1.0f) ? RENDER_PASS_TRANSPARENT : RENDER_PASS_OPAQUE;
+    Texture *texture = item.material != NULL ? item.material->diffuseMap : NULL;
+
+    RenderKey key;
+    key.key = makeKey(pass, sqrtf(dx * dx + dy * dy + dz * dz), getMaterialId(item.material), getTextureId(texture));
+    key.item = (int)items.size();
+
+    items.push_back(item);
+    keys.push_back(key);
+
+    stats.numItems++;
+}
+
+//
+// sort
+// Description:
+//      Sorts the items of the frame by their keys, with a least significant byte first radix sort.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void RenderQueue::sort(void) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (keys.size() > 1) {
+        sortBuffer.resize(keys.size());
+
+        RenderKey *sorted;
+        radixSort(&keys[0], &sortBuffer[0], (int)keys.size(), &sorted);
+
+        if (sorted != &keys[0])
+            keys.swap(sortBuffer);
+    }
+
+    stats.sortTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// draw
+// Description:
+//      Draws the items in key order, call after 'sort'. Materials and transforms are only set
+//      when they change from one item to the next.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void RenderQueue::draw(void) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    RenderBackend *backend = RenderBackend::get();
+
+    stats.materialChanges = 0;
+    stats.textureChanges = 0;
+    stats.transformChanges = 0;
+
+    bool first = true;
+    Material *currentMaterial = NULL;
+    Texture *currentTexture = NULL;
+    const float *currentTransform = NULL;
+
+    for (int i = 0; i < (int)keys.size(); i++) {
+        const RenderItem &item = items[keys[i].item];
+
+        if (first || item.material != currentMaterial) {
+            Texture *texture = item.material != NULL ? item.material->diffuseMap : NULL;
+
+            item.model->applyMaterial(item.material);
+            stats.materialChanges++;
+
+            if (first || texture != currentTexture)
+                stats.textureChanges++;
+
+            currentMaterial = item.material;
+            currentTexture = texture;
+        }
+
+        if (first || item.transform != currentTransform) {
+            if (!first && currentTransform != NULL)
+                backend->popMatrix();
+
+            if (item.transform != NULL) {
+                backend->pushMatrix();
+                backend->multMatrix(item.transform);
+            }
+
+            currentTransform = item.transform;
+            stats.transformChanges++;
+        }
+
+        item.model->drawBatch(item.object, item.batch);
+        first = false;
+    }
+
+    if (currentTransform != NULL)
+        backend->popMatrix();
+
+    backend->disable(GL_TEXTURE_2D);
+
+    stats.drawTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// makeKey
+// Description:
+//      Builds the sort key of an item, see the layout at the top of RenderQueue.h.
+// Parameters:
+//      pass     <RENDER_PASS>: Opaque or transparent.
+//      depth    <float>: Distance from the view point, negative values count as zero.
+//      material <int>: Id of the material, only the low 16 bits are used.
+//      texture  <int>: Id of the texture, only the low 16 bits are used.
+// Returns:
+//      <unsigned long long>: The key.
+//
+unsigned long long RenderQueue::makeKey(RENDER_PASS pass, float depth, int material, int texture) {
+    unsigned int depthBits;
+
+    depth = depth > 0.0f ? depth : 0.0f;
+    std::memcpy(&depthBits, &depth, sizeof(depthBits));
+    depthBits >>= 32 - RENDER_KEY_DEPTH_BITS;
+
+    unsigned long long state = ((unsigned long long)(texture & RENDER_KEY_ID_MASK) << RENDER_KEY_ID_BITS) |
+                               (unsigned long long)(material & RENDER_KEY_ID_MASK);
+    unsigned long long key = (unsigned long long)pass << 62;
+
+    if (pass == RENDER_PASS_TRANSPARENT) {
+        key |= (unsigned long long)(RENDER_KEY_DEPTH_MASK - depthBits) << 38;
+        key |= state << 6;
+    }
+    else {
+        key |= state << 30;
+        key |= (unsigned long long)depthBits << 6;
+    }
+    return key;
+}
+
+//
+// getNumItems
+// Description:
+//      Getter function for the number of items in the frame.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: Number of items.
+//
+int RenderQueue::getNumItems(void) const {
+    return (int)items.size();
+}
+
+//
+// getItem
+// Description:
+//      Getter function for an item, in the order they were added.
+// Parameters:
+//      index <int>: Index of the item.
+// Returns:
+//      <const RenderItem&>: The item.
+//
+const RenderItem &RenderQueue::getItem(int index) const {
+    return items[index];
+}
+
+//
+// getKeys
+// Description:
+//      Getter function for the keys of the frame, in draw order after 'sort'.
+// Parameters:
+//      None (void).
+// Returns:
+//      <const RenderKey*>: The keys, 'getNumItems' of them.
+//
+const RenderKey *RenderQueue::getKeys(void) const {
+    return keys.empty() ? NULL : &keys[0];
+}
+
+//
+// getStats
+// Description:
+//      Getter function for the statistics of the frame.
+// Parameters:
+//      None (void).
+// Returns:
+//      stats <const RenderQueueStats&>: Item count, state changes and timings.
+//
+const RenderQueueStats &RenderQueue::getStats(void) const {
+    return stats;
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// getMaterialId
+// Description:
+//      Returns the id of a material, giving it the next free id when it is new.
+// Parameters:
+//      material <Material*>: The material, NULL has its own id.
+// Returns:
+//      <int>: The id.
+//
+int RenderQueue::getMaterialId(Material *material) {
+    std::unordered_map<Material *, int>::iterator it = materialIds.find(material);
+
+    if (it != materialIds.end())
+        return it->second;
+
+    int id = (int)materialIds.size();
+    materialIds[material] = id;
+    return id;
+}
+
+//
+// getTextureId
+// Description:
+//      Returns the id of a texture, giving it the next free id when it is new.
+// Parameters:
+//      texture <Texture*>: The texture, NULL has its own id.
+// Returns:
+//      <int>: The id.
+//
+int RenderQueue::getTextureId(Texture *texture) {
+    std::unordered_map<Texture *, int>::iterator it = textureIds.find(texture);
+
+    if (it != textureIds.end())
+        return it->second;
+
+    int id = (int)textureIds.size();
+    textureIds[texture] = id;
+    return id;
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// radixSort
+// Description:
+//      Sorts keys with eight passes of 8 bits, lowest byte first. The histograms of all passes are
+//      counted in one read of the keys, and passes where every key has the same byte are skipped,
+//      which is common for the pass and id bytes.
+// Parameters:
+//      keys   <RenderKey*>: The keys.
+//      buffer <RenderKey*>: Room for 'count' keys.
+//      count  <int>: Number of keys.
+//      sorted <RenderKey**>: Receives 'keys' or 'buffer', whichever holds the sorted keys.
+// Returns:
+//      None (void).
+//
+static void radixSort(RenderKey *keys, RenderKey *buffer, int count, RenderKey **sorted) {
+    std::vector<int> histograms(8 * 256, 0);
+
+    for (int i = 0; i < count; i++) {
+        unsigned long long key = keys[i].key;
+
+        for (int pass = 0; pass < 8; pass++)
+            histograms[pass * 256 + (int)((key >> (pass * 8)) & 0xFF)]++;
+    }
+
+    RenderKey *source = keys;
+    RenderKey *destination = buffer;
+
+    for (int pass = 0; pass < 8; pass++) {
+        int *histogram = &histograms[pass * 256];
+        int shift = pass * 8;
+
+        if (histogram[(source[0].key >> shift) & 0xFF] == count)
+            continue;
+
+        int offset = 0;
+        for (int b = 0; b < 256; b++) {
+            int size = histogram[b];
+            histogram[b] = offset;
+            offset += size;
+        }
+
+        for (int i = 0; i < count; i++)
+            destination[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+
+        RenderKey *swap = source;
+        source = destination;
+        destination = swap;
+    }
+
+    *sorted = source;
+}
@@ -0,0 +1,387 @@
+// RingBuffer.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/RingBuffer.h"
+#include <chrono>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static GLFunctions &gl = GLExtensions::gl;
+
+static const unsigned long long RING_WAIT_TIMEOUT = 1000000; // Nanoseconds per wait before checking again
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// RingBuffer
+// Description:
+//      Constructor.
+//      Creates the ring with the best mode of the current OpenGL context.
+// Parameters:
+//      in_size           <size_t>: Size of the ring in bytes, enough for the data of several frames.
+//      in_framesInFlight <int>: Frames the GPU may be behind the CPU, only used by the cpu mode.
+//      headless          <bool>: Use the cpu mode even if there is an OpenGL context.
+// Returns:
+//      None (void).
+//
+RingBuffer::RingBuffer(size_t in_size, int in_framesInFlight, bool headless) {
+    size = in_size;
+    framesInFlight = in_framesInFlight > 1 ? in_framesInFlight : 1;
+
+    buffer = 0;
+    mapped = NULL;
+
+    head = 0;
+    frameBegin = 0;
+    writeOffset = 0;
+    writeBytes = 0;
+    frameWrapped = false;
+    frame = 0;
+
+    mode = RING_BUFFER_CPU;
+
+    if (headless || !GLExtensions::load()) {
+        memory.resize(size);
+        return;
+    }
+
+    int version = GLExtensions::getVersion();
+    bool bufferStorage = (version >= 44 || GLExtensions::hasExtension("GL_ARB_buffer_storage")) && gl.bufferStorage != NULL;
+    bool sync = (version >= 32 || GLExtensions::hasExtension("GL_ARB_sync")) && gl.fenceSync != NULL;
+
+    if (bufferStorage && sync && gl.mapBufferRange != NULL) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        gl.genBuffers(1, &buffer);
+        gl.bindBuffer(GL_ARRAY_BUFFER, buffer);
+        gl.bufferStorage(GL_ARRAY_BUFFER, (ptrdiff_t)size, NULL, flags);
+        mapped = (unsigned char *)gl.mapBufferRange(GL_ARRAY_BUFFER, 0, (ptrdiff_t)size, flags);
+        gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+
+        if (mapped != NULL) {
+            mode = RING_BUFFER_PERSISTENT;
+            return;
+        }
+
+        // Buffer storage cannot be resized, start over with a new buffer
+        gl.deleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+
+    if (version >= 15 && gl.genBuffers != NULL) {
+        gl.genBuffers(1, &buffer);
+        gl.bindBuffer(GL_ARRAY_BUFFER, buffer);
+        gl.bufferData(GL_ARRAY_BUFFER, (ptrdiff_t)size, NULL, GL_STREAM_DRAW);
+        gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+
+        mode = RING_BUFFER_ORPHAN;
+    }
+
+    memory.resize(size);
+}
+
+//
+// ~RingBuffer
+// Description:
+//      Destructor.
+//      Deletes the fences and the buffer.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+RingBuffer::~RingBuffer() {
+    for (int i = 0; i < (int)fences.size(); i++) {
+        if (fences[i].sync != NULL)
+            gl.deleteSync(fences[i].sync);
+    }
+
+    if (mapped != NULL) {
+        gl.bindBuffer(GL_ARRAY_BUFFER, buffer);
+        gl.unmapBuffer(GL_ARRAY_BUFFER);
+        gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    if (buffer != 0)
+        gl.deleteBuffers(1, &buffer);
+}
+
+//
+// begin
+// Description:
+//      Takes the next free range of the ring for a write, waiting for the frames which still use
+//      it. Finish the write with 'commit' before the next 'begin'.
+// Parameters:
+//      bytes     <size_t>: Size of the write.
+//      alignment <size_t>: Alignment of the offset in the buffer, a power of two.
+// Returns:
+//      <void*>: Memory to write the data to, NULL if the write does not fit in the part of the
+//               ring not used by the current frame.
+//
+void *RingBuffer::begin(size_t bytes, size_t alignment) {
+    writeBytes = 0;
+
+    if (bytes == 0 || bytes > size) {
+        stats.failedWrites++;
+        return NULL;
+    }
+
+    size_t offset = (head + alignment - 1) & ~(alignment - 1);
+    bool wrap = offset + bytes > size;
+
+    if (wrap)
+        offset = 0;
+
+    // The first write of a frame may wrap freely, later ones must stay behind the start of the frame.
+    // Orphaning gives the buffer new storage, which leaves the data of the frame where it was.
+    bool firstWrite = stats.frameWrites == 0;
+
+    if (mode != RING_BUFFER_ORPHAN && !firstWrite && (frameWrapped || wrap) && offset + bytes > frameBegin) {
+        stats.failedWrites++;
+        return NULL;
+    }
+
+    if (wrap) {
+        stats.wraps++;
+
+        if (firstWrite)
+            frameBegin = 0;
+        else
+            frameWrapped = true;
+
+        if (mode == RING_BUFFER_ORPHAN) {
+            gl.bindBuffer(GL_ARRAY_BUFFER, buffer);
+            gl.bufferData(GL_ARRAY_BUFFER, (ptrdiff_t)size, NULL, GL_STREAM_DRAW);
+            gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+    }
+
+    if (firstWrite && !wrap)
+        frameBegin = offset;
+
+    // Fences are in frame order, wait up to the newest frame which used the range
+    int lastOverlap = -1;
+
+    for (int i = 0; i < (int)fences.size(); i++) {
+        if (overlaps(fences[i], offset, offset + bytes))
+            lastOverlap = i;
+    }
+
+    for (int i = 0; i <= lastOverlap; i++) {
+        waitForFence(fences.front());
+        fences.pop_front();
+    }
+
+    writeOffset = offset;
+    writeBytes = bytes;
+    head = offset + bytes;
+
+    return (mapped != NULL ? mapped : &memory[0]) + offset;
+}
+
+//
+// commit
+// Description:
+//      Finishes the write started by 'begin', uploading it in the orphan mode.
+// Parameters:
+//      None (void).
+// Returns:
+//      <size_t>: Offset of the data in the buffer, see 'getPointer'.
+//
+size_t RingBuffer::commit(void) {
+    if (writeBytes == 0)
+        return writeOffset;
+
+    if (mode == RING_BUFFER_ORPHAN) {
+        gl.bindBuffer(GL_ARRAY_BUFFER, buffer);
+        gl.bufferSubData(GL_ARRAY_BUFFER, (ptrdiff_t)writeOffset, (ptrdiff_t)writeBytes, &memory[writeOffset]);
+        gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    stats.frameBytes += writeBytes;
+    stats.totalBytes += writeBytes;
+    stats.frameWrites++;
+
+    writeBytes = 0;
+    return writeOffset;
+}
+
+//
+// endFrame
+// Description:
+//      Places the fence behind the draws of the frame, call after the last draw reading from the
+//      ring in the frame.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void RingBuffer::endFrame(void) {
+    if (stats.frameWrites > 0 && mode != RING_BUFFER_ORPHAN) {
+        RingFence fence;
+        fence.sync = mode == RING_BUFFER_PERSISTENT ? gl.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : NULL;
+        fence.frame = frame;
+        fence.begin = frameBegin;
+        fence.end = head;
+
+        fences.push_back(fence);
+    }
+
+    frame++;
+
+    stats.lastFrameBytes = stats.frameBytes;
+    stats.frameBytes = 0;
+    stats.frameWrites = 0;
+
+    frameBegin = head;
+    frameWrapped = false;
+}
+
+//
+// getPointer
+// Description:
+//      Turns an offset returned by 'commit' into the pointer argument of glVertexPointer and the
+//      other array functions. Bind 'getBuffer' to GL_ARRAY_BUFFER before, unless it is 0.
+// Parameters:
+//      offset <size_t>: Offset of the data.
+// Returns:
+//      <const void*>: The offset itself in the buffer modes, the address of the data in the cpu mode.
+//
+const void *RingBuffer::getPointer(size_t offset) const {
+    if (mode == RING_BUFFER_CPU)
+        return &memory[0] + offset;
+
+    return (const void *)offset;
+}
+
+//
+// getBuffer
+// Description:
+//      Getter function for the OpenGL buffer of the ring.
+// Parameters:
+//      None (void).
+// Returns:
+//      buffer <GLuint>: The buffer, 0 in the cpu mode.
+//
+GLuint RingBuffer::getBuffer(void) const {
+    return buffer;
+}
+
+//
+// getMode
+// Description:
+//      Getter function for the mode chosen for the context.
+// Parameters:
+//      None (void).
+// Returns:
+//      mode <RING_BUFFER_MODE>: Persistent, orphan or cpu.
+//
+RING_BUFFER_MODE RingBuffer::getMode(void) const {
+    return mode;
+}
+
+//
+// getSize
+// Description:
+//      Getter function for the size of the ring.
+// Parameters:
+//      None (void).
+// Returns:
+//      size <size_t>: Size in bytes.
+//
+size_t RingBuffer::getSize(void) const {
+    return size;
+}
+
+//
+// getStats
+// Description:
+//      Getter function for the statistics of the ring.
+// Parameters:
+//      None (void).
+// Returns:
+//      stats <const RingBufferStats&>: Bytes written, stalls and wraps.
+//
+const RingBufferStats &RingBuffer::getStats(void) const {
+    return stats;
+}
+
+//
+// resetStats
+// Description:
+//      Resets the counters of the statistics, the bytes of the current frame are kept.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void RingBuffer::resetStats(void) {
+    RingBufferStats reset;
+    reset.frameBytes = stats.frameBytes;
+    reset.frameWrites = stats.frameWrites;
+
+    stats = reset;
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// overlaps
+// Description:
+//      Checks if a range of the ring overlaps the range written by a fenced frame.
+// Parameters:
+//      fence <const RingFence&>: The frame.
+//      first <size_t>: First byte of the range.
+//      last  <size_t>: One past the last byte of the range.
+// Returns:
+//      <bool>: If the ranges overlap.
+//
+bool RingBuffer::overlaps(const RingFence &fence, size_t first, size_t last) const {
+    if (fence.begin < fence.end)
+        return first < fence.end && last > fence.begin;
+
+    // The frame wrapped, it used the end and the start of the ring
+    return last > fence.begin || first < fence.end;
+}
+
+//
+// waitForFence
+// Description:
+//      Waits until the GPU is done with the draws of a frame and deletes its fence.
+// Parameters:
+//      fence <RingFence&>: The fence.
+// Returns:
+//      None (void).
+//
+void RingBuffer::waitForFence(RingFence &fence) {
+    if (mode == RING_BUFFER_CPU) {
+        // The simulated GPU finishes a frame once it is framesInFlight - 1 frames behind
+        if (frame - fence.frame < framesInFlight - 1)
+            stats.stalls++;
+        return;
+    }
+
+    GLenum result = gl.clientWaitSync(fence.sync, 0, 0);
+
+    if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        while (result == GL_TIMEOUT_EXPIRED)
+            result = gl.clientWaitSync(fence.sync, GL_SYNC_FLUSH_COMMANDS_BIT, RING_WAIT_TIMEOUT);
+
+        stats.stalls++;
+        stats.stallTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    gl.deleteSync(fence.sync);
+    fence.sync = NULL;
+}
@@ -0,0 +1,629 @@
+// SpatialHash.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/SpatialHash.h"
+#include <math.h>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int SPATIAL_MIN_TABLE_SIZE = 64;
+
+static bool boxesOverlap(const BoundingBox &a, const BoundingBox &b);
+static bool boxSphereOverlap(const BoundingBox &box, const Vector3 &center, float radius);
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// SpatialHash
+// Description:
+//      Constructor.
+//      Creates an empty spatial hash. The cell size should be around the size of a typical
+//      entity: smaller cells list big entities in many cells, bigger cells put many entities
+//      in every cell.
+// Parameters:
+//      in_cellSize <float>: Size of the cubic cells.
+// Returns:
+//      None (void).
+//
+SpatialHash::SpatialHash(float in_cellSize) {
+    cellSize = in_cellSize > 0.0f ? in_cellSize : 1.0f;
+    inverseCellSize = 1.0f / cellSize;
+    numEntities = 0;
+    numEmptyCells = 0;
+}
+
+//
+// insert
+// Description:
+//      Adds entities. Inserting an id which is already in the hash updates it instead.
+// Parameters:
+//      ids   <const int*>: Ids of the entities, zero or greater.
+//      boxes <const BoundingBox*>: Bounding box of every entity.
+//      count <int>: Number of entities.
+// Returns:
+//      None (void).
+//
+void SpatialHash::insert(const int *ids, const BoundingBox *boxes, int count) {
+    for (int i = 0; i < count; i++) {
+        int id = ids[i];
+
+        if (id < 0)
+            continue;
+
+        if (contains(id)) {
+            update(&id, &boxes[i], 1);
+            continue;
+        }
+
+        if (id >= (int)entities.size())
+            entities.resize(id + 1);
+
+        SpatialEntity &entity = entities[id];
+        entity.box = boxes[i];
+        entity.active = true;
+        getCellRange(entity.box, entity.minCell, entity.maxCell);
+
+        addToCells(id);
+        numEntities++;
+    }
+}
+
+//
+// update
+// Description:
+//      Moves entities. Entities which stay within the same cells only get their box replaced.
+//      Ids which are not in the hash are ignored.
+// Parameters:
+//      ids   <const int*>: Ids of the entities.
+//      boxes <const BoundingBox*>: New bounding box of every entity.
+//      count <int>: Number of entities.
+// Returns:
+//      None (void).
+//
+void SpatialHash::update(const int *ids, const BoundingBox *boxes, int count) {
+    for (int i = 0; i < count; i++) {
+        int id = ids[i];
+
+        if (!contains(id))
+            continue;
+
+        SpatialEntity &entity = entities[id];
+        entity.box = boxes[i];
+
+        int minCell[3], maxCell[3];
+        getCellRange(entity.box, minCell, maxCell);
+
+        if (minCell[0] == entity.minCell[0] && minCell[1] == entity.minCell[1] && minCell[2] == entity.minCell[2] &&
+            maxCell[0] == entity.maxCell[0] && maxCell[1] == entity.maxCell[1] && maxCell[2] == entity.maxCell[2])
+            continue;
+
+        removeFromCells(id);
+
+        for (int axis = 0; axis < 3; axis++) {
+            entity.minCell[axis] = minCell[axis];
+            entity.maxCell[axis] = maxCell[axis];
+        }
+
+        addToCells(id);
+    }
+    deleteEmptyCells();
+}
+
+//
+// remove
+// Description:
+//      Removes entities. Ids which are not in the hash are ignored.
+// Parameters:
+//      ids   <const int*>: Ids of the entities.
+//      count <int>: Number of entities.
+// Returns:
+//      None (void).
+//
+void SpatialHash::remove(const int *ids, int count) {
+    for (int i = 0; i < count; i++) {
+        int id = ids[i];
+
+        if (!contains(id))
+            continue;
+
+        removeFromCells(id);
+        entities[id].active = false;
+        numEntities--;
+    }
+    deleteEmptyCells();
+}
+
+//
+// clear
+// Description:
+//      Removes all entities.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void SpatialHash::clear(void) {
+    entities.clear();
+    cells.clear();
+    tableKeys.clear();
+    tableCells.clear();
+    numEntities = 0;
+    numEmptyCells = 0;
+}
+
+//
+// queryBox
+// Description:
+//      Finds the entities whose bounding box overlaps a box.
+// Parameters:
+//      box     <const BoundingBox&>: The box.
+//      results <std::vector<int>&>: The ids of the entities are appended to this.
+// Returns:
+//      None (void).
+//
+void SpatialHash::queryBox(const BoundingBox &box, std::vector<int> &results) const {
+    int minCell[3], maxCell[3];
+    getCellRange(box, minCell, maxCell);
+
+    for (int x = minCell[0]; x <= maxCell[0]; x++) {
+        for (int y = minCell[1]; y <= maxCell[1]; y++) {
+            for (int z = minCell[2]; z <= maxCell[2]; z++) {
+                int cell = findCell(x, y, z);
+
+                if (cell < 0)
+                    continue;
+
+                const std::vector<int> &ids = cells[cell].entities;
+
+                for (int i = 0; i < (int)ids.size(); i++) {
+                    const SpatialEntity &entity = entities[ids[i]];
+
+                    // Only report the entity in the first cell it shares with the query
+                    if ((x != minCell[0] && x != entity.minCell[0]) ||
+                        (y != minCell[1] && y != entity.minCell[1]) ||
+                        (z != minCell[2] && z != entity.minCell[2]))
+                        continue;
+
+                    if (boxesOverlap(entity.box, box))
+                        results.push_back(ids[i]);
+                }
+            }
+        }
+    }
+}
+
+//
+// querySphere
+// Description:
+//      Finds the entities whose bounding box overlaps a sphere.
+// Parameters:
+//      center  <const Vector3&>: Center of the sphere.
+//      radius  <float>: Radius of the sphere.
+//      results <std::vector<int>&>: The ids of the entities are appended to this.
+// Returns:
+//      None (void).
+//
+void SpatialHash::querySphere(const Vector3 &center, float radius, std::vector<int> &results) const {
+    BoundingBox box(Vector3(center.x - radius, center.y - radius, center.z - radius),
+                    Vector3(center.x + radius, center.y + radius, center.z + radius));
+
+    int minCell[3], maxCell[3];
+    getCellRange(box, minCell, maxCell);
+
+    for (int x = minCell[0]; x <= maxCell[0]; x++) {
+        for (int y = minCell[1]; y <= maxCell[1]; y++) {
+            for (int z = minCell[2]; z <= maxCell[2]; z++) {
+                int cell = findCell(x, y, z);
+
+                if (cell < 0)
+                    continue;
+
+                const std::vector<int> &ids = cells[cell].entities;
+
+                for (int i = 0; i < (int)ids.size(); i++) {
+                    const SpatialEntity &entity = entities[ids[i]];
+
+                    if ((x != minCell[0] && x != entity.minCell[0]) ||
+                        (y != minCell[1] && y != entity.minCell[1]) ||
+                        (z != minCell[2] && z != entity.minCell[2]))
+                        continue;
+
+                    if (boxSphereOverlap(entity.box, center, radius))
+                        results.push_back(ids[i]);
+                }
+            }
+        }
+    }
+}
+
+//
+// findPairs
+// Description:
+//      Finds every pair of entities whose bounding boxes overlap, the candidates for the
+//      narrow-phase. Every pair is reported once.
+// Parameters:
+//      pairs <std::vector<SpatialPair>&>: The pairs are appended to this.
+// Returns:
+//      None (void).
+//
+void SpatialHash::findPairs(std::vector<SpatialPair> &pairs) const {
+    for (int c = 0; c < (int)cells.size(); c++) {
+        const std::vector<int> &ids = cells[c].entities;
+        int cellCoordinates[3] = {cells[c].x, cells[c].y, cells[c].z};
+
+        for (int a = 0; a < (int)ids.size(); a++) {
+            const SpatialEntity &first = entities[ids[a]];
+
+            for (int b = a + 1; b < (int)ids.size(); b++) {
+                const SpatialEntity &second = entities[ids[b]];
+
+                // Only report the pair in the first cell both entities are in
+                bool firstShared = true;
+
+                for (int axis = 0; axis < 3; axis++) {
+                    int shared = first.minCell[axis] > second.minCell[axis] ? first.minCell[axis] : second.minCell[axis];
+
+                    if (cellCoordinates[axis] != shared)
+                        firstShared = false;
+                }
+
+                if (!firstShared || !boxesOverlap(first.box, second.box))
+                    continue;
+
+                SpatialPair pair;
+                pair.first = ids[a] < ids[b] ? ids[a] : ids[b];
+                pair.second = ids[a] < ids[b] ? ids[b] : ids[a];
+                pairs.push_back(pair);
+            }
+        }
+    }
+}
+
+//
+// contains
+// Description:
+//      Checks if an entity is in the hash.
+// Parameters:
+//      id <int>: Id of the entity.
+// Returns:
+//      <bool>: If the entity is in the hash or not.
+//
+bool SpatialHash::contains(int id) const {
+    return id >= 0 && id < (int)entities.size() && entities[id].active;
+}
+
+//
+// getNumEntities
+// Description:
+//      Getter function for the number of entities in the hash.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: The number of entities.
+//
+int SpatialHash::getNumEntities(void) const {
+    return numEntities;
+}
+
+//
+// getNumCells
+// Description:
+//      Getter function for the number of cells holding at least one entity.
+// Parameters:
+//      None (void).
+// Returns:
+//      <int>: The number of cells.
+//
+int SpatialHash::getNumCells(void) const {
+    return (int)cells.size() - numEmptyCells;
+}
+
+//
+// getCellSize
+// Description:
+//      Getter function for the size of the cells.
+// Parameters:
+//      None (void).
+// Returns:
+//      <float>: The cell size.
+//
+float SpatialHash::getCellSize(void) const {
+    return cellSize;
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// getCellRange
+// Description:
+//      Calculates the range of cells a box overlaps.
+// Parameters:
+//      box     <const BoundingBox&>: The box.
+//      minCell <int*>: Receives the smallest cell coordinates, three values.
+//      maxCell <int*>: Receives the largest cell coordinates, three values.
+// Returns:
+//      None (void).
+//
+void SpatialHash::getCellRange(const BoundingBox &box, int *minCell, int *maxCell) const {
+    minCell[0] = (int)floorf(box.min.x * inverseCellSize);
+    minCell[1] = (int)floorf(box.min.y * inverseCellSize);
+    minCell[2] = (int)floorf(box.min.z * inverseCellSize);
+    maxCell[0] = (int)floorf(box.max.x * inverseCellSize);
+    maxCell[1] = (int)floorf(box.max.y * inverseCellSize);
+    maxCell[2] = (int)floorf(box.max.z * inverseCellSize);
+}
+
+//
+// addToCells
+// Description:
+//      Lists an entity in every cell of its cell range, creating cells as needed.
+// Parameters:
+//      id <int>: Id of the entity.
+// Returns:
+//      None (void).
+//
+void SpatialHash::addToCells(int id) {
+    const SpatialEntity &entity = entities[id];
+
+    for (int x = entity.minCell[0]; x <= entity.maxCell[0]; x++) {
+        for (int y = entity.minCell[1]; y <= entity.maxCell[1]; y++) {
+            for (int z = entity.minCell[2]; z <= entity.maxCell[2]; z++) {
+                SpatialCell &cell = cells[getCell(x, y, z)];
+
+                if (cell.entities.empty())
+                    numEmptyCells--;
+
+                cell.entities.push_back(id);
+            }
+        }
+    }
+}
+
+//
+// removeFromCells
+// Description:
+//      Removes an entity from every cell of its cell range. Cells left empty are kept, see
+//      'deleteEmptyCells'.
+// Parameters:
+//      id <int>: Id of the entity.
+// Returns:
+//      None (void).
+//
+void SpatialHash::removeFromCells(int id) {
+    const SpatialEntity &entity = entities[id];
+
+    for (int x = entity.minCell[0]; x <= entity.maxCell[0]; x++) {
+        for (int y = entity.minCell[1]; y <= entity.maxCell[1]; y++) {
+            for (int z = entity.minCell[2]; z <= entity.maxCell[2]; z++) {
+                int cell = findCell(x, y, z);
+
+                if (cell < 0)
+                    continue;
+
+                std::vector<int> &ids = cells[cell].entities;
+
+                for (int i = 0; i < (int)ids.size(); i++) {
+                    if (ids[i] == id) {
+                        ids[i] = ids.back();
+                        ids.pop_back();
+                        break;
+                    }
+                }
+
+                if (ids.empty())
+                    numEmptyCells++;
+            }
+        }
+    }
+}
+
+//
+// deleteEmptyCells
+// Description:
+//      Deletes the empty cells once they make up half of the cells, and rebuilds the hash table
+//      for the remaining ones.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void SpatialHash::deleteEmptyCells(void) {
+    if (numEmptyCells * 2 < (int)cells.size() || (int)cells.size() < SPATIAL_MIN_TABLE_SIZE)
+        return;
+
+    int numCells = 0;
+
+    for (int c = 0; c < (int)cells.size(); c++) {
+        if (cells[c].entities.empty())
+            continue;
+
+        if (c != numCells) {
+            cells[numCells].x = cells[c].x;
+            cells[numCells].y = cells[c].y;
+            cells[numCells].z = cells[c].z;
+            cells[numCells].entities.swap(cells[c].entities);
+        }
+        numCells++;
+    }
+
+    cells.resize(numCells);
+    numEmptyCells = 0;
+
+    rebuildTable((int)tableKeys.size());
+}
+
+//
+// findCell
+// Description:
+//      Looks up a cell in the hash table.
+// Parameters:
+//      x <int>: Cell x coordinate.
+//      y <int>: Cell y coordinate.
+//      z <int>: Cell z coordinate.
+// Returns:
+//      <int>: Index of the cell, -1 if it does not exist.
+//
+int SpatialHash::findCell(int x, int y, int z) const {
+    if (tableKeys.empty())
+        return -1;
+
+    long long key = getKey(x, y, z);
+    unsigned int mask = (unsigned int)tableKeys.size() - 1;
+
+    for (unsigned int slot = getHash(key) & mask; ; slot = (slot + 1) & mask) {
+        if (tableCells[slot] < 0)
+            return -1;
+
+        if (tableKeys[slot] == key)
+            return tableCells[slot];
+    }
+}
+
+//
+// getCell
+// Description:
+//      Looks up a cell in the hash table, creating an empty cell if it does not exist.
+// Parameters:
+//      x <int>: Cell x coordinate.
+//      y <int>: Cell y coordinate.
+//      z <int>: Cell z coordinate.
+// Returns:
+//      <int>: Index of the cell.
+//
+int SpatialHash::getCell(int x, int y, int z) {
+    // Keep the table at most half full so probe sequences stay short
+    if ((int)(cells.size() + 1) * 2 > (int)tableKeys.size())
+        rebuildTable((int)tableKeys.size() * 2);
+
+    long long key = getKey(x, y, z);
+    unsigned int mask = (unsigned int)tableKeys.size() - 1;
+    unsigned int slot = getHash(key) & mask;
+
+    for (; tableCells[slot] >= 0; slot = (slot + 1) & mask) {
+        if (tableKeys[slot] == key)
+            return tableCells[slot];
+    }
+
+    SpatialCell cell;
+    cell.x = x;
+    cell.y = y;
+    cell.z = z;
+    cells.push_back(cell);
+    numEmptyCells++;
+
+    tableKeys[slot] = key;
+    tableCells[slot] = (int)cells.size() - 1;
+
+    return tableCells[slot];
+}
+
+//
+// rebuildTable
+// Description:
+//      Reinserts every cell into a new hash table.
+// Parameters:
+//      capacity <int>: Number of slots, rounded up to a power of two big enough for the cells.
+// Returns:
+//      None (void).
+//
+void SpatialHash::rebuildTable(int capacity) {
+    int size = SPATIAL_MIN_TABLE_SIZE;
+
+    while (size < capacity || size < (int)cells.size() * 2 + 2)
+        size *= 2;
+
+    tableKeys.assign(size, 0);
+    tableCells.assign(size, -1);
+
+    unsigned int mask = (unsigned int)size - 1;
+
+    for (int c = 0; c < (int)cells.size(); c++) {
+        long long key = getKey(cells[c].x, cells[c].y, cells[c].z);
+        unsigned int slot = getHash(key) & mask;
+
+        while (tableCells[slot] >= 0)
+            slot = (slot + 1) & mask;
+
+        tableKeys[slot] = key;
+        tableCells[slot] = c;
+    }
+}
+
+//
+// getKey
+// Description:
+//      Packs cell coordinates into a hash key, 21 bits per axis.
+// Parameters:
+//      x <int>: Cell x coordinate.
+//      y <int>: Cell y coordinate.
+//      z <int>: Cell z coordinate.
+// Returns:
+//      <long long>: The key.
+//
+long long SpatialHash::getKey(int x, int y, int z) {
+    return (long long)(((unsigned long long)(x & 0x1fffff) << 42) |
+                       ((unsigned long long)(y & 0x1fffff) << 21) |
+                       (unsigned long long)(z & 0x1fffff));
+}
+
+//
+// getHash
+// Description:
+//      Mixes the bits of a cell key so that neighbouring cells spread over the hash table.
+// Parameters:
+//      key <long long>: The key.
+// Returns:
+//      <unsigned int>: The hash.
+//
+unsigned int SpatialHash::getHash(long long key) {
+    return (unsigned int)(((unsigned long long)key * 0x9e3779b97f4a7c15ULL) >> 32);
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// boxesOverlap
+// Description:
+//      Checks if two boxes overlap, touching counts as overlapping.
+// Parameters:
+//      a <const BoundingBox&>: First box.
+//      b <const BoundingBox&>: Second box.
+// Returns:
+//      <bool>: If the boxes overlap or not.
+//
+static bool boxesOverlap(const BoundingBox &a, const BoundingBox &b) {
+    return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+           a.min.y <= b.max.y && a.max.y >= b.min.y &&
+           a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+//
+// boxSphereOverlap
+// Description:
+//      Checks if a box and a sphere overlap by measuring the distance from the sphere center
+//      to the closest point in the box.
+// Parameters:
+//      box    <const BoundingBox&>: The box.
+//      center <const Vector3&>: Center of the sphere.
+//      radius <float>: Radius of the sphere.
+// Returns:
+//      <bool>: If the box and the sphere overlap or not.
+//
+static bool boxSphereOverlap(const BoundingBox &box, const Vector3 &center, float radius) {
+    float dx = center.x < box.min.x ? box.min.x - center.x : (center.x > box.max.x ? center.x - box.max.x : 0.0f);
+    float dy = center.y < box.min.y ? box.min.y - center.y : (center.y > box.max.y ? center.y - box.max.y : 0.0f);
+    float dz = center.z < box.min.z ? box.min.z - center.z : (center.z > box.max.z ? center.z - box.max.z : 0.0f);
+
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
@@ -0,0 +1,219 @@
+// TangentGenerator.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/TangentGenerator.h"
+#include "../include/CompiledMesh.h"
+#include "../include/Parallel.h"
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// normalize3
+// Description:
+//      Normalizes a 3 component vector in place.
+// Parameters:
+//      v <float*>: The vector.
+// Returns:
+//      <bool>: False if the vector has zero length and was left unchanged.
+//
+static bool normalize3(float *v) {
+    float length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+    if (length <= 1e-20f)
+        return false;
+
+    v[0] /= length;
+    v[1] /= length;
+    v[2] /= length;
+    return true;
+}
+
+//
+// cornerAngle
+// Description:
+//      Angle of a triangle at the corner 'p' between the edges towards 'a' and 'b'.
+// Parameters:
+//      p, a, b <const float*>: Corner positions.
+// Returns:
+//      <float>: The angle in radians.
+//
+static float cornerAngle(const float *p, const float *a, const float *b) {
+    float e0[3] = {a[0] - p[0], a[1] - p[1], a[2] - p[2]};
+    float e1[3] = {b[0] - p[0], b[1] - p[1], b[2] - p[2]};
+
+    if (!normalize3(e0) || !normalize3(e1))
+        return 0.0f;
+
+    float cosine = e0[0] * e1[0] + e0[1] * e1[1] + e0[2] * e1[2];
+    return acosf(fminf(fmaxf(cosine, -1.0f), 1.0f));
+}
+
+//
+// generateRange
+// Description:
+//      Generates the tangents of one compiled range.
+// Parameters:
+//      mesh     <CompiledMesh&>: The compiled mesh.
+//      group    <const CompiledGroup&>: The range, with 'firstTangent' assigned.
+//      vertices <const CompiledVertex*>: The full precision vertices of the range, from 'firstVertex'.
+// Returns:
+//      None (void).
+//
+static void generateRange(CompiledMesh &mesh, const CompiledGroup &group, const CompiledVertex *vertices) {
+    std::vector<float> sums(group.vertexCount * 6, 0.0f); // tangent, bitangent
+
+    for (int i = group.firstIndex; i + 2 < group.firstIndex + group.indexCount; i += 3) {
+        int corners[3] = {(int)mesh.indices[i], (int)mesh.indices[i + 1], (int)mesh.indices[i + 2]};
+
+        const CompiledVertex &v0 = vertices[corners[0] - group.firstVertex];
+        const CompiledVertex &v1 = vertices[corners[1] - group.firstVertex];
+        const CompiledVertex &v2 = vertices[corners[2] - group.firstVertex];
+
+        float e1[3] = {v1.position[0] - v0.position[0], v1.position[1] - v0.position[1], v1.position[2] - v0.position[2]};
+        float e2[3] = {v2.position[0] - v0.position[0], v2.position[1] - v0.position[1], v2.position[2] - v0.position[2]};
+
+        float s1 = v1.uv[0] - v0.uv[0];
+        float t1 = v1.uv[1] - v0.uv[1];
+        float s2 = v2.uv[0] - v0.uv[0];
+        float t2 = v2.uv[1] - v0.uv[1];
+
+        float determinant = s1 * t2 - s2 * t1;
+
+        if (fabsf(determinant) <= 1e-20f) // degenerate texture mapping
+            continue;
+
+        // Only the direction is used, the sign of the determinant keeps the orientation
+        float sign = determinant > 0.0f ? 1.0f : -1.0f;
+
+        float tangent[3] = {(e1[0] * t2 - e2[0] * t1) * sign, (e1[1] * t2 - e2[1] * t1) * sign, (e1[2] * t2 - e2[2] * t1) * sign};
+        float bitangent[3] = {(e2[0] * s1 - e1[0] * s2) * sign, (e2[1] * s1 - e1[1] * s2) * sign, (e2[2] * s1 - e1[2] * s2) * sign};
+
+        if (!normalize3(tangent) || !normalize3(bitangent))
+            continue;
+
+        const float *positions[3] = {v0.position, v1.position, v2.position};
+
+        for (int c = 0; c < 3; c++) {
+            float angle = cornerAngle(positions[c], positions[(c + 1) % 3], positions[(c + 2) % 3]);
+            float *sum = &sums[(corners[c] - group.firstVertex) * 6];
+
+            sum[0] += tangent[0] * angle;
+            sum[1] += tangent[1] * angle;
+            sum[2] += tangent[2] * angle;
+            sum[3] += bitangent[0] * angle;
+            sum[4] += bitangent[1] * angle;
+            sum[5] += bitangent[2] * angle;
+        }
+    }
+
+    for (int v = 0; v < group.vertexCount; v++) {
+        const float *normal = vertices[v].normal;
+        const float *sum = &sums[v * 6];
+        float *out = mesh.tangents[group.firstTangent + v].tangent;
+
+        // Gram-Schmidt against the normal
+        float dot = normal[0] * sum[0] + normal[1] * sum[1] + normal[2] * sum[2];
+        float tangent[3] = {sum[0] - normal[0] * dot, sum[1] - normal[1] * dot, sum[2] - normal[2] * dot};
+
+        if (!normalize3(tangent)) {
+            // No usable texture mapping, any direction perpendicular to the normal will do
+            float axis[3] = {0.0f, 0.0f, 0.0f};
+            axis[fabsf(normal[0]) < 0.9f ? 0 : 1] = 1.0f;
+
+            dot = normal[0] * axis[0] + normal[1] * axis[1] + normal[2] * axis[2];
+            tangent[0] = axis[0] - normal[0] * dot;
+            tangent[1] = axis[1] - normal[1] * dot;
+            tangent[2] = axis[2] - normal[2] * dot;
+
+            if (!normalize3(tangent)) {
+                tangent[0] = 1.0f;
+                tangent[1] = 0.0f;
+                tangent[2] = 0.0f;
+            }
+        }
+
+        float cross[3] = {normal[1] * tangent[2] - normal[2] * tangent[1],
+                          normal[2] * tangent[0] - normal[0] * tangent[2],
+                          normal[0] * tangent[1] - normal[1] * tangent[0]};
+
+        out[0] = tangent[0];
+        out[1] = tangent[1];
+        out[2] = tangent[2];
+        out[3] = (cross[0] * sum[3] + cross[1] * sum[4] + cross[2] * sum[5]) < 0.0f ? -1.0f : 1.0f;
+    }
+}
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// generate
+// Description:
+//      Assigns a tangent range to every compiled range with a bump mapped material and fills it.
+//      Other ranges keep 'firstTangent' at -1. CompiledMesh::compile calls it on the full precision
+//      stream, before quantizing. A quantized mesh is not converted: the vertices of each range are
+//      decoded into a copy, so the stream and its quantization report stay as they are.
+// Parameters:
+//      mesh      <CompiledMesh&>: The compiled mesh.
+//      materials <std::vector<Material *>&>: The materials the ranges refer to.
+// Returns:
+//      None (void).
+//
+void TangentGenerator::generate(CompiledMesh &mesh, std::vector<Material *> &materials) {
+    std::vector<int> bumpGroups;
+    int numTangents = 0;
+
+    mesh.tangents.clear();
+
+    for (int g = 0; g < (int)mesh.groups.size(); g++) {
+        CompiledGroup &group = mesh.groups[g];
+        group.firstTangent = -1;
+
+        if (group.materialIndex < 0 || group.materialIndex >= (int)materials.size())
+            continue;
+
+        if (materials[group.materialIndex]->bumpMap == NULL)
+            continue;
+
+        group.firstTangent = numTangents;
+        numTangents += group.vertexCount;
+        bumpGroups.push_back(g);
+    }
+
+    if (bumpGroups.empty())
+        return;
+
+    bool quantized = mesh.getFormat() == VERTEX_FORMAT_QUANTIZED;
+
+    mesh.tangents.resize(numTangents);
+
+    Parallel::forRange(0, (int)bumpGroups.size(), [&](int first, int last) {
+        std::vector<CompiledVertex> decoded;
+
+        for (int b = first; b < last; b++) {
+            const CompiledGroup &group = mesh.groups[bumpGroups[b]];
+
+            if (group.vertexCount == 0)
+                continue;
+
+            if (!quantized) {
+                generateRange(mesh, group, &mesh.vertices[group.firstVertex]);
+                continue;
+            }
+
+            decoded.resize(group.vertexCount);
+
+            for (int v = 0; v < group.vertexCount; v++)
+                mesh.decodeVertex(group.firstVertex + v, decoded[v]);
+
+            generateRange(mesh, group, &decoded[0]);
+        }
+    }, 1);
+}
@@ -1,11 +1,13 @@
 // Texture.cpp
 // Created by Edward Glöckner 2023-06-29.
-// Last modified: 2023-08-08.
+// Last modified: 2026-10-17.
 
 //*********************************************************************************
 // Headers
 //*********************************************************************************
 #include "../include/Texture.h"
+#include "../include/RenderBackend.h"
+#include "../include/Profiler.h"
 
 //*********************************************************************************
 // Globals
@@ -53,12 +55,11 @@ Texture::~Texture() {
     for (std::vector<Texture *>::iterator it = textures.begin(); it != textures.end(); it++) {
         if ((*it) == this) {
             textures.erase(it);
+            break;
         }
     }
 
-    if (imageData) {
-        delete imageData;
-    }
+    MemoryTracker::deallocate(imageData);
 }
 
 //*********************************************************************************
@@ -81,6 +82,8 @@ Texture::~Texture() {
 //      bool: True if the TGA image was successfully loaded and the OpenGL texture was created, false otherwise.
 //
 bool Texture::loadTGA(std::string filename) {
+    PROFILE_SCOPE("Texture::loadTGA");
+
     TGA_Header TGAheader;
 
     std::ifstream file(filename.data(), std::ios_base::binary);
@@ -114,14 +117,15 @@ bool Texture::loadTGA(std::string filename) {
     GLuint bytesPerPixel = bpp / 8;
     GLuint imageSize = width * height * bytesPerPixel;
 
-    imageData = new GLubyte[imageSize];
+    imageData = MemoryTracker::allocateArray<GLubyte>(imageSize, MEMORY_TEXTURE);
 
     if (imageData == NULL) { // out of memory
         return false;
     }
 
     if (!file.read((char*)imageData, imageSize)) {
-        delete imageData;
+        MemoryTracker::deallocate(imageData);
+        imageData = NULL;
         return false;
     }
     
@@ -153,11 +157,13 @@ bool Texture::loadTGA(std::string filename) {
 //      <bool>: True if the OpenGL texture was successfully created, false otherwise.
 //
 bool Texture::createTexture(unsigned char* imageData, int width, int height, int type) {
-    glGenTextures(1, &texID);
-    glBindTexture(GL_TEXTURE_2D, texID);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexImage2D(GL_TEXTURE_2D, 0, type, width, height, 0, type, GL_UNSIGNED_BYTE, imageData);
+    RenderBackend *backend = RenderBackend::get();
+
+    texID = backend->createTexture();
+    backend->bindTexture(GL_TEXTURE_2D, texID);
+    backend->setTextureParameter(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    backend->setTextureParameter(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    backend->uploadTexture(GL_TEXTURE_2D, 0, type, width, height, type, GL_UNSIGNED_BYTE, imageData);
     return true;
 }
 
@@ -0,0 +1,373 @@
+// TransparencySorter.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include "../include/TransparencySorter.h"
+#include "../include/RenderBackend.h"
+#include <math.h>
+#include <chrono>
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const int TRANSPARENT_RADIX_BITS = 11;
+static const int TRANSPARENT_RADIX_SIZE = 1 << TRANSPARENT_RADIX_BITS;
+static const int TRANSPARENT_RADIX_PASSES = 3;
+static const int TRANSPARENT_MAX_MOVES = 8; // Moves per face an insertion sort may take before giving up
+
+//*********************************************************************************
+// Public class functions
+//*********************************************************************************
+
+//
+// TransparencySorter
+// Description:
+//      Constructor.
+//      Creates a sorter without faces.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+TransparencySorter::TransparencySorter() {
+    model = NULL;
+    incrementalDistance = 0.5f;
+
+    clear();
+}
+
+//
+// build
+// Description:
+//      Collects the transparent faces of a model. Build again when the model is reloaded.
+// Parameters:
+//      in_model <Model&>: The model.
+// Returns:
+//      None (void).
+//
+void TransparencySorter::build(Model &in_model) {
+    clear();
+    model = &in_model;
+
+    std::vector<GroupObject *> &objects = model->getObjects();
+    int batchIndex = 0;
+
+    for (int i = 0; i < (int)objects.size(); i++) {
+        GroupObject *object = objects[i];
+
+        for (int b = 0; b < (int)object->batches.size(); b++, batchIndex++) {
+            FaceBatch &batch = object->batches[b];
+
+            if (batch.material == NULL || batch.material->alpha >= 1.0f)
+                continue;
+
+            for (int f = batch.firstFace; f < batch.firstFace + batch.numFaces; f++) {
+                Face *face = object->faces[f];
+
+                faces.push_back(face);
+                faceObjects.push_back(i);
+                faceBatches.push_back(batchIndex);
+                centers.push_back(face->faceCenter.x);
+                centers.push_back(face->faceCenter.y);
+                centers.push_back(face->faceCenter.z);
+            }
+        }
+    }
+
+    keys.resize(faces.size());
+
+    for (int i = 0; i < (int)keys.size(); i++) {
+        keys[i].key = 0;
+        keys[i].face = i;
+    }
+
+    stats.numFaces = (int)faces.size();
+    built = true;
+}
+
+//
+// clear
+// Description:
+//      Removes the faces, the sorter has to be built again before it is used.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void TransparencySorter::clear(void) {
+    faces.clear();
+    faceObjects.clear();
+    faceBatches.clear();
+    centers.clear();
+    keys.clear();
+    sortBuffer.clear();
+
+    lastViewPoint = Vector3(0.0f, 0.0f, 0.0f);
+    adaptiveDistance = incrementalDistance;
+    built = false;
+
+    stats = TransparencyStats();
+}
+
+//
+// isBuilt
+// Description:
+//      Checks if the faces of a model have been collected.
+// Parameters:
+//      None (void).
+// Returns:
+//      built <bool>: If 'build' was called since the last 'clear'.
+//
+bool TransparencySorter::isBuilt(void) const {
+    return built;
+}
+
+//
+// sort
+// Description:
+//      Orders the faces back to front as seen from a view point.
+// Parameters:
+//      viewPoint <const Vector3&>: Position of the camera, in model space.
+// Returns:
+//      None (void).
+//
+void TransparencySorter::sort(const Vector3 &viewPoint) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    float dx = viewPoint.x - lastViewPoint.x;
+    float dy = viewPoint.y - lastViewPoint.y;
+    float dz = viewPoint.z - lastViewPoint.z;
+    float move = sqrtf(dx * dx + dy * dy + dz * dz);
+
+    computeKeys(viewPoint);
+
+    stats.moves = 0;
+
+    bool sorted = false;
+
+    if (stats.fullSorts > 0 && move <= incrementalDistance && move <= adaptiveDistance) {
+        sorted = insertionSort();
+
+        // Dense scenes reorder many faces for a small move, only try moves half as long from now on.
+        // The number of moves grows about linearly with the distance, so a sort well within the limit
+        // lets the distance grow back towards the incremental distance.
+        if (!sorted)
+            adaptiveDistance = move * 0.5f;
+        else if (stats.moves < (int)keys.size() / 2)
+            adaptiveDistance = fminf(incrementalDistance, fmaxf(adaptiveDistance, move * 4.0f));
+    }
+
+    if (sorted) {
+        stats.incrementalSorts++;
+    }
+    else {
+        radixSort();
+        stats.fullSorts++;
+    }
+
+    lastViewPoint = viewPoint;
+
+    stats.sortTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// draw
+// Description:
+//      Draws the faces in the order of the last sort, setting the material only when it changes.
+// Parameters:
+//      objectVisible <const unsigned char*>: Visibility of the group objects, NULL draws all.
+//      batchVisible  <const unsigned char*>: Visibility of the face batches, NULL draws all.
+// Returns:
+//      None (void).
+//
+void TransparencySorter::draw(const unsigned char *objectVisible, const unsigned char *batchVisible) {
+    stats.numDrawn = 0;
+
+    if (model == NULL)
+        return;
+
+    Material *currentMaterial = NULL;
+
+    for (int i = 0; i < (int)keys.size(); i++) {
+        int face = keys[i].face;
+
+        if ((objectVisible != NULL && !objectVisible[faceObjects[face]]) ||
+            (batchVisible != NULL && !batchVisible[faceBatches[face]]))
+            continue;
+
+        if (faces[face]->material != currentMaterial || stats.numDrawn == 0) {
+            currentMaterial = faces[face]->material;
+            model->applyMaterial(currentMaterial);
+        }
+
+        model->drawFace(*faces[face]);
+        stats.numDrawn++;
+    }
+    RenderBackend::get()->disable(GL_TEXTURE_2D);
+}
+
+//
+// setIncrementalDistance
+// Description:
+//      Sets how far the view point may move between two sorts for the insertion sort to be tried.
+// Parameters:
+//      value <float>: The distance, 0 only keeps the order when the view point did not move.
+// Returns:
+//      None (void).
+//
+void TransparencySorter::setIncrementalDistance(float value) {
+    incrementalDistance = value;
+    adaptiveDistance = value;
+}
+
+//
+// getOrder
+// Description:
+//      Getter function for the faces in the order of the last sort.
+// Parameters:
+//      None (void).
+// Returns:
+//      <const TransparentKey*>: One key per face, the 'face' member indexes 'getFace'.
+//
+const TransparentKey *TransparencySorter::getOrder(void) const {
+    return keys.empty() ? NULL : &keys[0];
+}
+
+//
+// getFace
+// Description:
+//      Getter function for a transparent face.
+// Parameters:
+//      index <int>: Index of the face, in the order of 'build'.
+// Returns:
+//      <Face*>: The face.
+//
+Face *TransparencySorter::getFace(int index) const {
+    return faces[index];
+}
+
+//
+// getStats
+// Description:
+//      Getter function for the statistics of the sorter.
+// Parameters:
+//      None (void).
+// Returns:
+//      stats <const TransparencyStats&>: Face counts, sort counts and timing.
+//
+const TransparencyStats &TransparencySorter::getStats(void) const {
+    return stats;
+}
+
+//*********************************************************************************
+// Private class functions
+//*********************************************************************************
+
+//
+// computeKeys
+// Description:
+//      Computes the keys of the faces for a view point, keeping the order of the last sort.
+//      Squared distances are never negative, so their bits are ordered like the floats, and
+//      inverting them puts the farthest face first.
+// Parameters:
+//      viewPoint <const Vector3&>: Position of the camera.
+// Returns:
+//      None (void).
+//
+void TransparencySorter::computeKeys(const Vector3 &viewPoint) {
+    for (int i = 0; i < (int)keys.size(); i++) {
+        const float *center = &centers[keys[i].face * 3];
+
+        float dx = center[0] - viewPoint.x;
+        float dy = center[1] - viewPoint.y;
+        float dz = center[2] - viewPoint.z;
+        float distance = dx * dx + dy * dy + dz * dz;
+
+        unsigned int bits;
+        std::memcpy(&bits, &distance, sizeof(bits));
+        keys[i].key = ~bits;
+    }
+}
+
+//
+// radixSort
+// Description:
+//      Sorts the keys in three passes of 11 bits, counting all three histograms in one read.
+// Parameters:
+//      None (void).
+// Returns:
+//      None (void).
+//
+void TransparencySorter::radixSort(void) {
+    int count = (int)keys.size();
+
+    if (count < 2)
+        return;
+
+    std::vector<int> histograms(TRANSPARENT_RADIX_PASSES * TRANSPARENT_RADIX_SIZE, 0);
+    sortBuffer.resize(count);
+
+    for (int i = 0; i < count; i++) {
+        unsigned int key = keys[i].key;
+
+        for (int pass = 0; pass < TRANSPARENT_RADIX_PASSES; pass++)
+            histograms[pass * TRANSPARENT_RADIX_SIZE + ((key >> (pass * TRANSPARENT_RADIX_BITS)) & (TRANSPARENT_RADIX_SIZE - 1))]++;
+    }
+
+    for (int pass = 0; pass < TRANSPARENT_RADIX_PASSES; pass++) {
+        int *histogram = &histograms[pass * TRANSPARENT_RADIX_SIZE];
+        int shift = pass * TRANSPARENT_RADIX_BITS;
+
+        int offset = 0;
+        for (int b = 0; b < TRANSPARENT_RADIX_SIZE; b++) {
+            int size = histogram[b];
+            histogram[b] = offset;
+            offset += size;
+        }
+
+        for (int i = 0; i < count; i++)
+            sortBuffer[histogram[(keys[i].key >> shift) & (TRANSPARENT_RADIX_SIZE - 1)]++] = keys[i];
+
+        keys.swap(sortBuffer);
+    }
+}
+
+//
+// insertionSort
+// Description:
+//      Sorts nearly sorted keys by moving every key back until it is in place. Stops when the
+//      keys are further from sorted than expected after a small camera move.
+// Parameters:
+//      None (void).
+// Returns:
+//      <bool>: If the keys are sorted, false if the sort gave up.
+//
+bool TransparencySorter::insertionSort(void) {
+    int count = (int)keys.size();
+    long long maxMoves = (long long)count * TRANSPARENT_MAX_MOVES;
+    long long moves = 0;
+
+    for (int i = 1; i < count; i++) {
+        TransparentKey key = keys[i];
+        int j = i - 1;
+
+        while (j >= 0 && keys[j].key > key.key) {
+            keys[j + 1] = keys[j];
+            j--;
+        }
+
+        keys[j + 1] = key;
+        moves += i - 1 - j;
+
+        if (moves > maxMoves) {
+            stats.moves = (int)moves;
+            return false;
+        }
+    }
+
+    stats.moves = (int)moves;
+    return true;
+}
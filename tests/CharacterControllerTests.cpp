@@ -0,0 +1,432 @@
+// CharacterControllerTests.cpp
+// Created by Edward Glöckner 2026-10-17.
+// Last modified: 2026-10-17.
+
+// Deterministic tests of the character controller against fixed level pieces: two stairs of 0.2 units, a ramp
+// of 26.6 degrees and an inside corner of two walls on a floor. Each piece is written as an OBJ file, loaded into
+// a Model and a BVH, then capsule sweeps are checked for their time of impact, contact normal, face normal and
+// slide, and moves for the grounded flag and the height they step up. The expected values follow from the
+// geometry. The first argument is the directory the meshes are written to, the working directory by default.
+
+//*********************************************************************************
+// Headers
+//*********************************************************************************
+#include <math.h>
+#include <stdio.h>
+#include <fstream>
+#include <string>
+#include "../include/BVH.h"
+#include "../include/CharacterController.h"
+#include "../include/Model.h"
+
+//*********************************************************************************
+// Globals
+//*********************************************************************************
+static const float TEST_TOLERANCE = 1e-3f;
+static const float TEST_RADIUS = 0.25f;
+static const float TEST_THIN_RADIUS = 0.1f; // Below the risers, so they are not rolled over
+static const float TEST_SKIN = 0.01f;  // Default skin width of the controller
+
+// Floor up to x = 0, a step of 0.2 from x = 0 to 1 and a second one from x = 1 on, all from z = -2 to 2
+static const char *STAIRS_OBJ =
+    "v -3 0 -2\nv 0 0 -2\nv 0 0 2\nv -3 0 2\n"
+    "v 0 0.2 -2\nv 1 0.2 -2\nv 1 0.2 2\nv 0 0.2 2\n"
+    "v 1 0.4 -2\nv 4 0.4 -2\nv 4 0.4 2\nv 1 0.4 2\n"
+    "g floor\nf 1 4 3 2\n"
+    "g riser0\nf 2 3 8 5\n"
+    "g tread0\nf 5 8 7 6\n"
+    "g riser1\nf 6 7 12 9\n"
+    "g tread1\nf 9 12 11 10\n";
+
+// Floor up to x = 0, then a ramp rising 2 units over 4, from z = -2 to 2
+static const char *RAMP_OBJ =
+    "v -3 0 -2\nv 0 0 -2\nv 0 0 2\nv -3 0 2\n"
+    "v 4 2 -2\nv 4 2 2\n"
+    "g floor\nf 1 4 3 2\n"
+    "g ramp\nf 2 3 6 5\n";
+
+// Floor from -3 to 1 on x and z, closed by a wall at x = 1 and a wall at z = 1, both 2 units high
+static const char *CORNER_OBJ =
+    "v -3 0 -3\nv 1 0 -3\nv 1 0 1\nv -3 0 1\n"
+    "v 1 2 -3\nv 1 2 1\nv -3 2 1\n"
+    "g floor\nf 1 4 3 2\n"
+    "g wallx\nf 2 3 6 5\n"
+    "g wallz\nf 3 4 7 6\n";
+
+static int numChecks = 0;
+static int numFailures = 0;
+
+static bool loadLevel(const std::string &directory, const std::string &name, const char *contents, Model &model,
+                      BVH &bvh);
+static Capsule standing(float x, float bottom, float z, float radius = TEST_RADIUS);
+static void check(bool condition, const char *test, const char *what);
+static void checkNear(float value, float expected, const char *test, const char *what);
+static void checkVector(const Vector3 &value, const Vector3 &expected, const char *test, const char *what);
+static void checkFace(const CapsuleHit &hit, const Vector3 &expected, const char *test);
+static Vector3 expectedSlide(const Vector3 &displacement, float time, const Vector3 &normal);
+
+static void testStairs(const std::string &directory);
+static void testRamp(const std::string &directory);
+static void testCorner(const std::string &directory);
+
+//*********************************************************************************
+// Main
+//*********************************************************************************
+int main(int argc, char **argv) {
+    std::string directory = argc > 1 ? std::string(argv[1]) + "/" : std::string();
+
+    testStairs(directory);
+    testRamp(directory);
+    testCorner(directory);
+
+    printf("%d checks, %d failed\n", numChecks, numFailures);
+
+    return numFailures > 0 ? 1 : 0;
+}
+
+//*********************************************************************************
+// Tests
+//*********************************************************************************
+
+//
+// testStairs
+// Description:
+//      Lands on the first step, runs into the edge of its riser, and walks a thin capsule against the riser
+//      and up the stairs with the default step height and a step height lower than the risers. A capsule
+//      whose radius is above a riser rolls over its edge whatever the step height.
+// Parameters:
+//      directory <const std::string&>: Where the mesh is written.
+// Returns:
+//      None (void).
+//
+static void testStairs(const std::string &directory) {
+    Model model;
+    BVH bvh;
+
+    if (!loadLevel(directory, "stairs.obj", STAIRS_OBJ, model, bvh)) {
+        check(false, "stairs", "load");
+        return;
+    }
+
+    CharacterController controller(bvh);
+    CapsuleHit hit;
+
+    // Falling onto the first tread, the bottom sphere touches it 0.55 units down
+    Capsule capsule = standing(0.5f, 0.75f, 0.0f);
+    Vector3 displacement(0.0f, -1.0f, 0.0f);
+
+    check(controller.sweepCapsule(capsule, displacement, hit), "stairs land", "hit");
+    checkNear(hit.time, 0.55f, "stairs land", "time");
+    checkFace(hit, Vector3(0.0f, 1.0f, 0.0f), "stairs land");
+    checkVector(hit.normal, hit.faceNormal, "stairs land", "normal");
+    checkVector(hit.slide, Vector3(0.0f, 0.0f, 0.0f), "stairs land", "slide");
+    check(hit.face == model.getObjects()[3]->faces[0], "stairs land", "face");
+
+    // Walking into the riser, which is lower than the radius, touches its top edge at a height of 0.2. The
+    // riser faces the move so it is reported, and the contact normal points from the edge to the sphere center.
+    capsule = standing(-1.0f, 0.01f, 0.0f);
+    displacement = Vector3(2.0f, 0.0f, 0.0f);
+
+    float height = TEST_RADIUS + 0.01f - 0.2f;
+    float reach = sqrtf(TEST_RADIUS * TEST_RADIUS - height * height);
+    float time = (1.0f - reach) / 2.0f;
+    Vector3 normal(-reach / TEST_RADIUS, height / TEST_RADIUS, 0.0f);
+
+    check(controller.sweepCapsule(capsule, displacement, hit), "stairs edge", "hit");
+    checkNear(hit.time, time, "stairs edge", "time");
+    checkFace(hit, Vector3(-1.0f, 0.0f, 0.0f), "stairs edge");
+    checkVector(hit.normal, normal, "stairs edge", "normal");
+    checkVector(hit.slide, expectedSlide(displacement, time, normal), "stairs edge", "slide");
+    check(hit.face == model.getObjects()[2]->faces[0], "stairs edge", "face");
+
+    // A thin capsule walking into the riser touches its face, 0.1 units before it
+    capsule = standing(-1.0f, TEST_SKIN, 0.0f, TEST_THIN_RADIUS);
+
+    check(controller.sweepCapsule(capsule, displacement, hit), "stairs riser", "hit");
+    checkNear(hit.time, (1.0f - TEST_THIN_RADIUS) / 2.0f, "stairs riser", "time");
+    checkFace(hit, Vector3(-1.0f, 0.0f, 0.0f), "stairs riser");
+    checkVector(hit.normal, hit.faceNormal, "stairs riser", "normal");
+    checkVector(hit.slide, Vector3(0.0f, 0.0f, 0.0f), "stairs riser", "slide");
+
+    // Walking with gravity steps onto the first tread
+    bool grounded = false;
+    capsule = standing(-0.5f, TEST_SKIN, 0.0f, TEST_THIN_RADIUS);
+    Vector3 moved = controller.move(capsule, Vector3(0.8f, -0.05f, 0.0f), &grounded);
+
+    check(grounded, "stairs step", "grounded");
+    checkNear(moved.y, 0.2f, "stairs step", "rise");
+    check(moved.x > 0.7f, "stairs step", "forward");
+
+    // A step height below the risers stops the capsule on the floor in front of the first one
+    controller.setStepHeight(0.1f);
+    moved = controller.move(capsule, Vector3(0.8f, -0.05f, 0.0f), &grounded);
+    float end = capsule.point0.x + moved.x;
+
+    check(grounded, "stairs blocked", "grounded");
+    check(fabsf(moved.y) <= TEST_SKIN, "stairs blocked", "rise");
+    check(end > -TEST_THIN_RADIUS - 2.0f * TEST_SKIN && end < -TEST_THIN_RADIUS, "stairs blocked", "against the riser");
+}
+
+//
+// testRamp
+// Description:
+//      Lands on the ramp, walks up it, and walks on it with a maximum slope below its angle.
+// Parameters:
+//      directory <const std::string&>: Where the mesh is written.
+// Returns:
+//      None (void).
+//
+static void testRamp(const std::string &directory) {
+    Model model;
+    BVH bvh;
+
+    if (!loadLevel(directory, "ramp.obj", RAMP_OBJ, model, bvh)) {
+        check(false, "ramp", "load");
+        return;
+    }
+
+    CharacterController controller(bvh);
+    CapsuleHit hit;
+
+    // The ramp surface is at y = x / 2, the sphere touches it when its center is the radius off the plane
+    float length = sqrtf(5.0f);
+    Vector3 normal(-1.0f / length, 2.0f / length, 0.0f);
+
+    Capsule capsule(Vector3(2.0f, 2.0f, 0.0f), Vector3(2.0f, 3.0f, 0.0f), TEST_RADIUS);
+    Vector3 displacement(0.0f, -1.0f, 0.0f);
+    float time = 2.0f - (1.0f + TEST_RADIUS * length / 2.0f);
+
+    check(controller.sweepCapsule(capsule, displacement, hit), "ramp land", "hit");
+    checkNear(hit.time, time, "ramp land", "time");
+    checkFace(hit, normal, "ramp land");
+    checkVector(hit.normal, hit.faceNormal, "ramp land", "normal");
+    checkVector(hit.slide, expectedSlide(displacement, time, normal), "ramp land", "slide");
+    check(hit.slide.x < 0.0f && hit.slide.y < 0.0f, "ramp land", "slide down the ramp");
+    check(hit.face == model.getObjects()[2]->faces[0], "ramp land", "face");
+
+    // Walking up the ramp with gravity keeps the capsule on it, rising half as much as it moves forward
+    bool grounded = false;
+    Vector3 start(1.0f, 0.5f + TEST_RADIUS * length / 2.0f + TEST_SKIN, 0.0f);
+    capsule = Capsule(start, Vector3(start.x, start.y + 1.0f, start.z), TEST_RADIUS);
+    Vector3 moved = controller.move(capsule, Vector3(1.0f, -0.1f, 0.0f), &grounded);
+
+    check(grounded, "ramp walk", "grounded");
+    check(moved.x > 0.5f, "ramp walk", "forward");
+    check(fabsf(moved.y - moved.x / 2.0f) < TEST_SKIN, "ramp walk", "rise");
+
+    // Slopes steeper than the maximum are not ground and cannot be stepped onto
+    controller.setMaxSlope(20.0f);
+    moved = controller.move(capsule, Vector3(1.0f, -0.1f, 0.0f), &grounded);
+
+    check(!grounded, "ramp steep", "grounded");
+}
+
+//
+// testCorner
+// Description:
+//      Runs into one wall of the inside corner at an angle, and walks diagonally into the corner.
+// Parameters:
+//      directory <const std::string&>: Where the mesh is written.
+// Returns:
+//      None (void).
+//
+static void testCorner(const std::string &directory) {
+    Model model;
+    BVH bvh;
+
+    if (!loadLevel(directory, "corner.obj", CORNER_OBJ, model, bvh)) {
+        check(false, "corner", "load");
+        return;
+    }
+
+    CharacterController controller(bvh);
+    CapsuleHit hit;
+
+    // Off the floor, the capsule touches the wall at x = 1 when its axis is at x = 0.75, half way
+    Capsule capsule = standing(0.0f, 0.5f, 0.0f);
+    Vector3 displacement(1.5f, 0.0f, 0.5f);
+
+    check(controller.sweepCapsule(capsule, displacement, hit), "corner wall", "hit");
+    checkNear(hit.time, 0.5f, "corner wall", "time");
+    checkFace(hit, Vector3(-1.0f, 0.0f, 0.0f), "corner wall");
+    checkVector(hit.normal, hit.faceNormal, "corner wall", "normal");
+    checkVector(hit.slide, Vector3(0.0f, 0.0f, 0.25f), "corner wall", "slide");
+    check(hit.face == model.getObjects()[2]->faces[0], "corner wall", "face");
+
+    // Walking into the corner slides along the first wall into the second and stops in the corner, on the
+    // floor and without climbing the walls
+    bool grounded = false;
+    capsule = standing(0.0f, TEST_SKIN, 0.0f);
+    Vector3 moved = controller.move(capsule, Vector3(2.0f, -0.05f, 1.5f), &grounded);
+    Vector3 end(capsule.point0.x + moved.x, capsule.point0.y + moved.y, capsule.point0.z + moved.z);
+
+    check(grounded, "corner move", "grounded");
+    check(end.x > 0.75f - 2.0f * TEST_SKIN && end.x < 0.75f, "corner move", "x against the wall");
+    check(end.z > 0.75f - 2.0f * TEST_SKIN && end.z < 0.75f, "corner move", "z against the wall");
+    check(fabsf(moved.y) < 0.05f, "corner move", "rise");
+}
+
+//*********************************************************************************
+// Helper functions
+//*********************************************************************************
+
+//
+// loadLevel
+// Description:
+//      Writes a mesh to an OBJ file, loads it and builds its BVH.
+// Parameters:
+//      directory <const std::string&>: Where the file is written, ends with a separator or is empty.
+//      name      <const std::string&>: Filename.
+//      contents  <const char*>: OBJ text.
+//      model     <Model&>: Receives the mesh.
+//      bvh       <BVH&>: Built over the mesh.
+// Returns:
+//      <bool>: If the mesh was written and loaded.
+//
+static bool loadLevel(const std::string &directory, const std::string &name, const char *contents, Model &model,
+                      BVH &bvh) {
+    std::string filename = directory + name;
+
+    {
+        std::ofstream ostr(filename.data());
+        ostr << contents;
+
+        if (!ostr)
+            return false;
+    }
+
+    if (!model.loadObject(filename))
+        return false;
+
+    bvh.build(model);
+    return true;
+}
+
+//
+// standing
+// Description:
+//      Makes an upright capsule, one unit between its sphere centers.
+// Parameters:
+//      x      <float>: Position of the axis.
+//      bottom <float>: Height of the lowest point.
+//      z      <float>: Position of the axis.
+//      radius <float>: Radius of the capsule.
+// Returns:
+//      <Capsule>: The capsule.
+//
+static Capsule standing(float x, float bottom, float z, float radius) {
+    Vector3 point0(x, bottom + radius, z);
+    Vector3 point1(x, bottom + radius + 1.0f, z);
+
+    return Capsule(point0, point1, radius);
+}
+
+//
+// check
+// Description:
+//      Counts a check and prints it if it failed.
+// Parameters:
+//      condition <bool>: If the check passed.
+//      test      <const char*>: Name of the test.
+//      what      <const char*>: What was checked.
+// Returns:
+//      None (void).
+//
+static void check(bool condition, const char *test, const char *what) {
+    numChecks++;
+
+    if (!condition) {
+        numFailures++;
+        printf("FAILED %s: %s\n", test, what);
+    }
+}
+
+//
+// checkNear
+// Description:
+//      Checks a value against the expected one within the test tolerance.
+// Parameters:
+//      value    <float>: Result.
+//      expected <float>: Expected result.
+//      test     <const char*>: Name of the test.
+//      what     <const char*>: What was checked.
+// Returns:
+//      None (void).
+//
+static void checkNear(float value, float expected, const char *test, const char *what) {
+    bool near = fabsf(value - expected) <= TEST_TOLERANCE;
+    check(near, test, what);
+
+    if (!near)
+        printf("    got %f, expected %f\n", value, expected);
+}
+
+//
+// checkVector
+// Description:
+//      Checks a vector against the expected one within the test tolerance.
+// Parameters:
+//      value    <const Vector3&>: Result.
+//      expected <const Vector3&>: Expected result.
+//      test     <const char*>: Name of the test.
+//      what     <const char*>: What was checked.
+// Returns:
+//      None (void).
+//
+static void checkVector(const Vector3 &value, const Vector3 &expected, const char *test, const char *what) {
+    bool near = fabsf(value.x - expected.x) <= TEST_TOLERANCE && fabsf(value.y - expected.y) <= TEST_TOLERANCE &&
+                fabsf(value.z - expected.z) <= TEST_TOLERANCE;
+    check(near, test, what);
+
+    if (!near)
+        printf("    got (%f %f %f), expected (%f %f %f)\n", value.x, value.y, value.z, expected.x, expected.y, expected.z);
+}
+
+//
+// checkFace
+// Description:
+//      Checks the face normal of a hit, which has to be the normal of the hit face from the model turned
+//      towards the capsule, and the expected one.
+// Parameters:
+//      hit      <const CapsuleHit&>: The hit.
+//      expected <const Vector3&>: Expected unit face normal.
+//      test     <const char*>: Name of the test.
+// Returns:
+//      None (void).
+//
+static void checkFace(const CapsuleHit &hit, const Vector3 &expected, const char *test) {
+    checkVector(hit.faceNormal, expected, test, "face normal");
+    check(hit.face != NULL, test, "face");
+
+    if (hit.face == NULL)
+        return;
+
+    Vector3 faceNormal = hit.face->faceNormal;
+    float length = sqrtf(faceNormal.x * faceNormal.x + faceNormal.y * faceNormal.y + faceNormal.z * faceNormal.z);
+    float cosine = (faceNormal.x * hit.faceNormal.x + faceNormal.y * hit.faceNormal.y +
+                    faceNormal.z * hit.faceNormal.z) / length;
+
+    checkNear(fabsf(cosine), 1.0f, test, "face normal from the face");
+}
+
+//
+// expectedSlide
+// Description:
+//      Computes the slide of a hit: the displacement left after the contact with the part into the contact
+//      plane removed.
+// Parameters:
+//      displacement <const Vector3&>: The swept displacement.
+//      time         <float>: Time of impact.
+//      normal       <const Vector3&>: Unit contact normal.
+// Returns:
+//      <Vector3>: The slide.
+//
+static Vector3 expectedSlide(const Vector3 &displacement, float time, const Vector3 &normal) {
+    Vector3 remaining(displacement.x * (1.0f - time), displacement.y * (1.0f - time), displacement.z * (1.0f - time));
+    float into = remaining.x * normal.x + remaining.y * normal.y + remaining.z * normal.z;
+
+    if (into >= 0.0f)
+        return remaining;
+
+    return Vector3(remaining.x - normal.x * into, remaining.y - normal.y * into, remaining.z - normal.z * into);
+}